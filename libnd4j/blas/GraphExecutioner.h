@@ -71,6 +71,12 @@ namespace nd4j {
 
         static Graph *importFromFlatBuffers(const char *filename);
 
+        /**
+        * This method maps given FlatBuffers file into memory, and returns Graph instance.
+        * Aligned constants with native byte order reference mapped memory instead of being copied, mapping is released together with Graph
+        */
+        static Graph *importFromMappedFlatBuffers(const char *filename);
+
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
     };
 
@@ -39,6 +39,10 @@
 
 namespace nd4j {
 
+    namespace expr {
+        template <typename E>
+        class Expression;
+    }
 
     ND4J_EXPORT NDArray operator-(const float&, const NDArray&);
     ND4J_EXPORT NDArray operator-(const float16&, const NDArray&);
@@ -231,6 +235,12 @@ namespace nd4j {
         template <typename T>
         NDArray& operator=(const T scalar);
 
+        /**
+        *  assignment operator, evaluates lazy expression into this array, defined in NDArrayExpression.h
+        */
+        template <typename E>
+        NDArray& operator=(const expr::Expression<E>& expression);
+
 
         /**
         *   operators for memory allocation and deletion
@@ -422,6 +432,12 @@ namespace nd4j {
         void assign(const int8_t value);
         void assign(const bool value);
 
+        /**
+        *  evaluates lazy expression into this array in single pass, defined in NDArrayExpression.h
+        */
+        template <typename E>
+        void assign(const expr::Expression<E>& expression);
+
         /**
         *  returns new copy of this array, optionally in different order
         */
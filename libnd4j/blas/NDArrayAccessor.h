@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_NDARRAYACCESSOR_H
+#define LIBND4J_NDARRAYACCESSOR_H
+
+#include <NDArray.h>
+#include <array/DataTypeUtils.h>
+#include <type_traits>
+#include <stdexcept>
+
+namespace nd4j {
+
+    /**
+     * Typed view of NDArray for helper kernels.
+     *
+     * Data type and rank are checked once on construction, shape and strides are copied, so element access afterwards
+     * is plain pointer arithmetic: no data type dispatch and no shapeInfo parsing per element, unlike NDArray::e<T>/p.
+     * Accessor doesn't own anything and must not outlive the array.
+     *
+     *      NDArrayAccessor<float, 2> x(*input);          // rank known at compile time
+     *      x(i, j) += 1.f;
+     *
+     *      NDArrayAccessor<const float> y(*other);       // any rank, read-only
+     *      for (auto it = y.begin(); it != y.end(); ++it)
+     *          sum += *it;                              // c-order traversal, offsets are updated incrementally
+     *
+     * Linear index has the same meaning as in NDArray::e(i): position of element in c-order traversal of the array.
+     *
+     * Rank - rank of array, or 0 if it's known at runtime only
+     */
+    template <typename T, int Rank = 0>
+    class NDArrayAccessor {
+    private:
+        static const int kStorage = Rank > 0 ? Rank : MAX_RANK;
+
+        T* _buffer;
+        int _rank;
+        Nd4jLong _length;
+        // > 0 if offset of linear index i is just i * _ews
+        Nd4jLong _ews;
+        Nd4jLong _shape[kStorage];
+        Nd4jLong _strides[kStorage];
+
+        void init(T* buffer, const Nd4jLong* shapeInfo) {
+            auto info = const_cast<Nd4jLong*>(shapeInfo);
+
+            if (Rank > 0 && shape::rank(info) != Rank)
+                throw std::invalid_argument("NDArrayAccessor: rank of array is not equal to template Rank!");
+
+            _buffer = buffer;
+            _rank = shape::rank(info);
+            _length = ArrayOptions::arrayType(info) == ArrayType::EMPTY ? 0 : shape::length(info);
+
+            for (int d = 0; d < _rank; d++) {
+                _shape[d] = shape::shapeOf(info)[d];
+                _strides[d] = shape::stride(info)[d];
+            }
+
+            if (_length <= 1)
+                _ews = 1;
+            else if (_rank == 1)
+                _ews = _strides[0];
+            else
+                _ews = shape::order(info) == 'c' ? shape::elementWiseStride(info) : 0;
+        }
+
+    public:
+        class Iterator {
+        private:
+            const NDArrayAccessor* _accessor;
+            Nd4jLong _index;
+            Nd4jLong _offset;
+            Nd4jLong _coords[kStorage];
+
+        public:
+            Iterator(const NDArrayAccessor* accessor, Nd4jLong index) : _accessor(accessor), _index(index), _offset(0) {
+                if (index >= accessor->lengthOf())
+                    return;
+
+                for (int d = accessor->rank() - 1; d >= 0; d--) {
+                    _coords[d] = index % accessor->_shape[d];
+                    _offset += _coords[d] * accessor->_strides[d];
+                    index /= accessor->_shape[d];
+                }
+            }
+
+            FORCEINLINE T& operator*() const {
+                return _accessor->_buffer[_offset];
+            }
+
+            FORCEINLINE Nd4jLong index() const {
+                return _index;
+            }
+
+            FORCEINLINE Iterator& operator++() {
+                ++_index;
+
+                if (_accessor->_ews > 0) {
+                    _offset += _accessor->_ews;
+                    return *this;
+                }
+
+                for (int d = _accessor->rank() - 1; d >= 0; d--) {
+                    if (++_coords[d] < _accessor->_shape[d]) {
+                        _offset += _accessor->_strides[d];
+                        break;
+                    }
+
+                    _offset -= (_coords[d] - 1) * _accessor->_strides[d];
+                    _coords[d] = 0;
+                }
+
+                return *this;
+            }
+
+            FORCEINLINE bool operator==(const Iterator& other) const {
+                return _index == other._index;
+            }
+
+            FORCEINLINE bool operator!=(const Iterator& other) const {
+                return _index != other._index;
+            }
+        };
+
+        explicit NDArrayAccessor(const NDArray& array) {
+            if (DataTypeUtils::fromT<typename std::remove_const<T>::type>() != array.dataType())
+                throw std::invalid_argument("NDArrayAccessor: type of array is not equal to template type T!");
+
+            init(reinterpret_cast<T*>(array.getBuffer()), array.getShapeInfo());
+        }
+
+        /**
+         * Accessor over raw buffer described by shapeInfo, i.e. sub-array from TadViews.
+         * Data type isn't checked here, it's caller's responsibility
+         */
+        NDArrayAccessor(T* buffer, const Nd4jLong* shapeInfo) {
+            init(buffer, shapeInfo);
+        }
+
+        FORCEINLINE int rank() const {
+            return Rank > 0 ? Rank : _rank;
+        }
+
+        FORCEINLINE Nd4jLong lengthOf() const {
+            return _length;
+        }
+
+        FORCEINLINE Nd4jLong sizeAt(const int dim) const {
+            return _shape[dim];
+        }
+
+        FORCEINLINE Nd4jLong strideAt(const int dim) const {
+            return _strides[dim];
+        }
+
+        FORCEINLINE T* buffer() const {
+            return _buffer;
+        }
+
+        /**
+         * This method returns true if elements are spaced evenly in c-order, so buffer()[i * ews()] can be used directly
+         */
+        FORCEINLINE bool isLinear() const {
+            return _ews > 0;
+        }
+
+        FORCEINLINE Nd4jLong ews() const {
+            return _ews;
+        }
+
+        /**
+         * This method returns buffer offset of element with given linear index
+         */
+        FORCEINLINE Nd4jLong offset(Nd4jLong index) const {
+            if (_ews > 0)
+                return index * _ews;
+
+            Nd4jLong offset = 0;
+            for (int d = rank() - 1; d >= 0; d--) {
+                offset += (index % _shape[d]) * _strides[d];
+                index /= _shape[d];
+            }
+
+            return offset;
+        }
+
+        FORCEINLINE T& operator[](const Nd4jLong index) const {
+            return _buffer[offset(index)];
+        }
+
+        /**
+         * Element access by coordinates, number of coordinates must be equal to rank
+         */
+        template <typename... Coords>
+        FORCEINLINE T& operator()(const Coords... coords) const {
+            static_assert(Rank == 0 || sizeof...(Coords) == Rank, "NDArrayAccessor: number of coordinates must be equal to Rank");
+
+            const Nd4jLong c[] = {static_cast<Nd4jLong>(coords)...};
+            Nd4jLong offset = 0;
+            for (int d = 0; d < (int) sizeof...(Coords); d++)
+                offset += c[d] * _strides[d];
+
+            return _buffer[offset];
+        }
+
+        Iterator begin() const {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() const {
+            return Iterator(this, _length);
+        }
+    };
+}
+
+#endif //LIBND4J_NDARRAYACCESSOR_H
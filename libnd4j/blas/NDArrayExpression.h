@@ -0,0 +1,478 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_NDARRAYEXPRESSION_H
+#define LIBND4J_NDARRAYEXPRESSION_H
+
+#include <NDArray.h>
+#include <Environment.h>
+#include <templatemath.h>
+#include <op_boilerplate.h>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * Lazy elementwise expressions over NDArrays.
+ *
+ * Arithmetic on expressions builds a tree instead of allocating NDArray per operator, tree is evaluated in one pass
+ * when assigned to array:
+ *
+ *      z.assign(expr::sigmoid(expr::lazy(x) + 1.) * y + b);       // single loop, no temporaries
+ *      auto w = (expr::lazy(x) * 2.f).evaluate();                 // allocates result
+ *
+ * Operands are broadcast numpy-style, broadcasting is resolved once per evaluation. Evaluation happens in data type of
+ * target array, operands of other types are cast before the loop. Target may appear in expression itself, if any
+ * operand overlaps target differently, expression is evaluated into temporary array first.
+ *
+ * Expression keeps pointers to lvalue arrays, so it must not outlive them. Temporary arrays are moved into expression.
+ */
+namespace nd4j {
+namespace expr {
+
+    // max number of array operands in single expression
+    static const int kMaxOperands = 32;
+
+    /**
+     * Operands resolved against shape of evaluated expression
+     */
+    class Binding {
+    public:
+        std::vector<Nd4jLong> shape;
+        DataType dataType;
+
+        // strides of every operand over result shape, kMaxOperands x rank
+        std::vector<Nd4jLong> strides;
+        int numOperands = 0;
+
+        // true if all operands have result shape and are dense in the same order as target, loop is plain 1D then
+        bool flat = true;
+        // true if some operand overlaps target other way than element-to-element
+        bool aliased = false;
+
+        const NDArray* target = nullptr;
+        std::vector<std::unique_ptr<NDArray>> casts;
+
+        Binding(const std::vector<Nd4jLong>& resultShape, DataType resultType, const NDArray* resultArray) : shape(resultShape), dataType(resultType), target(resultArray) {
+            strides.resize(kMaxOperands * shape.size());
+        }
+
+        int rank() const {
+            return (int) shape.size();
+        }
+
+        // registers operand, returns its id and buffer of result data type
+        int bind(const NDArray& array, const void*& buffer) {
+            if(numOperands == kMaxOperands)
+                throw std::runtime_error("expr::Binding: too many array operands in expression");
+
+            const int id = numOperands++;
+            const int r = rank();
+            const int ar = array.rankOf();
+            Nd4jLong* s = strides.data() + id * r;
+
+            for(int d = 0; d < r; ++d) {
+                const int ad = d - (r - ar);
+                if(ad < 0 || (array.sizeAt(ad) == 1 && shape[d] != 1))
+                    s[d] = 0;
+                else if(array.sizeAt(ad) == shape[d])
+                    s[d] = array.stridesOf()[ad];
+                else
+                    throw std::runtime_error("expr::Binding: operands shapes are not broadcastable");
+            }
+
+            const NDArray* source = &array;
+            if(array.dataType() != dataType) {
+                casts.emplace_back(const_cast<NDArray&>(array).cast(dataType));
+                source = casts.back().get();
+                for(int d = 0; d < r; ++d)
+                    if(s[d] != 0)
+                        s[d] = source->stridesOf()[d - (r - ar)];
+            }
+            buffer = source->getBuffer();
+
+            const bool dense = ar == r && source->ews() == 1 && (target == nullptr || source->ordering() == target->ordering());
+            bool sameShape = ar == r;
+            for(int d = 0; sameShape && d < r; ++d)
+                sameShape = s[d] != 0 || shape[d] == 1;
+            flat = flat && dense && sameShape;
+
+            if(target != nullptr && source->getBuffer() != nullptr && overlaps(*source, *target)) {
+                bool sameMapping = source->getBuffer() == target->getBuffer();
+                for(int d = 0; sameMapping && d < r; ++d)
+                    sameMapping = shape[d] == 1 || s[d] == target->stridesOf()[d];
+                aliased = aliased || !sameMapping;
+            }
+
+            return id;
+        }
+
+    private:
+        static bool overlaps(const NDArray& a, const NDArray& b) {
+            const char* aStart = reinterpret_cast<const char*>(a.getBuffer());
+            const char* bStart = reinterpret_cast<const char*>(b.getBuffer());
+            return aStart < bStart + span(b) && bStart < aStart + span(a);
+        }
+
+        static Nd4jLong span(const NDArray& a) {
+            Nd4jLong last = 0;
+            for(int d = 0; d < a.rankOf(); ++d)
+                last += (a.sizeAt(d) - 1) * a.stridesOf()[d];
+            return (last + 1) * DataTypeUtils::sizeOfElement(a.dataType());
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // tree nodes
+
+    class ArrayTerm {
+    private:
+        std::shared_ptr<NDArray> _owned;
+        const NDArray* _array;
+
+        mutable const void* _buffer = nullptr;
+        mutable Nd4jLong _inner = 0;
+        mutable int _id = 0;
+
+    public:
+        explicit ArrayTerm(const NDArray& array) : _array(&array) { }
+        explicit ArrayTerm(NDArray&& array) : _owned(std::make_shared<NDArray>(std::move(array))) {
+            _array = _owned.get();
+        }
+
+        const NDArray* firstArray() const { return _array; }
+
+        void broadcastShape(std::vector<Nd4jLong>& shape) const {
+            const int r = _array->rankOf();
+            if((int) shape.size() < r)
+                shape.insert(shape.begin(), r - shape.size(), 1);
+            const int shift = (int) shape.size() - r;
+            for(int d = 0; d < r; ++d) {
+                const Nd4jLong dim = _array->sizeAt(d);
+                if(shape[shift + d] == 1)
+                    shape[shift + d] = dim;
+                else if(dim != 1 && dim != shape[shift + d])
+                    throw std::runtime_error("expr::ArrayTerm: operands shapes are not broadcastable");
+            }
+        }
+
+        void bind(Binding& binding) const {
+            _id = binding.bind(*_array, _buffer);
+            _inner = binding.rank() > 0 ? binding.strides[_id * binding.rank() + binding.rank() - 1] : 0;
+        }
+
+        template <typename T, bool Flat>
+        FORCEINLINE T value(const Nd4jLong* offsets, const Nd4jLong i) const {
+            return Flat ? reinterpret_cast<const T*>(_buffer)[i] : reinterpret_cast<const T*>(_buffer)[offsets[_id] + i * _inner];
+        }
+    };
+
+    class ScalarTerm {
+    private:
+        double _value;
+
+    public:
+        explicit ScalarTerm(const double value) : _value(value) { }
+
+        const NDArray* firstArray() const { return nullptr; }
+        void broadcastShape(std::vector<Nd4jLong>& shape) const { }
+        void bind(Binding& binding) const { }
+
+        template <typename T, bool Flat>
+        FORCEINLINE T value(const Nd4jLong* offsets, const Nd4jLong i) const {
+            return static_cast<T>(_value);
+        }
+    };
+
+    template <typename Op, typename A>
+    class UnaryTerm {
+    private:
+        A _a;
+
+    public:
+        explicit UnaryTerm(const A& a) : _a(a) { }
+
+        const NDArray* firstArray() const { return _a.firstArray(); }
+        void broadcastShape(std::vector<Nd4jLong>& shape) const { _a.broadcastShape(shape); }
+        void bind(Binding& binding) const { _a.bind(binding); }
+
+        template <typename T, bool Flat>
+        FORCEINLINE T value(const Nd4jLong* offsets, const Nd4jLong i) const {
+            return Op::template op<T>(_a.template value<T, Flat>(offsets, i));
+        }
+    };
+
+    template <typename Op, typename A, typename B>
+    class BinaryTerm {
+    private:
+        A _a;
+        B _b;
+
+    public:
+        BinaryTerm(const A& a, const B& b) : _a(a), _b(b) { }
+
+        const NDArray* firstArray() const {
+            auto first = _a.firstArray();
+            return first != nullptr ? first : _b.firstArray();
+        }
+
+        void broadcastShape(std::vector<Nd4jLong>& shape) const {
+            _a.broadcastShape(shape);
+            _b.broadcastShape(shape);
+        }
+
+        void bind(Binding& binding) const {
+            _a.bind(binding);
+            _b.bind(binding);
+        }
+
+        template <typename T, bool Flat>
+        FORCEINLINE T value(const Nd4jLong* offsets, const Nd4jLong i) const {
+            return Op::template op<T>(_a.template value<T, Flat>(offsets, i), _b.template value<T, Flat>(offsets, i));
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // elementwise functions
+
+    struct Add      { template <typename T> static FORCEINLINE T op(const T a, const T b) { return a + b; } };
+    struct Subtract { template <typename T> static FORCEINLINE T op(const T a, const T b) { return a - b; } };
+    struct Multiply { template <typename T> static FORCEINLINE T op(const T a, const T b) { return a * b; } };
+    struct Divide   { template <typename T> static FORCEINLINE T op(const T a, const T b) { return a / b; } };
+    struct Max      { template <typename T> static FORCEINLINE T op(const T a, const T b) { return a > b ? a : b; } };
+    struct Min      { template <typename T> static FORCEINLINE T op(const T a, const T b) { return a < b ? a : b; } };
+
+    struct Neg      { template <typename T> static FORCEINLINE T op(const T a) { return -a; } };
+    struct Abs      { template <typename T> static FORCEINLINE T op(const T a) { return nd4j::math::nd4j_abs<T>(a); } };
+    struct Exp      { template <typename T> static FORCEINLINE T op(const T a) { return nd4j::math::nd4j_exp<T, T>(a); } };
+    struct Log      { template <typename T> static FORCEINLINE T op(const T a) { return nd4j::math::nd4j_log<T, T>(a); } };
+    struct Sqrt     { template <typename T> static FORCEINLINE T op(const T a) { return nd4j::math::nd4j_sqrt<T, T>(a); } };
+    struct Tanh     { template <typename T> static FORCEINLINE T op(const T a) { return nd4j::math::nd4j_tanh<T, T>(a); } };
+    struct Sigmoid  { template <typename T> static FORCEINLINE T op(const T a) { return nd4j::math::nd4j_sigmoid<T, T>(a); } };
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename E>
+    class Expression {
+    private:
+        E _node;
+
+        template <typename T>
+        static void evaluate_(const E& node, const Binding& binding, NDArray& target);
+
+    public:
+        explicit Expression(const E& node) : _node(node) { }
+
+        const E& node() const { return _node; }
+
+        /**
+         * This method evaluates expression into target, target shape must match broadcast shape of operands
+         */
+        void evaluate(NDArray& target) const;
+
+        /**
+         * This method evaluates expression into new array, with data type of the first array operand
+         */
+        NDArray evaluate() const;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename E>
+    template <typename T>
+    void Expression<E>::evaluate_(const E& node, const Binding& binding, NDArray& target) {
+        T* z = target.bufferAsT<T>();
+        const Nd4jLong len = target.lengthOf();
+        const bool parallel = len > Environment::getInstance()->elementwiseThreshold();
+
+        if(binding.flat && target.ews() == 1) {
+            const Nd4jLong span = 4096;
+            const Nd4jLong numSpans = (len + span - 1) / span;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(parallel)
+            for(Nd4jLong s = 0; s < numSpans; ++s) {
+                const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(len, (s + 1) * span);
+                PRAGMA_OMP_SIMD
+                for(Nd4jLong i = s * span; i < end; ++i)
+                    z[i] = node.template value<T, true>(nullptr, i);
+            }
+            return;
+        }
+
+        const int rank = binding.rank();
+        const int num = binding.numOperands;
+        const Nd4jLong* shape = binding.shape.data();
+        const Nd4jLong* strides = binding.strides.data();
+        const Nd4jLong* zStrides = target.stridesOf();
+
+        const Nd4jLong inner = rank > 0 ? shape[rank - 1] : 1;
+        const Nd4jLong zInner = rank > 0 ? zStrides[rank - 1] : 0;
+        const Nd4jLong rows = inner == 0 ? 0 : len / inner;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallel && rows > 1)
+        for(Nd4jLong row = 0; row < rows; ++row) {
+            Nd4jLong offsets[kMaxOperands];
+            Nd4jLong zOffset = 0;
+            for(int k = 0; k < num; ++k)
+                offsets[k] = 0;
+
+            Nd4jLong rest = row;
+            for(int d = rank - 2; d >= 0 && rest > 0; --d) {
+                const Nd4jLong coord = rest % shape[d];
+                rest /= shape[d];
+                zOffset += coord * zStrides[d];
+                for(int k = 0; k < num; ++k)
+                    offsets[k] += coord * strides[k * rank + d];
+            }
+
+            T* pZ = z + zOffset;
+            PRAGMA_OMP_SIMD
+            for(Nd4jLong i = 0; i < inner; ++i)
+                pZ[i * zInner] = node.template value<T, false>(offsets, i);
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename E>
+    void Expression<E>::evaluate(NDArray& target) const {
+        std::vector<Nd4jLong> shape;
+        _node.broadcastShape(shape);
+
+        if(shape.size() < (size_t) target.rankOf())
+            shape.insert(shape.begin(), target.rankOf() - shape.size(), 1);
+        if(shape != target.getShapeAsVector())
+            throw std::runtime_error("Expression::evaluate: target shape doesn't match shape of expression");
+
+        Binding binding(shape, target.dataType(), &target);
+        _node.bind(binding);
+
+        if(binding.aliased) {
+            NDArray temp(target.ordering(), shape, target.dataType(), target.getWorkspace());
+            evaluate(temp);
+            target.assign(temp);
+            return;
+        }
+
+        BUILD_SINGLE_SELECTOR(target.dataType(), evaluate_, (_node, binding, target), NUMERIC_TYPES);
+    }
+
+    template <typename E>
+    NDArray Expression<E>::evaluate() const {
+        auto first = _node.firstArray();
+        if(first == nullptr)
+            throw std::runtime_error("Expression::evaluate: expression has no array operands");
+
+        std::vector<Nd4jLong> shape;
+        _node.broadcastShape(shape);
+
+        NDArray result(first->ordering(), shape, first->dataType(), first->getWorkspace());
+        evaluate(result);
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // expression builders
+
+    FORCEINLINE Expression<ArrayTerm> lazy(const NDArray& array) {
+        return Expression<ArrayTerm>(ArrayTerm(array));
+    }
+
+    FORCEINLINE Expression<ArrayTerm> lazy(NDArray&& array) {
+        return Expression<ArrayTerm>(ArrayTerm(std::move(array)));
+    }
+
+#define ND4J_EXPRESSION_BINARY(NAME, OP) \
+    template <typename A, typename B> \
+    FORCEINLINE Expression<BinaryTerm<OP, A, B>> NAME(const Expression<A>& a, const Expression<B>& b) { \
+        return Expression<BinaryTerm<OP, A, B>>(BinaryTerm<OP, A, B>(a.node(), b.node())); \
+    } \
+    template <typename A> \
+    FORCEINLINE Expression<BinaryTerm<OP, A, ArrayTerm>> NAME(const Expression<A>& a, const NDArray& b) { \
+        return NAME(a, lazy(b)); \
+    } \
+    template <typename A> \
+    FORCEINLINE Expression<BinaryTerm<OP, A, ArrayTerm>> NAME(const Expression<A>& a, NDArray&& b) { \
+        return NAME(a, lazy(std::move(b))); \
+    } \
+    template <typename B> \
+    FORCEINLINE Expression<BinaryTerm<OP, ArrayTerm, B>> NAME(const NDArray& a, const Expression<B>& b) { \
+        return NAME(lazy(a), b); \
+    } \
+    template <typename B> \
+    FORCEINLINE Expression<BinaryTerm<OP, ArrayTerm, B>> NAME(NDArray&& a, const Expression<B>& b) { \
+        return NAME(lazy(std::move(a)), b); \
+    } \
+    template <typename A> \
+    FORCEINLINE Expression<BinaryTerm<OP, A, ScalarTerm>> NAME(const Expression<A>& a, const double b) { \
+        return Expression<BinaryTerm<OP, A, ScalarTerm>>(BinaryTerm<OP, A, ScalarTerm>(a.node(), ScalarTerm(b))); \
+    } \
+    template <typename B> \
+    FORCEINLINE Expression<BinaryTerm<OP, ScalarTerm, B>> NAME(const double a, const Expression<B>& b) { \
+        return Expression<BinaryTerm<OP, ScalarTerm, B>>(BinaryTerm<OP, ScalarTerm, B>(ScalarTerm(a), b.node())); \
+    }
+
+#define ND4J_EXPRESSION_UNARY(NAME, OP) \
+    template <typename A> \
+    FORCEINLINE Expression<UnaryTerm<OP, A>> NAME(const Expression<A>& a) { \
+        return Expression<UnaryTerm<OP, A>>(UnaryTerm<OP, A>(a.node())); \
+    } \
+    FORCEINLINE Expression<UnaryTerm<OP, ArrayTerm>> NAME(const NDArray& a) { \
+        return NAME(lazy(a)); \
+    } \
+    FORCEINLINE Expression<UnaryTerm<OP, ArrayTerm>> NAME(NDArray&& a) { \
+        return NAME(lazy(std::move(a))); \
+    }
+
+    ND4J_EXPRESSION_BINARY(operator+, Add)
+    ND4J_EXPRESSION_BINARY(operator-, Subtract)
+    ND4J_EXPRESSION_BINARY(operator*, Multiply)
+    ND4J_EXPRESSION_BINARY(operator/, Divide)
+    ND4J_EXPRESSION_BINARY(max, Max)
+    ND4J_EXPRESSION_BINARY(min, Min)
+
+    ND4J_EXPRESSION_UNARY(abs, Abs)
+    ND4J_EXPRESSION_UNARY(exp, Exp)
+    ND4J_EXPRESSION_UNARY(log, Log)
+    ND4J_EXPRESSION_UNARY(sqrt, Sqrt)
+    ND4J_EXPRESSION_UNARY(tanh, Tanh)
+    ND4J_EXPRESSION_UNARY(sigmoid, Sigmoid)
+
+    // plain arrays keep eager unary minus
+    template <typename A>
+    FORCEINLINE Expression<UnaryTerm<Neg, A>> operator-(const Expression<A>& a) {
+        return Expression<UnaryTerm<Neg, A>>(UnaryTerm<Neg, A>(a.node()));
+    }
+
+#undef ND4J_EXPRESSION_BINARY
+#undef ND4J_EXPRESSION_UNARY
+}
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename E>
+    void NDArray::assign(const expr::Expression<E>& expression) {
+        expression.evaluate(*this);
+    }
+
+    template <typename E>
+    NDArray& NDArray::operator=(const expr::Expression<E>& expression) {
+        expression.evaluate(*this);
+        return *this;
+    }
+}
+
+#endif //LIBND4J_NDARRAYEXPRESSION_H
@@ -599,6 +599,11 @@ public:
 
     void initializeFunctions(Nd4jPointer *functions);
 
+    /**
+     * This method passes BLAS/LAPACK functions table of given length. Version without length assumes legacy 10-slot table
+     */
+    void initializeFunctions(Nd4jPointer *functions, int numFunctions);
+
     /**
      * This method acquires memory chunk of requested size on host side
      *
@@ -854,6 +859,31 @@ public:
      */
     void enableVerboseMode(bool reallyEnable);
 
+    /**
+     * This method enables or disables per-op tracing. Traced events are kept in per-thread ring buffers
+     *
+     * @param reallyEnable
+     */
+    void enableOpTracing(bool reallyEnable);
+
+    /**
+     *
+     * @return true if per-op tracing is enabled
+     */
+    bool isOpTracingEnabled();
+
+    /**
+     * This method drops all traced events collected so far
+     */
+    void resetOpTrace();
+
+    /**
+     * This method writes traced events to given file in Chrome trace JSON format
+     *
+     * @param fileName
+     */
+    void dumpOpTrace(const char *fileName);
+
     /**
      *
      * @param gridSize
@@ -1390,47 +1420,34 @@ public:
 
     ////// NPZ //////
 
+    /**
+     * This method opens npz archive. Only zip directory is read here, members are loaded on demand
+     */
     void* mapFromNpzFile(std::string path){
-        cnpy::npz_t* mapPtr = new cnpy::npz_t();
-        cnpy::npz_t map = cnpy::npzLoad(path);
-        mapPtr->insert(map.begin(), map.end());
-        return reinterpret_cast<void*>(mapPtr);
+        return reinterpret_cast<void*>(new cnpy::NpzArchive(path.c_str()));
     }
 
 
     int getNumNpyArraysInMap(void *map){
-        cnpy::npz_t* arrays = reinterpret_cast<cnpy::npz_t*>(map);
-        int n = arrays->size();
-        return n;
+        auto archive = reinterpret_cast<cnpy::NpzArchive*>(map);
+        return archive->size();
     }
 
     const char* getNpyArrayNameFromMap(void *map, int index){
-        cnpy::npz_t* arrays = reinterpret_cast<cnpy::npz_t*>(map);
-        cnpy::npz_t::iterator it = arrays->begin();
-        cnpy::npz_t::iterator end = arrays->end();
-        int cnt = 0;
-        for(; it != end; ++it, ++cnt){
-            if (cnt == index){
-                // FIXME: @fariz, this is a leak!
-                return const_cast<const char *>(strdup(it->first.c_str()));
-            }
-        }
-        throw std::runtime_error("No array at index.");
+        auto archive = reinterpret_cast<cnpy::NpzArchive*>(map);
+        if (index < 0 || index >= archive->size())
+            throw std::runtime_error("No array at index.");
+
+        // name is owned by archive
+        return archive->members()[index].name.c_str();
     }
 
     void* getNpyArrayFromMap(void *map, int index){
-        cnpy::npz_t* arrays = reinterpret_cast<cnpy::npz_t*>(map);
-        cnpy::npz_t::iterator it = arrays->begin();
-        cnpy::npz_t::iterator end = arrays->end();
-        cnpy::NpyArray *arr = new cnpy::NpyArray();
-        int cnt = 0;
-        for(; it != end; ++it, ++cnt){
-            if (cnt == index){
-                *arr = it->second;
-                return arr;
-            }
-        }
-        throw std::runtime_error("No array at index.");
+        auto archive = reinterpret_cast<cnpy::NpzArchive*>(map);
+        if (index < 0 || index >= archive->size())
+            throw std::runtime_error("No array at index.");
+
+        return reinterpret_cast<void*>(new cnpy::NpyArray(archive->npyArray(index)));
     }
 
     void* getNpyArrayData(void *npArray){
@@ -1470,8 +1487,8 @@ public:
     }
 
     void deleteNPArrayMap(void *map){
-        cnpy::npz_t* arrays = reinterpret_cast<cnpy::npz_t*>(map);
-        delete arrays;
+        auto archive = reinterpret_cast<cnpy::NpzArchive*>(map);
+        delete archive;
     }
     //////
 
@@ -1591,6 +1608,54 @@ public:
     int execCustomOp(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace);
     int execCustomOp(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer opContext);
 
+    /**
+     * This method resolves custom op by hash once. Returned handle stays valid for process lifetime,
+     * so callers issuing the same op many times can skip registry lookup via execCustomOpByHandle
+     *
+     * @param hash
+     * @return handle, or nullptr if op wasn't found
+     */
+    Nd4jPointer getCustomOpHandle(Nd4jLong hash);
+    int execCustomOpByHandle(Nd4jPointer* extraPointers, Nd4jPointer opHandle, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace);
+    int execCustomOpByHandle(Nd4jPointer* extraPointers, Nd4jPointer opHandle, Nd4jPointer opContext);
+
+    /**
+     * These methods manage pooled fastpath op contexts: context is created once, then new buffers and arguments
+     * are bound into it before every execCustomOp(extraPointers, hash, opContext) call.
+     * Bound buffers are wrapped into NDArrays which are reused across calls, deleteOpContext returns context into pool
+     */
+    Nd4jPointer createOpContext();
+    void setOpContextInput(Nd4jPointer opContext, int index, Nd4jPointer buffer, Nd4jPointer shapeInfo, Nd4jPointer specialBuffer, Nd4jPointer specialShapeInfo);
+    void setOpContextOutput(Nd4jPointer opContext, int index, Nd4jPointer buffer, Nd4jPointer shapeInfo, Nd4jPointer specialBuffer, Nd4jPointer specialShapeInfo);
+    void setOpContextTArguments(Nd4jPointer opContext, double *arguments, int numberOfArguments);
+    void setOpContextIArguments(Nd4jPointer opContext, Nd4jLong *arguments, int numberOfArguments);
+    void setOpContextBArguments(Nd4jPointer opContext, bool *arguments, int numberOfArguments);
+    void resetOpContext(Nd4jPointer opContext);
+    void deleteOpContext(Nd4jPointer opContext);
+
+    /**
+     * These methods submit custom ops and stored graphs for asynchronous execution, and return ticket handle.
+     * Tasks within one stream are executed in submission order, dependencies are tickets (possibly of other streams)
+     * which have to be done before task starts. Buffers and op context used by task must stay intact until its ticket is done.
+     * Every ticket has to be released via deleteTicket
+     */
+    Nd4jPointer execCustomOpAsync(Nd4jPointer* extraPointers, Nd4jLong streamId, Nd4jLong hash, Nd4jPointer opContext, Nd4jPointer* dependencies, int numDependencies);
+    Nd4jPointer executeStoredGraphAsync(Nd4jPointer *extraPointers, Nd4jLong streamId, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer* dependencies, int numDependencies);
+    bool isTicketDone(Nd4jPointer ticket);
+    int waitForTicket(Nd4jPointer ticket);
+
+    /**
+     * This method waits for graph ticket, and returns its results. Caller owns them, and releases via deleteVariablesSet
+     */
+    nd4j::graph::VariablesSet* getTicketVariables(Nd4jPointer ticket);
+    void deleteTicket(Nd4jPointer ticket);
+    void syncExecutionStream(Nd4jLong streamId);
+
+    /**
+     * This method releases worker thread of given stream, once tasks submitted so far are done
+     */
+    void destroyExecutionStream(Nd4jLong streamId);
+
     nd4j::ShapeList* calculateOutputShapes(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputShapes, int numInputShapes, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs);
     nd4j::ShapeList* calculateOutputShapes(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputShapes, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool *bArgs, int numBArgs);
 
@@ -1598,6 +1663,11 @@ public:
 
     int registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer);
 
+    /**
+     * This method maps FlatBuffers file into memory and registers graph from it. Constants reference mapped memory where possible
+     */
+    int registerMappedGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, const char *fileName);
+
     nd4j::graph::VariablesSet *executeStoredGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs);
 
     int unregisterGraph(Nd4jPointer *extraPointers, Nd4jLong graphId);
@@ -1632,6 +1702,42 @@ public:
                       int* hIindexes, int* dIindexes);
 
     void inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4jLong *shapeInfo, Nd4jPointer specialBuffer, Nd4jLong *specialShapeInfo, Nd4jPointer debugInfo);
+
+    /**
+     * HNSW approximate nearest neighbors index over fp32 vectors, all buffers are host memory
+     *
+     * @param metric - 0 for euclidean, 1 for cosine, 2 for dot product
+     * @param M - number of links per node
+     * @param efConstruction - size of candidates list used during insertion
+     * @param capacity - number of vectors to preallocate storage for
+     *
+     * None of these methods throw: failures are printed, and reported as nullptr or status other than ND4J_STATUS_OK
+     */
+    Nd4jPointer createHnswIndex(int dimensions, int metric, int M, int efConstruction, Nd4jLong capacity);
+
+    /**
+     * This method adds [numVectors, dimensions] row-major vectors to the index, ids are assigned sequentially
+     */
+    int addToHnswIndex(Nd4jPointer index, float *vectors, Nd4jLong numVectors);
+
+    /**
+     * This method writes [numQueries, k] ids and distances of approximate nearest neighbors, sorted from best to worst
+     */
+    int searchHnswIndex(Nd4jPointer index, float *queries, Nd4jLong numQueries, int k, int ef, Nd4jLong *ids, float *distances);
+
+    Nd4jLong hnswIndexSize(Nd4jPointer index);
+
+    /**
+     * This method writes index to file, returns ND4J_STATUS_BAD_OUTPUT if file can't be written
+     */
+    int saveHnswIndex(Nd4jPointer index, const char *fileName);
+
+    /**
+     * This method maps previously saved index into memory. Returns nullptr if file can't be read or is corrupted
+     */
+    Nd4jPointer loadHnswIndex(const char *fileName);
+
+    void deleteHnswIndex(Nd4jPointer index);
 };
 
 
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_TADVIEWS_H
+#define LIBND4J_TADVIEWS_H
+
+#include <NDArray.h>
+#include <NDArrayAccessor.h>
+#include <helpers/ConstantTadHelper.h>
+#include <array/DataTypeUtils.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace nd4j {
+
+    /**
+     * Non-owning list of sub-arrays (TADs) of NDArray along given dimensions.
+     *
+     * Same sub-arrays as NDArray::allTensorsAlongDimension(dimensions), but nothing is allocated per TAD:
+     * all of them share single shapeInfo, and offsets come from ConstantTadHelper cache.
+     *
+     *      TadViews rows(*input, {1});
+     *      for (Nd4jLong i = 0; i < rows.size(); i++) {
+     *          auto row = rows.accessor<float, 1>(i);   // typed element access
+     *          rows.at(i).assign(0.f);                  // or NDArray view on stack, for NDArray methods
+     *      }
+     *
+     * Views must not outlive the array. Since all views point to the same cached TAD shapeInfo, methods changing
+     * shapeInfo in place (permutei, reshapei, setShapeInfo, etc) must not be called on them: that would change
+     * every TAD of this shape in the process. Use permute/reshape/dup instead, they give arrays with their own shapeInfo.
+     */
+    class TadViews {
+    private:
+        int8_t* _buffer = nullptr;
+        Nd4jLong* _shapeInfo = nullptr;
+        Nd4jLong* _offsets = nullptr;
+        Nd4jLong _numTads = 0;
+        Nd4jLong _tadLength = 0;
+        nd4j::DataType _dataType;
+        int _sizeOfT;
+        nd4j::memory::Workspace* _workspace;
+
+    public:
+        class Iterator {
+        private:
+            const TadViews* _views;
+            Nd4jLong _index;
+
+        public:
+            Iterator(const TadViews* views, Nd4jLong index) : _views(views), _index(index) { }
+
+            FORCEINLINE NDArray operator*() const {
+                return _views->at(_index);
+            }
+
+            FORCEINLINE Iterator& operator++() {
+                ++_index;
+                return *this;
+            }
+
+            FORCEINLINE bool operator!=(const Iterator& other) const {
+                return _index != other._index;
+            }
+        };
+
+        TadViews(const NDArray& array, const std::vector<int>& dimensions) {
+            _dataType = array.dataType();
+            _sizeOfT = array.sizeOfT();
+            _workspace = array.getWorkspace();
+
+            // empty list of dimensions gives empty list of sub-arrays, same as allTensorsAlongDimension does
+            if (dimensions.empty())
+                return;
+
+            std::vector<int> copy(dimensions);
+            std::sort(copy.begin(), copy.end());
+
+            if (copy.back() >= array.rankOf())
+                throw std::runtime_error("TadViews: all input dimensions must be smaller than rank of input array !");
+
+            auto& tadPack = ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), copy);
+
+            _buffer = reinterpret_cast<int8_t*>(array.getBuffer());
+            _shapeInfo = tadPack.primaryShapeInfo();
+            _offsets = tadPack.primaryOffsets();
+            _numTads = tadPack.numberOfTads();
+            _tadLength = shape::length(_shapeInfo);
+        }
+
+        TadViews(const NDArray& array, const std::initializer_list<int>& dimensions) : TadViews(array, std::vector<int>(dimensions)) { }
+
+        /**
+         * number of sub-arrays
+         */
+        FORCEINLINE Nd4jLong size() const {
+            return _numTads;
+        }
+
+        /**
+         * shapeInfo shared by all sub-arrays
+         */
+        FORCEINLINE Nd4jLong* shapeInfo() const {
+            return _shapeInfo;
+        }
+
+        FORCEINLINE Nd4jLong tadLength() const {
+            return _tadLength;
+        }
+
+        /**
+         * offset of i-th sub-array in buffer of original array, in elements
+         */
+        FORCEINLINE Nd4jLong offset(const Nd4jLong i) const {
+            return _offsets[i];
+        }
+
+        FORCEINLINE void* bufferAt(const Nd4jLong i) const {
+            return _buffer + _offsets[i] * _sizeOfT;
+        }
+
+        template <typename T>
+        FORCEINLINE T* bufferAt(const Nd4jLong i) const {
+            return reinterpret_cast<T*>(_buffer) + _offsets[i];
+        }
+
+        /**
+         * typed accessor of i-th sub-array, T must match data type of original array
+         */
+        template <typename T, int Rank = 0>
+        NDArrayAccessor<T, Rank> accessor(const Nd4jLong i) const {
+            if (DataTypeUtils::fromT<typename std::remove_const<T>::type>() != _dataType)
+                throw std::invalid_argument("TadViews: type of array is not equal to template type T!");
+
+            return NDArrayAccessor<T, Rank>(bufferAt<T>(i), _shapeInfo);
+        }
+
+        /**
+         * NDArray view of i-th sub-array: lives on stack, owns neither buffer nor shapeInfo.
+         * shapeInfo is the cached one shared with other views, so it's read-only: no in-place shape changes here
+         */
+        FORCEINLINE NDArray at(const Nd4jLong i) const {
+            return NDArray(bufferAt(i), _shapeInfo, _workspace);
+        }
+
+        FORCEINLINE NDArray operator[](const Nd4jLong i) const {
+            return at(i);
+        }
+
+        Iterator begin() const {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() const {
+            return Iterator(this, _numTads);
+        }
+    };
+}
+
+#endif //LIBND4J_TADVIEWS_H
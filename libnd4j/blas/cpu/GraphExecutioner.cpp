@@ -31,6 +31,7 @@
 #include <Scope.h>
 #include <GraphExecutioner.h>
 #include <graph/TimeHolder.h>
+#include <graph/OutputAliasing.h>
 #include <loops/scalar.h>
 #include <loops/pairwise_transform.h>
 #include <loops/transform_same.h>
@@ -234,6 +235,9 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+    // lets producers of concat inputs write into concat output, and split outputs be views of split input
+    OutputAliasing aliasing(graph);
+
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -435,6 +439,8 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 auto timeStart = std::chrono::system_clock::now();
 
+                aliasing.prepare(node, __variableSpace);
+
                 // actual node execution happens right here
                 Nd4jStatus status = executeFlatNode(graph, node, __variableSpace);
 
@@ -899,6 +905,20 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
             return restoredGraph;
         }
 
+        Graph* GraphExecutioner::importFromMappedFlatBuffers(const char *filename) {
+            auto file = new MappedFile(filename);
+
+            // basic sanity check before trusting file contents
+            flatbuffers::Verifier verifier(reinterpret_cast<uint8_t *>(file->buffer()), static_cast<size_t>(file->length()));
+            if (!VerifyFlatGraphBuffer(verifier)) {
+                delete file;
+                throw std::runtime_error(std::string("File doesn't contain valid FlatGraph: ") + filename);
+            }
+
+            // Graph owns file from now on, even if construction fails
+            return new Graph(GetFlatGraph(file->buffer()), nullptr, file);
+        }
+
         Graph *GraphExecutioner::importFromFlatPointer(Nd4jPointer ptr) {
             auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(ptr));
             auto restoredGraph = new Graph(fg);
@@ -68,9 +68,13 @@ bool experimentalSupport = false;
 #include <TAD.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/Context.h>
+#include <graph/ContextPool.h>
+#include <graph/ExecutionQueue.h>
 #include <graph/ResultWrapper.h>
 #include <helpers/DebugHelper.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/OpTracer.h>
+#include <helpers/HnswIndex.h>
 
 using namespace nd4j;
 
@@ -98,6 +102,7 @@ void NativeOps::execIndexReduceScalar(Nd4jPointer *extraPointers,
                                                 void *extraParams,
                                                 void *hZ, Nd4jLong *hZShapeInfo,
                                                 void *dZ, Nd4jLong *dZShapeInfo) {
+    ND4J_TRACE_OP("execIndexReduceScalar", opNum, hXShapeInfo, nullptr);
 
     NativeOpExcutioner::execIndexReduceScalar(opNum, hX, hXShapeInfo, extraParams, hZ, hZShapeInfo);
 }
@@ -121,6 +126,7 @@ void  NativeOps::execIndexReduce(Nd4jPointer *extraPointers,int opNum,
                                         void *dZ, Nd4jLong *dZShapeInfo,
                                         void *hDimension, Nd4jLong *hDimensionShape,
                                         void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execIndexReduce", opNum, hXShapeInfo, nullptr);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -167,6 +173,7 @@ void NativeOps::execBroadcast(Nd4jPointer *extraPointers,
                                       void *dZ, Nd4jLong *dZShapeInfo,
                                       void *hDimension, Nd4jLong *hDimensionShape,
                                       void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execBroadcast", opNum, hXShapeInfo, hYShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -199,6 +206,7 @@ void NativeOps::execBroadcastBool(Nd4jPointer *extraPointers,
                               void *dZ, Nd4jLong *dZShapeInfo,
                                   void *hDimension, Nd4jLong *hDimensionShape,
                                   void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execBroadcastBool", opNum, hXShapeInfo, hYShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -243,6 +251,7 @@ void NativeOps::execPairwiseTransform(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execPairwiseTransform", opNum, hXShapeInfo, hYShapeInfo);
     NativeOpExcutioner::execPairwiseTransform(
             opNum,
             hX,
@@ -264,6 +273,7 @@ void NativeOps::execPairwiseTransformBool(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execPairwiseTransformBool", opNum, hXShapeInfo, hYShapeInfo);
     NativeOpExcutioner::execPairwiseBoolTransform(
             opNum,
             hX,
@@ -292,6 +302,7 @@ void NativeOps::execReduceFloat(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    ND4J_TRACE_OP("execReduceFloat", opNum, hXShapeInfo, nullptr);
 
     NativeOpExcutioner::execReduceFloatScalar(
             opNum,
@@ -311,6 +322,7 @@ void NativeOps::execReduceSame(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    ND4J_TRACE_OP("execReduceSame", opNum, hXShapeInfo, nullptr);
 
     NativeOpExcutioner::execReduceSameScalar(
             opNum,
@@ -330,6 +342,7 @@ void NativeOps::execReduceBool(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    ND4J_TRACE_OP("execReduceBool", opNum, hXShapeInfo, nullptr);
 
     NativeOpExcutioner::execReduceBoolScalar(
             opNum,
@@ -349,6 +362,7 @@ void NativeOps::execReduceLong(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    ND4J_TRACE_OP("execReduceLong", opNum, hXShapeInfo, nullptr);
 
     NativeOpExcutioner::execReduceLongScalar(
             opNum,
@@ -378,6 +392,7 @@ void NativeOps::execReduceFloat(Nd4jPointer *extraPointers,
                                    void *dZ, Nd4jLong *dZShapeInfo,
                                 void *hDimension, Nd4jLong *hDimensionShape,
                                 void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execReduceFloat", opNum, hXShapeInfo, nullptr);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -407,6 +422,7 @@ void NativeOps::execReduceBool(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execReduceBool", opNum, hXShapeInfo, nullptr);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -436,6 +452,7 @@ void NativeOps::execReduceSame(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execReduceSame", opNum, hXShapeInfo, nullptr);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -465,6 +482,7 @@ void NativeOps::execReduceLong(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    ND4J_TRACE_OP("execReduceLong", opNum, hXShapeInfo, nullptr);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -507,6 +525,7 @@ void NativeOps::execReduce3(Nd4jPointer *extraPointers,
                                     void *dZ, Nd4jLong *dZShapeInfo,
                                     Nd4jLong *tadOnlyShapeInfo, Nd4jLong *tadOffsets,
                                     Nd4jLong *yTadOnlyShapeInfo, Nd4jLong *yTadOffsets) {
+    ND4J_TRACE_OP("execReduce3", opNum, hXShapeInfo, hYShapeInfo);
 
     NativeOpExcutioner::execReduce3(opNum, hX, hXShapeInfo, extraParams, hY, hYShapeInfo, hZ, hZShapeInfo);
 }
@@ -528,6 +547,7 @@ void NativeOps::execReduce3Scalar(Nd4jPointer *extraPointers,int opNum,
                                             void *dY, Nd4jLong *dYShapeInfo,
                                             void *hZ, Nd4jLong *hZShapeInfo,
                                             void *dZ, Nd4jLong *dZShapeInfo) {
+    ND4J_TRACE_OP("execReduce3Scalar", opNum, hXShapeInfo, hYShapeInfo);
 
     NativeOpExcutioner::execReduce3Scalar(opNum,hX,hXShapeInfo,extraParams,hY,hYShapeInfo, hZ, hZShapeInfo);
 }
@@ -557,6 +577,7 @@ void NativeOps::execReduce3(Nd4jPointer *extraPointers,
                                     void *dDimension, Nd4jLong *dDimensionShape,
                                     Nd4jLong *tadOnlyShapeInfo, Nd4jLong *tadOffsets,
                                     Nd4jLong *yTadOnlyShapeInfo, Nd4jLong *yTadOffsets) {
+    ND4J_TRACE_OP("execReduce3", opNum, hXShapeInfo, hYShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -595,6 +616,7 @@ void NativeOps::execScalar(
         void *hScalar, Nd4jLong *hScalarShapeInfo,
         void *dScalar, Nd4jLong *dScalarShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execScalar", opNum, hXShapeInfo, nullptr);
     NativeOpExcutioner::execScalar(
             opNum,
             hX,
@@ -616,6 +638,7 @@ void NativeOps::execScalarBool(
         void *hScalar, Nd4jLong *hScalarShapeInfo,
         void *dScalar, Nd4jLong *dScalarShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execScalarBool", opNum, hXShapeInfo, nullptr);
     NativeOpExcutioner::execScalarBool(
             opNum,
             hX,
@@ -642,6 +665,7 @@ void NativeOps::execSummaryStatsScalar(Nd4jPointer *extraPointers,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         bool biasCorrected) {
+    ND4J_TRACE_OP("execSummaryStatsScalar", opNum, hXShapeInfo, nullptr);
     NativeOpExcutioner::execSummaryStatsScalar(
             opNum,
             hX,
@@ -668,6 +692,7 @@ void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                          void *hZ, Nd4jLong *hZShapeInfo,
                                          void *dZ, Nd4jLong *dZShapeInfo,
                                          bool biasCorrected) {
+    ND4J_TRACE_OP("execSummaryStats", opNum, hXShapeInfo, nullptr);
     NativeOpExcutioner::execSummaryStats(
             opNum,
             hX,
@@ -699,6 +724,7 @@ void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                          void *dDimension, Nd4jLong *dDimensionShape,
                                          bool biasCorrected,
                                          Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets) {
+    ND4J_TRACE_OP("execSummaryStats", opNum, hXShapeInfo, nullptr);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -733,6 +759,7 @@ void NativeOps::execTransformFloat(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execTransformFloat", opNum, hXShapeInfo, nullptr);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -755,6 +782,7 @@ void NativeOps::execTransformSame(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execTransformSame", opNum, hXShapeInfo, nullptr);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -777,6 +805,7 @@ void NativeOps::execTransformBool(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execTransformBool", opNum, hXShapeInfo, nullptr);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -799,6 +828,7 @@ void NativeOps::execTransformAny(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execTransformAny", opNum, hXShapeInfo, nullptr);
 
     NativeOpExcutioner::execTransformAny(
             opNum,
@@ -819,6 +849,7 @@ void NativeOps::execTransformStrict(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    ND4J_TRACE_OP("execTransformStrict", opNum, hXShapeInfo, nullptr);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -848,6 +879,7 @@ void NativeOps::execReduce3All(Nd4jPointer *extraPointers,
                                      Nd4jLong *xOffsets,
                                      Nd4jLong *yTadShapeInfo,
                                      Nd4jLong *yOffsets) {
+    ND4J_TRACE_OP("execReduce3All", opNum, hXShapeInfo, hYShapeInfo);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1064,6 +1096,10 @@ void NativeOps::initializeFunctions(Nd4jPointer *functions) {
     nd4j::BlasHelper::getInstance()->initializeFunctions(functions);
 }
 
+void NativeOps::initializeFunctions(Nd4jPointer *functions, int numFunctions) {
+    nd4j::BlasHelper::getInstance()->initializeFunctions(functions, numFunctions);
+}
+
 /**
        * This method acquires memory chunk of requested size on host side
        *
@@ -1215,6 +1251,22 @@ void NativeOps::enableVerboseMode(bool reallyEnable) {
     nd4j::Environment::getInstance()->setVerbose(reallyEnable);
 }
 
+void NativeOps::enableOpTracing(bool reallyEnable) {
+    nd4j::OpTracer::getInstance()->setEnabled(reallyEnable);
+}
+
+bool NativeOps::isOpTracingEnabled() {
+    return nd4j::OpTracer::getInstance()->isEnabled();
+}
+
+void NativeOps::resetOpTrace() {
+    nd4j::OpTracer::getInstance()->reset();
+}
+
+void NativeOps::dumpOpTrace(const char *fileName) {
+    nd4j::OpTracer::getInstance()->writeChromeTrace(fileName);
+}
+
 void NativeOps::setGridLimit(int gridSize) {
     // no-op
 }
@@ -1548,6 +1600,7 @@ void NativeOps::execScalar(Nd4jPointer *extraPointers,
                                  void *dDimension, Nd4jLong *dDimensionShape,
                                  Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets,
                                  Nd4jLong *tadShapeInfoZ, Nd4jLong *tadOffsetsZ) {
+    ND4J_TRACE_OP("execScalar", opNum, hXShapeInfo, nullptr);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1582,6 +1635,7 @@ void NativeOps::execScalarBool(Nd4jPointer *extraPointers,
                            void *dDimension, Nd4jLong *dDimensionShape,
                            Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets,
                            Nd4jLong *tadShapeInfoZ, Nd4jLong *tadOffsetsZ) {
+    ND4J_TRACE_OP("execScalarBool", opNum, hXShapeInfo, nullptr);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1633,6 +1687,7 @@ void NativeOps::execAggregate(Nd4jPointer *extraPointers,int opNum,
                                     void *realArguments,
                                     int numRealArguments,
                                     nd4j::DataType dtype) {
+    ND4J_TRACE_OP("execAggregate", opNum, nullptr, nullptr);
 
     BUILD_SINGLE_SELECTOR(dtype, NativeOpExcutioner::execAggregate, (opNum, arguments, numArguments, shapeArguments, numShapeArguments, indexArguments, numIndexArguments, intArrays, numIntArrays, realArguments, numRealArguments), FLOAT_TYPES);
 
@@ -1706,6 +1761,7 @@ void NativeOps::execAggregateBatch(Nd4jPointer *extraPointers,
                                          int maxReals,
                                          void *ptrToArguments,
                                          nd4j::DataType dtype) {
+    ND4J_TRACE_OP("execAggregateBatch", opNum, nullptr, nullptr);
     BUILD_SINGLE_SELECTOR(dtype, _batchExecutor, (extraPointers, numAggregates, opNum, maxArgs, maxShapes, maxIntArrays, maxIntArraySize, maxIdx, maxReals, ptrToArguments, dtype), FLOAT_TYPES);
 }
 
@@ -1716,6 +1772,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    ND4J_TRACE_OP("execRandom", opNum, hZShapeInfo, nullptr);
     NativeOpExcutioner::execRandom(opNum, state, hZ, hZShapeInfo, extraArguments);
 }
 
@@ -1729,6 +1786,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    ND4J_TRACE_OP("execRandom", opNum, hXShapeInfo, hYShapeInfo);
     NativeOpExcutioner::execRandom(opNum, state, hX, hXShapeInfo, hY, hYShapeInfo, hZ, hZShapeInfo, extraArguments);
 }
 
@@ -1740,6 +1798,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    ND4J_TRACE_OP("execRandom", opNum, hXShapeInfo, nullptr);
     NativeOpExcutioner::execRandom(opNum, state, hX, hXShapeInfo, hZ, hZShapeInfo, extraArguments);
 }
 
@@ -2115,6 +2174,58 @@ int NativeOps::execCustomOp(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPoint
     return realExec(op, extraPointers, hash, inputBuffers, inputShapes, numInputs, outputBuffers, outputShapes, numOutputs, tArgs, numTArgs, iArgs, numIArgs, bArgs, numBArgs, isInplace);
 }
 
+Nd4jPointer NativeOps::getCustomOpHandle(Nd4jLong hash) {
+    return reinterpret_cast<Nd4jPointer>(nd4j::ops::OpRegistrator::getInstance()->getOperation(hash));
+}
+
+int NativeOps::execCustomOpByHandle(Nd4jPointer* extraPointers, Nd4jPointer opHandle, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace) {
+    auto op = reinterpret_cast<nd4j::ops::DeclarableOp*>(opHandle);
+    if (op == nullptr)
+        return ND4J_STATUS_BAD_INPUT;
+
+    return realExec(op, extraPointers, op->getOpHash(), inputBuffers, inputShapes, numInputs, outputBuffers, outputShapes, numOutputs, tArgs, numTArgs, iArgs, numIArgs, bArgs, numBArgs, isInplace);
+}
+
+int NativeOps::execCustomOpByHandle(Nd4jPointer* extraPointers, Nd4jPointer opHandle, Nd4jPointer opContext) {
+    auto op = reinterpret_cast<nd4j::ops::DeclarableOp*>(opHandle);
+    if (op == nullptr)
+        return ND4J_STATUS_BAD_INPUT;
+
+    return op->execute(reinterpret_cast<Context*>(opContext));
+}
+
+Nd4jPointer NativeOps::createOpContext() {
+    return reinterpret_cast<Nd4jPointer>(nd4j::graph::ContextPool::acquire());
+}
+
+void NativeOps::setOpContextInput(Nd4jPointer opContext, int index, Nd4jPointer buffer, Nd4jPointer shapeInfo, Nd4jPointer specialBuffer, Nd4jPointer specialShapeInfo) {
+    reinterpret_cast<Context*>(opContext)->setInputArray(index, buffer, shapeInfo, specialBuffer, specialShapeInfo);
+}
+
+void NativeOps::setOpContextOutput(Nd4jPointer opContext, int index, Nd4jPointer buffer, Nd4jPointer shapeInfo, Nd4jPointer specialBuffer, Nd4jPointer specialShapeInfo) {
+    reinterpret_cast<Context*>(opContext)->setOutputArray(index, buffer, shapeInfo, specialBuffer, specialShapeInfo);
+}
+
+void NativeOps::setOpContextTArguments(Nd4jPointer opContext, double *arguments, int numberOfArguments) {
+    reinterpret_cast<Context*>(opContext)->setTArguments(arguments, numberOfArguments);
+}
+
+void NativeOps::setOpContextIArguments(Nd4jPointer opContext, Nd4jLong *arguments, int numberOfArguments) {
+    reinterpret_cast<Context*>(opContext)->setIArguments(arguments, numberOfArguments);
+}
+
+void NativeOps::setOpContextBArguments(Nd4jPointer opContext, bool *arguments, int numberOfArguments) {
+    reinterpret_cast<Context*>(opContext)->setBArguments(arguments, numberOfArguments);
+}
+
+void NativeOps::resetOpContext(Nd4jPointer opContext) {
+    reinterpret_cast<Context*>(opContext)->clearFastPath();
+}
+
+void NativeOps::deleteOpContext(Nd4jPointer opContext) {
+    nd4j::graph::ContextPool::release(reinterpret_cast<Context*>(opContext));
+}
+
 int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer) {
     auto graph = nd4j::graph::GraphExecutioner::importFromFlatPointer(flatBufferPointer);
 
@@ -2123,6 +2234,14 @@ int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jP
     return ND4J_STATUS_OK;
 }
 
+int NativeOps::registerMappedGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, const char *fileName) {
+    auto graph = nd4j::graph::GraphExecutioner::importFromMappedFlatBuffers(fileName);
+
+    nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    return ND4J_STATUS_OK;
+}
+
 static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
     auto graph = nd4j::graph::GraphHolder::getInstance()->cloneGraph(graphId);
     auto varSpace = graph->getVariableSpace();
@@ -2173,6 +2292,69 @@ nd4j::graph::VariablesSet* NativeOps::executeStoredGraph(Nd4jPointer *extraPoint
     return nullptr;
 }
 
+static std::shared_ptr<nd4j::graph::ExecutionTicket>& ticketOf(Nd4jPointer ticket) {
+    return *reinterpret_cast<std::shared_ptr<nd4j::graph::ExecutionTicket>*>(ticket);
+}
+
+static Nd4jPointer submitAsync(Nd4jLong streamId, nd4j::graph::ExecutionQueue::Task task, Nd4jPointer* dependencies, int numDependencies) {
+    std::vector<std::shared_ptr<nd4j::graph::ExecutionTicket>> deps;
+    for (int e = 0; e < numDependencies; e++)
+        deps.emplace_back(ticketOf(dependencies[e]));
+
+    auto ticket = nd4j::graph::ExecutionQueue::getInstance()->submit(streamId, task, deps);
+    return reinterpret_cast<Nd4jPointer>(new std::shared_ptr<nd4j::graph::ExecutionTicket>(ticket));
+}
+
+Nd4jPointer NativeOps::execCustomOpAsync(Nd4jPointer* extraPointers, Nd4jLong streamId, Nd4jLong hash, Nd4jPointer opContext, Nd4jPointer* dependencies, int numDependencies) {
+    auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation(hash);
+    auto context = reinterpret_cast<Context*>(opContext);
+
+    return submitAsync(streamId, [op, hash, context] (nd4j::graph::VariablesSet* &variables) -> Nd4jStatus {
+        if (op == nullptr) {
+            nd4j_printf("Can't find requested operation: [%lld]\n", hash);
+            return ND4J_STATUS_BAD_INPUT;
+        }
+
+        return op->execute(context);
+    }, dependencies, numDependencies);
+}
+
+Nd4jPointer NativeOps::executeStoredGraphAsync(Nd4jPointer *extraPointers, Nd4jLong streamId, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer* dependencies, int numDependencies) {
+    // caller may release pointer arrays right after submission
+    std::vector<Nd4jPointer> buffers(inputBuffers, inputBuffers + numInputs);
+    std::vector<Nd4jPointer> shapes(inputShapes, inputShapes + numInputs);
+    std::vector<int> indices(inputIndices, inputIndices + numInputs);
+
+    return submitAsync(streamId, [graphId, buffers, shapes, indices, numInputs] (nd4j::graph::VariablesSet* &variables) mutable -> Nd4jStatus {
+        variables = executeStoredGraphT(nullptr, graphId, buffers.data(), shapes.data(), indices.data(), numInputs);
+        return variables->status();
+    }, dependencies, numDependencies);
+}
+
+bool NativeOps::isTicketDone(Nd4jPointer ticket) {
+    return ticketOf(ticket)->isDone();
+}
+
+int NativeOps::waitForTicket(Nd4jPointer ticket) {
+    return ticketOf(ticket)->wait();
+}
+
+nd4j::graph::VariablesSet* NativeOps::getTicketVariables(Nd4jPointer ticket) {
+    return ticketOf(ticket)->takeVariables();
+}
+
+void NativeOps::deleteTicket(Nd4jPointer ticket) {
+    delete reinterpret_cast<std::shared_ptr<nd4j::graph::ExecutionTicket>*>(ticket);
+}
+
+void NativeOps::syncExecutionStream(Nd4jLong streamId) {
+    nd4j::graph::ExecutionQueue::getInstance()->synchronize(streamId);
+}
+
+void NativeOps::destroyExecutionStream(Nd4jLong streamId) {
+    nd4j::graph::ExecutionQueue::getInstance()->destroyStream(streamId);
+}
+
 int NativeOps::unregisterGraph(Nd4jPointer *extraPointers, Nd4jLong graphId) {
 
     nd4j::graph::GraphHolder::getInstance()->dropGraphAny(graphId);
@@ -2560,6 +2742,64 @@ void NativeOps::inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4
     nd4j::DebugHelper::retrieveDebugStatistics(p, &array);
 }
 
+////////////////////////////////////////////////////////////////////////
+// exceptions can't cross JNI boundary, so HNSW entry points report failures via status codes or nullptr
+Nd4jPointer NativeOps::createHnswIndex(int dimensions, int metric, int M, int efConstruction, Nd4jLong capacity) {
+    try {
+        return reinterpret_cast<Nd4jPointer>(new nd4j::HnswIndex(dimensions, metric, M, efConstruction, capacity));
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return nullptr;
+    }
+}
+
+int NativeOps::addToHnswIndex(Nd4jPointer index, float *vectors, Nd4jLong numVectors) {
+    try {
+        reinterpret_cast<nd4j::HnswIndex*>(index)->add(vectors, numVectors);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return ND4J_STATUS_BAD_INPUT;
+    }
+}
+
+int NativeOps::searchHnswIndex(Nd4jPointer index, float *queries, Nd4jLong numQueries, int k, int ef, Nd4jLong *ids, float *distances) {
+    try {
+        reinterpret_cast<nd4j::HnswIndex*>(index)->search(queries, numQueries, k, ef, ids, distances);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return ND4J_STATUS_BAD_INPUT;
+    }
+}
+
+Nd4jLong NativeOps::hnswIndexSize(Nd4jPointer index) {
+    return reinterpret_cast<nd4j::HnswIndex*>(index)->size();
+}
+
+int NativeOps::saveHnswIndex(Nd4jPointer index, const char *fileName) {
+    try {
+        reinterpret_cast<nd4j::HnswIndex*>(index)->save(fileName);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return ND4J_STATUS_BAD_OUTPUT;
+    }
+}
+
+Nd4jPointer NativeOps::loadHnswIndex(const char *fileName) {
+    try {
+        return reinterpret_cast<Nd4jPointer>(nd4j::HnswIndex::load(fileName));
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return nullptr;
+    }
+}
+
+void NativeOps::deleteHnswIndex(Nd4jPointer index) {
+    delete reinterpret_cast<nd4j::HnswIndex*>(index);
+}
+
 BUILD_SINGLE_TEMPLATE(template void flattenGeneric,(Nd4jPointer*, int, char, void*, Nd4jLong*, void*, Nd4jLong*), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pullRowsGeneric, (void *, Nd4jLong*, void*, Nd4jLong*, const int, Nd4jLong*, Nd4jLong*, Nd4jLong*, Nd4jLong*, Nd4jLong*), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void tearGeneric, (void *, Nd4jLong*, Nd4jPointer*, Nd4jLong*, Nd4jLong*, Nd4jLong*), LIBND4J_TYPES);
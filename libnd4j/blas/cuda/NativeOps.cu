@@ -78,6 +78,8 @@
 #include <NDArray.h>
 #include <GraphExecutioner.h>
 #include <graph/GraphHolder.h>
+#include <graph/ContextPool.h>
+#include <graph/ExecutionQueue.h>
 #include <graph/VariablesSet.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <ops/declarable/CustomOperations.h>
@@ -89,6 +91,8 @@
 #include <curand.h>
 #include <Status.h>
 #include <helpers/DebugHelper.h>
+#include <helpers/OpTracer.h>
+#include <helpers/HnswIndex.h>
 
 using namespace nd4j;
 
@@ -1646,6 +1650,11 @@ void NativeOps::initializeFunctions(Nd4jPointer *functions) {
 	*/
 }
 
+void NativeOps::initializeFunctions(Nd4jPointer *functions, int numFunctions) {
+    // device functions table has fixed layout
+    initializeFunctions(functions);
+}
+
 
 /**
  * This method acquires memory chunk of requested size on host side
@@ -1911,6 +1920,22 @@ void NativeOps::enableDebugMode(bool reallyEnable) {
 	nd4j::Environment::getInstance()->setDebug(reallyEnable);
 }
 
+void NativeOps::enableOpTracing(bool reallyEnable) {
+	nd4j::OpTracer::getInstance()->setEnabled(reallyEnable);
+}
+
+bool NativeOps::isOpTracingEnabled() {
+	return nd4j::OpTracer::getInstance()->isEnabled();
+}
+
+void NativeOps::resetOpTrace() {
+	nd4j::OpTracer::getInstance()->reset();
+}
+
+void NativeOps::dumpOpTrace(const char *fileName) {
+	nd4j::OpTracer::getInstance()->writeChromeTrace(fileName);
+}
+
 void NativeOps::setGridLimit(int gridSize) {
 	if (gridSize > 8192)
 		gridSize = 8192;
@@ -3354,6 +3379,58 @@ int NativeOps::execCustomOp(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPoint
     return op->execute(context);
 }
 
+Nd4jPointer NativeOps::getCustomOpHandle(Nd4jLong hash) {
+    return reinterpret_cast<Nd4jPointer>(nd4j::ops::OpRegistrator::getInstance()->getOperation(hash));
+}
+
+int NativeOps::execCustomOpByHandle(Nd4jPointer* extraPointers, Nd4jPointer opHandle, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace) {
+    auto op = reinterpret_cast<nd4j::ops::DeclarableOp*>(opHandle);
+    if (op == nullptr)
+        return ND4J_STATUS_BAD_INPUT;
+
+    return realExec(op, extraPointers, op->getOpHash(), inputBuffers, inputShapes, numInputs, outputBuffers, outputShapes, numOutputs, tArgs, numTArgs, iArgs, numIArgs, bArgs, numBArgs, isInplace);
+}
+
+int NativeOps::execCustomOpByHandle(Nd4jPointer* extraPointers, Nd4jPointer opHandle, Nd4jPointer opContext) {
+    auto op = reinterpret_cast<nd4j::ops::DeclarableOp*>(opHandle);
+    if (op == nullptr)
+        return ND4J_STATUS_BAD_INPUT;
+
+    return op->execute(reinterpret_cast<Context*>(opContext));
+}
+
+Nd4jPointer NativeOps::createOpContext() {
+    return reinterpret_cast<Nd4jPointer>(nd4j::graph::ContextPool::acquire());
+}
+
+void NativeOps::setOpContextInput(Nd4jPointer opContext, int index, Nd4jPointer buffer, Nd4jPointer shapeInfo, Nd4jPointer specialBuffer, Nd4jPointer specialShapeInfo) {
+    reinterpret_cast<Context*>(opContext)->setInputArray(index, buffer, shapeInfo, specialBuffer, specialShapeInfo);
+}
+
+void NativeOps::setOpContextOutput(Nd4jPointer opContext, int index, Nd4jPointer buffer, Nd4jPointer shapeInfo, Nd4jPointer specialBuffer, Nd4jPointer specialShapeInfo) {
+    reinterpret_cast<Context*>(opContext)->setOutputArray(index, buffer, shapeInfo, specialBuffer, specialShapeInfo);
+}
+
+void NativeOps::setOpContextTArguments(Nd4jPointer opContext, double *arguments, int numberOfArguments) {
+    reinterpret_cast<Context*>(opContext)->setTArguments(arguments, numberOfArguments);
+}
+
+void NativeOps::setOpContextIArguments(Nd4jPointer opContext, Nd4jLong *arguments, int numberOfArguments) {
+    reinterpret_cast<Context*>(opContext)->setIArguments(arguments, numberOfArguments);
+}
+
+void NativeOps::setOpContextBArguments(Nd4jPointer opContext, bool *arguments, int numberOfArguments) {
+    reinterpret_cast<Context*>(opContext)->setBArguments(arguments, numberOfArguments);
+}
+
+void NativeOps::resetOpContext(Nd4jPointer opContext) {
+    reinterpret_cast<Context*>(opContext)->clearFastPath();
+}
+
+void NativeOps::deleteOpContext(Nd4jPointer opContext) {
+    nd4j::graph::ContextPool::release(reinterpret_cast<Context*>(opContext));
+}
+
 int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer) {
 	
 	auto graph = nd4j::graph::GraphExecutioner::importFromFlatPointer(flatBufferPointer);
@@ -3363,6 +3440,14 @@ int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jP
 	return ND4J_STATUS_OK;
 }
 
+int NativeOps::registerMappedGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, const char *fileName) {
+	auto graph = nd4j::graph::GraphExecutioner::importFromMappedFlatBuffers(fileName);
+
+	nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+	return ND4J_STATUS_OK;
+}
+
 
 static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
 	auto graph = nd4j::graph::GraphHolder::getInstance()->pullGraph(graphId);
@@ -3414,6 +3499,69 @@ VariablesSet* NativeOps::executeStoredGraph(Nd4jPointer *extraPointers, Nd4jLong
 	return executeStoredGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
 }
 
+static std::shared_ptr<nd4j::graph::ExecutionTicket>& ticketOf(Nd4jPointer ticket) {
+    return *reinterpret_cast<std::shared_ptr<nd4j::graph::ExecutionTicket>*>(ticket);
+}
+
+static Nd4jPointer submitAsync(Nd4jLong streamId, nd4j::graph::ExecutionQueue::Task task, Nd4jPointer* dependencies, int numDependencies) {
+    std::vector<std::shared_ptr<nd4j::graph::ExecutionTicket>> deps;
+    for (int e = 0; e < numDependencies; e++)
+        deps.emplace_back(ticketOf(dependencies[e]));
+
+    auto ticket = nd4j::graph::ExecutionQueue::getInstance()->submit(streamId, task, deps);
+    return reinterpret_cast<Nd4jPointer>(new std::shared_ptr<nd4j::graph::ExecutionTicket>(ticket));
+}
+
+Nd4jPointer NativeOps::execCustomOpAsync(Nd4jPointer* extraPointers, Nd4jLong streamId, Nd4jLong hash, Nd4jPointer opContext, Nd4jPointer* dependencies, int numDependencies) {
+    auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation(hash);
+    auto context = reinterpret_cast<Context*>(opContext);
+
+    return submitAsync(streamId, [op, hash, context] (nd4j::graph::VariablesSet* &variables) -> Nd4jStatus {
+        if (op == nullptr) {
+            nd4j_printf("Can't find requested operation: [%lld]\n", hash);
+            return ND4J_STATUS_BAD_INPUT;
+        }
+
+        return op->execute(context);
+    }, dependencies, numDependencies);
+}
+
+Nd4jPointer NativeOps::executeStoredGraphAsync(Nd4jPointer *extraPointers, Nd4jLong streamId, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs, Nd4jPointer* dependencies, int numDependencies) {
+    // caller may release pointer arrays right after submission
+    std::vector<Nd4jPointer> buffers(inputBuffers, inputBuffers + numInputs);
+    std::vector<Nd4jPointer> shapes(inputShapes, inputShapes + numInputs);
+    std::vector<int> indices(inputIndices, inputIndices + numInputs);
+
+    return submitAsync(streamId, [graphId, buffers, shapes, indices, numInputs] (nd4j::graph::VariablesSet* &variables) mutable -> Nd4jStatus {
+        variables = executeStoredGraphT(nullptr, graphId, buffers.data(), shapes.data(), indices.data(), numInputs);
+        return variables->status();
+    }, dependencies, numDependencies);
+}
+
+bool NativeOps::isTicketDone(Nd4jPointer ticket) {
+    return ticketOf(ticket)->isDone();
+}
+
+int NativeOps::waitForTicket(Nd4jPointer ticket) {
+    return ticketOf(ticket)->wait();
+}
+
+nd4j::graph::VariablesSet* NativeOps::getTicketVariables(Nd4jPointer ticket) {
+    return ticketOf(ticket)->takeVariables();
+}
+
+void NativeOps::deleteTicket(Nd4jPointer ticket) {
+    delete reinterpret_cast<std::shared_ptr<nd4j::graph::ExecutionTicket>*>(ticket);
+}
+
+void NativeOps::syncExecutionStream(Nd4jLong streamId) {
+    nd4j::graph::ExecutionQueue::getInstance()->synchronize(streamId);
+}
+
+void NativeOps::destroyExecutionStream(Nd4jLong streamId) {
+    nd4j::graph::ExecutionQueue::getInstance()->destroyStream(streamId);
+}
+
 int NativeOps::unregisterGraph(Nd4jPointer *extraPointers, Nd4jLong graphId) {
 
 	nd4j::graph::GraphHolder::getInstance()->dropGraphAny(graphId);
@@ -3833,3 +3981,61 @@ void NativeOps::inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4
     nd4j::DebugHelper::retrieveDebugStatistics(p, &array);
 }
 
+////////////////////////////////////////////////////////////////////////
+// exceptions can't cross JNI boundary, so HNSW entry points report failures via status codes or nullptr
+Nd4jPointer NativeOps::createHnswIndex(int dimensions, int metric, int M, int efConstruction, Nd4jLong capacity) {
+    try {
+        return reinterpret_cast<Nd4jPointer>(new nd4j::HnswIndex(dimensions, metric, M, efConstruction, capacity));
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return nullptr;
+    }
+}
+
+int NativeOps::addToHnswIndex(Nd4jPointer index, float *vectors, Nd4jLong numVectors) {
+    try {
+        reinterpret_cast<nd4j::HnswIndex*>(index)->add(vectors, numVectors);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return ND4J_STATUS_BAD_INPUT;
+    }
+}
+
+int NativeOps::searchHnswIndex(Nd4jPointer index, float *queries, Nd4jLong numQueries, int k, int ef, Nd4jLong *ids, float *distances) {
+    try {
+        reinterpret_cast<nd4j::HnswIndex*>(index)->search(queries, numQueries, k, ef, ids, distances);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return ND4J_STATUS_BAD_INPUT;
+    }
+}
+
+Nd4jLong NativeOps::hnswIndexSize(Nd4jPointer index) {
+    return reinterpret_cast<nd4j::HnswIndex*>(index)->size();
+}
+
+int NativeOps::saveHnswIndex(Nd4jPointer index, const char *fileName) {
+    try {
+        reinterpret_cast<nd4j::HnswIndex*>(index)->save(fileName);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return ND4J_STATUS_BAD_OUTPUT;
+    }
+}
+
+Nd4jPointer NativeOps::loadHnswIndex(const char *fileName) {
+    try {
+        return reinterpret_cast<Nd4jPointer>(nd4j::HnswIndex::load(fileName));
+    } catch (std::exception &e) {
+        nd4j_printf("%s\n", e.what());
+        return nullptr;
+    }
+}
+
+void NativeOps::deleteHnswIndex(Nd4jPointer index) {
+    delete reinterpret_cast<nd4j::HnswIndex*>(index);
+}
+
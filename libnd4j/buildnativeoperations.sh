@@ -52,6 +52,7 @@ OPERATIONS=
 CLEAN="false"
 MINIFIER="false"
 TESTS="false"
+PERFTESTS="false"
 VERBOSE="false"
 NAME=
 while [[ $# > 0 ]]
@@ -121,6 +122,9 @@ case $key in
     -t|--tests)
     TESTS="true"
     ;;
+    -p|--perftests)
+    PERFTESTS="true"
+    ;;
     -V|--verbose)
     VERBOSE="true"
     ;;
@@ -422,6 +426,7 @@ fi
 EXPERIMENTAL_ARG="no";
 MINIFIER_ARG="-DLIBND4J_BUILD_MINIFIER=false"
 TESTS_ARG="-DBUILD_TESTS=OFF"
+PERFTESTS_ARG="-DLIBND4J_BUILD_PERFTESTS=false"
 NAME_ARG="-DLIBND4J_NAME=$NAME"
 
 if [ "$EXPERIMENTAL" == "yes" ]; then
@@ -437,6 +442,10 @@ if [ "$TESTS" == "true" ]; then
     TESTS_ARG="-DBUILD_TESTS=ON"
 fi
 
+if [ "$PERFTESTS" == "true" ]; then
+    PERFTESTS_ARG="-DLIBND4J_BUILD_PERFTESTS=true"
+fi
+
 ARCH_ARG="-DARCH=$ARCH -DEXTENSION=$CHIP_EXTENSION"
 
 CUDA_COMPUTE="-DCOMPUTE=$COMPUTE"
@@ -508,12 +517,13 @@ echo LIBRARY TYPE    = "${LIBTYPE}"
 echo OPERATIONS = "${OPERATIONS_ARG}"
 echo MINIFIER = "${MINIFIER_ARG}"
 echo TESTS = "${TESTS_ARG}"
+echo PERFTESTS = "${PERFTESTS_ARG}"
 echo NAME = "${NAME_ARG}"
 echo MKLDNN_PATH = "$MKLDNN_PATH"
 echo OPENBLAS_PATH = "$OPENBLAS_PATH"
 mkbuilddir
 pwd
-eval $CMAKE_COMMAND  "$BLAS_ARG" "$ARCH_ARG" "$NAME_ARG" "$SHARED_LIBS_ARG" "$MINIFIER_ARG" "$OPERATIONS_ARG" "$BUILD_TYPE" "$PACKAGING_ARG" "$EXPERIMENTAL_ARG" "$TESTS_ARG" "$CUDA_COMPUTE" -DMKLDNN_PATH="$MKLDNN_PATH" -DOPENBLAS_PATH="$OPENBLAS_PATH" -DDEV=FALSE -DCMAKE_NEED_RESPONSE=YES -DMKL_MULTI_THREADED=TRUE ../..
+eval $CMAKE_COMMAND  "$BLAS_ARG" "$ARCH_ARG" "$NAME_ARG" "$SHARED_LIBS_ARG" "$MINIFIER_ARG" "$OPERATIONS_ARG" "$BUILD_TYPE" "$PACKAGING_ARG" "$EXPERIMENTAL_ARG" "$TESTS_ARG" "$PERFTESTS_ARG" "$CUDA_COMPUTE" -DMKLDNN_PATH="$MKLDNN_PATH" -DOPENBLAS_PATH="$OPENBLAS_PATH" -DDEV=FALSE -DCMAKE_NEED_RESPONSE=YES -DMKL_MULTI_THREADED=TRUE ../..
 if [ "$PARALLEL" == "true" ]; then
     MAKE_ARGUMENTS="$MAKE_ARGUMENTS -j $MAKEJ"
 fi
@@ -21,6 +21,15 @@
 #include <pointercast.h>
 #include <stdexcept>
 #include"cnpy.h"
+#include "config.h"
+#include <NDArray.h>
+#include <helpers/BitwiseUtils.h>
+#include <array/DataTypeUtils.h>
+#include <helpers/logger.h>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 
 
@@ -628,4 +637,618 @@ std::vector<char> cnpy::createNpyHeader(const T *data,
 
 template ND4J_EXPORT std::vector<char> cnpy::createNpyHeader<void>(const void *data, const unsigned int *shape, const unsigned int ndims, unsigned int wordSize);
 
-template ND4J_EXPORT void cnpy::npy_save<float>(std::string fname, const float* data, const unsigned int* shape, const unsigned int ndims, std::string mode);
\ No newline at end of file
+template ND4J_EXPORT void cnpy::npy_save<float>(std::string fname, const float* data, const unsigned int* shape, const unsigned int ndims, std::string mode);
+
+/**
+ * Little-endian integer at given position, as used by zip format
+ */
+template <typename T>
+static T readLE(const char *data) {
+    T result = 0;
+    auto bytes = reinterpret_cast<const unsigned char *>(data);
+    for (int e = sizeof(T) - 1; e >= 0; e--)
+        result = (result << 8) | static_cast<T>(bytes[e]);
+
+    return result;
+}
+
+Nd4jLong cnpy::NpyHeader::length() const {
+    Nd4jLong length = 1;
+    for (auto v: shape)
+        length *= v;
+
+    return length;
+}
+
+Nd4jLong cnpy::NpyHeader::byteLength() const {
+    return length() * wordSize;
+}
+
+bool cnpy::NpyHeader::isNativeOrder() const {
+    return wordSize == 1 || littleEndian != nd4j::BitwiseUtils::isBE();
+}
+
+nd4j::DataType cnpy::NpyHeader::dataType() const {
+    switch (typeChar) {
+        case 'f':
+            if (wordSize == 2) return nd4j::DataType::HALF;
+            if (wordSize == 4) return nd4j::DataType::FLOAT32;
+            if (wordSize == 8) return nd4j::DataType::DOUBLE;
+            break;
+        case 'i':
+            if (wordSize == 1) return nd4j::DataType::INT8;
+            if (wordSize == 2) return nd4j::DataType::INT16;
+            if (wordSize == 4) return nd4j::DataType::INT32;
+            if (wordSize == 8) return nd4j::DataType::INT64;
+            break;
+        case 'u':
+            if (wordSize == 1) return nd4j::DataType::UINT8;
+            if (wordSize == 2) return nd4j::DataType::UINT16;
+            if (wordSize == 4) return nd4j::DataType::UINT32;
+            if (wordSize == 8) return nd4j::DataType::UINT64;
+            break;
+        case 'b':
+            if (wordSize == 1) return nd4j::DataType::BOOL;
+            break;
+        default:
+            break;
+    }
+
+    throw std::runtime_error(std::string("Unsupported npy data type: ") + typeChar + std::to_string(wordSize));
+}
+
+cnpy::NpyHeader cnpy::readNpyHeader(const char *data, Nd4jLong size) {
+    if (size < 10 || static_cast<unsigned char>(data[0]) != 0x93 || strncmp(data + 1, "NUMPY", 5) != 0)
+        throw std::runtime_error("readNpyHeader: npy magic string wasn't found");
+
+    auto major = static_cast<int>(data[6]);
+    Nd4jLong dictLength, dictStart;
+    if (major == 1) {
+        dictLength = readLE<unsigned short>(data + 8);
+        dictStart = 10;
+    } else if (major == 2 || major == 3) {
+        if (size < 12)
+            throw std::runtime_error("readNpyHeader: truncated header");
+
+        dictLength = readLE<unsigned int>(data + 8);
+        dictStart = 12;
+    } else
+        throw std::runtime_error("readNpyHeader: unsupported npy format version " + std::to_string(major));
+
+    if (dictStart + dictLength > size)
+        throw std::runtime_error("readNpyHeader: truncated header");
+
+    std::string dict(data + dictStart, dictLength);
+
+    NpyHeader header;
+    header.headerSize = dictStart + dictLength;
+
+    auto loc = dict.find("descr");
+    if (loc == std::string::npos)
+        throw std::runtime_error("readNpyHeader: descr wasn't found");
+
+    loc = dict.find('\'', loc + 6);
+    if (loc == std::string::npos || loc + 3 >= dict.size())
+        throw std::runtime_error("readNpyHeader: malformed descr");
+
+    auto order = dict[loc + 1];
+    header.littleEndian = order == '<' || order == '|' || (order == '=' && !nd4j::BitwiseUtils::isBE());
+    header.typeChar = dict[loc + 2];
+    header.wordSize = static_cast<unsigned int>(atoi(dict.c_str() + loc + 3));
+
+    loc = dict.find("fortran_order");
+    if (loc == std::string::npos)
+        throw std::runtime_error("readNpyHeader: fortran_order wasn't found");
+
+    header.fortranOrder = dict.find("True", loc) == dict.find_first_not_of(" :'\"", loc + 13);
+
+    loc = dict.find("shape");
+    auto start = dict.find('(', loc);
+    auto end = dict.find(')', start);
+    if (loc == std::string::npos || start == std::string::npos || end == std::string::npos)
+        throw std::runtime_error("readNpyHeader: shape wasn't found");
+
+    // scalars have empty shape tuple
+    for (auto e = start + 1; e < end; ) {
+        auto next = dict.find(',', e);
+        if (next == std::string::npos || next > end)
+            next = end;
+
+        auto token = dict.substr(e, next - e);
+        if (token.find_first_of("0123456789") != std::string::npos)
+            header.shape.emplace_back(std::stoll(token));
+
+        e = next + 1;
+    }
+
+    return header;
+}
+
+std::string cnpy::writeNpyHeader(nd4j::DataType dataType, const std::vector<Nd4jLong> &shape, bool fortranOrder, size_t reserve) {
+    char typeChar;
+    switch (dataType) {
+        case nd4j::DataType::HALF:
+        case nd4j::DataType::FLOAT32:
+        case nd4j::DataType::DOUBLE:
+            typeChar = 'f';
+            break;
+        case nd4j::DataType::INT8:
+        case nd4j::DataType::INT16:
+        case nd4j::DataType::INT32:
+        case nd4j::DataType::INT64:
+            typeChar = 'i';
+            break;
+        case nd4j::DataType::UINT8:
+        case nd4j::DataType::UINT16:
+        case nd4j::DataType::UINT32:
+        case nd4j::DataType::UINT64:
+            typeChar = 'u';
+            break;
+        case nd4j::DataType::BOOL:
+            typeChar = 'b';
+            break;
+        default:
+            throw std::invalid_argument("writeNpyHeader: data type can't be represented in npy format");
+    }
+
+    auto wordSize = nd4j::DataTypeUtils::sizeOf(dataType);
+
+    std::string dict = "{'descr': '";
+    dict += wordSize == 1 ? '|' : BigEndianTest();
+    dict += typeChar;
+    dict += std::to_string(wordSize);
+    dict += "', 'fortran_order': ";
+    dict += fortranOrder ? "True" : "False";
+    dict += ", 'shape': (";
+    for (size_t e = 0; e < shape.size(); e++) {
+        if (e > 0)
+            dict += ", ";
+        dict += std::to_string(shape[e]);
+    }
+
+    if (shape.size() == 1)
+        dict += ",";
+    dict += "), }";
+
+    // 10 bytes of preamble, dict is padded with spaces and ends with \n, so that array data is 64-byte aligned
+    auto total = std::max<size_t>(10 + dict.size() + 1, reserve);
+    total = (total + 63) / 64 * 64;
+    if (total - 10 > 65535)
+        throw std::invalid_argument("writeNpyHeader: header is too long");
+
+    dict.append(total - 10 - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::string header;
+    header += (char) 0x93;
+    header += "NUMPY";
+    header += (char) 0x01;
+    header += (char) 0x00;
+    header += (char) ((total - 10) & 0xFF);
+    header += (char) (((total - 10) >> 8) & 0xFF);
+    header += dict;
+
+    return header;
+}
+
+nd4j::NDArray* cnpy::arrayFromNpy(const NpyHeader &header, const char *data) {
+    auto dtype = header.dataType();
+    auto order = header.fortranOrder ? 'f' : 'c';
+
+    if (header.isNativeOrder())
+        return new nd4j::NDArray(const_cast<char *>(data), order, header.shape, dtype);
+
+    auto result = new nd4j::NDArray(order, header.shape, dtype);
+    auto buffer = reinterpret_cast<char *>(result->getBuffer());
+    auto length = header.length();
+    auto wordSize = header.wordSize;
+
+    PRAGMA_OMP_PARALLEL_FOR
+    for (Nd4jLong e = 0; e < length; e++)
+        for (unsigned int b = 0; b < wordSize; b++)
+            buffer[e * wordSize + b] = data[e * wordSize + wordSize - b - 1];
+
+    return result;
+}
+
+cnpy::NpyMappedFile::NpyMappedFile(const char *fileName) : _file(fileName) {
+    auto data = reinterpret_cast<const char *>(_file.buffer());
+    _header = readNpyHeader(data, _file.length());
+
+    if (_header.headerSize + _header.byteLength() > _file.length())
+        throw std::runtime_error(std::string("NpyMappedFile: file is truncated: ") + fileName);
+}
+
+const cnpy::NpyHeader& cnpy::NpyMappedFile::header() const {
+    return _header;
+}
+
+void* cnpy::NpyMappedFile::data() {
+    return reinterpret_cast<char *>(_file.buffer()) + _header.headerSize;
+}
+
+nd4j::NDArray* cnpy::NpyMappedFile::asArray() {
+    return arrayFromNpy(_header, reinterpret_cast<char *>(data()));
+}
+
+cnpy::NpzArchive::NpzArchive(const char *fileName) : _file(fileName) {
+    parseCentralDirectory();
+}
+
+cnpy::NpzArchive::~NpzArchive() {
+    for (auto &v: _inflated)
+        delete[] v.second;
+
+    for (auto &v: _realigned)
+        delete[] v.second;
+}
+
+void cnpy::NpzArchive::parseCentralDirectory() {
+    auto data = reinterpret_cast<const char *>(_file.buffer());
+    auto length = _file.length();
+
+    // end of central directory record is at the very end, followed by optional comment
+    Nd4jLong eocd = -1;
+    for (Nd4jLong e = length - 22; e >= 0 && e >= length - 22 - 65535; e--) {
+        if (readLE<unsigned int>(data + e) == 0x06054b50) {
+            eocd = e;
+            break;
+        }
+    }
+
+    if (eocd < 0)
+        throw std::runtime_error("NpzArchive: end of central directory wasn't found");
+
+    Nd4jLong numRecords = readLE<unsigned short>(data + eocd + 10);
+    Nd4jLong directoryOffset = readLE<unsigned int>(data + eocd + 16);
+
+    // zip64 archives keep real values in separate record, referenced by locator right before eocd
+    if (eocd >= 20 && readLE<unsigned int>(data + eocd - 20) == 0x07064b50) {
+        auto eocd64 = static_cast<Nd4jLong>(readLE<uint64_t>(data + eocd - 20 + 8));
+        if (eocd64 + 56 > length || readLE<unsigned int>(data + eocd64) != 0x06064b50)
+            throw std::runtime_error("NpzArchive: malformed zip64 end of central directory");
+
+        numRecords = static_cast<Nd4jLong>(readLE<uint64_t>(data + eocd64 + 32));
+        directoryOffset = static_cast<Nd4jLong>(readLE<uint64_t>(data + eocd64 + 48));
+    }
+
+    auto cursor = directoryOffset;
+    for (Nd4jLong r = 0; r < numRecords; r++) {
+        if (cursor + 46 > length || readLE<unsigned int>(data + cursor) != 0x02014b50)
+            throw std::runtime_error("NpzArchive: malformed central directory");
+
+        NpzMember member;
+        member.compression = readLE<unsigned short>(data + cursor + 10);
+        member.compressedSize = readLE<unsigned int>(data + cursor + 20);
+        member.uncompressedSize = readLE<unsigned int>(data + cursor + 24);
+        member.localHeaderOffset = readLE<unsigned int>(data + cursor + 42);
+
+        auto nameLength = readLE<unsigned short>(data + cursor + 28);
+        auto extraLength = readLE<unsigned short>(data + cursor + 30);
+        auto commentLength = readLE<unsigned short>(data + cursor + 32);
+
+        member.name = std::string(data + cursor + 46, nameLength);
+        if (member.name.size() > 4 && member.name.compare(member.name.size() - 4, 4, ".npy") == 0)
+            member.name.erase(member.name.size() - 4);
+
+        // zip64 extended information: only fields saturated in the main record are present, in fixed order
+        auto extra = cursor + 46 + nameLength;
+        auto extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd) {
+            auto id = readLE<unsigned short>(data + extra);
+            auto size = readLE<unsigned short>(data + extra + 2);
+            if (id == 0x0001) {
+                auto field = extra + 4;
+                if (member.uncompressedSize == 0xFFFFFFFFL) {
+                    member.uncompressedSize = static_cast<Nd4jLong>(readLE<uint64_t>(data + field));
+                    field += 8;
+                }
+
+                if (member.compressedSize == 0xFFFFFFFFL) {
+                    member.compressedSize = static_cast<Nd4jLong>(readLE<uint64_t>(data + field));
+                    field += 8;
+                }
+
+                if (member.localHeaderOffset == 0xFFFFFFFFL)
+                    member.localHeaderOffset = static_cast<Nd4jLong>(readLE<uint64_t>(data + field));
+            }
+
+            extra += 4 + size;
+        }
+
+        if (member.compression != 0 && member.compression != 8)
+            throw std::runtime_error("NpzArchive: unsupported compression method for member " + member.name);
+
+        _index[member.name] = static_cast<int>(_members.size());
+        _members.emplace_back(member);
+
+        cursor += 46 + nameLength + extraLength + commentLength;
+    }
+}
+
+int cnpy::NpzArchive::size() {
+    return static_cast<int>(_members.size());
+}
+
+const std::vector<cnpy::NpzMember>& cnpy::NpzArchive::members() {
+    return _members;
+}
+
+bool cnpy::NpzArchive::contains(const std::string &name) {
+    return _index.count(name) > 0;
+}
+
+int cnpy::NpzArchive::indexOf(const std::string &name) {
+    auto it = _index.find(name);
+    if (it == _index.end())
+        throw std::invalid_argument("NpzArchive: member wasn't found: " + name);
+
+    return it->second;
+}
+
+const char* cnpy::NpzArchive::payload(int index) {
+    if (index < 0 || index >= size())
+        throw std::invalid_argument("NpzArchive: member index out of range");
+
+    auto data = reinterpret_cast<const char *>(_file.buffer());
+    auto &member = _members[index];
+
+    auto offset = member.localHeaderOffset;
+    if (offset + 30 > _file.length() || readLE<unsigned int>(data + offset) != 0x04034b50)
+        throw std::runtime_error("NpzArchive: malformed local header for member " + member.name);
+
+    // local extra field may differ from the one in central directory
+    offset += 30 + readLE<unsigned short>(data + offset + 26) + readLE<unsigned short>(data + offset + 28);
+    if (offset + member.compressedSize > _file.length())
+        throw std::runtime_error("NpzArchive: member is truncated: " + member.name);
+
+    return data + offset;
+}
+
+const char* cnpy::NpzArchive::memberData(int index) {
+    auto source = payload(index);
+    auto &member = _members[index];
+
+    if (member.compression == 0)
+        return source;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto it = _inflated.find(index);
+        if (it != _inflated.end())
+            return it->second;
+    }
+
+#ifdef HAVE_ZLIB
+    auto buffer = new char[member.uncompressedSize];
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(z_stream));
+
+    // zip stores raw deflate streams, without zlib header
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        delete[] buffer;
+        throw std::runtime_error("NpzArchive: inflateInit2 failed");
+    }
+
+    // avail_in/avail_out are 32-bit, so huge members are processed in chunks
+    const Nd4jLong chunk = 1L << 30;
+    Nd4jLong consumed = 0, produced = 0;
+    int status = Z_OK;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(source));
+    stream.next_out = reinterpret_cast<Bytef *>(buffer);
+    while (status == Z_OK) {
+        stream.avail_in = static_cast<uInt>(nd4j::math::nd4j_min<Nd4jLong>(chunk, member.compressedSize - consumed));
+        stream.avail_out = static_cast<uInt>(nd4j::math::nd4j_min<Nd4jLong>(chunk, member.uncompressedSize - produced));
+
+        auto availIn = stream.avail_in;
+        auto availOut = stream.avail_out;
+
+        status = inflate(&stream, Z_NO_FLUSH);
+
+        consumed += availIn - stream.avail_in;
+        produced += availOut - stream.avail_out;
+
+        if (status == Z_OK && availIn == stream.avail_in && availOut == stream.avail_out)
+            status = Z_BUF_ERROR;
+    }
+
+    inflateEnd(&stream);
+
+    if (status != Z_STREAM_END || produced != member.uncompressedSize) {
+        delete[] buffer;
+        throw std::runtime_error("NpzArchive: failed to inflate member " + member.name);
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // another thread could inflate the same member meanwhile
+    auto it = _inflated.find(index);
+    if (it != _inflated.end()) {
+        delete[] buffer;
+        return it->second;
+    }
+
+    _inflated[index] = buffer;
+    return buffer;
+#else
+    throw std::runtime_error("NpzArchive: member " + member.name + " is compressed, but libnd4j was built without zlib");
+#endif
+}
+
+const char* cnpy::NpzArchive::arrayData(int index, const NpyHeader &header) {
+    auto data = memberData(index) + header.headerSize;
+
+    // zip doesn't align member data, so stored member may start at any offset within archive
+    if (header.wordSize == 0 || reinterpret_cast<uintptr_t>(data) % header.wordSize == 0)
+        return data;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    auto it = _realigned.find(index);
+    if (it != _realigned.end())
+        return it->second;
+
+    // operator new[] returns memory aligned for any fundamental type
+    auto buffer = new char[header.byteLength()];
+    memcpy(buffer, data, header.byteLength());
+
+    _realigned[index] = buffer;
+    return buffer;
+}
+
+cnpy::NpyHeader cnpy::NpzArchive::header(int index) {
+    auto data = memberData(index);
+    auto header = readNpyHeader(data, _members[index].uncompressedSize);
+
+    if (header.headerSize + header.byteLength() > _members[index].uncompressedSize)
+        throw std::runtime_error("NpzArchive: member is truncated: " + _members[index].name);
+
+    return header;
+}
+
+cnpy::NpyArray cnpy::NpzArchive::npyArray(int index) {
+    auto h = header(index);
+
+    NpyArray result;
+    result.data = const_cast<char *>(arrayData(index, h));
+    result.wordSize = h.wordSize;
+    result.fortranOrder = h.fortranOrder;
+    for (auto v: h.shape)
+        result.shape.emplace_back(static_cast<unsigned int>(v));
+
+    return result;
+}
+
+nd4j::NDArray* cnpy::NpzArchive::array(int index) {
+    auto h = header(index);
+    return arrayFromNpy(h, arrayData(index, h));
+}
+
+nd4j::NDArray* cnpy::NpzArchive::array(const std::string &name) {
+    return array(indexOf(name));
+}
+
+std::map<std::string, nd4j::NDArray*> cnpy::NpzArchive::arrays() {
+    // members are independent deflate streams, so they're inflated in parallel
+    std::vector<int> compressed;
+    for (int e = 0; e < size(); e++)
+        if (_members[e].compression != 0)
+            compressed.emplace_back(e);
+
+    std::vector<std::string> errors(compressed.size());
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(dynamic, 1))
+    for (int e = 0; e < (int) compressed.size(); e++) {
+        try {
+            memberData(compressed[e]);
+        } catch (std::exception &ex) {
+            errors[e] = ex.what();
+        }
+    }
+
+    for (const auto &v: errors)
+        if (!v.empty())
+            throw std::runtime_error(v);
+
+    std::map<std::string, nd4j::NDArray*> result;
+    for (int e = 0; e < size(); e++)
+        result[_members[e].name] = array(e);
+
+    return result;
+}
+
+cnpy::NpyWriter::NpyWriter(const char *fileName, nd4j::DataType dataType, const std::vector<Nd4jLong> &shape, bool fortranOrder) {
+    _dataType = dataType;
+    _shape = shape;
+    _fortranOrder = fortranOrder;
+    _growing = !shape.empty() && shape[0] < 0;
+
+    if (_growing && fortranOrder)
+        throw std::invalid_argument("NpyWriter: unknown first dimension is supported for 'c' order only");
+
+    for (size_t e = _growing ? 1 : 0; e < shape.size(); e++)
+        if (shape[e] < 0)
+            throw std::invalid_argument("NpyWriter: only first dimension can be unknown");
+
+    // header for unknown number of rows reserves space for the longest possible value, so it can be rewritten in place
+    auto header = _growing ? writeNpyHeader(dataType, shape, fortranOrder, writeNpyHeader(dataType, shape, fortranOrder).size() + 20) : writeNpyHeader(dataType, shape, fortranOrder);
+    _headerSize = header.size();
+
+    _fp = fopen(fileName, "wb");
+    if (_fp == nullptr)
+        throw std::runtime_error(std::string("NpyWriter: unable to open file for writing: ") + fileName);
+
+    if (fwrite(header.data(), 1, header.size(), _fp) != header.size()) {
+        // destructor isn't invoked for partially constructed writer
+        fclose(_fp);
+        _fp = nullptr;
+        throw std::runtime_error("NpyWriter: failed to write header");
+    }
+}
+
+cnpy::NpyWriter::~NpyWriter() {
+    if (_fp == nullptr)
+        return;
+
+    try {
+        close();
+    } catch (std::exception &ex) {
+        nd4j_printf("NpyWriter: %s\n", ex.what());
+    }
+}
+
+void cnpy::NpyWriter::write(const void *data, Nd4jLong numBytes) {
+    if (_fp == nullptr)
+        throw std::runtime_error("NpyWriter: file is already closed");
+
+    if (numBytes <= 0)
+        return;
+
+    if (fwrite(data, 1, static_cast<size_t>(numBytes), _fp) != static_cast<size_t>(numBytes))
+        throw std::runtime_error("NpyWriter: failed to write data");
+
+    _written += numBytes;
+}
+
+void cnpy::NpyWriter::write(nd4j::NDArray &array) {
+    if (array.dataType() != _dataType)
+        throw std::invalid_argument("NpyWriter: array data type doesn't match file data type");
+
+    if (array.ordering() != (_fortranOrder ? 'f' : 'c') || array.ews() != 1) {
+        auto copy = array.dup(_fortranOrder ? 'f' : 'c');
+        write(copy->getBuffer(), copy->lengthOf() * copy->sizeOfT());
+        delete copy;
+    } else
+        write(array.getBuffer(), array.lengthOf() * array.sizeOfT());
+}
+
+void cnpy::NpyWriter::close() {
+    if (_fp == nullptr)
+        return;
+
+    auto fp = _fp;
+    _fp = nullptr;
+
+    Nd4jLong rowBytes = nd4j::DataTypeUtils::sizeOf(_dataType);
+    for (size_t e = _growing ? 1 : 0; e < _shape.size(); e++)
+        rowBytes *= _shape[e];
+
+    std::string error;
+    if (_growing) {
+        if (rowBytes > 0 && _written % rowBytes != 0)
+            error = "NpyWriter: amount of data written isn't a multiple of row size";
+        else {
+            _shape[0] = rowBytes > 0 ? _written / rowBytes : 0;
+            auto header = writeNpyHeader(_dataType, _shape, _fortranOrder, _headerSize);
+            if (header.size() != _headerSize || fseek(fp, 0, SEEK_SET) != 0 || fwrite(header.data(), 1, header.size(), fp) != header.size())
+                error = "NpyWriter: failed to update header";
+        }
+    } else if (_written != rowBytes)
+        error = "NpyWriter: amount of data written doesn't match declared shape";
+
+    if (fclose(fp) != 0 && error.empty())
+        error = "NpyWriter: failed to close file";
+
+    if (!error.empty())
+        throw std::runtime_error(error);
+}
@@ -43,6 +43,14 @@
 #include <streambuf>
 #include <op_boilerplate.h>
 #include <dll.h>
+#include <mutex>
+#include <pointercast.h>
+#include <array/DataType.h>
+#include <graph/MappedFile.h>
+
+namespace nd4j {
+    class NDArray;
+}
 
 
 
@@ -263,6 +271,180 @@ namespace cnpy {
     template<typename T>
     void npy_save(std::string fname, const T* data, const unsigned int* shape, const unsigned int ndims, std::string mode = "w");
 
+
+    /**
+     * Parsed npy header
+     */
+    struct ND4J_EXPORT NpyHeader {
+        // numpy type kind: 'f', 'i', 'u' or 'b'
+        char typeChar = '?';
+        unsigned int wordSize = 0;
+        bool littleEndian = true;
+        bool fortranOrder = false;
+        std::vector<Nd4jLong> shape;
+
+        // number of bytes before array data: magic string, version, header length and header itself
+        Nd4jLong headerSize = 0;
+
+        Nd4jLong length() const;
+        Nd4jLong byteLength() const;
+
+        /**
+         * This method returns true if data byte order matches byte order of this machine
+         */
+        bool isNativeOrder() const;
+
+        nd4j::DataType dataType() const;
+    };
+
+    /**
+     * This method parses npy header stored at given pointer. Versions 1.0, 2.0 and 3.0 of the format are supported
+     *
+     * @param data pointer to the beginning of npy data
+     * @param size number of bytes available at data
+     */
+    ND4J_EXPORT NpyHeader readNpyHeader(const char *data, Nd4jLong size);
+
+    /**
+     * This method builds npy header (magic string included) for given data type and shape.
+     * Header is padded with spaces to be at least reserve bytes long, total length is a multiple of 64
+     */
+    ND4J_EXPORT std::string writeNpyHeader(nd4j::DataType dataType, const std::vector<Nd4jLong> &shape, bool fortranOrder = false, size_t reserve = 0);
+
+    /**
+     * This method creates NDArray for npy array data. Data with native byte order is referenced in place,
+     * otherwise bytes are swapped into new buffer owned by NDArray
+     */
+    ND4J_EXPORT nd4j::NDArray* arrayFromNpy(const NpyHeader &header, const char *data);
+
+    /**
+     * Memory mapped npy file. Array data is referenced in place, pages are loaded lazily and shared via page cache
+     */
+    class ND4J_EXPORT NpyMappedFile {
+    protected:
+        nd4j::graph::MappedFile _file;
+        NpyHeader _header;
+
+    public:
+        explicit NpyMappedFile(const char *fileName);
+        ~NpyMappedFile() = default;
+
+        const NpyHeader& header() const;
+        void* data();
+
+        /**
+         * This method returns NDArray backed by mapped memory. Result must not outlive this NpyMappedFile
+         */
+        nd4j::NDArray* asArray();
+    };
+
+    /**
+     * Single member of npz archive, as described by zip central directory
+     */
+    struct ND4J_EXPORT NpzMember {
+        // member name with .npy suffix removed
+        std::string name;
+
+        // 0 for stored members, 8 for deflated ones
+        unsigned short compression = 0;
+        Nd4jLong compressedSize = 0;
+        Nd4jLong uncompressedSize = 0;
+        Nd4jLong localHeaderOffset = 0;
+    };
+
+    /**
+     * Memory mapped npz archive with lazy access to its members.
+     * Only zip central directory is parsed on open. Stored members are referenced in place if their data is aligned to element size,
+     * deflated members are inflated on first access and cached for the lifetime of the archive.
+     * Zip64 archives are supported, so members can exceed 4GB
+     */
+    class ND4J_EXPORT NpzArchive {
+    protected:
+        nd4j::graph::MappedFile _file;
+        std::vector<NpzMember> _members;
+        std::map<std::string, int> _index;
+
+        std::mutex _lock;
+        std::map<int, char*> _inflated;
+        std::map<int, char*> _realigned;
+
+        void parseCentralDirectory();
+        const char* payload(int index);
+        const char* memberData(int index);
+
+        // array data of given member, copied into separate buffer if its position within archive isn't aligned to element size
+        const char* arrayData(int index, const NpyHeader &header);
+    public:
+        explicit NpzArchive(const char *fileName);
+        ~NpzArchive();
+
+        NpzArchive(const NpzArchive &other) = delete;
+        NpzArchive& operator=(const NpzArchive &other) = delete;
+
+        int size();
+        const std::vector<NpzMember>& members();
+        bool contains(const std::string &name);
+
+        /**
+         * This method returns index of member with given name, throws std::invalid_argument if there's no such member
+         */
+        int indexOf(const std::string &name);
+
+        NpyHeader header(int index);
+
+        /**
+         * This method returns NpyArray for given member. Data belongs to the archive and stays valid as long as archive exists
+         */
+        NpyArray npyArray(int index);
+
+        /**
+         * This method returns NDArray for given member. Result must not outlive the archive
+         */
+        nd4j::NDArray* array(int index);
+        nd4j::NDArray* array(const std::string &name);
+
+        /**
+         * This method returns all members of the archive. Deflated members are inflated in parallel
+         */
+        std::map<std::string, nd4j::NDArray*> arrays();
+    };
+
+    /**
+     * Streaming npy writer: header is written first, data is appended in chunks, so arrays bigger than memory can be exported.
+     * If first dimension is -1, it's derived from amount of data written, and header is updated on close
+     */
+    class ND4J_EXPORT NpyWriter {
+    protected:
+        FILE *_fp = nullptr;
+        nd4j::DataType _dataType;
+        std::vector<Nd4jLong> _shape;
+        bool _fortranOrder;
+        bool _growing;
+        size_t _headerSize = 0;
+        Nd4jLong _written = 0;
+
+    public:
+        NpyWriter(const char *fileName, nd4j::DataType dataType, const std::vector<Nd4jLong> &shape, bool fortranOrder = false);
+        ~NpyWriter();
+
+        NpyWriter(const NpyWriter &other) = delete;
+        NpyWriter& operator=(const NpyWriter &other) = delete;
+
+        /**
+         * This method appends raw bytes of array data
+         */
+        void write(const void *data, Nd4jLong numBytes);
+
+        /**
+         * This method appends data of given array, which must have the same data type and memory order as output file
+         */
+        void write(nd4j::NDArray &array);
+
+        /**
+         * This method finalizes the file. Throws std::runtime_error if amount of data written doesn't match declared shape
+         */
+        void close();
+    };
 }
 
 /**
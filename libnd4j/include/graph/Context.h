@@ -65,6 +65,10 @@ namespace nd4j {
             std::vector<NDArray*> _fastpath_in;
             std::vector<NDArray*> _fastpath_out;
             std::vector<NDArray*> _handles;
+
+            // NDArray wrappers created for raw buffers, they are rebound instead of reallocated if Context is reused
+            std::vector<NDArray*> _wrappers_in;
+            std::vector<NDArray*> _wrappers_out;
         public:
             // TODO: maybe override new here as well?
 
@@ -198,6 +202,12 @@ namespace nd4j {
             void setTArguments(double *arguments, int numberOfArguments);
             void setIArguments(Nd4jLong *arguments, int numberOfArguments);
             void setBArguments(bool *arguments, int numberOfArguments);
+
+            /**
+             * This method detaches all fastpath arrays and arguments, so Context can be reused for next op call.
+             * Arrays allocated during previous call are released, wrappers of raw buffers are kept for rebinding
+             */
+            void clearFastPath();
         };
     }
 }
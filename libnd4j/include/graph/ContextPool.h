@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CONTEXTPOOL_H
+#define LIBND4J_CONTEXTPOOL_H
+
+#include <graph/Context.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class keeps idle fastpath Contexts of calling thread, so op calls coming from java don't allocate
+         * Context and NDArray wrappers every time. Pool is bounded, extra Contexts are just deleted on release
+         */
+        class ND4J_EXPORT ContextPool {
+        public:
+            /**
+             * This method returns empty fastpath Context, taken from pool of calling thread if possible
+             */
+            static Context* acquire();
+
+            /**
+             * This method clears given Context and puts it back into pool of calling thread
+             */
+            static void release(Context* context);
+
+            /**
+             * number of idle Contexts in pool of calling thread
+             */
+            static int size();
+        };
+    }
+}
+
+#endif //LIBND4J_CONTEXTPOOL_H
@@ -35,6 +35,9 @@ namespace nd4j {
         protected:
             // int ids of the input nodes
             std::vector<std::pair<int, int>> _inputs;
+
+            // VariableSpace slots of the inputs, -1 for inputs without slot
+            std::vector<int> _inputSlots;
             int _nodeId;
             std::vector<double> _tArgs;
             std::vector<int> _iArgs;
@@ -55,7 +58,7 @@ namespace nd4j {
 
         public:
             explicit ContextPrototype(nd4j::ops::OpDescriptor* opDescriptor = nullptr, int nodeId = 1, bool inPlace = false);
-            ~ContextPrototype() = default;
+            virtual ~ContextPrototype() = default;
 
             int getNodeId();
             int nodeId();
@@ -79,6 +82,11 @@ namespace nd4j {
             void fillInputs(std::vector<int>& inputs);
             std::vector<std::pair<int, int>>* inputs();
 
+            /**
+             * Slot indices of inputs, assigned by Graph at import. Context uses them instead of pair lookups when available
+             */
+            std::vector<int>* inputSlots();
+
             std::vector<double>* getTArguments();
             std::vector<int>* getIArguments();
             std::vector<bool>* getBArguments();
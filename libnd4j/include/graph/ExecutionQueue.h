@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_EXECUTIONQUEUE_H
+#define LIBND4J_EXECUTIONQUEUE_H
+
+#include <graph/ExecutionTicket.h>
+#include <map>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <functional>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class executes submitted tasks asynchronously. Every stream is served by its own worker thread,
+         * so tasks within one stream are executed in submission order. Tasks from different streams may run concurrently,
+         * and ordering between them is expressed via explicit dependencies: task starts only when all of its
+         * dependency tickets are done. If any dependency failed, task isn't executed and fails with the same status.
+         *
+         * Dependencies are waited for by the worker of task's stream, so stream is blocked meanwhile: tasks submitted
+         * to the same stream later don't start before that, even if they don't depend on anything.
+         * Workers are created on first use of stream id, and stay until stream is destroyed via destroyStream
+         */
+        class ND4J_EXPORT ExecutionQueue {
+        public:
+            // task returns its status, and may hand over graph results via its argument
+            typedef std::function<Nd4jStatus(VariablesSet*&)> Task;
+
+        private:
+            struct Stream {
+                std::thread worker;
+                std::mutex mutex;
+                std::condition_variable condition;
+                std::deque<std::pair<Task, std::shared_ptr<ExecutionTicket>>> tasks;
+                bool stopped = false;
+            };
+
+            std::mutex _lock;
+            std::map<Nd4jLong, Stream*> _streams;
+
+            ExecutionQueue() = default;
+            ~ExecutionQueue() = default;
+
+            Stream* stream(Nd4jLong streamId);
+            static void loop(Stream* stream);
+        public:
+            static ExecutionQueue* getInstance();
+
+            /**
+             * This method puts task into given stream, and returns ticket which is finished together with the task
+             */
+            std::shared_ptr<ExecutionTicket> submit(Nd4jLong streamId, Task task, const std::vector<std::shared_ptr<ExecutionTicket>> &dependencies = {});
+
+            /**
+             * This method blocks until all tasks submitted to given stream so far are finished
+             */
+            void synchronize(Nd4jLong streamId);
+
+            /**
+             * This method releases given stream: tasks submitted so far are still executed, and then worker exits.
+             * Submitting to the same stream id afterwards starts new stream
+             */
+            void destroyStream(Nd4jLong streamId);
+
+            /**
+             * number of streams with live workers
+             */
+            int numberOfStreams();
+        };
+    }
+}
+
+#endif //LIBND4J_EXECUTIONQUEUE_H
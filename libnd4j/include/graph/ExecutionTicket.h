@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_EXECUTIONTICKET_H
+#define LIBND4J_EXECUTIONTICKET_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/VariablesSet.h>
+#include <mutex>
+#include <condition_variable>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class is completion handle of single task submitted to ExecutionQueue
+         */
+        class ND4J_EXPORT ExecutionTicket {
+        private:
+            std::mutex _mutex;
+            std::condition_variable _condition;
+
+            bool _done = false;
+            Nd4jStatus _status = ND4J_STATUS_OK;
+
+            // results of graph execution, owned by ticket until taken
+            VariablesSet* _variables = nullptr;
+        public:
+            ExecutionTicket() = default;
+            ~ExecutionTicket();
+
+            /**
+             * This method is called by executor once task is finished, and wakes up all waiting threads
+             */
+            void finish(Nd4jStatus status, VariablesSet* variables = nullptr);
+
+            bool isDone();
+
+            /**
+             * This method blocks until task is finished, and returns its status
+             */
+            Nd4jStatus wait();
+
+            /**
+             * This method waits for task, and hands over graph results to caller. Returns nullptr for op tasks
+             */
+            VariablesSet* takeVariables();
+        };
+    }
+}
+
+#endif //LIBND4J_EXECUTIONTICKET_H
@@ -35,7 +35,22 @@ namespace nd4j {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
-            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+            // alignment used for array buffers at export, so mapped buffers can be referenced in place
+            static const int BUFFER_ALIGNMENT = 64;
+
+            /**
+             * This method restores NDArray from FlatArray.
+             *
+             * @param flatArray
+             * @param zeroCopy if true, and FlatArray buffer has native byte order and proper alignment - result will reference it instead of copy.
+             *                 Caller is responsible for keeping underlying FlatBuffer alive as long as result exists
+             */
+            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray, bool zeroCopy = false);
+
+            /**
+             * This method returns true if FlatArray buffer can be used by NDArray as is
+             */
+            static bool canReference(const nd4j::graph::FlatArray* flatArray);
         };
     }
 }
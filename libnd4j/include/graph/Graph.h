@@ -24,6 +24,7 @@
 #include <list>
 #include <algorithm>
 #include <map>
+#include <memory>
 //#include <NDArray.h>
 #include <graph/Node.h>
 #include <graph/Stash.h>
@@ -34,6 +35,7 @@
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MappedFile.h>
 #include <ops/declarable/OpDescriptor.h>
 
 namespace nd4j {
@@ -66,6 +68,10 @@ namespace nd4j {
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // file this graph was mapped from, if any. Constant arrays may reference its memory, so it's released after VariableSpace.
+            // clones share it, since their variables reference the same memory
+            std::shared_ptr<MappedFile> _mappedFile;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -79,8 +85,23 @@ namespace nd4j {
 
             void prepareOutputs();
 
+            // assigns VariableSpace slots to inputs of all nodes
+            void assignSlots();
+
+            // removes node from execution plan, node itself stays mapped
+            bool dropFromOnion(nd4j::graph::Node *node);
+
+            // import-time simplifications for inference graphs
+            int foldConstants();
+            int pruneNodes();
+
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            /**
+             * @param flatGraph
+             * @param variableSpace
+             * @param mappedFile if set, flatGraph is expected to point into this file. Graph takes ownership of it, and constants reference file memory instead of copies
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, MappedFile *mappedFile = nullptr);
 
             ~Graph();
 
@@ -215,6 +236,10 @@ namespace nd4j {
             Nd4jLong hashCode();
 
             /**
+             * This method marks nodes that can overwrite their inputs: legacy transforms and in-place declarable ops with
+             * default shape function, if overwritten inputs are produced by other nodes and have no other consumers.
+             * Called automatically for FORWARD_ONLY graphs in OPTIMIZED output mode
+             *
              * PLEASE NOTE: This method will be moved to private section
              */
             void tagInplaceNodes();
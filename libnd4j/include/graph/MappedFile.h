@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Read-only view of a file, backed by read-only memory mapping where available.
+         * Pages are loaded lazily and shared between processes via page cache. Writing into mapped memory is an access violation.
+         * On platforms without mmap support file is read into heap memory instead.
+         */
+        class ND4J_EXPORT MappedFile {
+        protected:
+            void *_buffer = nullptr;
+            Nd4jLong _length = 0;
+            bool _mapped = false;
+
+        public:
+            explicit MappedFile(const char *fileName);
+            ~MappedFile();
+
+            MappedFile(const MappedFile &other) = delete;
+            MappedFile& operator=(const MappedFile &other) = delete;
+
+            void* buffer();
+            Nd4jLong length();
+
+            /**
+             * This method returns true if file contents are memory mapped, false if they were copied
+             */
+            bool isMapped();
+        };
+    }
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_OUTPUTALIASING_H
+#define LIBND4J_OUTPUTALIASING_H
+
+#include <graph/Graph.h>
+#include <graph/Node.h>
+#include <graph/VariableSpace.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+
+        /**
+         * This class lets GraphExecutioner elide copies done by concat/stack and split/unstack nodes.
+         *
+         * Join: if output of some node is consumed by concat/stack only, the node writes its result straight into its slice
+         * of concat output: before the node runs, concat output is allocated and views of it are put into VariableSpace
+         * as outputs of producers, so DeclarableOp::prepareOutputs picks them up. Concat then skips chunks which are in place.
+         *
+         * Split: outputs of split/unstack become views of its input, if nobody modifies them or the input in place.
+         * These are raw views into input buffer, they don't hold it: they stay valid only while VariableSpace which
+         * produced them (and owns the input) lives, so results fetched from graph outputs must be dup()'ed before that.
+         *
+         * Views are created only for contiguous slices, i.e. when all dimensions before axis are unities (axis 0, or batch
+         * of 1 for NCHW concat along channels). Otherwise ops copy data with dense chunk kernels, as before.
+         * Graphs with control flow are never aliased. Join/split node may be graph output itself, but producers
+         * which are graph outputs and split inputs which are graph outputs aren't aliased.
+         */
+        class ND4J_EXPORT OutputAliasing {
+        private:
+            struct Slot {
+                Node* join;
+                int index;          // position among join inputs
+            };
+
+            Graph* _graph;
+            bool _enabled = true;
+
+            // producer output -> join node it feeds
+            std::map<std::pair<int, int>, Slot> _slots;
+            // producer id -> its aliasable outputs
+            std::map<int, std::vector<int>> _producers;
+            // joins planned during current execution, or found impossible
+            std::set<int> _planned;
+            std::set<int> _splits;
+
+            bool evalOutputShapes(Node* node, VariableSpace* variableSpace, std::vector<std::vector<Nd4jLong>>& shapes, std::vector<nd4j::DataType>& dtypes);
+            bool isAvailable(VariableSpace* variableSpace, std::pair<int, int> pair);
+            void planJoin(Node* join, VariableSpace* variableSpace);
+            void planSplit(Node* split, VariableSpace* variableSpace);
+
+        public:
+            /**
+             * topology analysis, done once per graph execution
+             */
+            explicit OutputAliasing(Graph* graph);
+
+            /**
+             * This method must be called right before node is executed: it places views into VariableSpace if outputs of
+             * this node can alias consumer output or node input
+             */
+            void prepare(Node* node, VariableSpace* variableSpace);
+
+            /**
+             * number of producer outputs that may be written into join outputs directly
+             */
+            int numberOfJoinSlots() const;
+        };
+    }
+}
+
+#endif //LIBND4J_OUTPUTALIASING_H
@@ -45,6 +45,12 @@ namespace nd4j {
             bool _placeholder = false;
             bool _removable = true;
 
+            // value is known at import time and never changes: CONSTANT variables and results of folded nodes
+            bool _constant = false;
+
+            // array buffer references memory of mapped FlatBuffers file, which isn't owned by array
+            bool _referenced = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -58,9 +64,17 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            /**
+             * @param flatVariable
+             * @param zeroCopy if true, VARIABLE/CONSTANT arrays will reference FlatBuffer memory where possible, see FlatUtils::fromFlatArray
+             */
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
+            /**
+             * This method returns deep copy of this Variable. Arrays referencing mapped memory aren't copied:
+             * clone gets view of the same buffer, so mapped graph must outlive its clones
+             */
             Variable* clone();
 
             template <typename N>
@@ -78,6 +92,8 @@ namespace nd4j {
             bool isReadOnly();
             bool isEmpty();
             bool isRemovable();
+            bool isConstant();
+            bool isReferenced();
 
             bool isPlaceholder();
 
@@ -94,6 +110,7 @@ namespace nd4j {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markConstant(bool reallyConstant);
 
             int id();
             int index();
@@ -85,6 +85,11 @@ namespace nd4j {
             virtual nd4j::graph::Stash* getStash();
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            // slots are owned by backed VariableSpace, variables put into this proxy take precedence over them
+            virtual int reserveSlot(std::pair<int,int>& pair);
+            virtual int slotOf(std::pair<int,int>& pair);
+            virtual Variable* slotVariable(int slot, std::pair<int,int>& pair);
         };
     }
 }
\ No newline at end of file
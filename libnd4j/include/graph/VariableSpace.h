@@ -69,6 +69,15 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // dense slots for (node, output) pairs: indices are assigned at graph import, so runtime lookups are plain array reads
+            std::map<std::pair<int, int>, int> _slotIds;
+            std::vector<std::pair<int, int>> _slotPairs;
+            std::vector<nd4j::graph::Variable*> _slots;
+
+            Variable* resolveSlot(const std::pair<int,int>& pair);
+            void refreshSlots(int id);
+            void refreshSlots();
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -138,6 +147,23 @@ namespace nd4j {
 
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            /**
+             * This method assigns dense slot index to given (node, output) pair, or returns index assigned before
+             * Slot follows the pair: it's updated whenever Variable for this pair is put into this VariableSpace
+             */
+            virtual int reserveSlot(std::pair<int,int>& pair);
+
+            /**
+             * This method returns slot index of given pair, or -1 if no slot was reserved for it
+             */
+            virtual int slotOf(std::pair<int,int>& pair);
+
+            /**
+             * This method returns Variable stored in given slot, or nullptr if there's nothing there yet.
+             * Pair is checked against the slot, so slot indices coming from another VariableSpace give nullptr instead of wrong Variable
+             */
+            virtual Variable* slotVariable(int slot, std::pair<int,int>& pair);
         };
     }
 }
@@ -34,6 +34,8 @@ namespace nd4j {
                     this->_inputs.push_back(v);
                 }
 
+                this->_inputSlots = *(prototype->inputSlots());
+
                 for (const auto &v: *(prototype->getTArguments())) {
                     this->_tArgs.push_back(v);
                 }
@@ -107,6 +109,12 @@ namespace nd4j {
 
             for (auto v:_handles)
                 delete v;
+
+            for (auto v:_wrappers_in)
+                delete v;
+
+            for (auto v:_wrappers_out)
+                delete v;
         }
 
         bool Context::hasWorkspaceProvided() {
@@ -221,9 +229,15 @@ namespace nd4j {
                 throw std::runtime_error("Context: bad Variable index");
             }
 
+            // slot lookup first, pair lookup is fallback for inputs without slot or not produced yet
             auto p = this->_inputs[idx];
 
-            auto v = variable(p);
+            Variable* v = nullptr;
+            if (idx < (int) this->_inputSlots.size() && _variableSpace != nullptr)
+                v = _variableSpace->slotVariable(this->_inputSlots[idx], p);
+
+            if (v == nullptr)
+                v = variable(p);
 
             if (Environment::getInstance()->isDebugAndVerbose() && v != nullptr &&  v->getNDArray() != nullptr) {
                 auto array = v->getNDArray();
@@ -383,15 +397,30 @@ namespace nd4j {
                 _handles.emplace_back(array);
         }
 
+        static NDArray* rebindWrapper(std::vector<NDArray*> &wrappers, int index, void *buffer, void *shapeInfo) {
+            if ((int) wrappers.size() < index + 1)
+                wrappers.resize(index+1, nullptr);
+
+            auto array = wrappers[index];
+            if (array == nullptr) {
+                array = new NDArray(buffer, reinterpret_cast<Nd4jLong *>(shapeInfo));
+                array->triggerAllocationFlag(false, false);
+                wrappers[index] = array;
+            } else {
+                array->setShapeInfo(reinterpret_cast<Nd4jLong *>(shapeInfo));
+                array->setBuffer(buffer);
+            }
+
+            return array;
+        }
+
         void Context::setInputArray(int index, void *buffer, void *shapeInfo, void *specialBuffer, void *specialShapeInfo) {
-            auto array = new NDArray(buffer, reinterpret_cast<Nd4jLong *>(shapeInfo));
-            array->triggerAllocationFlag(false, false);
+            auto array = rebindWrapper(_wrappers_in, index, buffer, shapeInfo);
 
             if (_fastpath_in.size() < index + 1)
                 _fastpath_in.resize(index+1);
 
             _fastpath_in[index] = array;
-            _handles.emplace_back(array);
         }
 
         void Context::setOutputArray(int index, NDArray *array, bool removable) {
@@ -408,11 +437,7 @@ namespace nd4j {
             if (_fastpath_out.size() < index + 1)
                 _fastpath_out.resize(index+1);
 
-            auto array = new NDArray(buffer, reinterpret_cast<Nd4jLong *>(shapeInfo));
-            array->triggerAllocationFlag(false, false);
-
-            _fastpath_out[index] = array;
-            _handles.emplace_back(array);
+            _fastpath_out[index] = rebindWrapper(_wrappers_out, index, buffer, shapeInfo);
         }
 
         void Context::setTArguments(double *arguments, int numberOfArguments) {
@@ -435,6 +460,20 @@ namespace nd4j {
             for (int e = 0; e < numberOfArguments; e++)
                 _bArgs.push_back(arguments[e]);
         }
+
+        void Context::clearFastPath() {
+            _fastpath_in.clear();
+            _fastpath_out.clear();
+
+            _tArgs.clear();
+            _iArgs.clear();
+            _bArgs.clear();
+
+            for (auto v:_handles)
+                delete v;
+
+            _handles.clear();
+        }
     }
 }
 
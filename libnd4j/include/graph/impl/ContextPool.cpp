@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/ContextPool.h>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        static const size_t kContextPoolLimit = 16;
+
+        // idle Contexts are owned by thread, and released together with it
+        struct ContextPoolHolder {
+            std::vector<Context*> contexts;
+
+            ~ContextPoolHolder() {
+                for (auto v: contexts)
+                    delete v;
+            }
+        };
+
+        static thread_local ContextPoolHolder _localContexts;
+
+        Context* ContextPool::acquire() {
+            auto &contexts = _localContexts.contexts;
+            if (contexts.empty())
+                return new Context(1);
+
+            auto context = contexts.back();
+            contexts.pop_back();
+            return context;
+        }
+
+        void ContextPool::release(Context* context) {
+            if (context == nullptr)
+                return;
+
+            context->clearFastPath();
+            context->markInplace(false);
+
+            auto &contexts = _localContexts.contexts;
+            if (contexts.size() >= kContextPoolLimit)
+                delete context;
+            else
+                contexts.emplace_back(context);
+        }
+
+        int ContextPool::size() {
+            return (int) _localContexts.contexts.size();
+        }
+    }
+}
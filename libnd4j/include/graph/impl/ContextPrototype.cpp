@@ -52,6 +52,10 @@ namespace nd4j {
             return &_inputs;
         }
 
+        std::vector<int>* ContextPrototype::inputSlots() {
+            return &_inputSlots;
+        }
+
         void ContextPrototype::fillInputs(std::vector<int>& inputs) {
             for (int e = 0; e < inputs.size(); e++) {
                 auto v = inputs.at(e);
@@ -161,6 +165,8 @@ namespace nd4j {
             for (auto v: _inputs)
                 clone->_inputs.emplace_back(v);
 
+            clone->_inputSlots = _inputSlots;
+
             for (auto v: _tArgs)
                 clone->_tArgs.emplace_back(v);
 
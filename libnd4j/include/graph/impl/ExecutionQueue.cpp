@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/ExecutionQueue.h>
+#include <helpers/logger.h>
+
+namespace nd4j {
+    namespace graph {
+        ExecutionQueue* ExecutionQueue::getInstance() {
+            // initialization of function-local static is thread-safe, and instance is never destroyed, since workers outlive static destructors
+            static auto instance = new ExecutionQueue();
+            return instance;
+        }
+
+        ExecutionQueue::Stream* ExecutionQueue::stream(Nd4jLong streamId) {
+            // _lock is held by caller
+            auto it = _streams.find(streamId);
+            if (it != _streams.end())
+                return it->second;
+
+            // worker is never joined: it deletes its stream on exit, see destroyStream()
+            auto stream = new Stream();
+            stream->worker = std::thread(&ExecutionQueue::loop, stream);
+            stream->worker.detach();
+
+            _streams[streamId] = stream;
+            return stream;
+        }
+
+        void ExecutionQueue::loop(Stream* stream) {
+            while (true) {
+                std::pair<Task, std::shared_ptr<ExecutionTicket>> task;
+                {
+                    std::unique_lock<std::mutex> lock(stream->mutex);
+                    stream->condition.wait(lock, [&] { return !stream->tasks.empty() || stream->stopped; });
+
+                    // stream is removed from the map before it's stopped, so nothing can be added after that
+                    if (stream->tasks.empty())
+                        break;
+
+                    task = std::move(stream->tasks.front());
+                    stream->tasks.pop_front();
+                }
+
+                VariablesSet* variables = nullptr;
+                Nd4jStatus status = ND4J_STATUS_OK;
+                try {
+                    status = task.first(variables);
+                } catch (std::exception &e) {
+                    nd4j_printf("Async task failed: [%s]\n", e.what());
+                    status = ND4J_STATUS_KERNEL_FAILURE;
+                } catch (...) {
+                    nd4j_printf("Async task failed: [unknown exception]\n", "");
+                    status = ND4J_STATUS_KERNEL_FAILURE;
+                }
+
+                task.second->finish(status, variables);
+            }
+
+            delete stream;
+        }
+
+        std::shared_ptr<ExecutionTicket> ExecutionQueue::submit(Nd4jLong streamId, Task task, const std::vector<std::shared_ptr<ExecutionTicket>> &dependencies) {
+            auto ticket = std::make_shared<ExecutionTicket>();
+
+            // dependencies were submitted before this task, so waiting for them can't deadlock
+            Task wrapped = [task, dependencies] (VariablesSet* &variables) -> Nd4jStatus {
+                for (auto const& v: dependencies) {
+                    auto status = v->wait();
+                    if (status != ND4J_STATUS_OK)
+                        return status;
+                }
+
+                return task(variables);
+            };
+
+            // task is queued under queue lock, so destroyStream() can't stop the stream in between
+            std::lock_guard<std::mutex> lock(_lock);
+            auto s = stream(streamId);
+            {
+                std::lock_guard<std::mutex> streamLock(s->mutex);
+                s->tasks.emplace_back(std::move(wrapped), ticket);
+            }
+
+            s->condition.notify_one();
+            return ticket;
+        }
+
+        void ExecutionQueue::synchronize(Nd4jLong streamId) {
+            submit(streamId, [] (VariablesSet* &variables) -> Nd4jStatus { return ND4J_STATUS_OK; })->wait();
+        }
+
+        void ExecutionQueue::destroyStream(Nd4jLong streamId) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            auto it = _streams.find(streamId);
+            if (it == _streams.end())
+                return;
+
+            auto s = it->second;
+            _streams.erase(it);
+            {
+                std::lock_guard<std::mutex> streamLock(s->mutex);
+                s->stopped = true;
+            }
+
+            s->condition.notify_one();
+        }
+
+        int ExecutionQueue::numberOfStreams() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return (int) _streams.size();
+        }
+    }
+}
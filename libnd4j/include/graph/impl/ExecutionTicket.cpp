@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/ExecutionTicket.h>
+
+namespace nd4j {
+    namespace graph {
+        ExecutionTicket::~ExecutionTicket() {
+            delete _variables;
+        }
+
+        void ExecutionTicket::finish(Nd4jStatus status, VariablesSet* variables) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _status = status;
+                _variables = variables;
+                _done = true;
+            }
+
+            _condition.notify_all();
+        }
+
+        bool ExecutionTicket::isDone() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _done;
+        }
+
+        Nd4jStatus ExecutionTicket::wait() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [&] { return _done; });
+            return _status;
+        }
+
+        VariablesSet* ExecutionTicket::takeVariables() {
+            wait();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto variables = _variables;
+            _variables = nullptr;
+            return variables;
+        }
+    }
+}
@@ -36,7 +36,35 @@ namespace nd4j {
             return std::pair<Nd4jLong, Nd4jLong>(pair->first(), pair->second());
         }
 
-        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray) {
+        bool FlatUtils::canReference(const nd4j::graph::FlatArray *flatArray) {
+            if (flatArray->buffer() == nullptr || flatArray->shape() == nullptr)
+                return false;
+
+            auto dtype = DataTypeUtils::fromFlatDataType(flatArray->dtype());
+            if (dtype == UTF8)
+                return false;
+
+            bool isBe = BitwiseUtils::isBE();
+            bool nativeOrder = (isBe && flatArray->byteOrder() == nd4j::graph::ByteOrder_BE) || (!isBe && flatArray->byteOrder() == nd4j::graph::ByteOrder_LE);
+            if (!nativeOrder)
+                return false;
+
+            auto rank = static_cast<int>(flatArray->shape()->Get(0));
+            auto shapeInfo = reinterpret_cast<const Nd4jLong *>(flatArray->shape()->data());
+
+            // empty arrays are restored via NDArrayFactory, nothing to reference
+            if (shape::isEmpty(shapeInfo))
+                return false;
+
+            if (shape::length(shapeInfo) * DataTypeUtils::sizeOf(dtype) > flatArray->buffer()->size())
+                return false;
+
+            // misaligned buffers can't be used by kernels directly
+            auto address = reinterpret_cast<Nd4jLong>(flatArray->buffer()->data());
+            return rank >= 0 && address % DataTypeUtils::sizeOf(dtype) == 0;
+        }
+
+        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray, bool zeroCopy) {
             auto rank = static_cast<int>(flatArray->shape()->Get(0));
             auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
             memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -91,6 +119,13 @@ namespace nd4j {
             }
 
 
+            if (zeroCopy && canReference(flatArray)) {
+                auto array = new NDArray((void *) flatArray->buffer()->data(), newShape);
+                array->triggerAllocationFlag(false, true);
+
+                return array;
+            }
+
             auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
 
             BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype, ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()),  length), LIBND4J_TYPES);
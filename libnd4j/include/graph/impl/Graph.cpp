@@ -25,10 +25,19 @@
 #include <vector>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
+#include <ops/declarable/DeclarableCustomOp.h>
+#include <ops/declarable/DeclarableReductionOp.h>
+#include <ops/declarable/DeclarableListOp.h>
+#include <ops/declarable/BooleanOp.h>
+#include <ops/declarable/LogicOp.h>
+#include <ops/declarable/LegacyOp.h>
 #include <graph/VariableProxy.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
+#include <graph/Context.h>
+#include <set>
+#include <string>
 
 namespace nd4j {
     namespace graph {
@@ -303,6 +312,9 @@ namespace nd4j {
             delete _variableSpace;
             delete _onion;
             delete _configuration;
+
+            // must go after VariableSpace: arrays there might reference mapped memory
+            _mappedFile.reset();
         }
 
         void Graph::addNode(Node *node) {
@@ -424,7 +436,7 @@ namespace nd4j {
                 nd4j_logger("Adding specific output variable: Outputs: %i; HasInternal: %i;\n", node->output()->size(), node->hasInternalOutputs());
 
                 // we're pushing this node to output only
-                if ((!node->hasInternalOutputs() && (_configuration->_outputMode == OutputMode_IMPLICIT || _configuration->_outputMode == OutputMode_EXPLICIT_AND_IMPLICIT)) ) {
+                if ((!node->hasInternalOutputs() && (_configuration->_outputMode == OutputMode_IMPLICIT || _configuration->_outputMode == OutputMode_EXPLICIT_AND_IMPLICIT || _configuration->_outputMode == OutputMode_OPTIMIZED)) ) {
                     for (int e = 0;  e < (int) node->output()->size(); e++) {
                         if (node->output()->at(e).first < 0)
                             pushToOutputOnce(node->output()->at(e).first);
@@ -699,85 +711,93 @@ namespace nd4j {
             if (_unmapped.size() == 0)
                 _built.store(true);
 
+            assignSlots();
             prepareOutputs();
 
+            if (_built.load() && _configuration->_direction == Direction_FORWARD_ONLY && _configuration->_outputMode == OutputMode_OPTIMIZED)
+                tagInplaceNodes();
+
             return nd4j::Status::OK();
         }
 
+        // ops with auto-generated shape function (OP_IMPL, CONFIGURABLE_OP_IMPL): output e has shape and type of input e
+        static bool isShapePreservingOp(nd4j::ops::DeclarableOp *op) {
+            return dynamic_cast<nd4j::ops::DeclarableCustomOp*>(op) == nullptr &&
+                   dynamic_cast<nd4j::ops::DeclarableReductionOp*>(op) == nullptr &&
+                   dynamic_cast<nd4j::ops::DeclarableListOp*>(op) == nullptr &&
+                   dynamic_cast<nd4j::ops::BooleanOp*>(op) == nullptr &&
+                   dynamic_cast<nd4j::ops::LogicOp*>(op) == nullptr &&
+                   dynamic_cast<nd4j::ops::LegacyOp*>(op) == nullptr;
+        }
+
         void Graph::tagInplaceNodes() {
             // just calling, in case it wasn't built before
             if (!_built.load())
                 this->buildGraph();
 
-            bool buildRef = false;
+            // loops and branches may read the same variable more than once, so nothing is overwritten there
+            if (!_scopes.empty())
+                return;
+
+            for (auto const& v : *_mapped)
+                if (v.second->opType() == OpType_LOGIC || v.second->hasGraphEmbedded() || v.second->isDivergencePoint())
+                    return;
+
+            // number of reads of every variable, across all nodes
+            std::map<std::pair<int, int>, int> uses;
+            for (auto const& v : *_mapped)
+                for (auto const& in : *v.second->input())
+                    uses[in]++;
 
-            // checking for non-refenenced nodes
             for (auto v: *_nodes) {
                 // skipping unmapped nodes
                 if (_mapped->count(v) == 0)
                     continue;
 
                 Node* node = _mapped->at(v);
-                if (node->totalReferences() == 0) {
-                    buildRef = true;
-                    break;
-                }
-            }
+                auto op = node->getCustomOp();
+                if (op == nullptr || !op->getOpDescriptor()->allowsInplace() || op->getOpDescriptor()->isDivergent())
+                    continue;
 
-            if (buildRef) {
-                for (auto v: *_nodes) {
-                    // skipping unmapped nodes
-                    if (_mapped->count(v) == 0)
+                /**
+                 * Node can be executed in-place if:
+                 * 1) op writes output e into input e, so output shape must be equal to input shape: legacy transforms,
+                 *    and declarable ops using default shape function, declared with in-place flag
+                 * 2) every overwritten input is produced by another node, and nobody else reads it. Variables and
+                 *    placeholders must survive, since graph is executed more than once
+                 */
+                bool legacy = dynamic_cast<nd4j::ops::LegacyOp*>(op) != nullptr;
+                if (legacy) {
+                    // legacy ops are tagged by Node, depending on op type
+                    if (!node->isInplace())
                         continue;
+                } else if (!isShapePreservingOp(op))
+                    continue;
 
-                    Node* node = _mapped->at(v);
-                    auto inputs = node->input();
-                    for (auto &t: *inputs) {
-                        if (_mapped->count(t.first) == 0)
-                            continue;
+                auto inputs = node->input();
+                int numOutputs = legacy ? 1 : op->getOpDescriptor()->getNumberOfOutputs();
+                bool inplace = numOutputs > 0 && numOutputs <= (int) inputs->size();
 
-                        Node* inode = _mapped->at(t.first);
-                        inode->addReference(node->id());
+                for (int e = 0; e < numOutputs && inplace; e++) {
+                    auto &t = inputs->at(e);
+
+                    if (_mapped->count(t.first) == 0 || uses[t] != 1) {
+                        inplace = false;
+                        break;
                     }
-                }
-            }
 
+                    // results of folded nodes are constants, and must survive execution
+                    if (_variableSpace->hasVariable(t) && _variableSpace->getVariable(t)->isConstant())
+                        inplace = false;
 
-            for (auto v: *_nodes) {
-                // skipping unmapped nodes
-                if (_mapped->count(v) == 0)
-                    continue;
+                    if (std::find(_output.begin(), _output.end(), t.first) != _output.end())
+                        inplace = false;
+                }
 
-                Node* node = _mapped->at(v);
-                
-                /**
-                 * Node can be inplace if 2 requirements met:
-                 * 1) current node allows in-place modification
-                 * 2) source node has only 1 output
-                 */                
-
-                // checking for first requirement first
-                if (node->getCustomOp() != nullptr)
-                    if (node->getCustomOp()->getOpDescriptor()->allowsInplace()){
-                        bool singleInput = true;
-                        auto inputs = node->input();
-                        for (auto &t: *inputs) {
-                            if (_mapped->count(t.first) == 0)
-                                continue;
-
-                            Node* inode = _mapped->at(t.first);
-
-                            int output_size = inode->output()->size();
-
-                            // checking for second requirement: inputNode must not be used as input anywhere
-                            if (inode->totalReferences() > 1) {
-                                singleInput = false;
-                                break;
-                            }
-                        }
+                if (inplace != node->isInplace())
+                    nd4j_debug("Node_%i in-place execution: %i\n", node->id(), (int) inplace);
 
-                        node->markInplace(singleInput);
-                    }
+                node->markInplace(inplace);
             }
         }
 
@@ -800,7 +820,7 @@ namespace nd4j {
                         _output.emplace_back(node->id());
                 }
 
-            } else if (_configuration->_outputMode == OutputMode_IMPLICIT) {
+            } else if (_configuration->_outputMode == OutputMode_IMPLICIT || _configuration->_outputMode == OutputMode_OPTIMIZED) {
                 // we're adding final nodes of the graph. those, not used as input anywhere
                 nd4j_debug("Paring nodes... \n", "");
 
@@ -864,7 +884,8 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, MappedFile *mappedFile) {
+            this->_mappedFile.reset(mappedFile);
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -891,7 +912,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, mappedFile != nullptr);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -944,8 +965,16 @@ namespace nd4j {
 
 
                 this->toposortNodes();
+                this->assignSlots();
 
                 _built = true;
+
+                // constant subgraphs are evaluated once here, and nodes that don't contribute to outputs are dropped
+                if (_configuration->_direction == Direction_FORWARD_ONLY) {
+                    auto folded = this->foldConstants();
+                    auto pruned = this->pruneNodes();
+                    nd4j_debug("Graph import: %i node(s) folded, %i node(s) pruned\n", folded, pruned);
+                }
             }
 
             /**
@@ -955,8 +984,190 @@ namespace nd4j {
              */
             if (_configuration->_direction == Direction_FORWARD_ONLY && _configuration->_outputMode == OutputMode_OPTIMIZED)
                 this->tagInplaceNodes();
+
+            // mapped arrays are shared by all clones of this graph, so nodes can't overwrite them
+            if (_mappedFile != nullptr) {
+                for (auto const& v : *_mapped) {
+                    auto node = v.second;
+                    if (!node->isInplace())
+                        continue;
+
+                    for (auto in : *node->input()) {
+                        if (_variableSpace->hasVariable(in) && _variableSpace->getVariable(in)->isReferenced()) {
+                            node->markInplace(false);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+
+        void Graph::assignSlots() {
+            for (auto const& v : *_mapped) {
+                auto block = v.second->getContextPrototype();
+                auto slots = block->inputSlots();
+
+                slots->clear();
+                for (auto &in: *block->inputs())
+                    slots->emplace_back(_variableSpace->reserveSlot(in));
+            }
         }
 
+        // custom ops that are deterministic and depend on inputs and arguments only, mostly shape arithmetic
+        static const std::set<std::string>& foldableCustomOps() {
+            static const std::set<std::string> ops = {
+                    "shape_of", "shapes_of", "size", "size_at", "rank", "reshape", "reshapeas", "transpose", "permute",
+                    "strided_slice", "slice", "concat", "stack", "parallel_stack", "unstack", "squeeze", "expand_dims",
+                    "fill", "fill_as", "zeros_as", "ones_as", "range", "cast", "identity", "gather", "tile", "tile_to_shape",
+                    "pad", "broadcast_to", "broadcast_dynamic_shape", "evaluate_reduction_shape",
+                    "add", "subtract", "multiply", "divide", "realdiv", "floordiv", "floormod", "maximum", "minimum",
+                    "reduce_sum", "reduce_prod", "mergeadd"};
+
+            return ops;
+        }
+
+        static bool isFoldable(Node *node) {
+            if (!node->hasCustomOp() || node->hasGraphEmbedded())
+                return false;
+
+            switch (node->opType()) {
+                case OpType_TRANSFORM_FLOAT:
+                case OpType_TRANSFORM_SAME:
+                case OpType_TRANSFORM_BOOL:
+                case OpType_TRANSFORM_STRICT:
+                case OpType_TRANSFORM_ANY:
+                case OpType_REDUCE_FLOAT:
+                case OpType_REDUCE_SAME:
+                case OpType_REDUCE_LONG:
+                case OpType_REDUCE_BOOL:
+                case OpType_INDEX_REDUCE:
+                case OpType_SCALAR:
+                case OpType_SCALAR_BOOL:
+                case OpType_BROADCAST:
+                case OpType_BROADCAST_BOOL:
+                case OpType_PAIRWISE:
+                case OpType_PAIRWISE_BOOL:
+                case OpType_REDUCE_3:
+                case OpType_SUMMARYSTATS:
+                    return true;
+                case OpType_CUSTOM:
+                    return foldableCustomOps().count(*node->getCustomOp()->getOpName()) > 0;
+                default:
+                    return false;
+            }
+        }
+
+        bool Graph::dropFromOnion(Node *node) {
+            if (_onion->count(node->getLayer()) == 0)
+                return false;
+
+            auto layer = _onion->at(node->getLayer());
+            auto it = std::find(layer->begin(), layer->end(), node);
+            if (it == layer->end())
+                return false;
+
+            layer->erase(it);
+            return true;
+        }
+
+        int Graph::foldConstants() {
+            int folded = 0;
+
+            // layers go in execution order, so results of folded nodes are available to the following layers
+            for (auto const& l : *_onion) {
+                std::vector<Node*> layer(*l.second);
+
+                for (auto node: layer) {
+                    if (!isFoldable(node))
+                        continue;
+
+                    bool constant = true;
+                    for (auto &in: *node->input()) {
+                        if (!_variableSpace->hasVariable(in)) {
+                            constant = false;
+                            break;
+                        }
+
+                        auto var = _variableSpace->getVariable(in);
+                        if (!var->isConstant() || !var->hasNDArray()) {
+                            constant = false;
+                            break;
+                        }
+                    }
+
+                    if (!constant)
+                        continue;
+
+                    Context context(node->getContextPrototype(), _variableSpace);
+                    Nd4jStatus status;
+                    try {
+                        status = node->getCustomOp()->execute(&context);
+                    } catch (std::exception &e) {
+                        nd4j_debug("Node_%i can't be folded: %s\n", node->id(), e.what());
+                        continue;
+                    }
+
+                    if (status != Status::OK() || !_variableSpace->hasVariable(node->id(), 0))
+                        continue;
+
+                    // outputs become constants, so consumers can be folded as well. node stays in plan if any output isn't an array
+                    std::vector<Variable*> outputs;
+                    for (int e = 0; _variableSpace->hasVariable(node->id(), e); e++)
+                        outputs.emplace_back(_variableSpace->getVariable(node->id(), e));
+
+                    bool arrays = true;
+                    for (auto v: outputs)
+                        arrays &= v->hasNDArray();
+
+                    if (!arrays)
+                        continue;
+
+                    for (auto v: outputs)
+                        v->markConstant(true);
+
+                    dropFromOnion(node);
+                    folded++;
+                }
+            }
+
+            return folded;
+        }
+
+        int Graph::pruneNodes() {
+            // only explicit outputs tell which nodes are required. control flow is left untouched
+            if (_configuration->_outputMode != OutputMode_EXPLICIT || _output.empty() || !_scopes.empty())
+                return 0;
+
+            for (auto const& v : *_mapped)
+                if (v.second->opType() == OpType_LOGIC || v.second->isDivergencePoint())
+                    return 0;
+
+            std::set<int> required;
+            std::vector<int> queue(_output.begin(), _output.end());
+            while (!queue.empty()) {
+                auto id = queue.back();
+                queue.pop_back();
+
+                if (_mapped->count(id) == 0 || required.count(id) > 0)
+                    continue;
+
+                required.insert(id);
+                for (auto &in: *_mapped->at(id)->input())
+                    queue.emplace_back(in.first);
+            }
+
+            int pruned = 0;
+            for (auto const& v : *_mapped) {
+                if (required.count(v.first) > 0)
+                    continue;
+
+                if (dropFromOnion(v.second))
+                    pruned++;
+            }
+
+            return pruned;
+        }
 
         void Graph::toposortNodes() {
             int attempts = 0;
@@ -1280,6 +1491,7 @@ namespace nd4j {
             auto clone = new Graph();
 
             clone->replaceState(new VariableProxy(this->_variableSpace), this->_configuration->clone());
+            clone->_mappedFile = _mappedFile;
 
             // transfer nodes
             for (int e = 0; e < _nodes->size(); e++)
@@ -1331,6 +1543,7 @@ namespace nd4j {
             auto clone = new Graph();
 
             clone->replaceState(this->_variableSpace->clone(), this->_configuration->clone());
+            clone->_mappedFile = _mappedFile;
 
             // transfer nodes
             for (int e = 0; e < _nodes->size(); e++)
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MappedFile.h>
+#include <helpers/logger.h>
+#include <stdexcept>
+#include <string>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace nd4j {
+    namespace graph {
+        MappedFile::MappedFile(const char *fileName) {
+            struct stat stat_buf;
+            if (stat(fileName, &stat_buf) != 0) {
+                nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", fileName);
+                throw std::runtime_error("File not found");
+            }
+
+            _length = static_cast<Nd4jLong>(stat_buf.st_size);
+            if (_length == 0)
+                throw std::runtime_error(std::string("Empty file: ") + fileName);
+
+#ifndef _WIN32
+            int fd = open(fileName, O_RDONLY, 0);
+            if (fd < 0)
+                throw std::runtime_error(std::string("Failed to open file for MMAP: ") + fileName);
+
+            // read-only mapping: Graph revokes in-place execution for nodes that read arrays referencing it
+            auto ptr = mmap(nullptr, static_cast<size_t>(_length), PROT_READ, MAP_SHARED, fd, 0);
+
+            // mapping holds its own reference to the file
+            close(fd);
+
+            if (ptr != MAP_FAILED) {
+                _buffer = ptr;
+                _mapped = true;
+                return;
+            }
+
+            nd4j_debug("MMAP failed for file [%s], falling back to read\n", fileName);
+#endif
+            auto data = new int8_t[_length];
+
+            FILE *in = fopen(fileName, "rb");
+            if (in == nullptr) {
+                delete[] data;
+                throw std::runtime_error(std::string("Failed to open file: ") + fileName);
+            }
+
+            auto cnt = fread(data, 1, static_cast<size_t>(_length), in);
+            fclose(in);
+
+            if (static_cast<Nd4jLong>(cnt) != _length) {
+                delete[] data;
+                throw std::runtime_error(std::string("Failed to read file: ") + fileName);
+            }
+
+            _buffer = data;
+        }
+
+        MappedFile::~MappedFile() {
+            if (_buffer == nullptr)
+                return;
+
+#ifndef _WIN32
+            if (_mapped) {
+                munmap(_buffer, static_cast<size_t>(_length));
+                return;
+            }
+#endif
+            delete[] reinterpret_cast<int8_t *>(_buffer);
+        }
+
+        void* MappedFile::buffer() {
+            return _buffer;
+        }
+
+        Nd4jLong MappedFile::length() {
+            return _length;
+        }
+
+        bool MappedFile::isMapped() {
+            return _mapped;
+        }
+    }
+}
@@ -0,0 +1,348 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/OutputAliasing.h>
+#include <graph/Context.h>
+#include <array/ShapeList.h>
+#include <algorithm>
+
+namespace nd4j {
+    namespace graph {
+
+        static bool isInplaceNode(Node* node) {
+            return node->isInplace() || (node->getContextPrototype() != nullptr && node->getContextPrototype()->isInplace());
+        }
+
+        static bool isOpNode(Node* node, const char* name) {
+            return node->hasCustomOp() && *node->getCustomOp()->getOpName() == name;
+        }
+
+        OutputAliasing::OutputAliasing(Graph* graph) {
+            _graph = graph;
+            auto mapped = graph->getMapped();
+
+            // number of times every node output is used as input
+            std::map<std::pair<int, int>, int> uses;
+            for (auto const& v : *mapped) {
+                auto node = v.second;
+
+                // rewinds and branches make lifetimes of arrays unpredictable
+                if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->isDivergencePoint()) {
+                    _enabled = false;
+                    return;
+                }
+
+                for (auto const& in : *node->input())
+                    uses[in]++;
+            }
+
+            auto outputs = graph->output();
+            auto isOutput = [&] (int id) -> bool {
+                return std::find(outputs->begin(), outputs->end(), id) != outputs->end();
+            };
+
+            for (auto const& v : *mapped) {
+                auto node = v.second;
+                // join/split node itself may be graph output: its result is a standalone array or view of live input
+                if (isInplaceNode(node))
+                    continue;
+
+                if (isOpNode(node, "concat") || isOpNode(node, "stack")) {
+                    for (int e = 0; e < (int) node->input()->size(); e++) {
+                        auto in = node->input()->at(e);
+                        if (mapped->count(in.first) == 0 || uses[in] != 1)
+                            continue;
+
+                        auto producer = mapped->at(in.first);
+                        if (!producer->hasCustomOp() || isInplaceNode(producer) || producer->hasExternalOutputs() || isOutput(producer->id()))
+                            continue;
+
+                        _slots[in] = {node, e};
+                        _producers[in.first].emplace_back(in.second);
+                    }
+                } else if (isOpNode(node, "split") || isOpNode(node, "unstack")) {
+                    // views are safe only if neither input nor outputs of split are modified in place later
+                    bool safe = true;
+                    for (auto const& u : *mapped) {
+                        if (!isInplaceNode(u.second))
+                            continue;
+
+                        for (auto const& in : *u.second->input()) {
+                            bool readsInput = std::find(node->input()->begin(), node->input()->end(), in) != node->input()->end();
+                            if (in.first == node->id() || readsInput)
+                                safe = false;
+                        }
+                    }
+
+                    for (auto const& in : *node->input())
+                        if (isOutput(in.first))
+                            safe = false;
+
+                    if (safe)
+                        _splits.insert(node->id());
+                }
+            }
+        }
+
+        int OutputAliasing::numberOfJoinSlots() const {
+            return _enabled ? (int) _slots.size() : 0;
+        }
+
+        bool OutputAliasing::isAvailable(VariableSpace* variableSpace, std::pair<int, int> pair) {
+            return variableSpace->hasVariable(pair) && variableSpace->getVariable(pair)->hasNDArray();
+        }
+
+        bool OutputAliasing::evalOutputShapes(Node* node, VariableSpace* variableSpace, std::vector<std::vector<Nd4jLong>>& shapes, std::vector<nd4j::DataType>& dtypes) {
+            ShapeList inSha;
+            for (auto in : *node->input()) {
+                if (!variableSpace->hasVariable(in))
+                    return false;
+
+                auto var = variableSpace->getVariable(in);
+                if (var->variableType() != VariableType::NDARRAY)
+                    continue;
+
+                // inputs aren't computed yet
+                if (!var->hasNDArray())
+                    return false;
+
+                inSha.push_back(var->getNDArray()->getShapeInfo());
+            }
+
+            Context ctx(node->getContextPrototype(), variableSpace);
+            ShapeList* outSha = nullptr;
+            try {
+                outSha = node->getCustomOp()->calculateOutputShape(&inSha, ctx);
+            } catch (std::exception &e) {
+                // node will report it properly once executed
+                return false;
+            }
+
+            bool result = true;
+            for (auto shapeInfo : *outSha->asVector()) {
+                if (ArrayOptions::arrayType(shapeInfo) == ArrayType::EMPTY || (shape::rank(shapeInfo) > 1 && shape::order(shapeInfo) != 'c'))
+                    result = false;
+
+                shapes.emplace_back(shape::shapeOf(shapeInfo), shape::shapeOf(shapeInfo) + shape::rank(shapeInfo));
+                dtypes.emplace_back(ArrayOptions::dataType(shapeInfo));
+            }
+
+            outSha->destroy();
+            delete outSha;
+
+            return result;
+        }
+
+        void OutputAliasing::planJoin(Node* join, VariableSpace* variableSpace) {
+            const int numInputs = join->input()->size();
+            std::vector<std::vector<Nd4jLong>> inShapes(numInputs);
+            std::vector<nd4j::DataType> inTypes(numInputs);
+            std::vector<bool> aliased(numInputs, false);
+
+            for (int e = 0; e < numInputs; e++) {
+                auto in = join->input()->at(e);
+
+                if (isAvailable(variableSpace, in)) {
+                    auto array = variableSpace->getVariable(in)->getNDArray();
+                    if (array->isEmpty()) {
+                        _planned.insert(join->id());
+                        return;
+                    }
+
+                    inShapes[e] = array->getShapeAsVector();
+                    inTypes[e] = array->dataType();
+                    continue;
+                }
+
+                // shape of input produced later can be evaluated only if that producer has all of its inputs already
+                auto slot = _slots.find(in);
+                if (slot == _slots.end() || slot->second.join != join)
+                    return;
+
+                std::vector<std::vector<Nd4jLong>> shapes;
+                std::vector<nd4j::DataType> dtypes;
+                if (!evalOutputShapes(_graph->getMapped()->at(in.first), variableSpace, shapes, dtypes))
+                    return;
+
+                if (in.second >= (int) shapes.size()) {
+                    _planned.insert(join->id());
+                    return;
+                }
+
+                inShapes[e] = shapes[in.second];
+                inTypes[e] = dtypes[in.second];
+                aliased[e] = true;
+            }
+
+            // from now on result doesn't depend on execution progress anymore
+            _planned.insert(join->id());
+
+            auto iArgs = join->getContextPrototype()->getIArguments();
+            const int rank = inShapes[0].size();
+            const bool isStack = isOpNode(join, "stack");
+            int axis = iArgs->size() > 0 ? iArgs->at(0) : 0;
+            if (axis < 0)
+                axis += isStack ? rank + 1 : rank;
+
+            if (!isStack && (iArgs->empty() || rank == 0))
+                return;
+
+            if (axis < 0 || axis > rank || (!isStack && axis == rank))
+                return;
+
+            std::vector<Nd4jLong> outShape(inShapes[0]);
+            for (int e = 1; e < numInputs; e++) {
+                if (inTypes[e] != inTypes[0] || inShapes[e].size() != inShapes[0].size())
+                    return;
+
+                for (int d = 0; d < rank; d++)
+                    if (inShapes[e][d] != inShapes[0][d] && (isStack || d != axis))
+                        return;
+
+                if (!isStack)
+                    outShape[axis] += inShapes[e][axis];
+            }
+
+            if (isStack)
+                outShape.insert(outShape.begin() + axis, numInputs);
+
+            // slices along axis are contiguous only if everything before axis is unity
+            for (int d = 0; d < axis; d++)
+                if (outShape[d] != 1)
+                    return;
+
+            std::pair<int, int> joinPair(join->id(), 0);
+            Context joinCtx(join->getContextPrototype(), variableSpace);
+            NDArray* output = nullptr;
+
+            if (isAvailable(variableSpace, joinPair)) {
+                output = variableSpace->getVariable(joinPair)->getNDArray();
+                if (output->ordering() != 'c' || output->ews() != 1 || output->dataType() != inTypes[0] || output->getShapeAsVector() != outShape)
+                    return;
+            } else {
+                output = new NDArray('c', outShape, inTypes[0], joinCtx.getWorkspace());
+                joinCtx.pushNDArrayToVariableSpace(joinPair, output);
+            }
+
+            Nd4jLong offset = 0;
+            for (int e = 0; e < numInputs; e++) {
+                auto in = join->input()->at(e);
+
+                if (aliased[e] && !isAvailable(variableSpace, in)) {
+                    auto view = new NDArray(output->bufferWithOffset(offset), 'c', inShapes[e], inTypes[e]);
+
+                    Context ctx(_graph->getMapped()->at(in.first)->getContextPrototype(), variableSpace);
+                    ctx.pushNDArrayToVariableSpace(in, view);
+
+                    nd4j_debug("Node_%i:%i writes into Node_%i output directly\n", in.first, in.second, join->id());
+                }
+
+                offset += shape::prodLong(inShapes[e].data(), inShapes[e].size());
+            }
+        }
+
+        void OutputAliasing::planSplit(Node* split, VariableSpace* variableSpace) {
+            auto iArgs = split->getContextPrototype()->getIArguments();
+            auto inputs = split->input();
+            if (iArgs->empty() || inputs->empty())
+                return;
+
+            for (auto in : *inputs)
+                if (!isAvailable(variableSpace, in))
+                    return;
+
+            // input and axis are resolved exactly as ops do it
+            NDArray* input = variableSpace->getVariable(inputs->at(0))->getNDArray();
+            int axis = 0;
+
+            if (isOpNode(split, "unstack")) {
+                axis = iArgs->at(0);
+            } else {
+                if (inputs->size() > 1) {
+                    auto a = input;
+                    auto b = variableSpace->getVariable(inputs->at(1))->getNDArray();
+
+                    if (a->isScalar()) {
+                        axis = a->e<int>(0);
+                        input = b;
+                    } else if (b->isScalar()) {
+                        axis = b->e<int>(0);
+                    } else
+                        return;
+                }
+
+                if (iArgs->size() == 2)
+                    axis = iArgs->at(1);
+            }
+
+            if (axis < 0)
+                axis += input->rankOf();
+
+            if (axis < 0 || axis >= input->rankOf() || input->ordering() != 'c' || input->ews() != 1 || input->isEmpty() || input->isS())
+                return;
+
+            for (int d = 0; d < axis; d++)
+                if (input->sizeAt(d) != 1)
+                    return;
+
+            std::vector<std::vector<Nd4jLong>> shapes;
+            std::vector<nd4j::DataType> dtypes;
+            if (!evalOutputShapes(split, variableSpace, shapes, dtypes) || shapes.empty())
+                return;
+
+            const Nd4jLong numOutputs = shapes.size();
+            const Nd4jLong length = input->lengthOf() / numOutputs;
+            if (length * numOutputs != input->lengthOf())
+                return;
+
+            for (int e = 0; e < numOutputs; e++)
+                if (dtypes[e] != input->dataType() || shape::prodLong(shapes[e].data(), shapes[e].size()) != length)
+                    return;
+
+            Context ctx(split->getContextPrototype(), variableSpace);
+            for (int e = 0; e < numOutputs; e++) {
+                std::pair<int, int> pair(split->id(), e);
+                if (isAvailable(variableSpace, pair))
+                    continue;
+
+                ctx.pushNDArrayToVariableSpace(pair, new NDArray(input->bufferWithOffset(e * length), 'c', shapes[e], dtypes[e]));
+            }
+
+            nd4j_debug("Node_%i outputs are views of its input\n", split->id());
+        }
+
+        void OutputAliasing::prepare(Node* node, VariableSpace* variableSpace) {
+            if (!_enabled)
+                return;
+
+            auto producer = _producers.find(node->id());
+            if (producer != _producers.end()) {
+                for (auto idx : producer->second) {
+                    auto join = _slots.at(std::pair<int, int>(node->id(), idx)).join;
+                    if (_planned.count(join->id()) == 0)
+                        planJoin(join, variableSpace);
+                }
+            }
+
+            if (_splits.count(node->id()) > 0)
+                planSplit(node, variableSpace);
+        }
+    }
+}
@@ -57,11 +57,19 @@ namespace nd4j {
             result->_external = this->_external;
             result->_id = this->_id;
             result->_readOnly = this->_readOnly;
+            result->_constant = this->_constant;
             result->_name = this->_name;
             result->_index = this->_index;
 
-            if (this->_ndarray != nullptr)
-                result->_ndarray = this->_ndarray->dup(this->_ndarray->ordering());
+            if (this->_ndarray != nullptr) {
+                if (_referenced) {
+                    // mapped weights are shared by all clones instead of being copied to heap on every execution
+                    result->_ndarray = new NDArray(_ndarray->buffer(), shape::copyShape(_ndarray->shapeInfo()));
+                    result->_ndarray->triggerAllocationFlag(false, true);
+                    result->_referenced = true;
+                } else
+                    result->_ndarray = this->_ndarray->dup(this->_ndarray->ordering());
+            }
 
             if (this->_list != nullptr)
                 result->_list = this->_list->clone();
@@ -171,6 +179,18 @@ namespace nd4j {
             return _removable;
         }
 
+        bool Variable::isConstant() {
+            return _constant;
+        }
+
+        bool Variable::isReferenced() {
+            return _referenced;
+        }
+
+        void Variable::markConstant(bool reallyConstant) {
+            _constant = reallyConstant;
+        }
+
         
         void nd4j::graph::Variable::setNDArrayList(nd4j::NDArrayList * list) {
             this->_variableType = VariableType::ARRAY_LIST;
@@ -189,7 +209,7 @@ namespace nd4j {
         }
 
         
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -208,8 +228,12 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
+                            _referenced = zeroCopy && nd4j::graph::FlatUtils::canReference(ar);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
+
+                            // referenced buffers aren't owned
+                            if (!_referenced)
+                                _ndarray->triggerAllocationFlag(true, true);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -220,14 +244,14 @@ namespace nd4j {
                             throw std::runtime_error("CONSTANT variable must have NDArray bundled");
 
                         auto ar = flatVariable->ndarray();
-                        if (ar->dtype() == DataType_UTF8) {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        }
-                        _ndarray->triggerAllocationFlag(true, true);
+                        _referenced = zeroCopy && nd4j::graph::FlatUtils::canReference(ar);
+                        _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
+
+                        if (!_referenced)
+                            _ndarray->triggerAllocationFlag(true, true);
 
                         _variableType = VariableType::NDARRAY;
+                        _constant = true;
                     }
                     break;
                 case VarType_ARRAY: {
@@ -319,10 +343,17 @@ namespace nd4j {
                 auto array = this->getNDArray();
                 auto fShape = builder.CreateVector(array->getShapeInfoAsFlatVector());
 
-                auto fBuffer = builder.CreateVector(array->asByteVector());
+                auto bytes = array->asByteVector();
+
+                // aligned buffer in native byte order can be referenced in place after import, see FlatUtils::fromFlatArray.
+                // vector data is aligned relative to the end of the buffer, and minimal alignment makes whole buffer size its multiple,
+                // so data ends up aligned relative to the beginning of the file as well
+                builder.TrackMinAlign(FlatUtils::BUFFER_ALIGNMENT);
+                builder.PreAlign(bytes.size(), FlatUtils::BUFFER_ALIGNMENT);
+                auto fBuffer = builder.CreateVector(bytes);
 
                 // packing array
-                auto fArray = CreateFlatArray(builder, fShape, fBuffer, (nd4j::graph::DataType) array->dataType());
+                auto fArray = CreateFlatArray(builder, fShape, fBuffer, (nd4j::graph::DataType) array->dataType(), BitwiseUtils::isBE() ? nd4j::graph::ByteOrder_BE : nd4j::graph::ByteOrder_LE);
 
                 // packing id/index of this var
                 auto fVid = CreateIntPair(builder, this->_id, this->_index);
@@ -232,6 +232,22 @@ namespace nd4j {
             return _current->flowPath();
         }
 
+        int VariableProxy::reserveSlot(std::pair<int,int>& pair) {
+            return _backed->reserveSlot(pair);
+        }
+
+        int VariableProxy::slotOf(std::pair<int,int>& pair) {
+            return _backed->slotOf(pair);
+        }
+
+        Variable* VariableProxy::slotVariable(int slot, std::pair<int,int>& pair) {
+            // slots belong to backed space, local variables shadow them
+            if (_current->hasVariable(pair))
+                return _current->getVariable(pair);
+
+            return _backed->slotVariable(slot, pair);
+        }
+
         
         void VariableProxy::putOutputVariable(Variable *variable) {
             _current->putOutputVariable(variable);
@@ -20,6 +20,7 @@
 
 #include <graph/VariableSpace.h>
 #include <NativeOps.h>
+#include <limits>
 
 namespace nd4j {
     namespace graph {
@@ -34,6 +35,11 @@ namespace nd4j {
         nd4j::graph::VariableSpace* nd4j::graph::VariableSpace::clone() {
             auto result = new VariableSpace();
 
+            // slot indices are shared with prototypes of graph nodes, so clone keeps them as is
+            result->_slotIds = _slotIds;
+            result->_slotPairs = _slotPairs;
+            result->_slots.resize(_slots.size(), nullptr);
+
             for (auto const& x : _paired) {
                 std::pair<int, int> pair(x.first.first, x.first.second);
 
@@ -79,6 +85,8 @@ namespace nd4j {
             this->_paired[pair] = variable;
 
             this->_handles->push_back(variable);
+
+            refreshSlots(pair.first);
         }
 
         std::vector<nd4j::graph::Variable*> * nd4j::graph::VariableSpace::getPlaceholders() {
@@ -231,6 +239,8 @@ namespace nd4j {
             //std::pair<std::pair<int, int>, nd4j::graph::Variable *> p(pair, variable);
             _paired[pair] = variable;
 
+            refreshSlots(pair.first);
+
             _varmap.unlock();
         }
 
@@ -303,6 +313,8 @@ namespace nd4j {
                 _temporary[id] = variable;
             }
 
+            refreshSlots(id);
+
             _varmap.unlock();
 
             std::pair<int,int> pair(id, 0);
@@ -374,6 +386,10 @@ namespace nd4j {
         VariableSpace& VariableSpace::operator=(const VariableSpace& other) {
             if (this == &other) return *this;
 
+            _slotIds = other._slotIds;
+            _slotPairs = other._slotPairs;
+            _slots.resize(other._slots.size(), nullptr);
+
             for (auto const& x : other._paired) {
                 std::pair<int, int> pair(x.first.first, x.first.second);
 
@@ -394,6 +410,8 @@ namespace nd4j {
                 this->_handles->push_back(clonedVar);
             }
 
+            refreshSlots();
+
             return *this;
         }
 
@@ -452,6 +470,66 @@ namespace nd4j {
             return _flow;
         }
 
+        Variable* VariableSpace::resolveSlot(const std::pair<int,int>& pair) {
+            // same rules as getVariable(pair), but missing pair gives nullptr instead of exception
+            auto it = _paired.find(pair);
+            if (it == _paired.end())
+                return nullptr;
+
+            if (pair.first < 0) {
+                auto vt = _variables.find(pair.first);
+                return vt == _variables.end() ? nullptr : vt->second;
+            }
+
+            return it->second;
+        }
+
+        void VariableSpace::refreshSlots(int id) {
+            if (_slotIds.empty())
+                return;
+
+            std::pair<int, int> first(id, std::numeric_limits<int>::min());
+            for (auto it = _slotIds.lower_bound(first); it != _slotIds.end() && it->first.first == id; ++it)
+                _slots[it->second] = resolveSlot(it->first);
+        }
+
+        void VariableSpace::refreshSlots() {
+            for (auto const& x : _slotIds)
+                _slots[x.second] = resolveSlot(x.first);
+        }
+
+        int VariableSpace::reserveSlot(std::pair<int,int>& pair) {
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            auto it = _slotIds.find(pair);
+            if (it != _slotIds.end())
+                return it->second;
+
+            int slot = static_cast<int>(_slots.size());
+            _slotIds[pair] = slot;
+            _slotPairs.emplace_back(pair);
+            _slots.emplace_back(resolveSlot(pair));
+
+            return slot;
+        }
+
+        int VariableSpace::slotOf(std::pair<int,int>& pair) {
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            auto it = _slotIds.find(pair);
+            return it == _slotIds.end() ? -1 : it->second;
+        }
+
+        Variable* VariableSpace::slotVariable(int slot, std::pair<int,int>& pair) {
+            // reserveSlot() may grow slot storage concurrently
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            if (slot < 0 || slot >= static_cast<int>(_slots.size()) || _slotPairs[slot] != pair)
+                return nullptr;
+
+            return _slots[slot];
+        }
+
         VariableSpace::VariableSpace() {
             _handles = new std::vector<Variable *>;
         }
@@ -30,6 +30,8 @@
 #include <helpers/benchmark/DeclarableBenchmark.h>
 #include <helpers/benchmark/MatrixBenchmark.h>
 #include <helpers/benchmark/BroadcastBenchmark.h>
+#include <helpers/benchmark/SortBenchmark.h>
+#include <helpers/benchmark/BenchmarkReport.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <graph/Context.h>
 #include <NDArray.h>
@@ -48,6 +50,7 @@ namespace nd4j {
     private:
         unsigned int _wIterations;
         unsigned int _rIterations;
+        BenchmarkReport *_report = nullptr;
 
     protected:
         void benchmarkOperation(OpBenchmark &benchmark);
@@ -62,6 +65,16 @@ namespace nd4j {
     public:
         BenchmarkHelper(unsigned int warmUpIterations = 10, unsigned int runIterations = 100);
 
+        /**
+         * If report is attached, results of every benchmarked operation are accumulated there, in addition to console output
+         */
+        void setReport(BenchmarkReport *report);
+
+        /**
+         * This method runs warmup + measured iterations of given benchmark, and returns timing summary without printing anything
+         */
+        BenchmarkResult measure(OpBenchmark &benchmark);
+
         void runOperationSuit(std::initializer_list<OpBenchmark*> benchmarks, const char *msg = nullptr);
         void runOperationSuit(std::vector<OpBenchmark*> &benchmarks, bool postHeaders, const char *msg = nullptr);
 
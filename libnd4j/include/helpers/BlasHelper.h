@@ -142,6 +142,18 @@ namespace nd4j {
                            double* u, int ldu, double* vt,
                            int ldvt);
 
+    typedef int (*LapackeSgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n,
+                           float* a, int lda, int* ipiv);
+
+    typedef int (*LapackeDgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n,
+                           double* a, int lda, int* ipiv);
+
+    typedef int (*LapackeSpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n,
+                           float* a, int lda);
+
+    typedef int (*LapackeDpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n,
+                           double* a, int lda);
+
     typedef cublasStatus_t (CUBLASWINAPI *CublasSgemv)(cublasHandle_t handle, 
                                                       cublasOperation_t trans, 
                                                       int m, 
@@ -388,6 +400,10 @@ namespace nd4j {
         LapackeDgesvd lapackeDgesvd;
         LapackeSgesdd lapackeSgesdd;
         LapackeDgesdd lapackeDgesdd;
+        LapackeSgetrf lapackeSgetrf = nullptr;
+        LapackeDgetrf lapackeDgetrf = nullptr;
+        LapackeSpotrf lapackeSpotrf = nullptr;
+        LapackeDpotrf lapackeDpotrf = nullptr;
 
         CublasSgemv cublasSgemv;
         CublasDgemv cublasDgemv;
@@ -406,7 +422,14 @@ namespace nd4j {
     public:
         static BlasHelper* getInstance();
 
-        void initializeFunctions(Nd4jPointer *functions);
+        // number of slots in function table before LAPACKE getrf/potrf were added
+        static const int LEGACY_FUNCTIONS = 10;
+
+        /**
+         * This method picks BLAS/LAPACK functions from the table passed by backend. Slots that follow LEGACY_FUNCTIONS
+         * are read only if numFunctions says they are there
+         */
+        void initializeFunctions(Nd4jPointer *functions, int numFunctions = LEGACY_FUNCTIONS);
 		void initializeDeviceFunctions(Nd4jPointer *functions);
 
         template <typename T>
@@ -435,6 +458,13 @@ namespace nd4j {
 
         LapackeSgesdd sgesdd();
         LapackeDgesdd dgesdd();
+
+        // LU and Cholesky factorizations, nullptr if LAPACK isn't available
+        LapackeSgetrf sgetrf();
+        LapackeDgetrf dgetrf();
+
+        LapackeSpotrf spotrf();
+        LapackeDpotrf dpotrf();
         
         // destructor
         ~BlasHelper() noexcept; 
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CONTIGUOUSBUFFER_H
+#define LIBND4J_CONTIGUOUSBUFFER_H
+
+#include <NDArray.h>
+
+namespace nd4j {
+    /**
+     * Holder of c-ordered contiguous array of given data type, used by cpu kernels working on raw buffers.
+     * Original array is used as is if it fits already, otherwise temporary copy is created,
+     * and written back into original array on destruction if requested
+     */
+    class ND4J_EXPORT ContiguousBuffer {
+    private:
+        NDArray* _original;
+        NDArray* _array;
+        bool _writeBack;
+    public:
+        ContiguousBuffer(const NDArray* array, nd4j::DataType dataType, bool writeBack = false);
+        ContiguousBuffer(const NDArray& array, nd4j::DataType dataType, bool writeBack = false);
+        ~ContiguousBuffer();
+
+        ContiguousBuffer(const ContiguousBuffer& other) = delete;
+        ContiguousBuffer& operator=(const ContiguousBuffer& other) = delete;
+
+        template <typename T>
+        T* buffer() {
+            return reinterpret_cast<T*>(_array->getBuffer());
+        }
+
+        NDArray* array();
+
+        /**
+         * This method returns true if temporary copy was created
+         */
+        bool isCopy();
+    };
+}
+
+#endif //LIBND4J_CONTIGUOUSBUFFER_H
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HALFCONVERSIONS_H
+#define LIBND4J_HALFCONVERSIONS_H
+
+#include <type_traits>
+#include <pointercast.h>
+#include <dll.h>
+#include <op_boilerplate.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+
+namespace nd4j {
+
+    /**
+     * Bulk conversions between fp32 and 16-bit floating point types.
+     *
+     * float16 conversions use F16C (8 elements per instruction) or AVX-512 (16 elements) when available,
+     * bfloat16 conversions are plain integer arithmetic which compiler vectorizes for any SIMD extension.
+     * Results are bit-identical to element-wise float16/bfloat16 conversions. All methods are single-threaded,
+     * callers are expected to split work.
+     */
+    class ND4J_EXPORT HalfConversions {
+    public:
+        // number of elements converted per staging buffer in mixed precision loops
+        static const int CHUNK = 1024;
+
+        static void toFloat(const float16 *x, float *z, Nd4jLong length);
+        static void fromFloat(const float *x, float16 *z, Nd4jLong length);
+
+        static void toFloat(const bfloat16 *x, float *z, Nd4jLong length);
+        static void fromFloat(const float *x, bfloat16 *z, Nd4jLong length);
+
+        /**
+         * Generic fallbacks, so templated code can stage any type through fp32 buffer
+         */
+        template <typename T>
+        static void toFloat(const T *x, float *z, Nd4jLong length) {
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = static_cast<float>(x[e]);
+        }
+
+        template <typename T>
+        static void fromFloat(const float *x, T *z, Nd4jLong length) {
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = static_cast<T>(x[e]);
+        }
+
+        /**
+         * This method returns true if T is 16-bit floating point type, which benefits from fp32 staging
+         */
+        template <typename T>
+        static FORCEINLINE bool isHalfType() {
+            return std::is_same<T, float16>::value || std::is_same<T, bfloat16>::value;
+        }
+    };
+}
+
+#endif //LIBND4J_HALFCONVERSIONS_H
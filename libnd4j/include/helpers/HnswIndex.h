@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HNSWINDEX_H
+#define LIBND4J_HNSWINDEX_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/MappedFile.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+namespace nd4j {
+
+    /**
+     * Approximate nearest neighbors index over fp32 vectors: Hierarchical Navigable Small World graph.
+     *
+     * Vectors get sequential ids in order of insertion. add() builds graph with all available threads, search() processes
+     * queries in parallel. search() must not be called concurrently with add().
+     *
+     * Metrics follow knn_topk op: 0 - euclidean, 1 - cosine (1 - cos), 2 - dot product (higher is better)
+     *
+     * save() writes flat binary file, load() maps it into memory, so vectors and links are never copied unless index grows.
+     */
+    class ND4J_EXPORT HnswIndex {
+    protected:
+        int _dimensions;
+        int _metric;
+        int _M;
+        int _M0;
+        int _efConstruction;
+        Nd4jLong _seed;
+        double _levelMult;
+
+        Nd4jLong _size = 0;
+        Nd4jLong _capacity = 0;
+
+        int _maxLevel = -1;
+        Nd4jLong _entryPoint = -1;
+
+        // views: either point into owned storage below, or into mapped file
+        float *_vectors = nullptr;
+        int *_links0 = nullptr;
+        int *_levels = nullptr;
+        std::vector<int *> _upper;
+
+        std::vector<float> _ownedVectors;
+        std::vector<int> _ownedLinks0;
+        std::vector<int> _ownedLevels;
+        std::vector<std::unique_ptr<int[]>> _ownedUpper;
+
+        std::unique_ptr<graph::MappedFile> _file;
+
+        std::mutex _global;
+        std::unique_ptr<std::mutex[]> _locks;
+
+        class VisitedPool;
+        std::unique_ptr<VisitedPool> _visited;
+
+        HnswIndex() = default;
+
+        void reserve(Nd4jLong capacity);
+        int randomLevel(Nd4jLong id);
+        void insert(Nd4jLong id);
+
+        float distance(const float *x, Nd4jLong id) const;
+        float distance(Nd4jLong a, Nd4jLong b) const;
+
+        int *links(Nd4jLong id, int level) const;
+        int maxLinks(int level) const;
+        std::mutex &lock(Nd4jLong id) const;
+
+        Nd4jLong greedy(const float *x, Nd4jLong entry, int fromLevel, int toLevel, bool locking) const;
+        void searchLayer(const float *x, Nd4jLong entry, int ef, int level, bool locking, std::vector<std::pair<float, Nd4jLong>> &result) const;
+        void selectNeighbors(std::vector<std::pair<float, Nd4jLong>> &candidates, int M) const;
+
+    public:
+        static const int METRIC_EUCLIDEAN = 0;
+        static const int METRIC_COSINE = 1;
+        static const int METRIC_DOT = 2;
+
+        /**
+         * @param dimensions - length of each vector
+         * @param metric - one of METRIC_* constants
+         * @param M - number of links per node on upper layers, layer 0 gets 2 * M
+         * @param efConstruction - size of candidates list used during insertion
+         * @param capacity - number of vectors to preallocate storage for, index grows when exceeded
+         * @param seed - seed for level generation, construction is deterministic for a given seed and single thread
+         */
+        HnswIndex(int dimensions, int metric, int M = 16, int efConstruction = 200, Nd4jLong capacity = 0, Nd4jLong seed = 119);
+        ~HnswIndex();
+
+        HnswIndex(const HnswIndex &other) = delete;
+        HnswIndex& operator=(const HnswIndex &other) = delete;
+
+        /**
+         * This method adds numVectors row-major vectors to the index
+         */
+        void add(const float *vectors, Nd4jLong numVectors);
+
+        /**
+         * This method finds k approximate nearest neighbors for each query.
+         * ids and distances are [numQueries, k], sorted from best to worst. Missing results are filled with -1 ids.
+         *
+         * @param ef - size of candidates list, values below k are raised to k
+         */
+        void search(const float *queries, Nd4jLong numQueries, int k, int ef, Nd4jLong *ids, float *distances) const;
+
+        void save(const char *fileName) const;
+
+        /**
+         * This method maps index saved by save(). Throws std::runtime_error if file is malformed, i.e. any link, level or offset is out of range
+         */
+        static HnswIndex* load(const char *fileName);
+
+        Nd4jLong size() const;
+        int dimensions() const;
+        int metric() const;
+
+        /**
+         * This method returns true if index data references memory mapped file
+         */
+        bool isMapped() const;
+    };
+}
+
+#endif //LIBND4J_HNSWINDEX_H
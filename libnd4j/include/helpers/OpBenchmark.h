@@ -18,6 +18,8 @@ namespace nd4j {
         NDArray *_y = nullptr;
         NDArray *_z = nullptr;
         std::vector<int> _axis;
+        double _flops = -1.0;
+        Nd4jLong _bytes = -1;
     public:
         OpBenchmark() = default;
         OpBenchmark(std::string name, NDArray *x, NDArray *y, NDArray *z);
@@ -34,6 +36,8 @@ namespace nd4j {
         void setZ(NDArray *array);
         void setAxis(std::vector<int> axis);
         void setAxis(std::initializer_list<int> axis);
+        void setFlops(double flops);
+        void setBytes(Nd4jLong bytes);
 
         NDArray& x();
         int opNum();
@@ -48,6 +52,13 @@ namespace nd4j {
         virtual std::string shape();
         virtual std::string inplace() = 0;
 
+        // these methods are used to derive GFLOP/s and GB/s figures for a single op invocation
+        virtual double flops();
+        virtual Nd4jLong bytes();
+
+        // this method is called before every iteration, outside of timed region, and restores state modified by previous iteration
+        virtual void resetOnce();
+
         virtual void executeOnce() = 0;
 
         virtual OpBenchmark* clone() = 0;
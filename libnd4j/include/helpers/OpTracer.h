@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_OP_TRACER_H
+#define LIBND4J_OP_TRACER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+
+    /**
+     * Single traced op invocation. Fixed size, so it can be stored in preallocated ring buffer without allocations
+     */
+    struct ND4J_EXPORT TraceEvent {
+        static const int MAX_NAME = 48;
+        static const int MAX_INPUTS = 4;
+        static const int MAX_DIMS = 6;
+
+        char name[MAX_NAME];
+        int opNum = -1;
+        int dataType = 0;
+        int numInputs = 0;
+        int ranks[MAX_INPUTS];
+        Nd4jLong shapes[MAX_INPUTS][MAX_DIMS];
+
+        // nanoseconds since tracer creation
+        Nd4jLong start = 0;
+        Nd4jLong end = 0;
+
+        // bytes allocated for outputs while op was running
+        Nd4jLong bytes = 0;
+        int threadId = 0;
+    };
+
+    /**
+     * Per-thread ring buffer. Only owner thread writes into it, readers use published head position.
+     * Every slot carries sequence number of event stored in it, so readers skip slots overwritten while being copied.
+     * Buffer of exited thread is handed to the next thread that starts tracing, events stored earlier stay collectable until overwritten
+     */
+    class ND4J_EXPORT OpTraceBuffer {
+    private:
+        std::vector<TraceEvent> _events;
+        std::vector<std::atomic<Nd4jLong>> _sequences;
+        std::atomic<Nd4jLong> _head;
+        std::atomic<Nd4jLong> _tail;
+        int _threadId;
+    public:
+        OpTraceBuffer(int threadId, int capacity);
+        ~OpTraceBuffer() = default;
+
+        int threadId();
+        int capacity();
+
+        // changes id reported for events pushed from now on, used when buffer is reused by another thread
+        void rebind(int threadId);
+
+        // owner thread only
+        void push(const TraceEvent &event);
+
+        // events dropped on overflow are not returned
+        void collect(std::vector<TraceEvent> &target);
+        void reset();
+    };
+
+    /**
+     * Low-overhead tracer for op entry points: DeclarableOp::execute and legacy NativeOps::exec* methods.
+     * Disabled by default, can be toggled at runtime via NativeOps::enableOpTracing or ND4J_OP_TRACE env variable.
+     * Collected events are exported in Chrome trace format, viewable in chrome://tracing or ui.perfetto.dev
+     */
+    class ND4J_EXPORT OpTracer {
+    private:
+        static OpTracer* _INSTANCE;
+
+        std::atomic<bool> _enabled;
+        std::atomic<int> _capacity;
+
+        std::mutex _lock;
+        std::vector<OpTraceBuffer*> _buffers;
+
+        // buffers released by exited threads, ready for reuse
+        std::vector<OpTraceBuffer*> _idle;
+        int _nextThreadId = 0;
+
+        Nd4jLong _origin;
+
+        OpTracer();
+        ~OpTracer();
+
+        OpTraceBuffer* localBuffer();
+    public:
+        static OpTracer* getInstance();
+
+        bool isEnabled() {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        void setEnabled(bool reallyEnable);
+
+        /**
+         * This method sets number of events stored per thread, 8192 by default. Applies to threads that didn't trace anything yet
+         */
+        void setCapacity(int capacity);
+
+        /**
+         * This method returns buffer to the pool. Called automatically on exit of every thread that traced something
+         */
+        void release(OpTraceBuffer *buffer);
+
+        /**
+         * This method returns number of per-thread buffers allocated so far, including idle ones
+         */
+        int numBuffers();
+
+        // nanoseconds since tracer creation
+        Nd4jLong now();
+
+        void record(const TraceEvent &event);
+
+        /**
+         * This method accounts memory allocated by current thread, reported as "bytes" of ops running in this thread
+         */
+        static void trackAllocation(Nd4jLong bytes);
+        static Nd4jLong allocatedBytes();
+
+        void reset();
+        std::vector<TraceEvent> events();
+
+        std::string asChromeTrace();
+        void writeChromeTrace(const char *fileName);
+    };
+
+    /**
+     * RAII helper: measures scope it was created in and stores event on destruction if tracing is enabled
+     */
+    class ND4J_EXPORT OpTraceScope {
+    private:
+        bool _active = false;
+        Nd4jLong _bytes = 0;
+        TraceEvent _event;
+    public:
+        OpTraceScope(const char *name, int opNum, Nd4jLong *xShapeInfo = nullptr, Nd4jLong *yShapeInfo = nullptr);
+        ~OpTraceScope();
+
+        bool isActive() {
+            return _active;
+        }
+
+        /**
+         * This method stores shape of one more input, ignored after TraceEvent::MAX_INPUTS
+         */
+        void addShape(Nd4jLong *shapeInfo);
+    };
+}
+
+#define ND4J_TRACE_OP(NAME, OPNUM, XSHAPE, YSHAPE) nd4j::OpTraceScope __traceScope(NAME, (int) (OPNUM), XSHAPE, YSHAPE)
+
+#endif
@@ -25,8 +25,8 @@
 #include <mutex>
 
 /**
- * This class provides PRIMITIVE read-write lock, and should NOT be used outside of GraphServer due to its inefficiency.
- * However, since GraphServer isn't supposed to have Reads/Writes ration even close to 1.0, it'll work just fine.
+ * This class provides PRIMITIVE read-write lock, and should NOT be used for anything but read-mostly data due to its inefficiency.
+ * However, since GraphServer and op shape caches aren't supposed to have Reads/Writes ration even close to 1.0, it'll work just fine.
  *
  * Basic idea: write lock won't be obtained before all read requests served
  */
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef DEV_TESTS_BENCHMARKREPORT_H
+#define DEV_TESTS_BENCHMARKREPORT_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace nd4j {
+    /**
+     * Timing summary of a single benchmarked op configuration. All timings are in microseconds.
+     */
+    struct ND4J_EXPORT BenchmarkResult {
+        std::string testName;
+        int opNum = 0;
+        std::string dataType;
+        std::string shape;
+        std::string strides;
+        std::string axis;
+        std::string orders;
+        std::string inplace;
+        std::string extra;
+
+        int threads = 1;
+        int warmup = 0;
+        int iterations = 0;
+
+        double mean = 0.0;
+        double median = 0.0;
+        double p90 = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double stdev = 0.0;
+
+        double gflops = 0.0;
+        double gbps = 0.0;
+
+        /**
+         * This method returns identifier used to match this result against baseline.
+         * Number of threads is a part of the key, so runs with different parallelism never collide
+         */
+        std::string key() const;
+    };
+
+    /**
+     * Single regression found by BenchmarkReport::compare()
+     */
+    struct ND4J_EXPORT BenchmarkRegression {
+        std::string key;
+        double baseline = 0.0;
+        double current = 0.0;
+        double tolerance = 0.0;
+
+        // current / baseline
+        double ratio() const;
+    };
+
+    /**
+     * This class accumulates benchmark results, serializes them to/from JSON and compares them against baseline
+     */
+    class ND4J_EXPORT BenchmarkReport {
+    protected:
+        std::vector<BenchmarkResult> _results;
+        std::map<std::string, std::string> _properties;
+
+        double _tolerance = 0.10;
+        double _noiseFloor = 5.0;
+        std::map<std::string, double> _tolerances;
+    public:
+        BenchmarkReport() = default;
+        ~BenchmarkReport() = default;
+
+        void addResult(const BenchmarkResult &result);
+        std::vector<BenchmarkResult>& results();
+
+        /**
+         * Free-form key/value pairs written to the report header, i.e. build id or host name
+         */
+        void setProperty(const std::string &key, const std::string &value);
+        std::string property(const std::string &key);
+
+        /**
+         * Relative slowdown of median time allowed before result is reported as regression, 0.10 means 10%
+         */
+        void setTolerance(double tolerance);
+
+        /**
+         * Tolerance override for all tests with names starting with given prefix. Longest prefix wins.
+         */
+        void setTolerance(const std::string &prefix, double tolerance);
+        double toleranceFor(const std::string &testName);
+
+        /**
+         * Absolute difference in microseconds below which timings are treated as noise
+         */
+        void setNoiseFloor(double microseconds);
+
+        std::string asJson();
+        void writeJson(const char *fileName);
+
+        /**
+         * These methods restore report from JSON produced by asJson()/writeJson()
+         */
+        static BenchmarkReport fromJson(const std::string &json);
+        static BenchmarkReport readJson(const char *fileName);
+
+        /**
+         * This method compares median timings of this report against baseline,
+         * and returns all results that got slower than allowed tolerance
+         */
+        std::vector<BenchmarkRegression> compare(BenchmarkReport &baseline);
+
+        /**
+         * This method returns keys of baseline results that weren't measured in this report
+         */
+        std::vector<std::string> missing(BenchmarkReport &baseline);
+    };
+}
+
+#endif //DEV_TESTS_BENCHMARKREPORT_H
@@ -27,22 +27,40 @@
 #include <OpBenchmark.h>
 #include <declarable/DeclarableOp.h>
 #include <declarable/OpRegistrator.h>
+#include <functional>
 
 namespace nd4j {
     class ND4J_EXPORT DeclarableBenchmark : public OpBenchmark  {
     protected:
         nd4j::ops::DeclarableOp *_op = nullptr;
         nd4j::graph::Context *_context = nullptr;
+        std::function<void()> _reset;
     public:
         DeclarableBenchmark(nd4j::ops::DeclarableOp &op, std::string name = 0) : OpBenchmark() {
             _op = ops::OpRegistrator::getInstance()->getOperation(op.getOpHash());
             _testName = name;
         }
 
+        DeclarableBenchmark(nd4j::ops::DeclarableOp &op, std::string name, nd4j::graph::Context *ctx) : DeclarableBenchmark(op, name) {
+            _context = ctx;
+        }
+
         void setContext(nd4j::graph::Context *ctx) {
             _context = ctx;
         }
 
+        /**
+         * Optional callback executed before every iteration, i.e. to restore output of accumulating in-place ops
+         */
+        void setReset(std::function<void()> reset) {
+            _reset = reset;
+        }
+
+        void resetOnce() override {
+            if (_reset)
+                _reset();
+        }
+
         std::string axis() override {
             return "N/A";
         }
@@ -81,6 +99,38 @@ namespace nd4j {
             return "N/A";
         }
 
+        double flops() override {
+            if (_flops >= 0.0 || _context == nullptr || !_context->isFastPath())
+                return _flops >= 0.0 ? _flops : 0.0;
+
+            // there's no generic way to count flops for custom op, so we fall back to output length
+            Nd4jLong length = 0;
+            for (auto v : _context->fastpath_out())
+                if (v != nullptr)
+                    length += v->lengthOf();
+
+            return static_cast<double>(length);
+        }
+
+        Nd4jLong bytes() override {
+            if (_bytes >= 0)
+                return _bytes;
+
+            if (_context == nullptr || !_context->isFastPath())
+                return 0;
+
+            Nd4jLong result = 0;
+            for (auto v : _context->fastpath_in())
+                if (v != nullptr)
+                    result += v->lengthOf() * v->sizeOfT();
+
+            for (auto v : _context->fastpath_out())
+                if (v != nullptr)
+                    result += v->lengthOf() * v->sizeOfT();
+
+            return result;
+        }
+
         void executeOnce() override {
             _op->execute(_context);
         }
@@ -79,6 +79,18 @@ namespace nd4j {
             return "N/A";
         }
 
+        double flops() override {
+            if (_flops >= 0.0)
+                return _flops;
+
+            // C[M, N] = A[M, K] x B[K, N] costs one multiply and one add per inner product element
+            auto m = _tA ? _x->sizeAt(1) : _x->sizeAt(0);
+            auto k = _tA ? _x->sizeAt(0) : _x->sizeAt(1);
+            auto n = _tB ? _y->sizeAt(0) : _y->sizeAt(1);
+
+            return 2.0 * m * n * k;
+        }
+
         std::string inplace() override {
             return "N/A";
         }
@@ -117,6 +129,7 @@ namespace nd4j {
             MatrixBenchmark* mb = new MatrixBenchmark(_alpha, _beta, _testName, _x, _y, _z);
             mb->_tA = _tA;
             mb->_tB = _tB;
+            mb->_flops = _flops;
             return mb;
         }
     };
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/StringUtils.h>
+#include <helpers/ConstantTadHelper.h>
+#include "../OpBenchmark.h"
+#include <cmath>
+
+#ifndef DEV_TESTS_SORTBENCHMARK_H
+#define DEV_TESTS_SORTBENCHMARK_H
+
+namespace nd4j {
+    /**
+     * This benchmark sorts X in place. Since sorting already sorted data isn't representative,
+     * Y holds untouched copy of the original X, and it's copied back into X before every run.
+     */
+    class ND4J_EXPORT SortBenchmark : public OpBenchmark {
+    protected:
+        bool _descending = false;
+    public:
+        SortBenchmark() : OpBenchmark() {
+            //
+        }
+
+        SortBenchmark(std::string testName, NDArray *x, bool descending) : OpBenchmark(testName, x, x->dup(), nullptr) {
+            _descending = descending;
+        }
+
+        SortBenchmark(std::string testName, NDArray *x, std::vector<int> axis, bool descending) : OpBenchmark(testName, x, x->dup(), nullptr, axis) {
+            _descending = descending;
+        }
+
+        ~SortBenchmark(){
+            delete _x;
+            delete _y;
+        }
+
+        void executeOnce() override {
+            memcpy(_x->buffer(), _y->buffer(), _x->lengthOf() * _x->sizeOfT());
+
+            if (_axis.empty()) {
+                NativeOpExcutioner::execSort(_x->buffer(), _x->shapeInfo(), _descending);
+            } else {
+                auto packX = ConstantTadHelper::getInstance()->tadForDimensions(_x->shapeInfo(), _axis);
+                NativeOpExcutioner::execSort(_x->buffer(), _x->shapeInfo(), _axis.data(), _axis.size(), packX.primaryShapeInfo(), packX.primaryOffsets(), _descending);
+            }
+        }
+
+        double flops() override {
+            if (_flops >= 0.0)
+                return _flops;
+
+            // n * log2(n) comparisons per sorted sequence
+            Nd4jLong n = _axis.empty() ? _x->lengthOf() : shape::tadLength(_x->shapeInfo(), _axis.data(), _axis.size());
+            Nd4jLong numSequences = _x->lengthOf() / n;
+
+            return static_cast<double>(numSequences) * n * std::log2(static_cast<double>(n));
+        }
+
+        Nd4jLong bytes() override {
+            if (_bytes >= 0)
+                return _bytes;
+
+            // restoring copy + sorting pass
+            return 3 * _x->lengthOf() * _x->sizeOfT();
+        }
+
+        std::string orders() override {
+            std::string result;
+            result += _x->ordering();
+            return result;
+        }
+
+        std::string strides() override {
+            return ShapeUtils::strideAsString(_x);
+        }
+
+        std::string axis() override {
+            if (_axis.empty())
+                return "ALL";
+
+            std::string result;
+            for (auto v:_axis) {
+                result += StringUtils::valueToString<int>(v);
+                result += ",";
+            }
+
+            return result;
+        }
+
+        std::string inplace() override {
+            return "true";
+        }
+
+        std::string extra() override {
+            return _descending ? "descending" : "ascending";
+        }
+
+        OpBenchmark* clone() override  {
+            return new SortBenchmark(_testName, _x->dup(), _axis, _descending);
+        }
+    };
+}
+
+#endif //DEV_TESTS_SORTBENCHMARK_H
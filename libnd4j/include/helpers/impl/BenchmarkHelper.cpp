@@ -23,6 +23,7 @@
 #include <NDArrayFactory.h>
 #include <chrono>
 #include <helpers/ShapeUtils.h>
+#include <Environment.h>
 
 namespace nd4j {
     BenchmarkHelper::BenchmarkHelper(unsigned int warmUpIterations, unsigned int runIterations) {
@@ -31,49 +32,84 @@ namespace nd4j {
     }
 
     void BenchmarkHelper::printHeader() {
-        nd4j_printf("TestName\tOpNum\tWarmup\tNumIter\tDataType\tInplace\tShape\tStrides\tAxis\tOrders\tavg (us)\tmedian (us)\tmin (us)\tmax (us)\tstdev (us)\n","");
+        nd4j_printf("TestName\tOpNum\tWarmup\tNumIter\tDataType\tInplace\tShape\tStrides\tAxis\tOrders\tavg (us)\tmedian (us)\tmin (us)\tmax (us)\tstdev (us)\tp90 (us)\tGFLOP/s\tGB/s\n","");
     }
 
-    void BenchmarkHelper::benchmarkOperation(OpBenchmark &benchmark) {
+    void BenchmarkHelper::setReport(BenchmarkReport *report) {
+        _report = report;
+    }
 
-        for (uint i = 0; i < _wIterations; i++)
+    BenchmarkResult BenchmarkHelper::measure(OpBenchmark &benchmark) {
+
+        for (uint i = 0; i < _wIterations; i++) {
+            benchmark.resetOnce();
             benchmark.executeOnce();
+        }
 
-        std::vector<Nd4jLong> timings(_rIterations);
+        std::vector<double> timings(_rIterations);
         double sumT = 0.0;
 
         for (uint i = 0; i < _rIterations; i++) {
-            auto timeStart = std::chrono::system_clock::now();
+            benchmark.resetOnce();
+
+            auto timeStart = std::chrono::high_resolution_clock::now();
 
             benchmark.executeOnce();
 
-            auto timeEnd = std::chrono::system_clock::now();
-            auto loopTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart)).count();
+            auto timeEnd = std::chrono::high_resolution_clock::now();
+            auto loopTime = std::chrono::duration_cast<std::chrono::nanoseconds> ((timeEnd - timeStart)).count() / 1000.0;
             timings[i] = loopTime;
             sumT += loopTime;
         }
-        sumT /= _rIterations;
+
+        BenchmarkResult result;
+        result.testName = benchmark.testName();
+        result.opNum = benchmark.opNum();
+        result.dataType = benchmark.dataType();
+        result.shape = benchmark.shape();
+        result.strides = benchmark.strides();
+        result.axis = benchmark.axis();
+        result.orders = benchmark.orders();
+        result.inplace = benchmark.inplace();
+        result.extra = benchmark.extra();
+        result.threads = nd4j::Environment::getInstance()->maxThreads();
+        result.warmup = _wIterations;
+        result.iterations = _rIterations;
+
+        if (_rIterations == 0)
+            return result;
 
         std::sort(timings.begin(), timings.end());
-        Nd4jLong median = timings[_rIterations / 2];
+        result.mean = sumT / _rIterations;
+        result.median = timings[_rIterations / 2];
+        result.p90 = timings[nd4j::math::nd4j_min<uint>(_rIterations - 1, (_rIterations * 9) / 10)];
+        result.min = timings.front();
+        result.max = timings.back();
+
+        double var = 0.0;
+        for (auto v:timings)
+            var += (v - result.mean) * (v - result.mean);
+        result.stdev = nd4j::math::nd4j_sqrt<double, double>(var / _rIterations);
+
+        // throughput figures are derived from median, since it's the least noisy number we have
+        if (result.median > 0.0) {
+            result.gflops = benchmark.flops() / (result.median * 1e3);
+            result.gbps = static_cast<double>(benchmark.bytes()) / (result.median * 1e3);
+        }
 
-        NDArray n = NDArrayFactory::create(timings, nullptr);
-        double stdev = n.varianceNumber(nd4j::variance::SummaryStatsStandardDeviation, false).e<double>(0);
-        Nd4jLong min = n.reduceNumber(nd4j::reduce::Min).e<Nd4jLong>(0);
-        Nd4jLong max = n.reduceNumber(nd4j::reduce::Max).e<Nd4jLong>(0);
+        return result;
+    }
 
-        // opNum, DataType, Shape, average time, median time
-        auto t = benchmark.dataType();
-        auto s = benchmark.shape();
-        auto strides = benchmark.strides();
-        auto o = benchmark.orders();
-        auto a = benchmark.axis();
-        auto inpl = benchmark.inplace();
+    void BenchmarkHelper::benchmarkOperation(OpBenchmark &benchmark) {
+        auto r = measure(benchmark);
 
         // printing out stuff
-        nd4j_printf("%s\t%i\t%i\t%i\t%s\t%s\t%s\t%s\t%s\t%s\t%lld\t%lld\t%lld\t%lld\t%.2f\n", benchmark.testName().c_str(), benchmark.opNum(),
-                    _wIterations, _rIterations, t.c_str(), inpl.c_str(), s.c_str(), strides.c_str(), a.c_str(), o.c_str(),
-                    nd4j::math::nd4j_floor<double, Nd4jLong>(sumT), median, min, max, stdev);
+        nd4j_printf("%s\t%i\t%i\t%i\t%s\t%s\t%s\t%s\t%s\t%s\t%lld\t%lld\t%lld\t%lld\t%.2f\t%lld\t%.3f\t%.3f\n", r.testName.c_str(), r.opNum,
+                    _wIterations, _rIterations, r.dataType.c_str(), r.inplace.c_str(), r.shape.c_str(), r.strides.c_str(), r.axis.c_str(), r.orders.c_str(),
+                    (Nd4jLong) r.mean, (Nd4jLong) r.median, (Nd4jLong) r.min, (Nd4jLong) r.max, r.stdev, (Nd4jLong) r.p90, r.gflops, r.gbps);
+
+        if (_report != nullptr)
+            _report->addResult(r);
     }
 
     void BenchmarkHelper::benchmarkScalarOperation(scalar::Ops op, std::string testName, double value, NDArray &x, NDArray &z) {
@@ -0,0 +1,431 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/benchmark/BenchmarkReport.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+namespace nd4j {
+
+    std::string BenchmarkResult::key() const {
+        std::string result(testName);
+        result += "|";
+        result += dataType;
+        result += "|";
+        result += shape;
+        result += "|";
+        result += axis;
+        result += "|";
+        result += extra;
+        result += "|";
+        result += std::to_string(threads);
+
+        return result;
+    }
+
+    double BenchmarkRegression::ratio() const {
+        return baseline > 0.0 ? current / baseline : 0.0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // JSON serialization helpers. Report format is flat, so we only need strings, numbers, arrays and objects
+    static std::string escape(const std::string &value) {
+        std::string result;
+        result.reserve(value.size() + 2);
+        result += '"';
+        for (auto c : value) {
+            switch (c) {
+                case '"': result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n"; break;
+                case '\t': result += "\\t"; break;
+                case '\r': result += "\\r"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        result += buf;
+                    } else
+                        result += c;
+            }
+        }
+        result += '"';
+        return result;
+    }
+
+    static std::string number(double value) {
+        if (!std::isfinite(value))
+            return "0";
+
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.4f", value);
+        return std::string(buf);
+    }
+
+    class JsonValue {
+    public:
+        enum Type {NIL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT};
+
+        Type type = NIL;
+        double num = 0.0;
+        std::string str;
+        std::vector<JsonValue> items;
+        std::map<std::string, JsonValue> fields;
+
+        const JsonValue* get(const std::string &name) const {
+            auto it = fields.find(name);
+            return it == fields.end() ? nullptr : &it->second;
+        }
+
+        std::string getString(const std::string &name) const {
+            auto v = get(name);
+            return v != nullptr && v->type == STRING ? v->str : std::string();
+        }
+
+        double getNumber(const std::string &name) const {
+            auto v = get(name);
+            return v != nullptr && v->type == NUMBER ? v->num : 0.0;
+        }
+    };
+
+    class JsonParser {
+    private:
+        const std::string &_json;
+        size_t _pos = 0;
+
+        // returns 0 at the end of input, so truncated documents fail in expect() instead of reading past the end
+        char peek() const {
+            return _pos < _json.size() ? _json[_pos] : '\0';
+        }
+
+        void skip() {
+            while (peek() == ' ' || peek() == '\n' || peek() == '\r' || peek() == '\t')
+                _pos++;
+        }
+
+        void expect(char c) {
+            skip();
+            if (peek() != c)
+                throw std::runtime_error(std::string("BenchmarkReport: malformed JSON, expected '") + c + "' at position " + std::to_string(_pos));
+            _pos++;
+        }
+
+        std::string parseString() {
+            expect('"');
+            std::string result;
+            while (_pos < _json.size() && peek() != '"') {
+                auto c = _json[_pos++];
+                if (c == '\\' && _pos < _json.size()) {
+                    auto e = _json[_pos++];
+                    switch (e) {
+                        case 'n': result += '\n'; break;
+                        case 't': result += '\t'; break;
+                        case 'r': result += '\r'; break;
+                        case 'b': result += '\b'; break;
+                        case 'f': result += '\f'; break;
+                        case 'u': {
+                            if (_pos + 4 > _json.size())
+                                throw std::runtime_error("BenchmarkReport: malformed JSON escape sequence");
+                            // we only ever write control characters this way, so single byte is enough
+                            result += static_cast<char>(strtol(_json.substr(_pos, 4).c_str(), nullptr, 16));
+                            _pos += 4;
+                            break;
+                        }
+                        default: result += e;
+                    }
+                } else
+                    result += c;
+            }
+            expect('"');
+            return result;
+        }
+
+    public:
+        explicit JsonParser(const std::string &json) : _json(json) { }
+
+        JsonValue parse() {
+            JsonValue value;
+            skip();
+            if (_pos >= _json.size())
+                throw std::runtime_error("BenchmarkReport: unexpected end of JSON");
+
+            auto c = _json[_pos];
+            if (c == '{') {
+                value.type = JsonValue::OBJECT;
+                _pos++;
+                skip();
+                if (peek() == '}') {
+                    _pos++;
+                    return value;
+                }
+
+                while (true) {
+                    auto name = parseString();
+                    expect(':');
+                    value.fields[name] = parse();
+                    skip();
+                    if (peek() == ',') {
+                        _pos++;
+                        skip();
+                        continue;
+                    }
+                    expect('}');
+                    break;
+                }
+            } else if (c == '[') {
+                value.type = JsonValue::ARRAY;
+                _pos++;
+                skip();
+                if (peek() == ']') {
+                    _pos++;
+                    return value;
+                }
+
+                while (true) {
+                    value.items.emplace_back(parse());
+                    skip();
+                    if (peek() == ',') {
+                        _pos++;
+                        continue;
+                    }
+                    expect(']');
+                    break;
+                }
+            } else if (c == '"') {
+                value.type = JsonValue::STRING;
+                value.str = parseString();
+            } else if (_json.compare(_pos, 4, "true") == 0) {
+                value.type = JsonValue::BOOLEAN;
+                value.num = 1.0;
+                _pos += 4;
+            } else if (_json.compare(_pos, 5, "false") == 0) {
+                value.type = JsonValue::BOOLEAN;
+                _pos += 5;
+            } else if (_json.compare(_pos, 4, "null") == 0) {
+                _pos += 4;
+            } else {
+                char *end = nullptr;
+                value.type = JsonValue::NUMBER;
+                value.num = strtod(_json.c_str() + _pos, &end);
+                if (end == _json.c_str() + _pos)
+                    throw std::runtime_error("BenchmarkReport: malformed JSON at position " + std::to_string(_pos));
+
+                _pos = end - _json.c_str();
+            }
+
+            return value;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    void BenchmarkReport::addResult(const BenchmarkResult &result) {
+        _results.emplace_back(result);
+    }
+
+    std::vector<BenchmarkResult>& BenchmarkReport::results() {
+        return _results;
+    }
+
+    void BenchmarkReport::setProperty(const std::string &key, const std::string &value) {
+        _properties[key] = value;
+    }
+
+    std::string BenchmarkReport::property(const std::string &key) {
+        auto it = _properties.find(key);
+        return it == _properties.end() ? std::string() : it->second;
+    }
+
+    void BenchmarkReport::setTolerance(double tolerance) {
+        _tolerance = tolerance;
+    }
+
+    void BenchmarkReport::setTolerance(const std::string &prefix, double tolerance) {
+        _tolerances[prefix] = tolerance;
+    }
+
+    void BenchmarkReport::setNoiseFloor(double microseconds) {
+        _noiseFloor = microseconds;
+    }
+
+    double BenchmarkReport::toleranceFor(const std::string &testName) {
+        double result = _tolerance;
+        size_t matched = 0;
+        for (const auto &v : _tolerances) {
+            if (v.first.size() >= matched && testName.compare(0, v.first.size(), v.first) == 0) {
+                matched = v.first.size();
+                result = v.second;
+            }
+        }
+
+        return result;
+    }
+
+    std::string BenchmarkReport::asJson() {
+        std::ostringstream os;
+        os << "{\n  \"version\": 1,\n  \"properties\": {";
+
+        bool first = true;
+        for (const auto &v : _properties) {
+            os << (first ? "\n" : ",\n") << "    " << escape(v.first) << ": " << escape(v.second);
+            first = false;
+        }
+        os << (first ? "}" : "\n  }") << ",\n  \"results\": [";
+
+        first = true;
+        for (const auto &r : _results) {
+            os << (first ? "\n" : ",\n") << "    {";
+            os << "\"name\": " << escape(r.testName) << ", ";
+            os << "\"opNum\": " << r.opNum << ", ";
+            os << "\"dataType\": " << escape(r.dataType) << ", ";
+            os << "\"shape\": " << escape(r.shape) << ", ";
+            os << "\"strides\": " << escape(r.strides) << ", ";
+            os << "\"axis\": " << escape(r.axis) << ", ";
+            os << "\"orders\": " << escape(r.orders) << ", ";
+            os << "\"inplace\": " << escape(r.inplace) << ", ";
+            os << "\"extra\": " << escape(r.extra) << ", ";
+            os << "\"threads\": " << r.threads << ", ";
+            os << "\"warmup\": " << r.warmup << ", ";
+            os << "\"iterations\": " << r.iterations << ", ";
+            os << "\"mean_us\": " << number(r.mean) << ", ";
+            os << "\"median_us\": " << number(r.median) << ", ";
+            os << "\"p90_us\": " << number(r.p90) << ", ";
+            os << "\"min_us\": " << number(r.min) << ", ";
+            os << "\"max_us\": " << number(r.max) << ", ";
+            os << "\"stdev_us\": " << number(r.stdev) << ", ";
+            os << "\"gflops\": " << number(r.gflops) << ", ";
+            os << "\"gbps\": " << number(r.gbps) << "}";
+            first = false;
+        }
+        os << (first ? "]" : "\n  ]") << "\n}\n";
+
+        return os.str();
+    }
+
+    void BenchmarkReport::writeJson(const char *fileName) {
+        std::ofstream out(fileName, std::ios::out | std::ios::trunc);
+        if (!out.is_open())
+            throw std::runtime_error(std::string("BenchmarkReport: can't open file for writing: ") + fileName);
+
+        out << asJson();
+    }
+
+    BenchmarkReport BenchmarkReport::fromJson(const std::string &json) {
+        JsonParser parser(json);
+        auto root = parser.parse();
+
+        if (root.type != JsonValue::OBJECT)
+            throw std::runtime_error("BenchmarkReport: JSON root should be an object");
+
+        BenchmarkReport report;
+
+        auto properties = root.get("properties");
+        if (properties != nullptr)
+            for (const auto &v : properties->fields)
+                if (v.second.type == JsonValue::STRING)
+                    report.setProperty(v.first, v.second.str);
+
+        auto results = root.get("results");
+        if (results == nullptr || results->type != JsonValue::ARRAY)
+            throw std::runtime_error("BenchmarkReport: JSON has no results array");
+
+        for (const auto &v : results->items) {
+            BenchmarkResult r;
+            r.testName = v.getString("name");
+            r.opNum = static_cast<int>(v.getNumber("opNum"));
+            r.dataType = v.getString("dataType");
+            r.shape = v.getString("shape");
+            r.strides = v.getString("strides");
+            r.axis = v.getString("axis");
+            r.orders = v.getString("orders");
+            r.inplace = v.getString("inplace");
+            r.extra = v.getString("extra");
+            r.threads = static_cast<int>(v.getNumber("threads"));
+            r.warmup = static_cast<int>(v.getNumber("warmup"));
+            r.iterations = static_cast<int>(v.getNumber("iterations"));
+            r.mean = v.getNumber("mean_us");
+            r.median = v.getNumber("median_us");
+            r.p90 = v.getNumber("p90_us");
+            r.min = v.getNumber("min_us");
+            r.max = v.getNumber("max_us");
+            r.stdev = v.getNumber("stdev_us");
+            r.gflops = v.getNumber("gflops");
+            r.gbps = v.getNumber("gbps");
+
+            report.addResult(r);
+        }
+
+        return report;
+    }
+
+    BenchmarkReport BenchmarkReport::readJson(const char *fileName) {
+        std::ifstream in(fileName);
+        if (!in.is_open())
+            throw std::runtime_error(std::string("BenchmarkReport: can't open file for reading: ") + fileName);
+
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        return fromJson(buffer.str());
+    }
+
+    std::vector<BenchmarkRegression> BenchmarkReport::compare(BenchmarkReport &baseline) {
+        std::map<std::string, BenchmarkResult*> index;
+        for (auto &v : baseline.results())
+            index[v.key()] = &v;
+
+        std::vector<BenchmarkRegression> result;
+        for (auto &v : _results) {
+            auto it = index.find(v.key());
+            if (it == index.end())
+                continue;
+
+            auto base = it->second->median;
+            auto tolerance = toleranceFor(v.testName);
+
+            // tiny ops are dominated by jitter, so absolute difference must exceed noise floor too
+            if (v.median > base * (1.0 + tolerance) && v.median - base > _noiseFloor) {
+                BenchmarkRegression regression;
+                regression.key = v.key();
+                regression.baseline = base;
+                regression.current = v.median;
+                regression.tolerance = tolerance;
+                result.emplace_back(regression);
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> BenchmarkReport::missing(BenchmarkReport &baseline) {
+        std::map<std::string, bool> measured;
+        for (const auto &v : _results)
+            measured[v.key()] = true;
+
+        std::vector<std::string> result;
+        for (const auto &v : baseline.results())
+            if (measured.count(v.key()) == 0)
+                result.emplace_back(v.key());
+
+        return result;
+    }
+}
@@ -27,7 +27,7 @@ namespace nd4j {
     }
 
 
-    void BlasHelper::initializeFunctions(Nd4jPointer *functions) {
+    void BlasHelper::initializeFunctions(Nd4jPointer *functions, int numFunctions) {
         nd4j_debug("Initializing BLAS\n","");
 
         _hasSgemv = functions[0] != nullptr;
@@ -49,6 +49,12 @@ namespace nd4j {
         this->lapackeDgesvd = (LapackeDgesvd)functions[7];
         this->lapackeSgesdd = (LapackeSgesdd)functions[8];
         this->lapackeDgesdd = (LapackeDgesdd)functions[9];
+
+        // older callers pass shorter table, so there's nothing to read past its end
+        this->lapackeSgetrf = numFunctions > 10 ? (LapackeSgetrf)functions[10] : nullptr;
+        this->lapackeDgetrf = numFunctions > 11 ? (LapackeDgetrf)functions[11] : nullptr;
+        this->lapackeSpotrf = numFunctions > 12 ? (LapackeSpotrf)functions[12] : nullptr;
+        this->lapackeDpotrf = numFunctions > 13 ? (LapackeDpotrf)functions[13] : nullptr;
     }
 
     void BlasHelper::initializeDeviceFunctions(Nd4jPointer *functions) {
@@ -329,6 +335,22 @@ namespace nd4j {
         return this->lapackeDgesdd;
     }
 
+    LapackeSgetrf BlasHelper::sgetrf() {
+        return this->lapackeSgetrf;
+    }
+
+    LapackeDgetrf BlasHelper::dgetrf() {
+        return this->lapackeDgetrf;
+    }
+
+    LapackeSpotrf BlasHelper::spotrf() {
+        return this->lapackeSpotrf;
+    }
+
+    LapackeDpotrf BlasHelper::dpotrf() {
+        return this->lapackeDpotrf;
+    }
+
     // destructor
     BlasHelper::~BlasHelper() noexcept { }
 
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/ContiguousBuffer.h>
+
+namespace nd4j {
+    ContiguousBuffer::ContiguousBuffer(const NDArray* array, nd4j::DataType dataType, bool writeBack) {
+        _original = const_cast<NDArray*>(array);
+        _writeBack = writeBack;
+
+        if (array->dataType() == dataType && array->ordering() == 'c' && array->ews() == 1) {
+            _array = _original;
+        } else {
+            _array = new NDArray('c', array->getShapeAsVector(), dataType, array->getWorkspace());
+            _array->assign(_original);
+        }
+    }
+
+    ContiguousBuffer::ContiguousBuffer(const NDArray& array, nd4j::DataType dataType, bool writeBack) : ContiguousBuffer(&array, dataType, writeBack) {
+        //
+    }
+
+    ContiguousBuffer::~ContiguousBuffer() {
+        if (_array != _original) {
+            if (_writeBack)
+                _original->assign(_array);
+
+            delete _array;
+        }
+    }
+
+    NDArray* ContiguousBuffer::array() {
+        return _array;
+    }
+
+    bool ContiguousBuffer::isCopy() {
+        return _array != _original;
+    }
+}
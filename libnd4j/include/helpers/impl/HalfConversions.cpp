@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/HalfConversions.h>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace nd4j {
+
+    static_assert(sizeof(float16) == 2, "float16 is expected to be 2 bytes long");
+    static_assert(sizeof(bfloat16) == 2, "bfloat16 is expected to be 2 bytes long");
+
+    void HalfConversions::toFloat(const float16 *x, float *z, Nd4jLong length) {
+        Nd4jLong e = 0;
+
+#if defined(__F16C__) || defined(__AVX512F__)
+        auto bits = reinterpret_cast<const uint16_t *>(x);
+#endif
+
+#if defined(__AVX512F__)
+        for (; e + 16 <= length; e += 16)
+            _mm512_storeu_ps(z + e, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + e))));
+#endif
+
+#if defined(__F16C__)
+        for (; e + 8 <= length; e += 8)
+            _mm256_storeu_ps(z + e, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + e))));
+#endif
+
+        // tail, or the whole thing if hardware conversion isn't available
+        for (; e < length; e++)
+            z[e] = static_cast<float>(x[e]);
+    }
+
+    void HalfConversions::fromFloat(const float *x, float16 *z, Nd4jLong length) {
+        Nd4jLong e = 0;
+
+#if defined(__F16C__) || defined(__AVX512F__)
+        auto bits = reinterpret_cast<uint16_t *>(z);
+#endif
+
+#if defined(__AVX512F__)
+        for (; e + 16 <= length; e += 16)
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(bits + e), _mm512_cvtps_ph(_mm512_loadu_ps(x + e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#endif
+
+#if defined(__F16C__)
+        for (; e + 8 <= length; e += 8)
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(bits + e), _mm256_cvtps_ph(_mm256_loadu_ps(x + e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#endif
+
+        for (; e < length; e++)
+            z[e] = static_cast<float16>(x[e]);
+    }
+
+    void HalfConversions::toFloat(const bfloat16 *x, float *z, Nd4jLong length) {
+        auto src = reinterpret_cast<const uint16_t *>(x);
+        auto dst = reinterpret_cast<uint32_t *>(z);
+
+        // bfloat16 is upper half of fp32
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            dst[e] = static_cast<uint32_t>(src[e]) << 16;
+    }
+
+    void HalfConversions::fromFloat(const float *x, bfloat16 *z, Nd4jLong length) {
+        auto src = reinterpret_cast<const uint32_t *>(x);
+        auto dst = reinterpret_cast<uint16_t *>(z);
+
+        // round to nearest even, NaNs become quiet NaN, exactly as bfloat16::assign(float) does
+        const auto qnan = static_cast<uint16_t>(bfloat16::nan()._data);
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++) {
+            auto v = src[e];
+            auto r = static_cast<uint16_t>((v + 0x7fffu + ((v >> 16) & 1u)) >> 16);
+            dst[e] = (v & 0x7fffffffu) > 0x7f800000u ? qnan : r;
+        }
+    }
+}
@@ -0,0 +1,725 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/HnswIndex.h>
+#include <helpers/logger.h>
+#include <ops/ops.h>
+#include <algorithm>
+#include <queue>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+namespace nd4j {
+
+    // nodes are guarded by striped locks, so memory used for locking doesn't grow with index
+    static const int LOCK_STRIPES = 65536;
+
+    static const char HNSW_MAGIC[8] = {'N', 'D', '4', 'J', 'H', 'N', 'S', 'W'};
+    static const int HNSW_VERSION = 1;
+
+    // on-disk header, all sections that follow are aligned to 8 bytes
+    struct HnswHeader {
+        char magic[8];
+        int version;
+        int dimensions;
+        int metric;
+        int M;
+        int M0;
+        int efConstruction;
+        int maxLevel;
+        int reserved;
+        Nd4jLong seed;
+        Nd4jLong size;
+        Nd4jLong entryPoint;
+        Nd4jLong upperLength;
+    };
+
+    static FORCEINLINE Nd4jLong alignedLength(Nd4jLong bytes) {
+        return (bytes + 7) & ~static_cast<Nd4jLong>(7);
+    }
+
+    // distance kernels are built from reduce3 op definitions
+    static FORCEINLINE float squaredEuclidean(const float *x, const float *y, int length) {
+        float sum = 0.0f;
+
+        PRAGMA_OMP_SIMD_SUM(sum)
+        for (int e = 0; e < length; e++)
+            sum = simdOps::EuclideanDistance<float, float>::update(sum, simdOps::EuclideanDistance<float, float>::op(x[e], y[e], nullptr), nullptr);
+
+        return sum;
+    }
+
+    static FORCEINLINE float dot(const float *x, const float *y, int length) {
+        float sum = 0.0f;
+
+        PRAGMA_OMP_SIMD_SUM(sum)
+        for (int e = 0; e < length; e++)
+            sum = simdOps::Dot<float, float>::update(sum, simdOps::Dot<float, float>::op(x[e], y[e], nullptr), nullptr);
+
+        return sum;
+    }
+
+    static void normalize(float *x, int length) {
+        auto norm = nd4j::math::nd4j_sqrt<float, float>(dot(x, x, length));
+        if (norm <= 0.0f)
+            return;
+
+        PRAGMA_OMP_SIMD
+        for (int e = 0; e < length; e++)
+            x[e] /= norm;
+    }
+
+    // splitmix64, so level of each node depends on seed and id only, not on thread that inserts it
+    static FORCEINLINE uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // visited marks are reused between searches: list is cleared by bumping its tag
+    class HnswIndex::VisitedPool {
+    public:
+        struct List {
+            std::vector<unsigned short> marks;
+            unsigned short tag = 0;
+
+            FORCEINLINE bool visit(Nd4jLong id) {
+                if (marks[id] == tag)
+                    return false;
+
+                marks[id] = tag;
+                return true;
+            }
+        };
+
+    private:
+        std::mutex _lock;
+        std::vector<List *> _free;
+
+    public:
+        ~VisitedPool() {
+            for (auto list: _free)
+                delete list;
+        }
+
+        List* acquire(Nd4jLong capacity) {
+            List *list = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (!_free.empty()) {
+                    list = _free.back();
+                    _free.pop_back();
+                }
+            }
+
+            if (list == nullptr)
+                list = new List();
+
+            if (static_cast<Nd4jLong>(list->marks.size()) < capacity)
+                list->marks.resize(capacity, 0);
+
+            if (++list->tag == 0) {
+                std::fill(list->marks.begin(), list->marks.end(), 0);
+                list->tag = 1;
+            }
+
+            return list;
+        }
+
+        void release(List *list) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _free.emplace_back(list);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    HnswIndex::HnswIndex(int dimensions, int metric, int M, int efConstruction, Nd4jLong capacity, Nd4jLong seed) {
+        if (dimensions <= 0)
+            throw std::invalid_argument("HnswIndex: dimensions should be positive");
+
+        if (metric < METRIC_EUCLIDEAN || metric > METRIC_DOT)
+            throw std::invalid_argument("HnswIndex: unknown metric");
+
+        if (M < 2)
+            throw std::invalid_argument("HnswIndex: M should be at least 2");
+
+        _dimensions = dimensions;
+        _metric = metric;
+        _M = M;
+        _M0 = 2 * M;
+        _efConstruction = nd4j::math::nd4j_max<int>(efConstruction, M);
+        _seed = seed;
+        _levelMult = 1.0 / std::log(static_cast<double>(M));
+
+        _locks.reset(new std::mutex[LOCK_STRIPES]);
+        _visited.reset(new VisitedPool());
+
+        if (capacity > 0)
+            reserve(capacity);
+    }
+
+    HnswIndex::~HnswIndex() = default;
+
+    Nd4jLong HnswIndex::size() const {
+        return _size;
+    }
+
+    int HnswIndex::dimensions() const {
+        return _dimensions;
+    }
+
+    int HnswIndex::metric() const {
+        return _metric;
+    }
+
+    bool HnswIndex::isMapped() const {
+        return _file != nullptr && _file->isMapped();
+    }
+
+    FORCEINLINE int* HnswIndex::links(Nd4jLong id, int level) const {
+        if (level == 0)
+            return _links0 + id * (_M0 + 1);
+
+        return _upper[id] + (level - 1) * (_M + 1);
+    }
+
+    FORCEINLINE int HnswIndex::maxLinks(int level) const {
+        return level == 0 ? _M0 : _M;
+    }
+
+    FORCEINLINE std::mutex& HnswIndex::lock(Nd4jLong id) const {
+        return _locks[id & (LOCK_STRIPES - 1)];
+    }
+
+    FORCEINLINE float HnswIndex::distance(const float *x, Nd4jLong id) const {
+        auto y = _vectors + id * _dimensions;
+
+        switch (_metric) {
+            case METRIC_EUCLIDEAN:
+                return squaredEuclidean(x, y, _dimensions);
+            case METRIC_COSINE:
+                return 1.0f - dot(x, y, _dimensions);
+            default:
+                return -dot(x, y, _dimensions);
+        }
+    }
+
+    FORCEINLINE float HnswIndex::distance(Nd4jLong a, Nd4jLong b) const {
+        return distance(_vectors + a * _dimensions, b);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // moves index into owned storage of given capacity. Mapped file is released here, since all data is copied
+    void HnswIndex::reserve(Nd4jLong capacity) {
+        if (capacity <= _capacity)
+            return;
+
+        std::vector<float> vectors(capacity * _dimensions);
+        std::vector<int> links0(capacity * (_M0 + 1));
+        std::vector<int> levels(capacity);
+
+        if (_size > 0) {
+            std::memcpy(vectors.data(), _vectors, _size * _dimensions * sizeof(float));
+            std::memcpy(links0.data(), _links0, _size * (_M0 + 1) * sizeof(int));
+            std::memcpy(levels.data(), _levels, _size * sizeof(int));
+        }
+
+        _ownedUpper.resize(capacity);
+        _upper.resize(capacity, nullptr);
+
+        // upper layers of mapped index live in file, so they are copied too
+        for (Nd4jLong e = 0; e < _size; e++) {
+            if (_upper[e] == nullptr || _ownedUpper[e] != nullptr)
+                continue;
+
+            auto length = levels[e] * (_M + 1);
+            _ownedUpper[e].reset(new int[length]);
+            std::memcpy(_ownedUpper[e].get(), _upper[e], length * sizeof(int));
+            _upper[e] = _ownedUpper[e].get();
+        }
+
+        _ownedVectors.swap(vectors);
+        _ownedLinks0.swap(links0);
+        _ownedLevels.swap(levels);
+
+        _vectors = _ownedVectors.data();
+        _links0 = _ownedLinks0.data();
+        _levels = _ownedLevels.data();
+        _capacity = capacity;
+
+        _file.reset();
+    }
+
+    int HnswIndex::randomLevel(Nd4jLong id) {
+        auto bits = mix(static_cast<uint64_t>(_seed) * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(id));
+
+        // uniform value from (0, 1]
+        auto u = (static_cast<double>(bits >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+        return static_cast<int>(-std::log(u) * _levelMult);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    Nd4jLong HnswIndex::greedy(const float *x, Nd4jLong entry, int fromLevel, int toLevel, bool locking) const {
+        auto current = entry;
+        auto currentDistance = distance(x, current);
+        std::vector<int> neighbors(_M0 + 1);
+
+        for (int level = fromLevel; level >= toLevel; level--) {
+            bool changed = true;
+            while (changed) {
+                changed = false;
+
+                auto l = links(current, level);
+                if (locking) {
+                    std::lock_guard<std::mutex> guard(lock(current));
+                    std::memcpy(neighbors.data(), l, (l[0] + 1) * sizeof(int));
+                } else
+                    std::memcpy(neighbors.data(), l, (l[0] + 1) * sizeof(int));
+
+                for (int e = 1; e <= neighbors[0]; e++) {
+                    auto d = distance(x, neighbors[e]);
+                    if (d < currentDistance) {
+                        currentDistance = d;
+                        current = neighbors[e];
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        return current;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // best-first search within single layer, result is sorted from nearest to farthest
+    void HnswIndex::searchLayer(const float *x, Nd4jLong entry, int ef, int level, bool locking, std::vector<std::pair<float, Nd4jLong>> &result) const {
+        typedef std::pair<float, Nd4jLong> Candidate;
+
+        auto visited = _visited->acquire(_capacity);
+        std::vector<int> neighbors(_M0 + 1);
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+        std::priority_queue<Candidate> top;
+
+        auto d = distance(x, entry);
+        visited->visit(entry);
+        candidates.emplace(d, entry);
+        top.emplace(d, entry);
+
+        while (!candidates.empty()) {
+            auto c = candidates.top();
+            if (c.first > top.top().first && static_cast<int>(top.size()) >= ef)
+                break;
+
+            candidates.pop();
+
+            auto l = links(c.second, level);
+            if (locking) {
+                std::lock_guard<std::mutex> guard(lock(c.second));
+                std::memcpy(neighbors.data(), l, (l[0] + 1) * sizeof(int));
+            } else
+                std::memcpy(neighbors.data(), l, (l[0] + 1) * sizeof(int));
+
+            for (int e = 1; e <= neighbors[0]; e++) {
+                Nd4jLong n = neighbors[e];
+                if (!visited->visit(n))
+                    continue;
+
+                auto dn = distance(x, n);
+                if (static_cast<int>(top.size()) < ef || dn < top.top().first) {
+                    candidates.emplace(dn, n);
+                    top.emplace(dn, n);
+
+                    if (static_cast<int>(top.size()) > ef)
+                        top.pop();
+                }
+            }
+        }
+
+        _visited->release(visited);
+
+        result.resize(top.size());
+        for (auto e = static_cast<int>(top.size()) - 1; e >= 0; e--) {
+            result[e] = top.top();
+            top.pop();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // neighbor selection heuristic: candidate is kept only if it's closer to base than to any neighbor already selected
+    void HnswIndex::selectNeighbors(std::vector<std::pair<float, Nd4jLong>> &candidates, int M) const {
+        if (static_cast<int>(candidates.size()) <= M)
+            return;
+
+        std::vector<std::pair<float, Nd4jLong>> selected;
+        selected.reserve(M);
+
+        for (const auto &c: candidates) {
+            bool keep = true;
+            for (const auto &s: selected)
+                if (distance(c.second, s.second) < c.first) {
+                    keep = false;
+                    break;
+                }
+
+            if (keep) {
+                selected.emplace_back(c);
+                if (static_cast<int>(selected.size()) >= M)
+                    break;
+            }
+        }
+
+        candidates.swap(selected);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    void HnswIndex::insert(Nd4jLong id) {
+        auto x = _vectors + id * _dimensions;
+        auto level = _levels[id];
+
+        // global lock is held for whole insertion only if this node becomes new entry point
+        std::unique_lock<std::mutex> global(_global);
+        auto maxLevel = _maxLevel;
+        auto entry = _entryPoint;
+
+        if (entry < 0) {
+            _entryPoint = id;
+            _maxLevel = level;
+            return;
+        }
+
+        if (level <= maxLevel)
+            global.unlock();
+
+        entry = greedy(x, entry, maxLevel, level + 1, true);
+
+        std::vector<std::pair<float, Nd4jLong>> found;
+        std::vector<std::pair<float, Nd4jLong>> pruned;
+
+        for (int l = nd4j::math::nd4j_min<int>(level, maxLevel); l >= 0; l--) {
+            searchLayer(x, entry, _efConstruction, l, true, found);
+            entry = found[0].second;
+
+            selectNeighbors(found, _M);
+
+            {
+                std::lock_guard<std::mutex> guard(lock(id));
+                auto own = links(id, l);
+                own[0] = static_cast<int>(found.size());
+                for (int e = 0; e < own[0]; e++)
+                    own[e + 1] = static_cast<int>(found[e].second);
+            }
+
+            // backward links, neighbor lists that are full get pruned with the same heuristic
+            auto limit = maxLinks(l);
+            for (const auto &f: found) {
+                auto n = f.second;
+                std::lock_guard<std::mutex> guard(lock(n));
+                auto other = links(n, l);
+
+                if (other[0] < limit) {
+                    other[++other[0]] = static_cast<int>(id);
+                    continue;
+                }
+
+                pruned.clear();
+                pruned.emplace_back(f.first, id);
+                for (int e = 1; e <= other[0]; e++)
+                    pruned.emplace_back(distance(n, other[e]), other[e]);
+
+                std::sort(pruned.begin(), pruned.end());
+                selectNeighbors(pruned, limit);
+
+                other[0] = static_cast<int>(pruned.size());
+                for (int e = 0; e < other[0]; e++)
+                    other[e + 1] = static_cast<int>(pruned[e].second);
+            }
+        }
+
+        if (level > maxLevel) {
+            _entryPoint = id;
+            _maxLevel = level;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    void HnswIndex::add(const float *vectors, Nd4jLong numVectors) {
+        if (numVectors <= 0)
+            return;
+
+        // links are stored as int32
+        if (_size + numVectors > static_cast<Nd4jLong>(INT_MAX))
+            throw std::invalid_argument("HnswIndex: index can't hold more than INT_MAX vectors");
+
+        if (_size + numVectors > _capacity)
+            reserve(nd4j::math::nd4j_max<Nd4jLong>(_size + numVectors, _capacity + _capacity / 2));
+
+        auto start = _size;
+        auto end = _size + numVectors;
+
+        std::memcpy(_vectors + start * _dimensions, vectors, numVectors * _dimensions * sizeof(float));
+
+        if (_metric == METRIC_COSINE) {
+            PRAGMA_OMP_PARALLEL_FOR_IF(numVectors > 1024)
+            for (Nd4jLong e = start; e < end; e++)
+                normalize(_vectors + e * _dimensions, _dimensions);
+        }
+
+        // levels and link storage are prepared upfront, so parallel insertion never allocates
+        for (Nd4jLong e = start; e < end; e++) {
+            auto level = randomLevel(e);
+            _levels[e] = level;
+            _links0[e * (_M0 + 1)] = 0;
+
+            if (level > 0) {
+                _ownedUpper[e].reset(new int[level * (_M + 1)]);
+                _upper[e] = _ownedUpper[e].get();
+
+                for (int l = 1; l <= level; l++)
+                    links(e, l)[0] = 0;
+            }
+        }
+
+        _size = end;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(dynamic, 16))
+        for (Nd4jLong e = start; e < end; e++)
+            insert(e);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    void HnswIndex::search(const float *queries, Nd4jLong numQueries, int k, int ef, Nd4jLong *ids, float *distances) const {
+        if (k <= 0)
+            throw std::invalid_argument("HnswIndex: k should be positive");
+
+        ef = nd4j::math::nd4j_max<int>(ef, k);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numQueries > 1)
+        for (Nd4jLong q = 0; q < numQueries; q++) {
+            auto qIds = ids + q * k;
+            auto qDistances = distances + q * k;
+
+            std::fill(qIds, qIds + k, -1);
+            std::fill(qDistances, qDistances + k, 0.0f);
+
+            if (_entryPoint < 0)
+                continue;
+
+            std::vector<float> normalized;
+            auto x = queries + q * _dimensions;
+            if (_metric == METRIC_COSINE) {
+                normalized.assign(x, x + _dimensions);
+                normalize(normalized.data(), _dimensions);
+                x = normalized.data();
+            }
+
+            std::vector<std::pair<float, Nd4jLong>> found;
+            auto entry = greedy(x, _entryPoint, _maxLevel, 1, false);
+            searchLayer(x, entry, ef, 0, false, found);
+
+            auto limit = nd4j::math::nd4j_min<int>(k, static_cast<int>(found.size()));
+            for (int e = 0; e < limit; e++) {
+                qIds[e] = found[e].second;
+
+                switch (_metric) {
+                    case METRIC_EUCLIDEAN:
+                        qDistances[e] = nd4j::math::nd4j_sqrt<float, float>(found[e].first);
+                        break;
+                    case METRIC_COSINE:
+                        qDistances[e] = found[e].first;
+                        break;
+                    default:
+                        qDistances[e] = -found[e].first;
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    static void writeBytes(FILE *out, const void *data, Nd4jLong bytes, const char *fileName) {
+        if (bytes > 0 && fwrite(data, 1, static_cast<size_t>(bytes), out) != static_cast<size_t>(bytes)) {
+            fclose(out);
+            throw std::runtime_error(std::string("HnswIndex: failed to write file: ") + fileName);
+        }
+    }
+
+    static void writePadding(FILE *out, Nd4jLong bytes, const char *fileName) {
+        static const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        writeBytes(out, padding, alignedLength(bytes) - bytes, fileName);
+    }
+
+    static void writeSection(FILE *out, const void *data, Nd4jLong bytes, const char *fileName) {
+        writeBytes(out, data, bytes, fileName);
+        writePadding(out, bytes, fileName);
+    }
+
+    void HnswIndex::save(const char *fileName) const {
+        // upper layers are written as single block, nodes reference it via offsets
+        std::vector<Nd4jLong> offsets(_size, -1);
+        Nd4jLong upperLength = 0;
+        for (Nd4jLong e = 0; e < _size; e++) {
+            if (_levels[e] > 0) {
+                offsets[e] = upperLength;
+                upperLength += _levels[e] * (_M + 1);
+            }
+        }
+
+        HnswHeader header;
+        std::memset(&header, 0, sizeof(HnswHeader));
+        std::memcpy(header.magic, HNSW_MAGIC, sizeof(HNSW_MAGIC));
+        header.version = HNSW_VERSION;
+        header.dimensions = _dimensions;
+        header.metric = _metric;
+        header.M = _M;
+        header.M0 = _M0;
+        header.efConstruction = _efConstruction;
+        header.maxLevel = _maxLevel;
+        header.seed = _seed;
+        header.size = _size;
+        header.entryPoint = _entryPoint;
+        header.upperLength = upperLength;
+
+        FILE *out = fopen(fileName, "wb");
+        if (out == nullptr)
+            throw std::runtime_error(std::string("HnswIndex: failed to open file for writing: ") + fileName);
+
+        writeSection(out, &header, sizeof(HnswHeader), fileName);
+        writeSection(out, _vectors, _size * _dimensions * sizeof(float), fileName);
+        writeSection(out, _levels, _size * sizeof(int), fileName);
+        writeSection(out, _links0, _size * (_M0 + 1) * sizeof(int), fileName);
+        writeSection(out, offsets.data(), _size * sizeof(Nd4jLong), fileName);
+
+        for (Nd4jLong e = 0; e < _size; e++)
+            if (_levels[e] > 0)
+                writeBytes(out, _upper[e], _levels[e] * (_M + 1) * sizeof(int), fileName);
+
+        writePadding(out, upperLength * sizeof(int), fileName);
+
+        if (fclose(out) != 0)
+            throw std::runtime_error(std::string("HnswIndex: failed to write file: ") + fileName);
+    }
+
+    HnswIndex* HnswIndex::load(const char *fileName) {
+        std::unique_ptr<graph::MappedFile> file(new graph::MappedFile(fileName));
+
+        auto buffer = reinterpret_cast<int8_t *>(file->buffer());
+        auto length = file->length();
+
+        if (length < static_cast<Nd4jLong>(sizeof(HnswHeader)))
+            throw std::runtime_error(std::string("HnswIndex: file is too short: ") + fileName);
+
+        auto header = reinterpret_cast<HnswHeader *>(buffer);
+        if (std::memcmp(header->magic, HNSW_MAGIC, sizeof(HNSW_MAGIC)) != 0 || header->version != HNSW_VERSION)
+            throw std::runtime_error(std::string("HnswIndex: unsupported file format: ") + fileName);
+
+        // index parameters and sections sizes are derived from header fields, so they're bounded by file length before any arithmetic
+        const Nd4jLong maxInts = length / static_cast<Nd4jLong>(sizeof(int));
+        if (header->dimensions <= 0 || header->dimensions > maxInts || header->metric < METRIC_EUCLIDEAN || header->metric > METRIC_DOT
+            || header->M < 2 || header->M > maxInts || header->M > INT_MAX / 2 - 1 || header->M0 != 2 * header->M)
+            throw std::runtime_error(std::string("HnswIndex: file is corrupted: ") + fileName);
+
+        auto size = header->size;
+        if (size < 0 || header->upperLength < 0 || header->upperLength > maxInts
+            || size > maxInts / header->dimensions || size > maxInts / (header->M0 + 1))
+            throw std::runtime_error(std::string("HnswIndex: file is corrupted: ") + fileName);
+
+        std::unique_ptr<HnswIndex> index(new HnswIndex(header->dimensions, header->metric, header->M, header->efConstruction, 0, header->seed));
+
+        Nd4jLong offset = alignedLength(sizeof(HnswHeader));
+        auto vectors = offset;
+        offset += alignedLength(size * header->dimensions * sizeof(float));
+        auto levels = offset;
+        offset += alignedLength(size * sizeof(int));
+        auto links0 = offset;
+        offset += alignedLength(size * (header->M0 + 1) * sizeof(int));
+        auto offsets = offset;
+        offset += alignedLength(size * sizeof(Nd4jLong));
+        auto upper = offset;
+        offset += header->upperLength * sizeof(int);
+
+        if (offset > length)
+            throw std::runtime_error(std::string("HnswIndex: file is corrupted: ") + fileName);
+
+        index->_vectors = reinterpret_cast<float *>(buffer + vectors);
+        index->_levels = reinterpret_cast<int *>(buffer + levels);
+        index->_links0 = reinterpret_cast<int *>(buffer + links0);
+
+        auto upperOffsets = reinterpret_cast<Nd4jLong *>(buffer + offsets);
+        auto upperBase = reinterpret_cast<int *>(buffer + upper);
+
+        // search follows links without any checks, so graph structure is validated once here
+        auto corrupted = [&] (const char *what) {
+            return std::runtime_error(std::string("HnswIndex: file is corrupted, ") + what + ": " + fileName);
+        };
+
+        if (size == 0 ? (header->entryPoint != -1 || header->maxLevel != -1) : (header->entryPoint < 0 || header->entryPoint >= size || header->maxLevel < 0))
+            throw corrupted("invalid entry point");
+
+        if (size > 0 && index->_levels[header->entryPoint] != header->maxLevel)
+            throw corrupted("entry point isn't on top level");
+
+        auto validLinks = [&] (const int *l, int limit) {
+            if (l[0] < 0 || l[0] > limit)
+                return false;
+
+            for (int e = 1; e <= l[0]; e++)
+                if (l[e] < 0 || l[e] >= size)
+                    return false;
+
+            return true;
+        };
+
+        index->_upper.resize(size, nullptr);
+        index->_ownedUpper.resize(size);
+        for (Nd4jLong e = 0; e < size; e++) {
+            auto level = index->_levels[e];
+            if (level < 0 || level > header->maxLevel)
+                throw corrupted("invalid node level");
+
+            if (!validLinks(index->_links0 + e * (header->M0 + 1), header->M0))
+                throw corrupted("invalid links");
+
+            if (level == 0)
+                continue;
+
+            if (upperOffsets[e] < 0 || upperOffsets[e] > header->upperLength - static_cast<Nd4jLong>(level) * (header->M + 1))
+                throw corrupted("invalid upper layers offset");
+
+            index->_upper[e] = upperBase + upperOffsets[e];
+            for (int l = 0; l < level; l++)
+                if (!validLinks(index->_upper[e] + l * (header->M + 1), header->M))
+                    throw corrupted("invalid links");
+        }
+
+        index->_size = size;
+        index->_capacity = size;
+        index->_maxLevel = header->maxLevel;
+        index->_entryPoint = header->entryPoint;
+        index->_file.swap(file);
+
+        return index.release();
+    }
+}
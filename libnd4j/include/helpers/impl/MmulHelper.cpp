@@ -25,19 +25,39 @@
 #include <helpers/ShapeUtils.h>
 #include <helpers/BlasHelper.h>
 #include <NDArrayFactory.h>
+#include <loops/type_conversions.h>
 
 namespace nd4j { 
 
+//////////////////////////////////////////////////////////////////////////////
+// 16-bit floats are used for storage only, products are accumulated in fp32
+template <typename T>
+struct MmulAccumulator {
+    typedef T type;
+};
+
+template <>
+struct MmulAccumulator<float16> {
+    typedef float type;
+};
+
+template <>
+struct MmulAccumulator<bfloat16> {
+    typedef float type;
+};
+
 
 //////////////////////////////////////////////////////////////////////////////
 // MXK x KxN = MxN
 template <typename T1, typename T2, typename T3>
 static void usualGemm(const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* vA, const int lda, const void* vB, const int ldb, const double beta, void* vC, const int ldc) {
 
+    typedef typename MmulAccumulator<T3>::type Acc;
+
     T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
     T2* B = reinterpret_cast<T2*>(const_cast<void*>(vB));
     T3* C = reinterpret_cast<T3*>(vC);
-    T3 alphaZ(alpha), betaZ(beta);
+    Acc alphaZ(alpha), betaZ(beta);
     
     const bool flagC = cOrder == 'f';
     const bool flagA = (flagC && transA) || (!flagC && !transA);
@@ -48,19 +68,19 @@ static void usualGemm(const char cOrder, const bool transA, const bool transB, c
        for(uint col = 0; col < N; ++col) {
             
             T3* c = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
-            T3 val = 0;
+            Acc val = 0;
 
            PRAGMA_OMP_SIMD
             for(uint i = 0; i < K; ++i) {
-                T3 a = flagA ? *(A + row * lda + i) : *(A + row + i * lda);
-                T3 b = flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);             
+                Acc a = static_cast<Acc>(flagA ? *(A + row * lda + i) : *(A + row + i * lda));
+                Acc b = static_cast<Acc>(flagB ? *(B + col + i * ldb) : *(B + col * ldb + i));
                 val += alphaZ * a * b;
             }
             
             if(betaZ)
-                *c = val + betaZ * *c;
+                *c = static_cast<T3>(val + betaZ * static_cast<Acc>(*c));
             else
-                *c = val;
+                *c = static_cast<T3>(val);
        }
     }
 }
@@ -70,10 +90,12 @@ static void usualGemm(const char cOrder, const bool transA, const bool transB, c
 template <typename T1, typename T2, typename T3>
 static void usualGemv(const char aOrder, const int M, const int N, const double alpha, const void* vA, const int lda, const void* vX, const int incx, const double beta, void* vY, const int incy) {
 
+    typedef typename MmulAccumulator<T3>::type Acc;
+
     T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
     T2* X = reinterpret_cast<T2*>(const_cast<void*>(vX));
     T3* Y = reinterpret_cast<T3*>(vY);
-    T3 alphaZ(alpha), betaZ(beta);
+    Acc alphaZ(alpha), betaZ(beta);
     
     const bool flagA = aOrder == 'f';
 
@@ -81,19 +103,19 @@ static void usualGemv(const char aOrder, const int M, const int N, const double
     for(int row = 0; row < M; ++row) {
                         
         T3* y = Y + row * incy;
-        T3 val = 0;
+        Acc val = 0;
 
         PRAGMA_OMP_SIMD
         for(int i = 0; i < N; ++i) {
-            T3 a = flagA ? *(A + row + i * lda) : *(A + row * lda + i);
-            T3 x = *(X + i * incx);
+            Acc a = static_cast<Acc>(flagA ? *(A + row + i * lda) : *(A + row * lda + i));
+            Acc x = static_cast<Acc>(*(X + i * incx));
             val += alphaZ * a * x;
         }
         
         if(betaZ)
-            *y = val + betaZ * *y;
+            *y = static_cast<T3>(val + betaZ * static_cast<Acc>(*y));
         else
-            *y = val;
+            *y = static_cast<T3>(val);
     }
 }
 
@@ -102,17 +124,36 @@ static void usualGemv(const char aOrder, const int M, const int N, const double
 template <typename T1, typename T2, typename T3>
 static void usualDot(const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ) {
 
+    typedef typename MmulAccumulator<T3>::type Acc;
+
     T1* X = reinterpret_cast<T1*>(const_cast<void*>(vX));
     T2* Y = reinterpret_cast<T2*>(const_cast<void*>(vY));
     T3* Z = reinterpret_cast<T3*>(vZ);
-    T3 alphaZ(alpha), betaZ(beta);
+    Acc alphaZ(alpha), betaZ(beta);
 
-    T3 sum = 0;
+    Acc sum = 0;
     PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(sumT:sum)
     for(unsigned int i = 0; i < length; ++i)
-        sum = sum + X[i * incx] * Y[i * incy];        
+        sum = sum + static_cast<Acc>(X[i * incx]) * static_cast<Acc>(Y[i * incy]);
     
-    *Z = alphaZ * sum + betaZ * *Z;
+    *Z = static_cast<T3>(alphaZ * sum + betaZ * static_cast<Acc>(*Z));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// 16-bit floats: operands are converted to fp32 in bulk, multiplied by BLAS sgemm, and result is rounded back once
+template <typename T>
+static void halfGemm(const CBLAS_ORDER blasOrder, const CBLAS_TRANSPOSE transA, const CBLAS_TRANSPOSE transB, const int M, const int N, const int K, const double alpha, const NDArray* A, const int lda, const NDArray* B, const int ldb, const double beta, NDArray* C, const int ldc) {
+
+    std::vector<float> a(A->lengthOf()), b(B->lengthOf()), c(C->lengthOf());
+
+    TypeCast::convertGeneric<T, float>(nullptr, A->getBuffer(), A->lengthOf(), a.data());
+    TypeCast::convertGeneric<T, float>(nullptr, B->getBuffer(), B->lengthOf(), b.data());
+    if(beta != 0.0)
+        TypeCast::convertGeneric<T, float>(nullptr, C->getBuffer(), C->lengthOf(), c.data());
+
+    BlasHelper::getInstance()->sgemm()(blasOrder, transA, transB, M, N, K, (float) alpha, a.data(), lda, b.data(), ldb, (float) beta, c.data(), ldc);
+
+    TypeCast::convertGeneric<float, T>(nullptr, c.data(), C->lengthOf(), C->getBuffer());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -183,6 +224,13 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
         nd4j_debug("MMUL: Using provided BLAS impl\n","");
         BlasHelper::getInstance()->dgemm()(blasOrder, transAblas, transBblas, M, N, K, (double) alpha, reinterpret_cast<double *>(pA->getBuffer()), lda, reinterpret_cast<double *>(pB->getBuffer()), ldb, (double) beta, reinterpret_cast<double *>(pC->getBuffer()), ldc);
     }
+    else if (ABC && (aType == DataType::HALF || aType == DataType::BFLOAT16) && BlasHelper::getInstance()->hasGEMM(DataType::FLOAT32)) {
+        nd4j_debug("MMUL: Using provided BLAS impl with fp32 staging\n","");
+        if (aType == DataType::HALF)
+            halfGemm<float16>(blasOrder, transAblas, transBblas, M, N, K, alpha, pA, lda, pB, ldb, beta, pC, ldc);
+        else
+            halfGemm<bfloat16>(blasOrder, transAblas, transBblas, M, N, K, alpha, pA, lda, pB, ldb, beta, pC, ldc);
+    }
     else {
         nd4j_debug("MMUL: Using fallback BLAS impl\n","");
         BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (cOrder, transA, transB, M, N, K, alpha, pA->getBuffer(), lda, pB->getBuffer(), ldb, beta, pC->getBuffer(), ldc), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
@@ -85,6 +85,14 @@ namespace nd4j {
         _axis = axis;
     }
 
+    void OpBenchmark::setFlops(double flops) {
+        _flops = flops;
+    }
+
+    void OpBenchmark::setBytes(Nd4jLong bytes) {
+        _bytes = bytes;
+    }
+
     std::vector<int> OpBenchmark::getAxis(){
         return _axis;
     }
@@ -110,4 +118,34 @@ namespace nd4j {
         else
             return "N/A";
     }
-}
\ No newline at end of file
+
+    double OpBenchmark::flops() {
+        if (_flops >= 0.0)
+            return _flops;
+
+        // by default we assume one operation per element of the largest operand
+        Nd4jLong length = 0;
+        for (auto v : {_x, _y, _z})
+            if (v != nullptr)
+                length = nd4j::math::nd4j_max<Nd4jLong>(length, v->lengthOf());
+
+        return static_cast<double>(length);
+    }
+
+    Nd4jLong OpBenchmark::bytes() {
+        if (_bytes >= 0)
+            return _bytes;
+
+        // every operand is either read or written once, in-place ops still touch memory twice
+        Nd4jLong result = 0;
+        for (auto v : {_x, _y, _z})
+            if (v != nullptr)
+                result += v->lengthOf() * v->sizeOfT();
+
+        return result;
+    }
+
+    void OpBenchmark::resetOnce() {
+        // stateless by default
+    }
+}
@@ -0,0 +1,353 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+//  @author raver119@gmail.com
+//
+
+#include <helpers/OpTracer.h>
+#include <helpers/shape.h>
+#include <helpers/logger.h>
+#include <array/ArrayOptions.h>
+#include <array/DataTypeUtils.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace nd4j {
+
+    // buffer of the current thread. Buffers are owned by OpTracer, holder only gives it back once thread exits
+    struct OpTraceBufferHolder {
+        OpTraceBuffer* buffer = nullptr;
+
+        ~OpTraceBufferHolder() {
+            if (buffer != nullptr)
+                OpTracer::getInstance()->release(buffer);
+        }
+    };
+
+    static thread_local OpTraceBufferHolder _localBuffer;
+    static thread_local Nd4jLong _localAllocated = 0;
+
+    OpTraceBuffer::OpTraceBuffer(int threadId, int capacity) : _events(capacity), _sequences(capacity) {
+        _threadId = threadId;
+        _head.store(0);
+        _tail.store(0);
+
+        for (auto &v : _sequences)
+            v.store(-1);
+    }
+
+    int OpTraceBuffer::threadId() {
+        return _threadId;
+    }
+
+    int OpTraceBuffer::capacity() {
+        return (int) _events.size();
+    }
+
+    void OpTraceBuffer::rebind(int threadId) {
+        _threadId = threadId;
+    }
+
+    void OpTraceBuffer::push(const TraceEvent &event) {
+        auto head = _head.load(std::memory_order_relaxed);
+        auto index = head % (Nd4jLong) _events.size();
+
+        // slot is marked as busy before its contents change, seqlock-style
+        _sequences[index].store(-1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto &slot = _events[index];
+        slot = event;
+        slot.threadId = _threadId;
+
+        // event becomes visible to readers only after it was written completely
+        _sequences[index].store(head, std::memory_order_release);
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    void OpTraceBuffer::collect(std::vector<TraceEvent> &target) {
+        auto head = _head.load(std::memory_order_acquire);
+        auto capacity = (Nd4jLong) _events.size();
+        auto tail = std::max<Nd4jLong>(_tail.load(), head - capacity);
+
+        for (Nd4jLong e = tail; e < head; e++) {
+            auto index = e % capacity;
+            if (_sequences[index].load(std::memory_order_acquire) != e)
+                continue;
+
+            TraceEvent event = _events[index];
+
+            // owner thread might have wrapped around and overwritten this slot while it was copied
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequences[index].load(std::memory_order_relaxed) != e)
+                continue;
+
+            target.emplace_back(event);
+        }
+    }
+
+    void OpTraceBuffer::reset() {
+        _tail.store(_head.load(std::memory_order_acquire));
+    }
+
+    OpTracer::OpTracer() {
+        _enabled.store(false);
+        _capacity.store(8192);
+        _origin = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        const char* capacity = std::getenv("ND4J_OP_TRACE_CAPACITY");
+        if (capacity != nullptr) {
+            int val = atoi(capacity);
+            if (val > 0)
+                _capacity.store(val);
+        }
+
+        const char* trace = std::getenv("ND4J_OP_TRACE");
+        if (trace != nullptr) {
+            std::string value(trace);
+            _enabled.store(value == "1" || value == "true" || value == "TRUE");
+        }
+    }
+
+    OpTracer::~OpTracer() {
+        for (auto v : _buffers)
+            delete v;
+    }
+
+    OpTracer* OpTracer::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new OpTracer();
+
+        return _INSTANCE;
+    }
+
+    void OpTracer::setEnabled(bool reallyEnable) {
+        _enabled.store(reallyEnable);
+    }
+
+    void OpTracer::setCapacity(int capacity) {
+        if (capacity <= 0)
+            throw std::invalid_argument("OpTracer: capacity should be positive");
+
+        _capacity.store(capacity);
+    }
+
+    Nd4jLong OpTracer::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() - _origin;
+    }
+
+    OpTraceBuffer* OpTracer::localBuffer() {
+        if (_localBuffer.buffer == nullptr) {
+            // registration happens once per thread, so this lock isn't on the hot path
+            std::lock_guard<std::mutex> lock(_lock);
+            auto capacity = _capacity.load();
+            auto threadId = _nextThreadId++;
+
+            auto it = std::find_if(_idle.begin(), _idle.end(), [capacity] (OpTraceBuffer *b) -> bool {
+                return b->capacity() == capacity;
+            });
+
+            if (it != _idle.end()) {
+                _localBuffer.buffer = *it;
+                _localBuffer.buffer->rebind(threadId);
+                _idle.erase(it);
+            } else {
+                _localBuffer.buffer = new OpTraceBuffer(threadId, capacity);
+                _buffers.emplace_back(_localBuffer.buffer);
+            }
+        }
+
+        return _localBuffer.buffer;
+    }
+
+    void OpTracer::release(OpTraceBuffer *buffer) {
+        std::lock_guard<std::mutex> lock(_lock);
+        _idle.emplace_back(buffer);
+    }
+
+    int OpTracer::numBuffers() {
+        std::lock_guard<std::mutex> lock(_lock);
+        return (int) _buffers.size();
+    }
+
+    void OpTracer::record(const TraceEvent &event) {
+        localBuffer()->push(event);
+    }
+
+    void OpTracer::trackAllocation(Nd4jLong bytes) {
+        _localAllocated += bytes;
+    }
+
+    Nd4jLong OpTracer::allocatedBytes() {
+        return _localAllocated;
+    }
+
+    void OpTracer::reset() {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (auto v : _buffers)
+            v->reset();
+
+        // idle buffers of outdated capacity can't be reused anymore, and they hold no events after reset
+        auto capacity = _capacity.load();
+        for (auto it = _idle.begin(); it != _idle.end(); ) {
+            if ((*it)->capacity() != capacity) {
+                _buffers.erase(std::find(_buffers.begin(), _buffers.end(), *it));
+                delete *it;
+                it = _idle.erase(it);
+            } else
+                it++;
+        }
+    }
+
+    std::vector<TraceEvent> OpTracer::events() {
+        std::vector<TraceEvent> result;
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            for (auto v : _buffers)
+                v->collect(result);
+        }
+
+        std::stable_sort(result.begin(), result.end(), [] (const TraceEvent &a, const TraceEvent &b) -> bool {
+            return a.start < b.start;
+        });
+
+        return result;
+    }
+
+    static void escapeName(std::ostringstream &os, const char *name) {
+        for (auto c = name; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\')
+                os << '\\' << *c;
+            else if ((unsigned char) *c < 0x20)
+                os << ' ';
+            else
+                os << *c;
+        }
+    }
+
+    std::string OpTracer::asChromeTrace() {
+        auto list = events();
+
+        std::ostringstream os;
+        os.setf(std::ios::fixed);
+        os.precision(3);
+
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+        for (size_t e = 0; e < list.size(); e++) {
+            auto &v = list[e];
+
+            if (e > 0)
+                os << ",";
+
+            // complete event, timestamps are expected in microseconds
+            os << "\n{\"name\": \"";
+            escapeName(os, v.name);
+            os << "\", \"cat\": \"op\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << v.threadId
+               << ", \"ts\": " << (v.start / 1000.0)
+               << ", \"dur\": " << ((v.end - v.start) / 1000.0)
+               << ", \"args\": {\"opNum\": " << v.opNum
+               << ", \"dtype\": \"" << DataTypeUtils::asString((nd4j::DataType) v.dataType)
+               << "\", \"shapes\": \"";
+
+            for (int i = 0; i < v.numInputs; i++) {
+                if (i > 0)
+                    os << ", ";
+
+                os << "[";
+                for (int r = 0; r < v.ranks[i] && r < TraceEvent::MAX_DIMS; r++) {
+                    if (r > 0)
+                        os << ", ";
+                    os << v.shapes[i][r];
+                }
+
+                if (v.ranks[i] > TraceEvent::MAX_DIMS)
+                    os << ", ...";
+
+                os << "]";
+            }
+
+            os << "\", \"bytes\": " << v.bytes << "}}";
+        }
+
+        os << "\n]}\n";
+
+        return os.str();
+    }
+
+    void OpTracer::writeChromeTrace(const char *fileName) {
+        std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+            throw std::runtime_error(std::string("OpTracer: unable to open file for writing: ") + fileName);
+
+        file << asChromeTrace();
+        file.close();
+    }
+
+    OpTraceScope::OpTraceScope(const char *name, int opNum, Nd4jLong *xShapeInfo, Nd4jLong *yShapeInfo) {
+        auto tracer = OpTracer::getInstance();
+        if (!tracer->isEnabled())
+            return;
+
+        _active = true;
+
+        strncpy(_event.name, name, TraceEvent::MAX_NAME - 1);
+        _event.name[TraceEvent::MAX_NAME - 1] = '\0';
+        _event.opNum = opNum;
+
+        addShape(xShapeInfo);
+        addShape(yShapeInfo);
+
+        _bytes = OpTracer::allocatedBytes();
+        _event.start = tracer->now();
+    }
+
+    void OpTraceScope::addShape(Nd4jLong *shapeInfo) {
+        if (!_active || shapeInfo == nullptr || _event.numInputs >= TraceEvent::MAX_INPUTS)
+            return;
+
+        if (_event.numInputs == 0)
+            _event.dataType = (int) ArrayOptions::dataType(shapeInfo);
+
+        auto idx = _event.numInputs++;
+        auto rank = shape::rank(shapeInfo);
+        _event.ranks[idx] = rank;
+
+        auto shapeOf = shape::shapeOf(shapeInfo);
+        for (int e = 0; e < rank && e < TraceEvent::MAX_DIMS; e++)
+            _event.shapes[idx][e] = shapeOf[e];
+    }
+
+    OpTraceScope::~OpTraceScope() {
+        if (!_active)
+            return;
+
+        auto tracer = OpTracer::getInstance();
+        _event.end = tracer->now();
+        _event.bytes = OpTracer::allocatedBytes() - _bytes;
+
+        // tracing could be disabled while op was running, event is stored anyway
+        tracer->record(_event);
+    }
+
+    nd4j::OpTracer* nd4j::OpTracer::_INSTANCE = 0;
+}
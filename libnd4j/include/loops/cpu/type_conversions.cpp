@@ -22,6 +22,7 @@
 #include <op_boilerplate.h>
 #include <loops/type_conversions.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/HalfConversions.h>
 
 namespace nd4j {
 
@@ -180,6 +181,25 @@ namespace nd4j {
         }
     }
 
+    /**
+     * This method converts 16-bit floats via fp32 staging buffers, so bulk F16C/SIMD conversions are used on both sides
+     */
+    template<typename S, typename T>
+    static void convertStaged(S *x, Nd4jLong N, T *z) {
+        auto numChunks = (N + HalfConversions::CHUNK - 1) / HalfConversions::CHUNK;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(N > nd4j::Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            float buffer[HalfConversions::CHUNK];
+
+            auto start = c * HalfConversions::CHUNK;
+            auto length = nd4j::math::nd4j_min<Nd4jLong>(HalfConversions::CHUNK, N - start);
+
+            HalfConversions::toFloat(x + start, buffer, length);
+            HalfConversions::fromFloat(buffer, z + start, length);
+        }
+    }
+
     /**
      * This is cpu version, so leave it here as inline, to avoid templates instantiation
      *
@@ -194,6 +214,11 @@ namespace nd4j {
         auto x = reinterpret_cast<S *>(dx);
         auto z = reinterpret_cast<T *>(dz);
 
+        if (HalfConversions::isHalfType<S>() || HalfConversions::isHalfType<T>()) {
+            convertStaged<S, T>(x, N, z);
+            return;
+        }
+
         if (N < nd4j::Environment::getInstance()->elementwiseThreshold()) {
             for (int i = 0; i < N; i++) {
                 // FIXME: get rid of through-float though
@@ -31,12 +31,15 @@
 #include <array/ShapeList.h>
 #include <array/ResultSet.h>
 #include <helpers/OpArgsHolder.h>
+#include <helpers/SimpleReadWriteLock.h>
 #include <dll.h>
 //#include <ops/declarable/declarable_ops.h>
 
 #include <chrono>
 #include <ctime>
 #include <mutex>
+#include <map>
+#include <memory>
 
 using namespace nd4j::graph;
 
@@ -68,6 +71,14 @@ namespace nd4j {
             std::mutex _registrator;
             bool _registered = false;
 
+            // output shapes by input signature: input shapeInfos, arguments and data type. used only if op descriptor allows it.
+            // entries are never modified after insertion, so lookups share them instead of copying, under read lock only
+            typedef std::shared_ptr<const std::vector<std::vector<Nd4jLong>>> CachedShapes;
+            nd4j::SimpleReadWriteLock _shapeCacheLock;
+            std::map<std::vector<Nd4jLong>, CachedShapes> _shapeCache;
+
+            void buildShapeCacheKey(Context& block, ShapeList& inputShapes, std::vector<Nd4jLong>& key);
+
         protected:
             OpDescriptor *_descriptor;
             NDArray _scalar;
@@ -131,6 +142,12 @@ namespace nd4j {
             // this method returns OpDescriptor, describing this Op instance
             OpDescriptor *getOpDescriptor();
 
+            /**
+             * These methods provide access to output shapes cached by prepareOutputs
+             */
+            int shapeCacheSize();
+            void purgeShapeCache();
+
             Nd4jStatus validateDataTypes(Context& block);
 
             /**
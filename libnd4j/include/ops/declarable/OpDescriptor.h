@@ -61,6 +61,9 @@ namespace nd4j {
             // flag, if this given op allows in-place execution
             bool _allowsInplace = true;
 
+            // flag, if output shapes depend on input shapes, arguments and data type only, but not on input values
+            bool _shapeCacheable = false;
+
             // minimal required number of T-type arguments.
             // -1 as value means: not limited, variable number of arguments
             int _tArgs = 0;
@@ -143,6 +146,9 @@ namespace nd4j {
             // returns TRUE if this op allows in-place execution
             bool allowsInplace();
 
+            // returns TRUE if output shapes calculated once can be reused for the same input shapes and arguments
+            bool isShapeCacheable();
+
             // this method returns opNum (applicable for legacy XYZ ops only)
             int getOpNum();
 
@@ -165,6 +171,7 @@ namespace nd4j {
             OpDescriptor* setAllowedInputTypes(nd4j::DataType dtype);
             OpDescriptor* setAllowedOutputTypes(nd4j::DataType dtype);
             OpDescriptor* setSameMode(bool reallySame);
+            OpDescriptor* setShapeCacheable(bool reallyCacheable);
             OpDescriptor* setInputType(int idx, nd4j::DataType dtype);
             OpDescriptor* setOutputType(int idx, nd4j::DataType dtype);
 
@@ -25,6 +25,7 @@
 #include <vector>
 #include <map>
 #include <mutex>
+#include <atomic>
 #include <ops/declarable/DeclarableOp.h>
 
 // handlers part
@@ -39,6 +40,10 @@ namespace nd4j {
         *   so once binary is executed, static objects are initialized automatically, and we get list of all ops
         *   available at runtime via this singleton.
         *
+        *   Lookups by hash don't take locks: on first lookup registry is frozen into open-addressing table, which is
+        *   published atomically and rebuilt only if something gets registered afterwards. Ops are never unregistered,
+        *   so pointers returned here are stable and can be used as op handles.
+        *
         */
         class ND4J_EXPORT OpRegistrator {
         private:
@@ -66,6 +71,25 @@ namespace nd4j {
             std::mutex _locker;
             std::string _opsList;
             bool isInit = false;
+
+            // frozen hash -> op table, linear probing, capacity is power of 2 and at least twice number of ops
+            struct OpSlot {
+                Nd4jLong hash;
+                nd4j::ops::DeclarableOp* op;
+            };
+
+            struct OpTable {
+                std::vector<OpSlot> slots;
+                uint64_t mask;
+            };
+
+            std::atomic<OpTable*> _table{nullptr};
+            // tables replaced by later registrations, kept alive for concurrent readers
+            std::vector<OpTable*> _tables;
+
+            OpTable* freeze();
+            static void insertOp(OpTable* table, Nd4jLong hash, nd4j::ops::DeclarableOp* op);
+            static nd4j::ops::DeclarableOp* findOp(const OpTable* table, Nd4jLong hash);
         public:
             ~OpRegistrator();
 
@@ -131,7 +131,8 @@ DECLARE_SHAPE_FN(matmul) {
         getOpDescriptor()
                 ->setAllowedInputTypes(0, {ALL_FLOATS})
                 ->setAllowedInputTypes(1, {ALL_FLOATS})
-                ->setAllowedOutputTypes(0, {ALL_FLOATS});
+                ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                ->setShapeCacheable(true);
     }
 
 }
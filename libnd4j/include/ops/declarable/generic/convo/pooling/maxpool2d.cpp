@@ -87,7 +87,8 @@ DECLARE_SYN(maxpool, maxpool2d);
         DECLARE_TYPES(maxpool2d) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setShapeCacheable(true);
         }
 
 
@@ -152,6 +153,7 @@ CUSTOM_OP_IMPL(maxpool2d_bp, 2, 1, false, 0, 10) {
 
     auto input = INPUT_VARIABLE(0);                          // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
     auto gradO = INPUT_VARIABLE(1);                          // [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW), epsilon_next
+    auto argmax = block.width() > 2 ? INPUT_VARIABLE(2) : nullptr;    // optional, same shape as gradO, indices of max elements from max_pool_with_argmax
     auto gradI = OUTPUT_VARIABLE(0);                         // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW), epsilon
 
     int kH = INT_ARG(0);                                                        // filter(kernel) height
@@ -176,11 +178,17 @@ CUSTOM_OP_IMPL(maxpool2d_bp, 2, 1, false, 0, 10) {
     std::string expectedGradIShape = ShapeUtils::shapeAsString(ShapeUtils::composeShapeUsingDimsAndIdx({bS,iC,iH,iW,  0,indIOioC,indIiH,indIiH+1}));
     REQUIRE_TRUE(expectedGradOShape == ShapeUtils::shapeAsString(gradO), 0, "MAXPOOL2D_BP op: wrong shape of output's gradients array (next epsilon), expected is %s, but got %s instead !", expectedGradOShape.c_str(), ShapeUtils::shapeAsString(gradO).c_str());
     REQUIRE_TRUE(expectedGradIShape == ShapeUtils::shapeAsString(gradI), 0, "MAXPOOL2D_BP op: wrong shape of input's gradients array (epsilon), expected is %s, but got %s instead !", expectedGradIShape.c_str(), ShapeUtils::shapeAsString(gradI).c_str());
+    if(argmax != nullptr) {
+        REQUIRE_TRUE(expectedGradOShape == ShapeUtils::shapeAsString(argmax), 0, "MAXPOOL2D_BP op: wrong shape of argmax indices array, expected is %s, but got %s instead !", expectedGradOShape.c_str(), ShapeUtils::shapeAsString(argmax).c_str());
+        REQUIRE_TRUE(argmax->dataType() == DataType::INT64, 0, "MAXPOOL2D_BP op: argmax indices array must be INT64, but got %s instead !", DataTypeUtils::asString(argmax->dataType()).c_str());
+    }
 
     if(!isNCHW) {
         input = input->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]                        
         gradI = gradI->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]                        
         gradO = gradO->permute({0, 3, 1, 2});                                   // [bS, oH, oW, iC] -> [bS, iC, oH, oW]                        
+        if(argmax != nullptr)
+            argmax = argmax->permute({0, 3, 1, 2});                             // [bS, oH, oW, iC] -> [bS, iC, oH, oW]
     }
     
     if(isSameMode)                       // SAME        
@@ -199,12 +207,16 @@ CUSTOM_OP_IMPL(maxpool2d_bp, 2, 1, false, 0, 10) {
     
     // columns->template applyTransform<simdOps::Col2Im<T>>(gradI, std::vector<T>({(T)sH, (T)sW, (T)pH, (T)pW, (T)iH, (T)iW, (T)dH, (T)dW}).data());
     
-    ConvolutionUtils::pooling2dBP(block, *input, *gradO, *gradI, kH, kW, sH, sW, pH, pW, dH, dW, 0., 1.);
+    if(argmax != nullptr)
+        ConvolutionUtils::maxPooling2dBPWithArgmax(*argmax, *gradO, *gradI, isNCHW);
+    else
+        ConvolutionUtils::pooling2dBP(block, *input, *gradO, *gradI, kH, kW, sH, sW, pH, pW, dH, dW, 0., 1.);
 
     if(!isNCHW) {
         delete input;
         delete gradI;
         delete gradO;
+        delete argmax;
     }
     // delete columns;
     // delete columns2d;
@@ -51,11 +51,34 @@ namespace nd4j {
         }
 
         DECLARE_SHAPE_FN(max_pool_with_argmax) {
-            
+
             auto in = inputShape->at(0);
-            Nd4jLong* valuesShape = ShapeBuilders::copyShapeInfo(in, false, block.getWorkspace());    
-            Nd4jLong* indicesShape = ShapeBuilders::copyShapeInfoAndType(in, DataType::INT64, false, block.getWorkspace());    
-            
+            auto argI = *(block.getIArguments());
+
+            // 0,1 - kernel Height/Width; 2,3 - stride Height/Width; 4,5 - pad Height/Width; 6,7 - dilation Height/Width; 8 - same mode; 10 - NHWC
+            const bool isNCHW = argI.size() > 10 ? argI[10] == 0 : true;
+            const int iH = shape::sizeAt(in, isNCHW ? 2 : 1);
+            const int iW = shape::sizeAt(in, isNCHW ? 3 : 2);
+
+            int oH = 0;
+            int oW = 0;
+            ConvolutionUtils::calcOutSizePool2D(oH, oW, argI[0], argI[1], argI[2], argI[3], argI[4], argI[5], argI[6], argI[7], iH, iW, argI[8] != 0);
+
+            std::vector<Nd4jLong> outShape = {shape::sizeAt(in, 0), 0, 0, 0};
+            if (isNCHW) {
+                outShape[1] = shape::sizeAt(in, 1);
+                outShape[2] = oH;
+                outShape[3] = oW;
+            }
+            else {
+                outShape[1] = oH;
+                outShape[2] = oW;
+                outShape[3] = shape::sizeAt(in, 3);
+            }
+
+            Nd4jLong* valuesShape = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(in), shape::order(in), outShape, block.getWorkspace());
+            Nd4jLong* indicesShape = ShapeBuilders::createShapeInfo(DataType::INT64, shape::order(in), outShape, block.getWorkspace());
+
             return SHAPELIST(valuesShape, indicesShape);
         }
     }
@@ -25,6 +25,7 @@
 #include <pointercast.h>
 #include <op_boilerplate.h>
 #include <NDArray.h>
+#include <ops/declarable/helpers/scatter.h>
 #include <numeric>
 
 
@@ -36,98 +37,17 @@ class ScatterHelper {
     public:
 
 ////////////////////////////////////////////////////////////////////////
-        static FORCEINLINE void scatter(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, const bool lock) {
-
-            const int outRank = output.rankOf();
-            const int indRank = indices.rankOf();
-            const int updRank = updates.rankOf();
-            const Nd4jLong indLen = indices.lengthOf();
-
-            if(outRank == 1) {
-
-                PRAGMA_OMP_PARALLEL_FOR_IF(!lock)
-                for(Nd4jLong i = 0; i < indLen; ++i) {
-                    
-                    Nd4jLong idx = indices.e<Nd4jLong>(i);
-                    NDArray out = output({idx, idx+1});
-
-                    PRAGMA_OMP_CRITICAL
-                    {
-                        out.applyPairwiseTransform(op, updates.e(i), nullptr);
-                    }
-                }
-            }
-            else {      // outRank > 1
-
-                int sizeOfDims = indRank;
-                if(outRank == updRank && indices.isVector())
-                    sizeOfDims = 1;
-
-                std::vector<int> dimsToExcludeUpd(sizeOfDims);
-                std::iota(dimsToExcludeUpd.begin(), dimsToExcludeUpd.end(), 0);
-
-                PRAGMA_OMP_PARALLEL_FOR_IF(!lock)
-                for(Nd4jLong i = 0; i < indLen; ++i) {                                       
-
-                    NDArray outSubArr = output(indices.e<Nd4jLong>(i), std::vector<int>({0}));
-                    NDArray updSubArr = updates(i, dimsToExcludeUpd);
-
-                    PRAGMA_OMP_CRITICAL
-                    {
-                        outSubArr.applyPairwiseTransform(op, updSubArr, nullptr);
-                    }
-                }
-            }
-        }
+// lock = true means updates are applied in calling thread only
+static FORCEINLINE void scatter(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, const bool lock) {
+
+    helpers::scatter(op, indices, updates, output, lock);
+}
 
 
 ////////////////////////////////////////////////////////////////////////
 static FORCEINLINE void scatterND(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, const bool lock) {
 
-    const Nd4jLong indLen = indices.lengthOf();
-    const int outRank = output.rankOf();
-    const int indRank = indices.rankOf();
-    const Nd4jLong indLastDim = indices.sizeAt(-1);
-
-    if(outRank == 1) {
-
-        PRAGMA_OMP_PARALLEL_FOR_IF(!lock)
-        for(Nd4jLong i = 0; i < indLen; ++i) {
-
-            auto idx = indices.e<Nd4jLong>(i);
-            auto out = output({idx, idx+1});
-            PRAGMA_OMP_CRITICAL
-            {
-                out.applyPairwiseTransform(op, updates.e(i), nullptr);
-            }
-        }
-    } 
-    else {
-
-        std::vector<int> dimsToExcludeInd = ShapeUtils::evalDimsToExclude(indRank, {indRank-1});
-        std::vector<int> dimsToExcludeUpd(indRank - 1);
-        std::iota(dimsToExcludeUpd.begin(), dimsToExcludeUpd.end(), 0);
-        std::vector<Nd4jLong> idxRangeOut(2*outRank, 0);
-
-        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(!lock) firstprivate(idxRangeOut))
-        for(Nd4jLong i = 0; i < indLen/indLastDim; ++i) {
-            
-            auto indSubArr = indices(i, dimsToExcludeInd);
-
-            for(Nd4jLong j = 0; j < indLastDim; ++j) {
-                idxRangeOut[2*j] = indSubArr.e<Nd4jLong>(j);
-                idxRangeOut[2*j + 1] = idxRangeOut[2*j] + 1;
-            }
-
-            auto outSubArr = output(idxRangeOut);
-            auto updSubArr = updates(i, dimsToExcludeUpd);
-
-            PRAGMA_OMP_CRITICAL
-            {
-                outSubArr.applyPairwiseTransform(op, updSubArr, nullptr);
-            }
-        }        
-    }
+    helpers::scatterND(op, indices, updates, output, lock);
 }
 
 
@@ -120,6 +120,19 @@ namespace nd4j {
 
             static void pooling2d(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0);
 
+            /**
+             * max pooling which also reports position of max element for each output value
+             * input [bS, iC, iH, iW], output and indices [bS, iC, oH, oW], NHWC arrays are expected to be permuted to this order
+             * indices are linear positions within image, counted in NCHW or NHWC order depending on isNCHW
+             */
+            static void maxPooling2dWithArgmax(const NDArray& input, NDArray& output, NDArray& indices, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const bool isNCHW);
+
+            /*
+             * max pooling backprop driven by indices produced by maxPooling2dWithArgmax, so windows aren't searched again
+             * gradO and indices [bS, iC, oH, oW], gradI [bS, iC, iH, iW], NHWC arrays are expected to be permuted to this order
+             */
+            static void maxPooling2dBPWithArgmax(const NDArray& indices, const NDArray& gradO, NDArray& gradI, const bool isNCHW);
+
             static void pooling3d(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0);
 
             static void pooling2dBP(nd4j::graph::Context& block, const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0);
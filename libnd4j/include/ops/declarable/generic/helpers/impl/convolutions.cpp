@@ -24,6 +24,7 @@
 #include <ops/declarable/helpers/col2im.h>
 #include <NDArrayFactory.h>
 #include <MmulHelper.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops  {
@@ -1390,6 +1391,448 @@ void ConvolutionUtils::getMKLDNNMemoryDescPool3d(
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// window [start, end) of output position o along one spatial axis, clipped to input the same way generic kernels do it
+static FORCEINLINE void poolingWindow(const Nd4jLong o, const int k, const int s, const int p, const int d, const int inSize, Nd4jLong& start, Nd4jLong& end) {
+    start = o * s - p;
+    end   = start + k + (k - 1) * (d - 1);
+    if(start < 0)
+        start += d * ((-start + d - 1) / d);
+    if(end > inSize)
+        end -= d * ((end - inSize + d - 1) / d);
+}
+
+// number of window elements along one axis, same expression as in generic kernels
+static FORCEINLINE Nd4jLong poolingWindowSize(const Nd4jLong start, const Nd4jLong end, const int d) {
+    return (end - start) / d + ((end - start) % d == 0 ? 0 : 1);
+}
+
+// channels processed by one task in channels-last backprop
+static const int kPoolingChannelsBlock = 64;
+
+//////////////////////////////////////////////////////////////////////////
+// Dense pooling kernels for max/avg modes. Arrays are [bS, iC, iH, iW] / [bS, iC, oH, oW], either plain NCHW with unit
+// width stride (kernel vectorizes along width), or NHWC arrays permuted to this order with unit channel stride
+// (kernel vectorizes along channels). Returns false if layout doesn't fit, so caller falls back to generic kernel.
+// If argmax isn't nullptr, it receives [bS, iC, oH, oW] c-ordered indices of max elements within image, counted in
+// NCHW or NHWC order depending on isNCHW.
+template <typename T>
+static bool pooling2dDense_(const NDArray& input, NDArray& output, Nd4jLong* argmax, const bool isNCHW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
+
+    if(poolingMode > 1)
+        return false;
+
+    const T* in  = const_cast<NDArray&>(input).bufferAsT<T>();
+          T* out = output.bufferAsT<T>();
+
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(1);
+    const int iH = input.sizeAt(2);
+    const int iW = input.sizeAt(3);
+    const int oH = output.sizeAt(2);
+    const int oW = output.sizeAt(3);
+
+    const Nd4jLong* iS = input.stridesOf();
+    const Nd4jLong* oS = output.stridesOf();
+
+    const bool planar = iS[3] == 1 && oS[3] == 1;
+    const bool interleaved = !planar && iS[1] == 1 && oS[1] == 1;
+    if(!planar && !interleaved)
+        return false;
+
+    const int  kProd    = kH * kW;
+    const bool isMax    = poolingMode == 0;
+    const T    minValue = -DataTypeUtils::max<T>();
+
+    // logical index of (c, h, w) within image, as max_pool_with_argmax reports it
+    const Nd4jLong aC = isNCHW ? (Nd4jLong) iH * iW : 1;
+    const Nd4jLong aH = isNCHW ? (Nd4jLong) iW : (Nd4jLong) iW * iC;
+    const Nd4jLong aW = isNCHW ? 1 : iC;
+
+    if(planar) {
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for(Nd4jLong plane = 0; plane < (Nd4jLong) bS * iC; ++plane) {
+            const Nd4jLong b = plane / iC;
+            const Nd4jLong c = plane % iC;
+            const T* pIn  = in  + b * iS[0] + c * iS[1];
+                  T* pOut = out + b * oS[0] + c * oS[1];
+            Nd4jLong* pArg = argmax == nullptr ? nullptr : argmax + plane * oH * oW;
+
+            // kernel rows are reduced first with one contiguous sweep each, overlapping windows along width reuse it
+            std::unique_ptr<T[]> cols(argmax == nullptr ? new T[iW] : nullptr);
+            Nd4jLong hstart, hend, wstart, wend;
+
+            for(int oh = 0; oh < oH; ++oh) {
+                poolingWindow(oh, kH, sH, pH, dH, iH, hstart, hend);
+
+                if(pArg != nullptr) {
+                    for(int ow = 0; ow < oW; ++ow) {
+                        poolingWindow(ow, kW, sW, pW, dW, iW, wstart, wend);
+                        T max = minValue;
+                        Nd4jLong pos = -1;
+                        for(Nd4jLong h = hstart; h < hend; h += dH)
+                            for(Nd4jLong w = wstart; w < wend; w += dW) {
+                                T val = pIn[h * iS[2] + w];
+                                if(val > max) {
+                                    max = val;
+                                    pos = c * aC + h * aH + w * aW;
+                                }
+                            }
+                        pOut[oh * oS[2] + ow] = max;
+                        pArg[oh * oW + ow] = pos;
+                    }
+                    continue;
+                }
+
+                T* pCols = cols.get();
+                const T init = isMax ? minValue : static_cast<T>(0.f);
+
+                PRAGMA_OMP_SIMD
+                for(int w = 0; w < iW; ++w)
+                    pCols[w] = init;
+
+                for(Nd4jLong h = hstart; h < hend; h += dH) {
+                    const T* row = pIn + h * iS[2];
+                    if(isMax) {
+                        PRAGMA_OMP_SIMD
+                        for(int w = 0; w < iW; ++w)
+                            pCols[w] = row[w] > pCols[w] ? row[w] : pCols[w];
+                    }
+                    else {
+                        PRAGMA_OMP_SIMD
+                        for(int w = 0; w < iW; ++w)
+                            pCols[w] += row[w];
+                    }
+                }
+
+                const Nd4jLong rows = poolingWindowSize(hstart, hend, dH);
+
+                for(int ow = 0; ow < oW; ++ow) {
+                    poolingWindow(ow, kW, sW, pW, dW, iW, wstart, wend);
+                    T val = init;
+                    if(isMax) {
+                        for(Nd4jLong w = wstart; w < wend; w += dW)
+                            val = pCols[w] > val ? pCols[w] : val;
+                    }
+                    else {
+                        for(Nd4jLong w = wstart; w < wend; w += dW)
+                            val += pCols[w];
+
+                        if (extraParam0 == 0)           //Exclude padding
+                            val /= static_cast<T>(rows * poolingWindowSize(wstart, wend, dW));
+                        else if (extraParam0 == 1)      //Include padding
+                            val /= static_cast<T>(kProd);
+                    }
+                    pOut[oh * oS[2] + ow] = val;
+                }
+            }
+        }
+        return true;
+    }
+
+    // channels-last: every window element is contiguous vector of channels
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided) collapse(2))
+    for(int b = 0; b < bS; ++b) {
+        for(int oh = 0; oh < oH; ++oh) {
+            const T* pIn = in + b * iS[0];
+            std::vector<Nd4jLong> pos(argmax == nullptr ? 0 : iC);
+            Nd4jLong hstart, hend, wstart, wend;
+            poolingWindow(oh, kH, sH, pH, dH, iH, hstart, hend);
+
+            for(int ow = 0; ow < oW; ++ow) {
+                poolingWindow(ow, kW, sW, pW, dW, iW, wstart, wend);
+                T* pOut = out + b * oS[0] + oh * oS[2] + ow * oS[3];
+
+                if(argmax != nullptr) {
+                    Nd4jLong* pPos = pos.data();
+                    for(int c = 0; c < iC; ++c) {
+                        pOut[c] = minValue;
+                        pPos[c] = -1;
+                    }
+
+                    for(Nd4jLong h = hstart; h < hend; h += dH)
+                        for(Nd4jLong w = wstart; w < wend; w += dW) {
+                            const T* pix = pIn + h * iS[2] + w * iS[3];
+                            const Nd4jLong base = h * aH + w * aW;
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                if(pix[c] > pOut[c]) {
+                                    pOut[c] = pix[c];
+                                    pPos[c] = base + c * aC;
+                                }
+                        }
+
+                    for(int c = 0; c < iC; ++c)
+                        argmax[(((Nd4jLong) b * iC + c) * oH + oh) * oW + ow] = pPos[c];
+                    continue;
+                }
+
+                const T init = isMax ? minValue : static_cast<T>(0.f);
+                PRAGMA_OMP_SIMD
+                for(int c = 0; c < iC; ++c)
+                    pOut[c] = init;
+
+                for(Nd4jLong h = hstart; h < hend; h += dH)
+                    for(Nd4jLong w = wstart; w < wend; w += dW) {
+                        const T* pix = pIn + h * iS[2] + w * iS[3];
+                        if(isMax) {
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                pOut[c] = pix[c] > pOut[c] ? pix[c] : pOut[c];
+                        }
+                        else {
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                pOut[c] += pix[c];
+                        }
+                    }
+
+                if(!isMax && extraParam0 <= 1) {
+                    const T divisor = extraParam0 == 0 ? static_cast<T>(poolingWindowSize(hstart, hend, dH) * poolingWindowSize(wstart, wend, dW)) : static_cast<T>(kProd);
+                    PRAGMA_OMP_SIMD
+                    for(int c = 0; c < iC; ++c)
+                        pOut[c] /= divisor;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Dense backprop kernels for max/avg modes, layouts are the same as for pooling2dDense_, input and gradI must share strides.
+// gradI is expected to be zeroed already. Tasks never share gradI elements: planes for NCHW, channel blocks for NHWC.
+template <typename T>
+static bool pooling2dBPDense_(const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
+
+    if(poolingMode > 1)
+        return false;
+
+    const T* in = const_cast<NDArray&>(input).bufferAsT<T>();
+    const T* gO = const_cast<NDArray&>(gradO).bufferAsT<T>();
+          T* gI = gradI.bufferAsT<T>();
+
+    const int bS = gradI.sizeAt(0);
+    const int iC = gradI.sizeAt(1);
+    const int iH = gradI.sizeAt(2);
+    const int iW = gradI.sizeAt(3);
+    const int oH = gradO.sizeAt(2);
+    const int oW = gradO.sizeAt(3);
+
+    const Nd4jLong* iS = gradI.stridesOf();
+    const Nd4jLong* oS = gradO.stridesOf();
+
+    for(int e = 0; e < 4; ++e)
+        if(input.stridesOf()[e] != iS[e])
+            return false;
+
+    const bool planar = iS[3] == 1 && oS[3] == 1;
+    const bool interleaved = !planar && iS[1] == 1 && oS[1] == 1;
+    if(!planar && !interleaved)
+        return false;
+
+    const int  kProd    = kH * kW;
+    const bool isMax    = poolingMode == 0;
+    const T    minValue = -DataTypeUtils::max<T>();
+
+    if(planar) {
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for(Nd4jLong plane = 0; plane < (Nd4jLong) bS * iC; ++plane) {
+            const Nd4jLong b = plane / iC;
+            const Nd4jLong c = plane % iC;
+            const T* pIn  = in + b * iS[0] + c * iS[1];
+                  T* pgI  = gI + b * iS[0] + c * iS[1];
+            const T* pgO  = gO + b * oS[0] + c * oS[1];
+            Nd4jLong hstart, hend, wstart, wend;
+
+            for(int oh = 0; oh < oH; ++oh) {
+                poolingWindow(oh, kH, sH, pH, dH, iH, hstart, hend);
+
+                for(int ow = 0; ow < oW; ++ow) {
+                    poolingWindow(ow, kW, sW, pW, dW, iW, wstart, wend);
+                    T valO = pgO[oh * oS[2] + ow * oS[3]];
+
+                    if(isMax) {
+                        T max = minValue;
+                        Nd4jLong pos = -1;
+                        for(Nd4jLong h = hstart; h < hend; h += dH)
+                            for(Nd4jLong w = wstart; w < wend; w += dW) {
+                                T val = pIn[h * iS[2] + w];
+                                if(val > max) {
+                                    max = val;
+                                    pos = h * iS[2] + w;
+                                }
+                            }
+                        if(pos >= 0)
+                            pgI[pos] += valO;
+                    }
+                    else {
+                        if (extraParam0 == 0)           //Exclude padding
+                            valO /= static_cast<T>(poolingWindowSize(hstart, hend, dH) * poolingWindowSize(wstart, wend, dW));
+                        else if (extraParam0 == 1)      //Include padding
+                            valO /= static_cast<T>(kProd);
+
+                        for(Nd4jLong h = hstart; h < hend; h += dH) {
+                            T* row = pgI + h * iS[2];
+                            PRAGMA_OMP_SIMD
+                            for(Nd4jLong w = wstart; w < wend; w += dW)
+                                row[w] += valO;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // channels-last: argmax of window is found for block of channels at once, then gradients are scattered
+    const int numBlocks = (iC + kPoolingChannelsBlock - 1) / kPoolingChannelsBlock;
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided) collapse(2))
+    for(int b = 0; b < bS; ++b) {
+        for(int block = 0; block < numBlocks; ++block) {
+            const int cStart = block * kPoolingChannelsBlock;
+            const int cSize  = nd4j::math::nd4j_min<int>(kPoolingChannelsBlock, iC - cStart);
+
+            const T* pIn = in + b * iS[0] + cStart;
+                  T* pgI = gI + b * iS[0] + cStart;
+
+            T maxVal[kPoolingChannelsBlock];
+            Nd4jLong maxPos[kPoolingChannelsBlock];
+            Nd4jLong hstart, hend, wstart, wend;
+
+            for(int oh = 0; oh < oH; ++oh) {
+                poolingWindow(oh, kH, sH, pH, dH, iH, hstart, hend);
+
+                for(int ow = 0; ow < oW; ++ow) {
+                    poolingWindow(ow, kW, sW, pW, dW, iW, wstart, wend);
+                    const T* pgO = gO + b * oS[0] + oh * oS[2] + ow * oS[3] + cStart;
+
+                    if(isMax) {
+                        for(int c = 0; c < cSize; ++c) {
+                            maxVal[c] = minValue;
+                            maxPos[c] = -1;
+                        }
+
+                        for(Nd4jLong h = hstart; h < hend; h += dH)
+                            for(Nd4jLong w = wstart; w < wend; w += dW) {
+                                const Nd4jLong offset = h * iS[2] + w * iS[3];
+                                const T* pix = pIn + offset;
+                                PRAGMA_OMP_SIMD
+                                for(int c = 0; c < cSize; ++c)
+                                    if(pix[c] > maxVal[c]) {
+                                        maxVal[c] = pix[c];
+                                        maxPos[c] = offset;
+                                    }
+                            }
+
+                        for(int c = 0; c < cSize; ++c)
+                            if(maxPos[c] >= 0)
+                                pgI[maxPos[c] + c] += pgO[c];
+                    }
+                    else {
+                        T divisor = static_cast<T>(1.f);
+                        if (extraParam0 == 0)           //Exclude padding
+                            divisor = static_cast<T>(poolingWindowSize(hstart, hend, dH) * poolingWindowSize(wstart, wend, dW));
+                        else if (extraParam0 == 1)      //Include padding
+                            divisor = static_cast<T>(kProd);
+
+                        for(int c = 0; c < cSize; ++c)
+                            maxVal[c] = pgO[c] / divisor;
+
+                        for(Nd4jLong h = hstart; h < hend; h += dH)
+                            for(Nd4jLong w = wstart; w < wend; w += dW) {
+                                T* pix = pgI + h * iS[2] + w * iS[3];
+                                PRAGMA_OMP_SIMD
+                                for(int c = 0; c < cSize; ++c)
+                                    pix[c] += maxVal[c];
+                            }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void maxPooling2dWithArgmax_(const NDArray& input, NDArray& output, NDArray& indices, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const bool isNCHW) {
+    // input is  [bS, iC, iH, iW]
+    // output and indices are [bS, iC, oH, oW]
+
+    std::vector<Nd4jLong> argmax(output.lengthOf());
+
+    if(!pooling2dDense_<T>(input, output, argmax.data(), isNCHW, kH, kW, sH, sW, pH, pW, dH, dW, 0, 1)) {
+        // arbitrary strides, make dense copies
+        NDArray* in  = const_cast<NDArray&>(input).dup('c');
+        NDArray* out = output.dup('c');
+        pooling2dDense_<T>(*in, *out, argmax.data(), isNCHW, kH, kW, sH, sW, pH, pW, dH, dW, 0, 1);
+        output.assign(out);
+        delete in;
+        delete out;
+    }
+
+    const int iC = output.sizeAt(1);
+    const int oH = output.sizeAt(2);
+    const int oW = output.sizeAt(3);
+    const Nd4jLong* s = indices.stridesOf();
+    Nd4jLong* idx = indices.bufferAsT<Nd4jLong>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(argmax.size() > Environment::getInstance()->elementwiseThreshold())
+    for(Nd4jLong plane = 0; plane < (Nd4jLong) output.sizeAt(0) * iC; ++plane) {
+        const Nd4jLong* pArg = argmax.data() + plane * oH * oW;
+        Nd4jLong* pIdx = idx + (plane / iC) * s[0] + (plane % iC) * s[1];
+        for(int oh = 0; oh < oH; ++oh)
+            for(int ow = 0; ow < oW; ++ow)
+                pIdx[oh * s[2] + ow * s[3]] = pArg[oh * oW + ow];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void maxPooling2dBPWithArgmax_(const NDArray& indices, const NDArray& gradO, NDArray& gradI, const bool isNCHW) {
+    // indices and gradO are [bS, iC, oH, oW]
+    // gradI is [bS, iC, iH, iW]
+
+    gradI.assign(0.f);
+
+    const T* gO = const_cast<NDArray&>(gradO).bufferAsT<T>();
+          T* gI = gradI.bufferAsT<T>();
+    const Nd4jLong* idx = const_cast<NDArray&>(indices).bufferAsT<Nd4jLong>();
+
+    const int iC = gradI.sizeAt(1);
+    const int iH = gradI.sizeAt(2);
+    const int iW = gradI.sizeAt(3);
+    const int oH = gradO.sizeAt(2);
+    const int oW = gradO.sizeAt(3);
+
+    const Nd4jLong* iS = gradI.stridesOf();
+    const Nd4jLong* oS = gradO.stridesOf();
+    const Nd4jLong* xS = indices.stridesOf();
+
+    // index of max element within image always belongs to the same channel, so planes never share gradI elements
+    PRAGMA_OMP_PARALLEL_FOR_IF(gradO.lengthOf() > Environment::getInstance()->elementwiseThreshold())
+    for(Nd4jLong plane = 0; plane < (Nd4jLong) gradI.sizeAt(0) * iC; ++plane) {
+        const Nd4jLong b = plane / iC;
+        const Nd4jLong c = plane % iC;
+              T* pgI  = gI  + b * iS[0] + c * iS[1];
+        const T* pgO  = gO  + b * oS[0] + c * oS[1];
+        const Nd4jLong* pIdx = idx + b * xS[0] + c * xS[1];
+
+        for(int oh = 0; oh < oH; ++oh)
+            for(int ow = 0; ow < oW; ++ow) {
+                const Nd4jLong pos = pIdx[oh * xS[2] + ow * xS[3]];
+                if(pos < 0)
+                    continue;
+
+                const Nd4jLong h = isNCHW ? (pos / iW) % iH : pos / ((Nd4jLong) iW * iC);
+                const Nd4jLong w = isNCHW ? pos % iW : (pos / iC) % iW;
+                pgI[h * iS[2] + w * iS[3]] += pgO[oh * oS[2] + ow * oS[3]];
+            }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename T>
 static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
@@ -1467,6 +1910,9 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
 #endif
     nd4j_debug("MKL-DNN is not used for pooling2d!\n", 0);
 
+    if(pooling2dDense_<T>(input, output, nullptr, true, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0))
+        return;
+
     const Nd4jLong iStride0 = input.stridesOf()[0];
     const Nd4jLong iStride1 = input.stridesOf()[1];
     const Nd4jLong iStride2 = input.stridesOf()[2];
@@ -2022,6 +2468,9 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
 #endif
     nd4j_debug("MKL-DNN is not used for pooling2d_bp!\n", 0);
 
+    if(pooling2dBPDense_<T>(input, gradO, gradI, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0))
+        return;
+
     const Nd4jLong iStride0 = gradI.stridesOf()[0];
     const Nd4jLong iStride1 = gradI.stridesOf()[1];
     const Nd4jLong iStride2 = gradI.stridesOf()[2];
@@ -2555,6 +3004,12 @@ void ConvolutionUtils::upsampling3dBP(const NDArray& gradO, NDArray& gradI, cons
 void ConvolutionUtils::pooling2d(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
     BUILD_SINGLE_SELECTOR(input.dataType(), pooling2d_, (block, input, output, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0), LIBND4J_TYPES);
 }
+void ConvolutionUtils::maxPooling2dWithArgmax(const NDArray& input, NDArray& output, NDArray& indices, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const bool isNCHW) {
+    BUILD_SINGLE_SELECTOR(input.dataType(), maxPooling2dWithArgmax_, (input, output, indices, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW), LIBND4J_TYPES);
+}
+void ConvolutionUtils::maxPooling2dBPWithArgmax(const NDArray& indices, const NDArray& gradO, NDArray& gradI, const bool isNCHW) {
+    BUILD_SINGLE_SELECTOR(gradO.dataType(), maxPooling2dBPWithArgmax_, (indices, gradO, gradI, isNCHW), LIBND4J_TYPES);
+}
 void ConvolutionUtils::pooling3d(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0) {
     BUILD_SINGLE_SELECTOR(input.dataType(), pooling3d_, (block, input, output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0), LIBND4J_TYPES);
 }
@@ -2579,6 +3034,8 @@ BUILD_SINGLE_TEMPLATE(template void upsampling3dBP_, (const NDArray& gradO, NDAr
 BUILD_SINGLE_TEMPLATE(template void vol2col_,        (const NDArray& volume, NDArray& columns, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void col2vol_,        (const NDArray& columns, NDArray& volume, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling2d_,      (nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
+BUILD_SINGLE_TEMPLATE(template void maxPooling2dWithArgmax_, (const NDArray& input, NDArray& output, NDArray& indices, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const bool isNCHW), LIBND4J_TYPES);
+BUILD_SINGLE_TEMPLATE(template void maxPooling2dBPWithArgmax_, (const NDArray& indices, const NDArray& gradO, NDArray& gradI, const bool isNCHW), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling3d_,      (nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling2dBP_,    (nd4j::graph::Context& block, const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling3dBP_,    (nd4j::graph::Context& block, const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
@@ -354,6 +354,16 @@ CUSTOM_OP_IMPL(batchnorm_bp, 4, 3, false, 1, 2) {
     REQUIRE_TRUE(areShapesOk, 0, "BATCHNORM_BP op: the shapes of input arrays are not mutually broadcastable !");    
     RELEASE(outShapeInfo, block.getWorkspace());
 
+    // per-channel params and dense arrays of the same type: all gradients are evaluated in single pass
+    const int channelAxis = helpers::batchnormChannelAxis(input, {mean, variance, gamma, beta, dLdM, dLdV, dLdG, dLdB});
+    if(channelAxis >= 0 && dLdO->isSameShape(input) && dLdI->isSameShape(input) &&
+       dLdO->ordering() == 'c' && dLdO->ews() == 1 && dLdI->ordering() == 'c' && dLdI->ews() == 1 &&
+       input->dataType() == dLdO->dataType() && input->dataType() == dLdI->dataType() && input->dataType() == mean->dataType()) {
+
+        helpers::batchnormBp(input, mean, variance, gamma, dLdO, dLdI, dLdM, dLdV, dLdG, dLdB, channelAxis, epsilon);
+        return Status::OK();
+    }
+
     // ***** calculations ***** //
 
     auto sigmaInv = (*variance + epsilon).transform(transform::RSqrt);
@@ -22,6 +22,7 @@
 #if NOT_EXCLUDED(OP_fused_batch_norm)
 
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/batchnorm.h>
 
 namespace nd4j {
 namespace ops {
@@ -71,9 +72,6 @@ CUSTOM_OP_IMPL(fused_batch_norm, 3, 1, false, 0, 2) {
     }
     else {
         REQUIRE_TRUE(block.width() == 3, 0, "CUSTOM_OP fused_batch_norm: when isTraining=true then number of input arrays must be equal to 3, but got %i instead !", block.width());   
-        std::vector<Nd4jLong> shape = {iD};
-        mean = NDArrayFactory::create_(scale->ordering(), shape, scale->dataType(), block.getWorkspace());
-        variance = NDArrayFactory::create_(scale->ordering(), shape, scale->dataType(), block.getWorkspace());
     }
 
     // FIXME: double?
@@ -84,44 +82,57 @@ CUSTOM_OP_IMPL(fused_batch_norm, 3, 1, false, 0, 2) {
         epsilon = 0.001;
     
     const int restSize = x->lengthOf() / iD;    
-    auto xAffected = NDArrayFactory::create(x->ordering(), {restSize, iD}, x->dataType(), block.getWorkspace());
-    xAffected.assign(x);
-
     const int restSizeMinusOne = (restSize > 1) ? (restSize - 1) : 1;
     // FIXME: float?
-    const double restSizeInv = 1.0 / restSize;
     const double restSizeAdjust = (double)restSize / restSizeMinusOne;
 
+    // kernels below work on dense c-ordered arrays of output type
+    const auto dtype = y->dataType();
+    const int axis = dataFormat ? 1 : 3;
+
+    std::vector<NDArray*> temporaries;
+    auto prepare = [&](NDArray* arr) -> NDArray* {
+        if(arr->dataType() == dtype && arr->ordering() == 'c' && arr->ews() == 1)
+            return arr;
+        auto tmp = NDArrayFactory::create_('c', arr->getShapeAsVector(), dtype, block.getWorkspace());
+        tmp->assign(arr);
+        temporaries.push_back(tmp);
+        return tmp;
+    };
+
+    auto xIn      = prepare(x);
+    auto scaleIn  = prepare(scale);
+    auto offsetIn = prepare(offset);
+
     if(isTraining) {
-        auto sum = xAffected.reduceAlongDims(reduce::Sum, {0});
-        sum *= restSizeInv;
-        mean->assign(sum);
-        *batchMean = *mean;
-        //delete sum;
+        // single pass statistics, then single normalization pass
+        mean     = NDArrayFactory::create_('c', {iD}, dtype, block.getWorkspace());
+        variance = NDArrayFactory::create_('c', {iD}, dtype, block.getWorkspace());
+        temporaries.push_back(mean);
+        temporaries.push_back(variance);
+        helpers::batchnormStats(xIn, mean, variance, axis);
     }
-    else 
-        *batchMean = 0.;
-    
-    xAffected -= *mean;
-
-    if(isTraining) {        
-        int power = 2;
-        xAffected.applyScalar(scalar::Pow, power);
-        auto sum = xAffected.reduceAlongDims(reduce::Sum, {0});
-        sum *= restSizeInv;
-        variance->assign(sum);
-        *batchVar  = (*variance) * restSizeAdjust;
-        //delete sum;
+    else {
+        mean     = prepare(mean);
+        variance = prepare(variance);
     }
-    else 
-        *batchVar  = 0.;      
-    xAffected *= (*variance + epsilon).transform(transform::RSqrt) * (*scale) + (*offset);
-    y->assign( xAffected );
+
+    auto yOut = y->ordering() == 'c' && y->ews() == 1 ? y : prepare(y);
+    helpers::batchnorm(xIn, mean, variance, scaleIn, offsetIn, yOut, {axis}, epsilon);
+    if(yOut != y)
+        y->assign(yOut);
 
     if(isTraining) {
-        delete mean;
-        delete variance;
+        batchMean->assign(mean);
+        batchVar->assign(*variance * restSizeAdjust);
     }
+    else {
+        *batchMean = 0.;
+        *batchVar  = 0.;
+    }
+
+    for(auto tmp : temporaries)
+        delete tmp;
 
     return Status::OK();
 }
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/image_suppression.h>
+
+#if NOT_EXCLUDED(OP_combined_non_max_suppression)
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(combined_non_max_suppression, 2, 4, false, 0, 2) {
+            auto boxes = INPUT_VARIABLE(0);
+            auto scores = INPUT_VARIABLE(1);
+
+            auto nmsedBoxes = OUTPUT_VARIABLE(0);
+            auto nmsedScores = OUTPUT_VARIABLE(1);
+            auto nmsedClasses = OUTPUT_VARIABLE(2);
+            auto validDetections = OUTPUT_VARIABLE(3);
+
+            REQUIRE_TRUE(boxes->rankOf() == 4 && boxes->sizeAt(3) == 4, 0, "image.combined_non_max_suppression: boxes should have shape [batch, num_boxes, q, 4]");
+            REQUIRE_TRUE(scores->rankOf() == 3, 0, "image.combined_non_max_suppression: The rank of scores array should be 3, but %i is given", scores->rankOf());
+            REQUIRE_TRUE(scores->sizeAt(0) == boxes->sizeAt(0) && scores->sizeAt(1) == boxes->sizeAt(1), 0, "image.combined_non_max_suppression: boxes and scores should have the same batch size and number of boxes");
+            REQUIRE_TRUE(boxes->sizeAt(2) == 1 || boxes->sizeAt(2) == scores->sizeAt(2), 0, "image.combined_non_max_suppression: q dimension of boxes should be either 1 or number of classes, but %i is given", (int) boxes->sizeAt(2));
+
+            int maxOutputPerClass = INT_ARG(0);
+            int maxTotalSize = INT_ARG(1);
+            REQUIRE_TRUE(maxOutputPerClass > 0 && maxTotalSize > 0, 0, "image.combined_non_max_suppression: output sizes should be positive");
+
+            // with pad_per_class output may be shorter than max_total_size, shape function has decided that already
+            maxTotalSize = nmsedScores->sizeAt(1);
+
+            bool clipBoxes = false;
+            if (block.getIArguments()->size() > 3)
+                clipBoxes = INT_ARG(3) != 0;
+
+            double threshold = 0.5;
+            if (block.getTArguments()->size() > 0)
+                threshold = T_ARG(0);
+
+            double scoreThreshold = -std::numeric_limits<double>::infinity();
+            if (block.getTArguments()->size() > 1)
+                scoreThreshold = T_ARG(1);
+
+            double softNmsSigma = 0.;
+            if (block.getTArguments()->size() > 2)
+                softNmsSigma = T_ARG(2);
+
+            helpers::combinedNonMaxSuppression(boxes, scores, maxOutputPerClass, maxTotalSize, threshold, scoreThreshold, softNmsSigma, clipBoxes, nmsedBoxes, nmsedScores, nmsedClasses, validDetections);
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(combined_non_max_suppression) {
+            auto boxes = inputShape->at(0);
+            auto scores = inputShape->at(1);
+
+            Nd4jLong batchSize = shape::sizeAt(boxes, 0);
+            Nd4jLong maxTotalSize = INT_ARG(1);
+
+            bool padPerClass = block.getIArguments()->size() > 2 && INT_ARG(2) != 0;
+            if (padPerClass)
+                maxTotalSize = nd4j::math::nd4j_min<Nd4jLong>(maxTotalSize, static_cast<Nd4jLong>(INT_ARG(0)) * shape::sizeAt(scores, 2));
+
+            auto nmsedBoxes = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(boxes), 'c', {batchSize, maxTotalSize, 4}, block.getWorkspace());
+            auto nmsedScores = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(scores), 'c', {batchSize, maxTotalSize}, block.getWorkspace());
+            auto nmsedClasses = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(scores), 'c', {batchSize, maxTotalSize}, block.getWorkspace());
+            auto validDetections = ShapeBuilders::createVectorShapeInfo(nd4j::DataType::INT32, batchSize, block.getWorkspace());
+
+            return SHAPELIST(nmsedBoxes, nmsedScores, nmsedClasses, validDetections);
+        }
+
+        DECLARE_TYPES(combined_non_max_suppression) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(2, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(3, {ALL_INTS});
+        }
+    }
+}
+#endif
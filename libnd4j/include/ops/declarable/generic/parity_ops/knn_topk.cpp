@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_knn_topk)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/knn.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(knn_topk, 2, 2, false, 0, 1) {
+            auto queries = INPUT_VARIABLE(0);
+            auto base = INPUT_VARIABLE(1);
+
+            auto distances = OUTPUT_VARIABLE(0);
+            auto indices = OUTPUT_VARIABLE(1);
+
+            const int k = INT_ARG(0);
+            const int metric = block.numI() > 1 ? INT_ARG(1) : (int) helpers::KNN_EUCLIDEAN;
+
+            REQUIRE_TRUE(queries->rankOf() == 2 && base->rankOf() == 2, 0, "knn_topk: queries and base should be 2D matrices, but got ranks %i and %i", queries->rankOf(), base->rankOf());
+            REQUIRE_TRUE(queries->sizeAt(1) == base->sizeAt(1), 0, "knn_topk: queries and base should have the same number of columns, but got %i and %i", (int) queries->sizeAt(1), (int) base->sizeAt(1));
+            REQUIRE_TRUE(queries->dataType() == base->dataType(), 0, "knn_topk: queries and base should have the same data type");
+            REQUIRE_TRUE(k > 0 && k <= base->sizeAt(0), 0, "knn_topk: k should be in range [1, %i], but got %i", (int) base->sizeAt(0), k);
+            REQUIRE_TRUE(metric >= (int) helpers::KNN_EUCLIDEAN && metric <= (int) helpers::KNN_DOT, 0, "knn_topk: unknown metric %i", metric);
+
+            helpers::knnTopK(queries, base, k, metric, distances, indices);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(knn_topk) {
+            auto queries = inputShape->at(0);
+            const Nd4jLong k = INT_ARG(0);
+            const Nd4jLong numQueries = shape::sizeAt(queries, 0);
+
+            // distances are computed in fp32 for everything but double
+            auto dtype = ArrayOptions::dataType(queries) == nd4j::DataType::DOUBLE ? nd4j::DataType::DOUBLE : nd4j::DataType::FLOAT32;
+
+            auto distances = ShapeBuilders::createShapeInfo(dtype, 'c', {numQueries, k}, block.getWorkspace());
+            auto indices = ShapeBuilders::createShapeInfo(nd4j::DataType::INT64, 'c', {numQueries, k}, block.getWorkspace());
+
+            return SHAPELIST(distances, indices);
+        }
+
+        DECLARE_TYPES(knn_topk) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_INTS, ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(1, {ALL_INTS});
+        }
+    }
+}
+
+#endif
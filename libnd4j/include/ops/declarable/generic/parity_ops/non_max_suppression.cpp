@@ -46,7 +46,15 @@ namespace nd4j {
             if (block.getTArguments()->size() > 0)
                 threshold = T_ARG(0);
 
-            helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, output);
+            double scoreThreshold = -std::numeric_limits<double>::infinity();
+            if (block.getTArguments()->size() > 1)
+                scoreThreshold = T_ARG(1);
+
+            double softNmsSigma = 0.;
+            if (block.getTArguments()->size() > 2)
+                softNmsSigma = T_ARG(2);
+
+            helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, output, scoreThreshold, softNmsSigma);
             return Status::OK();
         }
 
@@ -55,7 +63,12 @@ namespace nd4j {
             int outRank = shape::rank(in);
             Nd4jLong *outputShape = nullptr;
 
-            int maxOutputSize = INT_ARG(0);
+            int maxOutputSize;
+            if (block.width() > 2)
+                maxOutputSize = INPUT_VARIABLE(2)->e<int>(0);
+            else
+                maxOutputSize = INT_ARG(0);
+
             Nd4jLong boxSize = shape::sizeAt(in, 0);
             if (boxSize < maxOutputSize) 
                 maxOutputSize = boxSize;
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_resize_area)
+
+//#include <ops/declarable/headers/parity_ops.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/image_resize.h>
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(resize_area, 1, 1, false, 0, -2) {
+
+            NDArray* image = INPUT_VARIABLE(0);
+            NDArray* output = OUTPUT_VARIABLE(0);
+            int width;
+            int height;
+            bool center = false; // - default value
+            bool isNCHW = false;
+            if (block.width() > 1) {
+                auto newImageSize = INPUT_VARIABLE(1);
+                REQUIRE_TRUE(newImageSize->lengthOf() == 2, 0, "resize_area: Resize params is a pair of values, not %i.", newImageSize->lengthOf());
+                REQUIRE_TRUE(block.numI() <= 2, 0, "resize_area: Resize params already given by the second param. Int params are expensive.");
+                width = newImageSize->e<int>(0);
+                height = newImageSize->e<int>(1);
+                if (block.numI() >= 1) {
+                    center = 0 != INT_ARG(0);
+                }
+                if (block.numI() == 2)
+                    isNCHW = 0 != INT_ARG(1);
+            }
+            else {
+                REQUIRE_TRUE(block.numI() >= 2 && block.numI() <= 4, 0, "resize_area: Neither resize width nor height are provided.");
+                width = INT_ARG(0);
+                height = INT_ARG(1);
+                if (block.numI() >= 3)
+                    center = 0 != INT_ARG(2);
+                if (block.numI() == 4)
+                    isNCHW = 0 != INT_ARG(3);
+            }
+
+            REQUIRE_TRUE(image->rankOf() == 4, 0, "resize_area: Image should be 4D tensor, but got %i.", image->rankOf());
+            if (image->dataType() == output->dataType())
+                return helpers::resizeAreaFunctor(image, width, height, center, output, isNCHW);
+
+            // output of another type is accepted: images are resized in their own type, and result is cast
+            NDArray resized(output->ordering(), output->getShapeAsVector(), image->dataType(), block.getWorkspace());
+            auto status = helpers::resizeAreaFunctor(image, width, height, center, &resized, isNCHW);
+            output->assign(resized);
+
+            return status;
+        }
+
+        DECLARE_SHAPE_FN(resize_area) {
+            auto shapeList = SHAPELIST(); 
+            auto in = inputShape->at(0);
+
+            Nd4jLong* outputShape;
+
+            int width;
+            int height;
+            bool isNCHW = false;
+            if (block.width() > 1) {
+                auto newImageSize = INPUT_VARIABLE(1);
+                REQUIRE_TRUE(newImageSize->lengthOf() == 2, 0, "resize_area: Resize params is a pair of values, not %i.", newImageSize->lengthOf());
+                REQUIRE_TRUE(block.numI() <= 2, 0, "resize_area: Resize params already given by the second param. Int params are expensive.");
+                width = newImageSize->e<int>(0);
+                height = newImageSize->e<int>(1);
+                if (block.numI() == 2)
+                    isNCHW = 0 != INT_ARG(1);
+            }
+            else {
+                REQUIRE_TRUE(block.numI() >= 2 && block.numI() <= 4, 0, "resize_area: Neither resize width nor height are provided.");
+                width = INT_ARG(0);
+                height = INT_ARG(1);
+                if (block.numI() == 4)
+                    isNCHW = 0 != INT_ARG(3);
+            }
+            
+            ALLOCATE(outputShape, block.getWorkspace(), shape::shapeInfoLength(4), Nd4jLong);
+            outputShape[0] = 4;
+            outputShape[1] = in[1];
+            if (isNCHW) {
+                outputShape[2] = in[2];
+                outputShape[3] = width;
+                outputShape[4] = height;
+            } else {
+                outputShape[2] = width;
+                outputShape[3] = height;
+                outputShape[4] = in[4];
+            }
+            ShapeUtils::updateStridesAndType(outputShape, in, shape::order(in));
+
+            shapeList->push_back(outputShape); 
+            return shapeList;
+        }
+        DECLARE_TYPES(resize_area) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(nd4j::DataType::ANY)
+                    ->setAllowedOutputTypes({ALL_FLOATS, ALL_INTS});
+        }
+
+    }
+}
+
+#endif
\ No newline at end of file
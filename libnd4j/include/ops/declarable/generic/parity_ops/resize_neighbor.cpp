@@ -34,25 +34,39 @@ namespace nd4j {
             int width;
             int height;
             bool center = false; // - default value
+            bool isNCHW = false;
             if (block.width() > 1) {
                 auto newImageSize = INPUT_VARIABLE(1);
                 REQUIRE_TRUE(newImageSize->lengthOf() == 2, 0, "resize_nearest_neighbor: Resize params is a pair of values, not %i.", newImageSize->lengthOf());
-                REQUIRE_TRUE(block.numI() <= 1, 0, "resize_nearest_neighbor: Resize params already given by the second param. Int params are expensive.");
+                REQUIRE_TRUE(block.numI() <= 2, 0, "resize_nearest_neighbor: Resize params already given by the second param. Int params are expensive.");
                 width = newImageSize->e<int>(0);
                 height = newImageSize->e<int>(1);
-                if (block.numI() == 1) {
+                if (block.numI() >= 1) {
                     center = 0 != INT_ARG(0);
                 }
+                if (block.numI() == 2)
+                    isNCHW = 0 != INT_ARG(1);
             }
             else {
-                REQUIRE_TRUE(block.numI() <= 3, 0, "resize_nearest_neighbor: Neither resize width nor height are provided.");
+                REQUIRE_TRUE(block.numI() >= 2 && block.numI() <= 4, 0, "resize_nearest_neighbor: Neither resize width nor height are provided.");
                 width = INT_ARG(0);
                 height = INT_ARG(1);
-                if (block.numI() == 3)
+                if (block.numI() >= 3)
                     center = 0 != INT_ARG(2);
+                if (block.numI() == 4)
+                    isNCHW = 0 != INT_ARG(3);
             }
 
-            return helpers::resizeNeighborFunctor(image, width, height, center, output);
+            REQUIRE_TRUE(image->rankOf() == 4, 0, "resize_nearest_neighbor: Image should be 4D tensor, but got %i.", image->rankOf());
+            if (image->dataType() == output->dataType())
+                return helpers::resizeNeighborFunctor(image, width, height, center, output, isNCHW);
+
+            // output of another type is accepted: images are resized in their own type, and result is cast
+            NDArray resized(output->ordering(), output->getShapeAsVector(), image->dataType(), block.getWorkspace());
+            auto status = helpers::resizeNeighborFunctor(image, width, height, center, &resized, isNCHW);
+            output->assign(resized);
+
+            return status;
         }
 
         DECLARE_SHAPE_FN(resize_nearest_neighbor) {
@@ -63,25 +77,36 @@ namespace nd4j {
 
             int width;
             int height;
+            bool isNCHW = false;
             if (block.width() > 1) {
                 auto newImageSize = INPUT_VARIABLE(1);
                 REQUIRE_TRUE(newImageSize->lengthOf() == 2, 0, "resize_nearest_neighbor: Resize params is a pair of values, not %i.", newImageSize->lengthOf());
-                REQUIRE_TRUE(block.numI() <= 1, 0, "resize_nearest_neighbor: Resize params already given by the second param. Int params are expensive.");
+                REQUIRE_TRUE(block.numI() <= 2, 0, "resize_nearest_neighbor: Resize params already given by the second param. Int params are expensive.");
                 width = newImageSize->e<int>(0);
                 height = newImageSize->e<int>(1);
+                if (block.numI() == 2)
+                    isNCHW = 0 != INT_ARG(1);
             }
             else {
-                REQUIRE_TRUE(block.numI() <= 3, 0, "resize_nearest_neighbor: Neither resize width nor height are provided.");
+                REQUIRE_TRUE(block.numI() >= 2 && block.numI() <= 4, 0, "resize_nearest_neighbor: Neither resize width nor height are provided.");
                 width = INT_ARG(0);
                 height = INT_ARG(1);
+                if (block.numI() == 4)
+                    isNCHW = 0 != INT_ARG(3);
             }
             
             ALLOCATE(outputShape, block.getWorkspace(), shape::shapeInfoLength(4), Nd4jLong);
             outputShape[0] = 4;
             outputShape[1] = in[1];
-            outputShape[2] = width;
-            outputShape[3] = height;
-            outputShape[4] = in[4];
+            if (isNCHW) {
+                outputShape[2] = in[2];
+                outputShape[3] = width;
+                outputShape[4] = height;
+            } else {
+                outputShape[2] = width;
+                outputShape[3] = height;
+                outputShape[4] = in[4];
+            }
             ShapeUtils::updateStridesAndType(outputShape, in, shape::order(in));
 
             shapeList->push_back(outputShape); 
@@ -90,7 +115,7 @@ namespace nd4j {
         DECLARE_TYPES(resize_nearest_neighbor) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS, ALL_INTS});
         }
 
     }
@@ -22,6 +22,7 @@
 #if NOT_EXCLUDED(OP_split)
 
 #include <ops/declarable/headers/parity_ops.h>
+#include <ops/declarable/helpers/transforms.h>
 #include <array>
 
 namespace nd4j {
@@ -65,6 +66,14 @@ namespace ops {
 
         REQUIRE_TRUE(input->sizeAt(axis) % num_splits == 0, 0, "Split: num_splits has wrong value, remainder of division should be 0, but it's %i", input->sizeAt(axis) % num_splits);
 
+        std::vector<NDArray*> outArrs(num_splits);
+        for (int e = 0; e < num_splits; e++)
+            outArrs[e] = OUTPUT_VARIABLE(e);
+
+        // dense arrays: memcpy of contiguous chunks, outputs which are views of input already aren't touched at all
+        if (helpers::splitDense(*input, outArrs, axis))
+            return Status::OK();
+
         int pos = 0;
         int split = input->sizeAt(axis) / num_splits;
         std::vector<Nd4jLong> indices(2 * input->rankOf());
@@ -22,6 +22,7 @@
 #if NOT_EXCLUDED(OP_unstack)
 
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/transforms.h>
 #include <helpers/ConstantTadHelper.h>
 
 namespace nd4j {
@@ -37,6 +38,14 @@ namespace nd4j {
             REQUIRE_TRUE(dim < input->rankOf(), 0, "Unstack dimension should be lower then rank of input %i, but got dimension=%i !", input->rankOf(), dim);
             REQUIRE_TRUE(dim >= 0, 0, "Unstack dimension should be non-negative value, but got %i !", dim);
 
+            std::vector<NDArray*> outArrs(input->sizeAt(dim));
+            for (int e = 0; e < (int) outArrs.size(); e++)
+                outArrs[e] = OUTPUT_VARIABLE(e);
+
+            // dense arrays: memcpy of contiguous chunks, outputs which are views of input already aren't touched at all
+            if (helpers::splitDense(*input, outArrs, dim))
+                return Status::OK();
+
             std::vector<int> dims;
             for (int e = 0; e < input->rankOf(); e++)
                 if (e != dim)
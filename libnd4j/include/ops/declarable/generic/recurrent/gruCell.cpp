@@ -73,7 +73,8 @@ DECLARE_TYPES(gruCell) {
         ->setAllowedInputTypes(2, {ALL_FLOATS})
         ->setAllowedInputTypes(3, {ALL_FLOATS})
         ->setAllowedInputTypes(4, {ALL_FLOATS})
-        ->setAllowedOutputTypes({ALL_FLOATS});
+        ->setAllowedOutputTypes({ALL_FLOATS})
+        ->setShapeCacheable(true);
 }
 
 
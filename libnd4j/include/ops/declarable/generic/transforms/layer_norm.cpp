@@ -23,6 +23,8 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
+#include <ops/declarable/helpers/layer_norm.h>
+#include <NDArrayExpression.h>
 
 
 namespace nd4j {
@@ -39,6 +41,12 @@ namespace ops  {
         if (block.width() > 2)
             bias = INPUT_VARIABLE(2);
 
+        // normalization along last dimension: statistics and output of every row in single pass
+        if (helpers::layerNormFusable(input, axis, {output}, {gain, bias})) {
+            helpers::layerNorm(input, gain, bias, output);
+            return Status::OK();
+        }
+
         std::vector<Nd4jLong> longAxis = ArrayUtils::toLongVector(axis);
 
         nd4j::ops::standardize standardizeOp;
@@ -48,9 +56,10 @@ namespace ops  {
         std::vector<bool> bargs = {};
         standardizeOp.execute(inputs, outputs, targs, longAxis, bargs);
 
-        output->applyTrueBroadcast(nd4j::BroadcastOpsTuple::Multiply(), gain, output);
         if(bias != nullptr)
-            output->applyTrueBroadcast(nd4j::BroadcastOpsTuple::Add(), bias, output);
+            output->assign(expr::lazy(*output) * (*gain) + (*bias));        // single pass instead of two broadcasts
+        else
+            output->applyTrueBroadcast(nd4j::BroadcastOpsTuple::Multiply(), gain, output);
 
         return Status::OK();
     }
@@ -73,6 +82,12 @@ namespace ops  {
 
         std::vector<int> axis = *block.getIArguments();;
 
+        // standardization isn't recomputed twice (for dLdg and inside standardize_bp) here, all gradients come from single pass
+        if (input->rankOf() == 2 && helpers::layerNormFusable(input, axis, {eps, dLdx}, {gain, bias, dLdg, dLdb})) {
+            helpers::layerNormBp(input, gain, eps, dLdx, dLdg, dLdb);
+            return Status::OK();
+        }
+
         std::vector<Nd4jLong> longAxis = ArrayUtils::toLongVector(axis);
 
         if(bias != nullptr)
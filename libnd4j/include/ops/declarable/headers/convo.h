@@ -140,6 +140,9 @@ namespace nd4j {
          * 6: dilation height
          * 7: dilation width
          * 8: same mode: 0 false, 1 true
+         *
+         * maxpool2d_bp optionally accepts 3rd input: indices produced by max_pool_with_argmax with the same IntArgs,
+         * then gradients are scattered to these positions without searching pooling windows again.
          */
         #if NOT_EXCLUDED(OP_maxpool2d)
         DECLARE_CUSTOM_OP(maxpool2d, 1, 1, false, 0, 10);
@@ -299,11 +302,12 @@ namespace nd4j {
          *
          * Input - 4D tensor
          * Output:
-         *     0 - 4D tensor as input
-         *     1 - 4D tensor with max value indexes
+         *     0 - 4D tensor with pooled values
+         *     1 - 4D tensor with max value indexes, linear positions within image in input data format
          *     
          * Int params:
          *   9 int with 2x4 vectors and 1 bool value
+         *   optional 10th and 11th: divisor (unused), data format - 0 for NCHW (default), 1 for NHWC
          */
         #if NOT_EXCLUDED(OP_max_pool_woth_argmax)
         DECLARE_CUSTOM_OP(max_pool_with_argmax, 1, 2, false, 0, 9);
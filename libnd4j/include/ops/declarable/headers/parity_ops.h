@@ -1498,7 +1498,7 @@ namespace nd4j {
         *   0 - mode (default 0 - bilinear interpolation)
         *
         * output array:
-        *   the 4D-Tensor with resized to crop_size images given - float type
+        *   the 4D-Tensor with resized to crop_size images given - same type as images
         */
         #if NOT_EXCLUDED(OP_crop_and_resize)
         DECLARE_CUSTOM_OP(crop_and_resize, 4, 1, false, -1, -1);
@@ -1514,11 +1514,15 @@ namespace nd4j {
         * int arguments: (optional)
         *   0 - new width
         *   1 - new height
+        *   2 - align corners, default 0
+        *   3 - data format: 0 - NHWC (default), 1 - NCHW
+        *   when size tensor is given, int arguments are shifted: 0 - align corners, 1 - data format
         *
         * output array:
-        *   the 4D-Tensor with calculated backproped dots
+        *   the 4D-Tensor with resized images, of the same data type as input. Output of another type is accepted,
+        *   resize is done in input type then, and result is cast
         *
-        * CAUTION: either size tensor or a pair of int params should be provided.
+        * CAUTION: either size tensor or a pair of int params should be provided, op fails if neither is given.
         */
 
         #if NOT_EXCLUDED(OP_resize_bilinear)
@@ -1535,17 +1539,71 @@ namespace nd4j {
         * int arguments: (optional)
         *   0 - new width
         *   1 - new height
+        *   2 - align corners, default 0
+        *   3 - data format: 0 - NHWC (default), 1 - NCHW
+        *   when size tensor is given, int arguments are shifted: 0 - align corners, 1 - data format
         *
         * output array:
-        *   the 4D-Tensor with calculated backproped dots
+        *   the 4D-Tensor with resized images, of the same data type as input. Output of another type is accepted,
+        *   resize is done in input type then, and result is cast
         *
-        * CAUTION: either size tensor or a pair of int params should be provided.
+        * CAUTION: either size tensor or a pair of int params should be provided, op fails if neither is given.
         */
 
         #if NOT_EXCLUDED(OP_resize_bilinear)
         DECLARE_CUSTOM_OP(resize_nearest_neighbor, 1, 1, false, 0, -2);
         #endif
 
+        /**
+        * This op make bicubic interpolated resize for given tensor
+        *
+        * input array:
+        *    0 - 4D-Tensor with shape (batch, sizeX, sizeY, channels)
+        *    1 - 1D-Tensor with 2 values (newWidth, newHeight) (optional)
+        *
+        * int arguments: (optional)
+        *   0 - new width
+        *   1 - new height
+        *   2 - align corners, default 0
+        *   3 - data format: 0 - NHWC (default), 1 - NCHW
+        *   when size tensor is given, int arguments are shifted: 0 - align corners, 1 - data format
+        *
+        * output array:
+        *   the 4D-Tensor with resized images, of the same data type as input. Output of another type is accepted,
+        *   resize is done in input type then, and result is cast
+        *
+        * CAUTION: either size tensor or a pair of int params should be provided, op fails if neither is given.
+        */
+
+        #if NOT_EXCLUDED(OP_resize_bicubic)
+        DECLARE_CUSTOM_OP(resize_bicubic, 1, 1, false, 0, -2);
+        #endif
+
+        /**
+        * This op make area interpolated resize for given tensor: each output pixel averages input pixels it covers
+        *
+        * input array:
+        *    0 - 4D-Tensor with shape (batch, sizeX, sizeY, channels)
+        *    1 - 1D-Tensor with 2 values (newWidth, newHeight) (optional)
+        *
+        * int arguments: (optional)
+        *   0 - new width
+        *   1 - new height
+        *   2 - align corners, default 0
+        *   3 - data format: 0 - NHWC (default), 1 - NCHW
+        *   when size tensor is given, int arguments are shifted: 0 - align corners, 1 - data format
+        *
+        * output array:
+        *   the 4D-Tensor with resized images, of the same data type as input. Output of another type is accepted,
+        *   resize is done in input type then, and result is cast
+        *
+        * CAUTION: either size tensor or a pair of int params should be provided, op fails if neither is given.
+        */
+
+        #if NOT_EXCLUDED(OP_resize_area)
+        DECLARE_CUSTOM_OP(resize_area, 1, 1, false, 0, -2);
+        #endif
+
         /**
         * This op calculates backprop dot for two tensors along given dimensions
         *
@@ -1580,6 +1638,9 @@ namespace nd4j {
          *     2 - output_size - 0D-tensor by int type (optional)
          * float args:
          *     0 - threshold - threshold value for overlap checks (optional, by default 0.5)
+         *     1 - score_threshold - boxes with score not above this value are dropped (optional, by default -inf)
+         *     2 - soft_nms_sigma - when positive, soft-NMS is used: scores of boxes overlapping by no more than threshold
+         *         decay as exp(-iou^2 / (2 * sigma)) instead of being suppressed (optional, by default 0)
          * int args:
          *     0 - output_size - as arg 2 used for same target. Eigher this or arg 2 should be provided.
          *
@@ -1588,6 +1649,35 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(non_max_suppression, 2, 1, false, 0, 0);
         #endif
 
+        /*
+         * image.combined_non_max_suppression op: batched, per class NMS
+         * input:
+         *     0 - boxes - 4D-tensor with shape (batch, num_boxes, q, 4), q is 1 for boxes shared by all classes
+         *         or num_classes for per class boxes
+         *     1 - scores - 3D-tensor with shape (batch, num_boxes, num_classes)
+         * float args:
+         *     0 - threshold - threshold value for overlap checks (optional, by default 0.5)
+         *     1 - score_threshold - boxes with score not above this value are dropped (optional, by default -inf)
+         *     2 - soft_nms_sigma - soft-NMS sigma, see non_max_suppression (optional, by default 0)
+         * int args:
+         *     0 - max_output_size_per_class
+         *     1 - max_total_size - number of detections kept per batch entry
+         *     2 - pad_per_class - if non-zero, output_size is min(max_total_size, max_output_size_per_class * num_classes),
+         *         otherwise it's max_total_size (optional, by default 0)
+         *     3 - clip_boxes - if non-zero, output box coordinates are clipped to [0, 1] (optional, by default 0,
+         *         unlike TF where it's true, to keep unnormalized boxes intact)
+         *
+         * output:
+         *     0 - nmsed_boxes - (batch, output_size, 4), boxes type
+         *     1 - nmsed_scores - (batch, output_size), scores type
+         *     2 - nmsed_classes - (batch, output_size), scores type
+         *     3 - valid_detections - (batch), INT32
+         * Detections are ordered by score, unused entries are zeros.
+         * */
+        #if NOT_EXCLUDED(OP_combined_non_max_suppression)
+        DECLARE_CUSTOM_OP(combined_non_max_suppression, 2, 4, false, 0, 2);
+        #endif
+
         /*
          * cholesky op - decomposite positive square symetric matrix (or matricies when rank > 2).
          * input:
@@ -1629,6 +1719,26 @@ namespace nd4j {
         DECLARE_CONFIGURABLE_OP(fake_quant_with_min_max_vars, 3, 1, true, 0, -2);
         #endif
 
+        /**
+         * knn_topk - brute-force k nearest neighbors search, distances are computed in tiles with gemm,
+         * and only k best candidates per query are kept
+         *
+         * input params:
+         *    0 - 2D NDArray of queries [Q, D]
+         *    1 - 2D NDArray of base vectors [N, D], same data type as queries
+         *
+         * int params:
+         *    0 - k, number of neighbors, 1 <= k <= N
+         *    1 - metric (optional): 0 - euclidean (default), 1 - cosine distance, 2 - dot product (the larger the better)
+         *
+         * output:
+         *    0 - [Q, k] distances, ordered from best to worst. DOUBLE for double inputs, FLOAT32 otherwise
+         *    1 - [Q, k] INT64 row numbers within base
+         */
+        #if NOT_EXCLUDED(OP_knn_topk)
+        DECLARE_CUSTOM_OP(knn_topk, 2, 2, false, 0, 1);
+        #endif
+
     }
 }
 
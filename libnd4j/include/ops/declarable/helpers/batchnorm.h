@@ -29,6 +29,24 @@ namespace helpers {
 
 
 	void batchnorm(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon);
+
+    /**
+     * Returns axis of input which mean/variance/gamma/beta arrays run along (after numpy-like broadcasting), if input is c-ordered
+     * and dense, and all params are effectively vectors of length input->sizeAt(axis), i.e. [C] for NHWC or [1,C,1,1] for NCHW.
+     * Returns -1 otherwise, then fused kernels below can't be used.
+     */
+    int batchnormChannelAxis(const NDArray* input, const std::vector<const NDArray*>& params);
+
+    /**
+     * Per-channel mean and biased variance of input, in single pass over input (Welford updates merged with Chan's formula)
+     */
+    void batchnormStats(const NDArray* input, NDArray* mean, NDArray* variance, const int axis);
+
+    /**
+     * Gradients of batchnorm in single pass over input and dLdO, see batchnorm_bp op for formulas.
+     * input, dLdO and dLdI must be dense c-ordered arrays of same shape, gamma/dLdG/dLdB may be nullptr
+     */
+    void batchnormBp(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* dLdO, NDArray* dLdI, NDArray* dLdM, NDArray* dLdV, NDArray* dLdG, NDArray* dLdB, const int axis, const double epsilon);
     
 
 }
@@ -19,6 +19,7 @@
 //
 
 #include <ops/declarable/helpers/adjust_hue.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -54,16 +55,16 @@ namespace helpers {
                 helpers::hv_to_rgb(h, v_min, v_max, o, o + 1, o + 2);
             }
         } else {
-            auto tadsChannelsIn  = array->allTensorsAlongDimension({0});
-            auto tadsChannelsOut = output->allTensorsAlongDimension( {0});
+            TadViews tadsChannelsIn(*array, {0});
+            TadViews tadsChannelsOut(*output, {0});
 
-            auto bufferR = reinterpret_cast<T *>(tadsChannelsIn->at(0)->buffer());
-            auto bufferG = reinterpret_cast<T *>(tadsChannelsIn->at(1)->buffer());
-            auto bufferB = reinterpret_cast<T *>(tadsChannelsIn->at(2)->buffer());
+            auto bufferR = tadsChannelsIn.bufferAt<T>(0);
+            auto bufferG = tadsChannelsIn.bufferAt<T>(1);
+            auto bufferB = tadsChannelsIn.bufferAt<T>(2);
 
-            auto outputR = reinterpret_cast<T *>(tadsChannelsOut->at(0)->buffer());
-            auto outputG = reinterpret_cast<T *>(tadsChannelsOut->at(1)->buffer());
-            auto outputB = reinterpret_cast<T *>(tadsChannelsOut->at(2)->buffer());
+            auto outputR = tadsChannelsOut.bufferAt<T>(0);
+            auto outputG = tadsChannelsOut.bufferAt<T>(1);
+            auto outputB = tadsChannelsOut.bufferAt<T>(2);
 
             PRAGMA_OMP_PARALLEL_FOR_SIMD
             for (int e = 0; e < tuples; e++) {
@@ -87,9 +88,6 @@ namespace helpers {
 
                 helpers::hv_to_rgb(h, v_min, v_max, _ro, _go, _bo);
             }
-
-            delete tadsChannelsIn;
-            delete tadsChannelsOut;
         }
     }
 
@@ -98,18 +96,16 @@ namespace helpers {
 
         float d = delta->e<float>(0);
         if (array->rankOf() == 4) {
-            auto tadsIn = array->allTensorsAlongDimension({0});
-            auto tadsOut = output->allTensorsAlongDimension({0});
-            int tSize = tadsIn->size();
+            TadViews tadsIn(*array, {0});
+            TadViews tadsOut(*output, {0});
+            Nd4jLong tSize = tadsIn.size();
             // FIXME: template selector should be moved out of loop
             PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 0; e < tSize; e++) {
-                BUILD_SINGLE_SELECTOR(xType, _adjust_hue_single, (tadsIn->at(e), tadsOut->at(e), d, isNHWC);, FLOAT_TYPES);
+            for (Nd4jLong e = 0; e < tSize; e++) {
+                auto tadIn = tadsIn.at(e);
+                auto tadOut = tadsOut.at(e);
+                BUILD_SINGLE_SELECTOR(xType, _adjust_hue_single, (&tadIn, &tadOut, d, isNHWC);, FLOAT_TYPES);
             }
-            
-
-            delete tadsIn;
-            delete tadsOut;
         } else {
             BUILD_SINGLE_SELECTOR(xType, _adjust_hue_single, (array, output, d, isNHWC);, FLOAT_TYPES);
         }
@@ -22,12 +22,289 @@
 #include<ops/declarable/helpers/batchnorm.h>
 #include <helpers/ShapeUtils.h>
 #include <OmpLaunchHelper.h>
+#include <NDArrayAccessor.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
 namespace helpers {
 
 
+// statistics of half precision types are accumulated in float
+template <typename T> struct NormAcc           { typedef T     type; };
+template <>           struct NormAcc<float16>  { typedef float type; };
+template <>           struct NormAcc<bfloat16> { typedef float type; };
+
+// rows of interleaved (NHWC-like) input handled by single task, partial sums of tasks are merged in fixed order
+static const Nd4jLong kBatchnormRowsPerTask = 64;
+
+static FORCEINLINE bool isDenseC(const NDArray* arr) {
+    return arr->ordering() == 'c' && arr->ews() == 1;
+}
+
+// input viewed as [outer, C, inner] with channels at given axis
+static void channelsLayout(const NDArray* input, const int axis, Nd4jLong& outer, Nd4jLong& numChannels, Nd4jLong& inner) {
+    outer = 1;
+    inner = 1;
+    numChannels = input->sizeAt(axis);
+    for(int i = 0; i < axis; ++i)
+        outer *= input->sizeAt(i);
+    for(int i = axis + 1; i < input->rankOf(); ++i)
+        inner *= input->sizeAt(i);
+}
+
+// merges statistics (count nB, mean mB, sum of squared deviations m2B) into (nA, mA, m2A)
+template <typename A>
+static FORCEINLINE void mergeStats(A& nA, A& mA, A& m2A, const A nB, const A mB, const A m2B) {
+    if(nB == (A) 0)
+        return;
+    const A n = nA + nB;
+    const A delta = mB - mA;
+    mA  += delta * nB / n;
+    m2A += m2B + delta * delta * nA * nB / n;
+    nA = n;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// output = (input - mean) * sigmaInvGam + beta over dense c-ordered input, sigmaInvGam = gamma / sqrt(variance + epsilon)
+template <typename T>
+static void batchnormDense_(const NDArray* input, const NDArray* mean, const NDArray* sigmaInvGam, const NDArray* beta, NDArray* output, const int axis) {
+
+    Nd4jLong outer, numChannels, inner;
+    channelsLayout(input, axis, outer, numChannels, inner);
+
+    // params are tiny, copy them into contiguous buffers once
+    std::vector<T> m(numChannels), sig(numChannels), b(numChannels, static_cast<T>(0));
+    NDArrayAccessor<const T> meanAcc(*mean), sigAcc(*sigmaInvGam);
+    for(Nd4jLong c = 0; c < numChannels; ++c) {
+        m[c] = meanAcc[c];
+        sig[c] = sigAcc[c];
+    }
+    if(beta != nullptr) {
+        NDArrayAccessor<const T> betaAcc(*beta);
+        for(Nd4jLong c = 0; c < numChannels; ++c)
+            b[c] = betaAcc[c];
+    }
+
+    const T* x = input->bufferAsT<T>();
+          T* z = output->bufferAsT<T>();
+
+    if(inner > 1) {
+        const Nd4jLong numPlanes = outer * numChannels;
+        PRAGMA_OMP_PARALLEL_FOR_IF(numPlanes * inner > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong p = 0; p < numPlanes; ++p) {
+            const Nd4jLong c = p % numChannels;
+            const T mc = m[c], sc = sig[c], bc = b[c];
+            const T* xp = x + p * inner;
+                  T* zp = z + p * inner;
+
+            PRAGMA_OMP_SIMD
+            for(Nd4jLong i = 0; i < inner; ++i)
+                zp[i] = (xp[i] - mc) * sc + bc;
+        }
+    }
+    else {
+        const T* mp = m.data();
+        const T* sp = sig.data();
+        const T* bp = b.data();
+        PRAGMA_OMP_PARALLEL_FOR_IF(outer * numChannels > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong r = 0; r < outer; ++r) {
+            const T* xr = x + r * numChannels;
+                  T* zr = z + r * numChannels;
+
+            PRAGMA_OMP_SIMD
+            for(Nd4jLong c = 0; c < numChannels; ++c)
+                zr[c] = (xr[c] - mp[c]) * sp[c] + bp[c];
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void batchnormStats_(const NDArray* input, NDArray* mean, NDArray* variance, const int axis) {
+
+    typedef typename NormAcc<T>::type A;
+
+    Nd4jLong outer, numChannels, inner;
+    channelsLayout(input, axis, outer, numChannels, inner);
+
+    const T* x = input->bufferAsT<T>();
+    std::vector<A> m(numChannels, (A) 0), m2(numChannels, (A) 0);
+
+    if(inner > 1) {
+        // planar layout: every plane is reduced in cache by two simple loops, then merged into running statistics of its channel
+        PRAGMA_OMP_PARALLEL_FOR_IF(numChannels > 1 && outer * numChannels * inner > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong c = 0; c < numChannels; ++c) {
+            A n = 0, mc = 0, m2c = 0;
+            for(Nd4jLong o = 0; o < outer; ++o) {
+                const T* xp = x + (o * numChannels + c) * inner;
+
+                A sum = 0;
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for(Nd4jLong i = 0; i < inner; ++i)
+                    sum += static_cast<A>(xp[i]);
+                const A pMean = sum / static_cast<A>(inner);
+
+                A sq = 0;
+                PRAGMA_OMP_SIMD_SUM(sq)
+                for(Nd4jLong i = 0; i < inner; ++i) {
+                    const A d = static_cast<A>(xp[i]) - pMean;
+                    sq += d * d;
+                }
+
+                mergeStats<A>(n, mc, m2c, static_cast<A>(inner), pMean, sq);
+            }
+            m[c] = mc;
+            m2[c] = m2c;
+        }
+    }
+    else {
+        // interleaved layout: Welford updates vectorized across channels, one set of partial statistics per task
+        const Nd4jLong numTasks = (outer + kBatchnormRowsPerTask - 1) / kBatchnormRowsPerTask;
+        std::vector<A> pm(numTasks * numChannels, (A) 0), pm2(numTasks * numChannels, (A) 0);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numTasks > 1 && outer * numChannels > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong t = 0; t < numTasks; ++t) {
+            A* tm  = pm.data()  + t * numChannels;
+            A* tm2 = pm2.data() + t * numChannels;
+            const Nd4jLong rStart = t * kBatchnormRowsPerTask;
+            const Nd4jLong rEnd = nd4j::math::nd4j_min<Nd4jLong>(rStart + kBatchnormRowsPerTask, outer);
+
+            for(Nd4jLong r = rStart; r < rEnd; ++r) {
+                const T* xr = x + r * numChannels;
+                const A invCount = (A) 1 / static_cast<A>(r - rStart + 1);
+
+                PRAGMA_OMP_SIMD
+                for(Nd4jLong c = 0; c < numChannels; ++c) {
+                    const A v = static_cast<A>(xr[c]);
+                    const A d = v - tm[c];
+                    tm[c] += d * invCount;
+                    tm2[c] += d * (v - tm[c]);
+                }
+            }
+        }
+
+        for(Nd4jLong t = 0; t < numTasks; ++t) {
+            const A count = static_cast<A>(nd4j::math::nd4j_min<Nd4jLong>(kBatchnormRowsPerTask, outer - t * kBatchnormRowsPerTask));
+            const A prev = static_cast<A>(t * kBatchnormRowsPerTask);
+            for(Nd4jLong c = 0; c < numChannels; ++c) {
+                A n = prev;
+                mergeStats<A>(n, m[c], m2[c], count, pm[t * numChannels + c], pm2[t * numChannels + c]);
+            }
+        }
+    }
+
+    const A total = static_cast<A>(outer * inner);
+    NDArrayAccessor<T> meanAcc(*mean), varAcc(*variance);
+    for(Nd4jLong c = 0; c < numChannels; ++c) {
+        meanAcc[c] = static_cast<T>(m[c]);
+        varAcc[c]  = static_cast<T>(m2[c] / total);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void batchnormBp_(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* dLdO, NDArray* dLdI, NDArray* dLdM, NDArray* dLdV, NDArray* dLdG, NDArray* dLdB, const int axis, const double epsilon) {
+
+    typedef typename NormAcc<T>::type A;
+
+    Nd4jLong outer, numChannels, inner;
+    channelsLayout(input, axis, outer, numChannels, inner);
+
+    // per channel: m - mean, s = 1/sqrt(variance + epsilon), k = s * gamma
+    std::vector<T> m(numChannels), s(numChannels), k(numChannels);
+    NDArrayAccessor<const T> meanAcc(*mean), varAcc(*variance);
+    for(Nd4jLong c = 0; c < numChannels; ++c) {
+        m[c] = meanAcc[c];
+        s[c] = static_cast<T>((A) 1 / nd4j::math::nd4j_sqrt<A, A>(static_cast<A>(varAcc[c]) + static_cast<A>(epsilon)));
+        k[c] = s[c];
+    }
+    if(gamma != nullptr) {
+        NDArrayAccessor<const T> gammaAcc(*gamma);
+        for(Nd4jLong c = 0; c < numChannels; ++c)
+            k[c] = s[c] * gammaAcc[c];
+    }
+
+    const T* x  = input->bufferAsT<T>();
+    const T* dO = dLdO->bufferAsT<T>();
+          T* dI = dLdI->bufferAsT<T>();
+
+    // sumD = sum(dLdO), sumDX = sum(dLdO * (input - mean)) per channel, dLdI is written in the same pass
+    std::vector<A> sumD(numChannels, (A) 0), sumDX(numChannels, (A) 0);
+
+    if(inner > 1) {
+        PRAGMA_OMP_PARALLEL_FOR_IF(numChannels > 1 && outer * numChannels * inner > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong c = 0; c < numChannels; ++c) {
+            const T mc = m[c], kc = k[c];
+            A sd = 0, sdx = 0;
+            for(Nd4jLong o = 0; o < outer; ++o) {
+                const Nd4jLong start = (o * numChannels + c) * inner;
+
+                PRAGMA_OMP_SIMD_SUM(sd)
+                for(Nd4jLong i = start; i < start + inner; ++i)
+                    sd += static_cast<A>(dO[i]);
+
+                PRAGMA_OMP_SIMD_SUM(sdx)
+                for(Nd4jLong i = start; i < start + inner; ++i)
+                    sdx += static_cast<A>(dO[i]) * static_cast<A>(x[i] - mc);
+
+                PRAGMA_OMP_SIMD
+                for(Nd4jLong i = start; i < start + inner; ++i)
+                    dI[i] = kc * dO[i];
+            }
+            sumD[c] = sd;
+            sumDX[c] = sdx;
+        }
+    }
+    else {
+        const Nd4jLong numTasks = (outer + kBatchnormRowsPerTask - 1) / kBatchnormRowsPerTask;
+        std::vector<A> pd(numTasks * numChannels, (A) 0), pdx(numTasks * numChannels, (A) 0);
+        const T* mp = m.data();
+        const T* kp = k.data();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numTasks > 1 && outer * numChannels > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong t = 0; t < numTasks; ++t) {
+            A* td  = pd.data()  + t * numChannels;
+            A* tdx = pdx.data() + t * numChannels;
+            const Nd4jLong rEnd = nd4j::math::nd4j_min<Nd4jLong>((t + 1) * kBatchnormRowsPerTask, outer);
+
+            for(Nd4jLong r = t * kBatchnormRowsPerTask; r < rEnd; ++r) {
+                const T* xr = x  + r * numChannels;
+                const T* dr = dO + r * numChannels;
+                      T* ir = dI + r * numChannels;
+
+                PRAGMA_OMP_SIMD
+                for(Nd4jLong c = 0; c < numChannels; ++c) {
+                    td[c]  += static_cast<A>(dr[c]);
+                    tdx[c] += static_cast<A>(dr[c]) * static_cast<A>(xr[c] - mp[c]);
+                    ir[c] = kp[c] * dr[c];
+                }
+            }
+        }
+
+        for(Nd4jLong t = 0; t < numTasks; ++t)
+            for(Nd4jLong c = 0; c < numChannels; ++c) {
+                sumD[c]  += pd[t * numChannels + c];
+                sumDX[c] += pdx[t * numChannels + c];
+            }
+    }
+
+    NDArrayAccessor<T> dLdMAcc(*dLdM), dLdVAcc(*dLdV);
+    for(Nd4jLong c = 0; c < numChannels; ++c) {
+        dLdMAcc[c] = static_cast<T>(-static_cast<A>(k[c]) * sumD[c]);
+        dLdVAcc[c] = static_cast<T>((A) -0.5f * static_cast<A>(s[c]) * static_cast<A>(s[c]) * static_cast<A>(k[c]) * sumDX[c]);
+    }
+    if(dLdG != nullptr) {
+        NDArrayAccessor<T> dLdGAcc(*dLdG);
+        for(Nd4jLong c = 0; c < numChannels; ++c)
+            dLdGAcc[c] = static_cast<T>(static_cast<A>(s[c]) * sumDX[c]);
+    }
+    if(dLdB != nullptr) {
+        NDArrayAccessor<T> dLdBAcc(*dLdB);
+        for(Nd4jLong c = 0; c < numChannels; ++c)
+            dLdBAcc[c] = static_cast<T>(sumD[c]);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename T>
 static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon) {
@@ -47,6 +324,11 @@ static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray*
     // auto sigmaInvGam = (*variance + epsilon).transform(transform::RSqrt);   //  sigmaInvGam = 1 / sqrt(variance + epsilon)
     // if(gamma != nullptr) sigmaInvGam *= *gamma;                   
 
+    if(axes.size() == 1 && isDenseC(input) && isDenseC(output) && mean->lengthOf() == input->sizeAt(axes[0])) {
+        batchnormDense_<T>(input, mean, &sigmaInvGam, beta, output, axes[0]);
+        return;
+    }
+
     const T* sigmaBuff = sigmaInvGam.bufferAsT<T>();
     const T* meanBuff  = mean->bufferAsT<T>();
     const T* inBuff    = input->bufferAsT<T>();
@@ -134,6 +416,56 @@ void batchnorm(const NDArray* input, const NDArray* mean, const NDArray* varianc
 
 
 
+//////////////////////////////////////////////////////////////////////////
+int batchnormChannelAxis(const NDArray* input, const std::vector<const NDArray*>& params) {
+
+    if(!isDenseC(input))
+        return -1;
+
+    const int rank = input->rankOf();
+    int axis = -1;
+    const NDArray* first = nullptr;
+
+    for(const auto param : params) {
+        if(param == nullptr)
+            continue;
+
+        if(first == nullptr)
+            first = param;
+        else if(!param->isSameShape(first) || param->dataType() != first->dataType())
+            return -1;
+    }
+
+    if(first == nullptr || first->rankOf() > rank)
+        return -1;
+
+    // params are aligned with trailing dimensions of input, like in broadcasting, only one of their dimensions may be non-unity
+    const int shift = rank - first->rankOf();
+    for(int i = 0; i < first->rankOf(); ++i) {
+        if(first->sizeAt(i) == 1)
+            continue;
+
+        if(axis >= 0 || first->sizeAt(i) != input->sizeAt(i + shift))
+            return -1;
+
+        axis = i + shift;
+    }
+
+    return axis;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void batchnormStats(const NDArray* input, NDArray* mean, NDArray* variance, const int axis) {
+
+    BUILD_SINGLE_SELECTOR(input->dataType(), batchnormStats_, (input, mean, variance, axis), FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void batchnormBp(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* dLdO, NDArray* dLdI, NDArray* dLdM, NDArray* dLdV, NDArray* dLdG, NDArray* dLdB, const int axis, const double epsilon) {
+
+    BUILD_SINGLE_SELECTOR(input->dataType(), batchnormBp_, (input, mean, variance, gamma, dLdO, dLdI, dLdM, dLdV, dLdG, dLdB, axis, epsilon), FLOAT_TYPES);
+}
+
 BUILD_SINGLE_TEMPLATE(template void batchnorm_, (const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon), FLOAT_TYPES);
 
 }
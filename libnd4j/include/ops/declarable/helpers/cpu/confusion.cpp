@@ -19,6 +19,7 @@
 //
 
 #include <ops/declarable/helpers/confusion.h>
+#include <TadViews.h>
 
 
 namespace nd4j {
@@ -27,7 +28,7 @@ namespace helpers {
 
     template <typename T>
     void _confusionFunctor(NDArray* labels, NDArray* predictions, NDArray* weights, NDArray* output) {
-        std::unique_ptr<ResultSet> arrs(output->allTensorsAlongDimension({1}));
+        TadViews arrs(*output, {1});
         int lLen = labels->lengthOf();
 
         PRAGMA_OMP_PARALLEL_FOR_IF(lLen > Environment::getInstance()->elementwiseThreshold())
@@ -35,7 +36,7 @@ namespace helpers {
             auto label = labels->e<Nd4jLong>(j);
             auto pred = predictions->e<Nd4jLong>(j);
             T value = (weights == nullptr ? (T)1.0f : weights->e<T>(j));
-            (*arrs->at(label)).p<T>(pred, value);
+            arrs.accessor<T>(label)[pred] = value;
         }
     }
 
@@ -19,6 +19,7 @@
 //
 
 #include <ops/declarable/helpers/axis.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -27,14 +28,14 @@ namespace helpers {
     template <typename T>
     static void _extractPatches(NDArray* images, NDArray* output, int sizeRow, int sizeCol, int strideRow, int strideCol, int rateRow, int rateCol, bool theSame){
         std::vector<int> restDims({1, 2, 3}); // the first and the last dims
-        std::unique_ptr<ResultSet> listOfMatricies(images->allTensorsAlongDimension(restDims));
-        std::unique_ptr<ResultSet> listOfOutputs(output->allTensorsAlongDimension(restDims));
+        TadViews listOfMatricies(*images, restDims);
+        TadViews listOfOutputs(*output, restDims);
         // 3D matricies - 2D matricies of vectors (if last dim is greater than 1)
         //int e = 0;
         const int ksizeRowsEffective = sizeRow + (sizeRow - 1) * (rateRow - 1);
         const int ksizeColsEffective = sizeCol + (sizeCol - 1) * (rateCol - 1);
         const int ksize = ksizeRowsEffective * ksizeColsEffective;
-        int batchCount = listOfMatricies->size(); //lengthOf() / ksize;
+        int batchCount = listOfMatricies.size(); //lengthOf() / ksize;
         Nd4jLong lastDim = images->sizeAt(3);
         Nd4jLong outLastDim = output->sizeAt(3);
         Nd4jLong rowDim = images->sizeAt(1);
@@ -50,8 +51,8 @@ namespace helpers {
         //Nd4jLong outputLastDim = output->sizeAt(3);
        PRAGMA_OMP_PARALLEL_FOR
         for (Nd4jLong batch = 0; batch < batchCount; batch++) {
-            auto patch = listOfMatricies->at(batch);
-            auto outMatrix = listOfOutputs->at(batch);
+            auto patch = listOfMatricies.accessor<T, 3>(batch);
+            auto outMatrix = listOfOutputs.accessor<T, 3>(batch);
             //auto patchBorder = patch->sizeAt(0);
             if (theSame) { // SAME case
                 for (Nd4jLong i = 0; i < outRowDim; i++) {
@@ -67,7 +68,7 @@ namespace helpers {
                             for (auto col = colStart; col < colEnd; col += rateCol)
                                 for (auto pixel = 0; pixel < lastDim; pixel++) {
                                     if (row >=0 && col >= 0 && row < rowDim && col < colDim)
-                                    outMatrix->p<T>(i, j, pos, patch->e<T>(row, col, pixel));
+                                    outMatrix(i, j, pos) = patch(row, col, pixel);
                                     pos++;
                                 }
                         //}
@@ -87,7 +88,7 @@ namespace helpers {
                             for (auto row = rowStart; row < rowEnd; row += rateRow)
                                 for (auto col = colStart; col < colEnd; col += rateCol)
                                     for (auto pixel = 0; pixel < lastDim; pixel++)
-                                        outMatrix->p<T>(i,j,pos++, patch->e<T>(row, col, pixel));
+                                        outMatrix(i, j, pos++) = patch(row, col, pixel);
                         //}
                     }
                 }
@@ -19,167 +19,479 @@
 //
 
 #include <ops/declarable/helpers/image_resize.h>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <memory>
+#include <limits>
+#include <type_traits>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    static int gcd(int one, int two) {
-        // modified Euclidian algorithm
-        if (one == two) return one;
-        if (one > two) {
-            if (one % two == 0) return two;
-            return gcd(one - two, two);
+    /**
+     * 1-D resampling table: every output coordinate is a weighted sum of `taps` source coordinates.
+     * All methods are separable, so 2-D resize is horizontal pass over source rows followed by vertical pass.
+     */
+    struct ResizeTable {
+        int taps = 1;
+        std::vector<Nd4jLong> indices;      // [outSize * taps], already clamped to source size
+        std::vector<double> weights;        // [outSize * taps]
+        std::vector<int8_t> outside;        // [outSize] or empty, used by crop_and_resize extrapolation
+    };
+
+    /**
+     * Image layout: element (y, x, c) lives at y * rowStride + x * pixelStride + c * channelStride
+     */
+    struct ImageGeometry {
+        Nd4jLong height;
+        Nd4jLong width;
+        Nd4jLong channels;
+        Nd4jLong rowStride;
+        Nd4jLong pixelStride;
+        Nd4jLong channelStride;
+
+        ImageGeometry(Nd4jLong height, Nd4jLong width, Nd4jLong channels, bool nchw) : height(height), width(width), channels(channels) {
+            if (nchw) {
+                rowStride = width;
+                pixelStride = 1;
+                channelStride = height * width;
+            } else {
+                rowStride = width * channels;
+                pixelStride = channels;
+                channelStride = 1;
+            }
         }
-        if (two % one == 0) return one;
-        return gcd(one, two - one);
-    }
 
-    struct BilinearInterpolationData {
-        Nd4jLong bottomIndex;  // Lower source index used in the interpolation
-        Nd4jLong topIndex;  // Upper source index used in the interpolation
-        // 1-D linear iterpolation scale (see:
-        // https://en.wikipedia.org/wiki/Bilinear_interpolation)
-        double interpolarValue;
+        Nd4jLong length() const {
+            return height * width * channels;
+        }
+    };
+
+    // number of output rows processed by one task, rows within task share horizontally resampled source rows
+    static const Nd4jLong kRowsPerTask = 16;
+
+    // integer types wider than 16 bits and doubles are accumulated in double, everything else in float
+    template <typename T>
+    struct ResizeAccumulator {
+        typedef float type;
+    };
+
+    template <>
+    struct ResizeAccumulator<double> {
+        typedef double type;
     };
 
-    inline void computeInterpolationWeights(Nd4jLong outSize,
-                                            Nd4jLong inSize,
-                                            double scale,
-                                            BilinearInterpolationData *interpolationData) {
-        interpolationData[outSize].bottomIndex = 0;
-        interpolationData[outSize].topIndex = 0;
+    template <>
+    struct ResizeAccumulator<int32_t> {
+        typedef double type;
+    };
 
-        PRAGMA_OMP_PARALLEL_FOR
-        for (Nd4jLong i = outSize - 1; i >= 0; --i) {
+    template <>
+    struct ResizeAccumulator<Nd4jLong> {
+        typedef double type;
+    };
+
+    template <typename T, typename A>
+    static FORCEINLINE typename std::enable_if<std::is_integral<T>::value, T>::type castPixel(A value) {
+        // integer images are rounded and saturated, so uint8 pipelines don't wrap around on bicubic overshoots
+        value = nd4j::math::nd4j_floor<A, A>(value + static_cast<A>(0.5f));
+        value = nd4j::math::nd4j_max<A>(static_cast<A>(std::numeric_limits<T>::min()), nd4j::math::nd4j_min<A>(value, static_cast<A>(std::numeric_limits<T>::max())));
+        return static_cast<T>(value);
+    }
+
+    template <typename T, typename A>
+    static FORCEINLINE typename std::enable_if<!std::is_integral<T>::value, T>::type castPixel(A value) {
+        return static_cast<T>(value);
+    }
+
+    static ResizeTable nearestTable(Nd4jLong inSize, Nd4jLong outSize, double scale, bool center) {
+        ResizeTable table;
+        table.taps = 1;
+        table.indices.resize(outSize);
+        table.weights.assign(outSize, 1.);
+        for (Nd4jLong i = 0; i < outSize; i++) {
+            float in = static_cast<float>(i * scale);
+            auto idx = static_cast<Nd4jLong>(center ? nd4j::math::p_round<float>(in) : nd4j::math::p_floor<float>(in));
+            table.indices[i] = nd4j::math::nd4j_min<Nd4jLong>(idx, inSize - 1);
+        }
+        return table;
+    }
+
+    static ResizeTable bilinearTable(Nd4jLong inSize, Nd4jLong outSize, float scale) {
+        ResizeTable table;
+        table.taps = 2;
+        table.indices.resize(outSize * 2);
+        table.weights.resize(outSize * 2);
+        for (Nd4jLong i = 0; i < outSize; i++) {
             double in = i * scale;
-            interpolationData[i].bottomIndex = static_cast<Nd4jLong>(in);
-            interpolationData[i].topIndex = nd4j::math::nd4j_min(interpolationData[i].bottomIndex + 1, inSize - 1);
-            interpolationData[i].interpolarValue = in - interpolationData[i].bottomIndex;
+            auto bottom = static_cast<Nd4jLong>(in);
+            double lerp = in - bottom;
+            table.indices[2 * i] = bottom;
+            table.indices[2 * i + 1] = nd4j::math::nd4j_min<Nd4jLong>(bottom + 1, inSize - 1);
+            table.weights[2 * i] = 1. - lerp;
+            table.weights[2 * i + 1] = lerp;
         }
+        return table;
     }
 
-/**
- * Computes the bilinear interpolation from the appropriate 4 float points
- * and the linear interpolation weights.
- */
-    inline double computeBilinear(double topLeft, double topRight,
-                                  double bottomLeft, double bottomRight,
-                                  double xVal, double yVal) {
-        double top = topLeft + (topRight - topLeft) * xVal;
-        double bottom = bottomLeft + (bottomRight - bottomLeft) * xVal;
-        return top + (bottom - top) * yVal;
+    static ResizeTable bicubicTable(Nd4jLong inSize, Nd4jLong outSize, float scale) {
+        // Keys cubic convolution kernel with a = -0.75, same as tf.image.resize_bicubic
+        const double a = -0.75;
+        ResizeTable table;
+        table.taps = 4;
+        table.indices.resize(outSize * 4);
+        table.weights.resize(outSize * 4);
+        for (Nd4jLong i = 0; i < outSize; i++) {
+            double in = i * scale;
+            auto base = static_cast<Nd4jLong>(nd4j::math::nd4j_floor<double, double>(in));
+            double t = in - base;
+            double t1 = t + 1.;
+            double t2 = 1. - t;
+
+            double w0 = ((a * t1 - 5. * a) * t1 + 8. * a) * t1 - 4. * a;
+            double w1 = ((a + 2.) * t - (a + 3.)) * t * t + 1.;
+            double w2 = ((a + 2.) * t2 - (a + 3.)) * t2 * t2 + 1.;
+            double w3 = 1. - w0 - w1 - w2;
+
+            table.weights[4 * i] = w0;
+            table.weights[4 * i + 1] = w1;
+            table.weights[4 * i + 2] = w2;
+            table.weights[4 * i + 3] = w3;
+            for (int e = 0; e < 4; e++)
+                table.indices[4 * i + e] = nd4j::math::nd4j_max<Nd4jLong>(0, nd4j::math::nd4j_min<Nd4jLong>(base - 1 + e, inSize - 1));
+        }
+        return table;
     }
 
-    static void
-    resizeImage(NDArray const *images, Nd4jLong batchSize, Nd4jLong inHeight, Nd4jLong inWidth, Nd4jLong outHeight,
-                Nd4jLong outWidth, Nd4jLong channels,
-                std::vector<BilinearInterpolationData> const &xs,
-                std::vector<BilinearInterpolationData> const &ys,
-                NDArray *output);
+    static ResizeTable areaTable(Nd4jLong inSize, Nd4jLong outSize, float scale) {
+        // every output pixel averages source pixels it covers, partially covered ones are weighted by overlap
+        ResizeTable table;
+        int taps = 1;
+        for (Nd4jLong i = 0; i < outSize; i++) {
+            auto start = static_cast<Nd4jLong>(nd4j::math::nd4j_floor<float, float>(i * scale));
+            auto end = static_cast<Nd4jLong>(nd4j::math::nd4j_ceil<float, float>((i + 1) * scale));
+            taps = nd4j::math::nd4j_max<int>(taps, static_cast<int>(end - start));
+        }
 
-    template<typename T>
-    static void
-    resizeImage_(NDArray const *images, Nd4jLong batchSize, Nd4jLong inHeight, Nd4jLong inWidth, Nd4jLong outHeight,
-                 Nd4jLong outWidth, Nd4jLong channels,
-                 std::vector<BilinearInterpolationData> const &xs,
-                 std::vector<BilinearInterpolationData> const &ys,
-                 NDArray *output) {
-
-        Nd4jLong inRowSize = inWidth * channels;
-        Nd4jLong inBatchNumValues = inHeight * inRowSize;
-        Nd4jLong outRowSize = outWidth * channels;
-
-        T const *input_b_ptr = reinterpret_cast<T const *>(images->getBuffer()); // this works only with 'c' direction
-        BilinearInterpolationData const *xs_ = xs.data();
-
-        T *output_y_ptr = reinterpret_cast<T *>(output->buffer());
-
-        PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (Nd4jLong b = 0; b < batchSize; ++b) {
-            for (Nd4jLong y = 0; y < outHeight; ++y) {
-                const T *ys_input_lower_ptr = input_b_ptr + ys[y].bottomIndex * inRowSize;
-                const T *ys_input_upper_ptr = input_b_ptr + ys[y].topIndex * inRowSize;
-                double yVal = ys[y].interpolarValue;
-                for (Nd4jLong x = 0; x < outWidth; ++x) {
-                    auto xsBottom = xs_[x].bottomIndex;
-                    auto xsTop = xs_[x].topIndex;
-                    auto xVal = xs_[x].interpolarValue;
-                    for (int c = 0; c < channels; ++c) {
-                        double topLeft(ys_input_lower_ptr[xsBottom + c]);
-                        double topRight(ys_input_lower_ptr[xsTop + c]);
-                        double bottomLeft(ys_input_upper_ptr[xsBottom + c]);
-                        double bottomRight(ys_input_upper_ptr[xsTop + c]);
-                        output_y_ptr[x * channels + c] =
-                                computeBilinear(topLeft, topRight, bottomLeft, bottomRight,
-                                                xVal, yVal);
-                    }
-                }
-                output_y_ptr += outRowSize;
+        table.taps = taps;
+        table.indices.assign(outSize * taps, 0);
+        table.weights.assign(outSize * taps, 0.);
+        for (Nd4jLong i = 0; i < outSize; i++) {
+            float in0 = i * scale;
+            float in1 = (i + 1) * scale;
+            auto start = static_cast<Nd4jLong>(nd4j::math::nd4j_floor<float, float>(in0));
+            auto end = static_cast<Nd4jLong>(nd4j::math::nd4j_ceil<float, float>(in1));
+            for (Nd4jLong e = start; e < end; e++) {
+                double overlap = nd4j::math::nd4j_min<float>(e + 1, in1) - nd4j::math::nd4j_max<float>(e, in0);
+                table.indices[i * taps + (e - start)] = nd4j::math::nd4j_min<Nd4jLong>(e, inSize - 1);
+                table.weights[i * taps + (e - start)] = overlap / scale;
             }
-            input_b_ptr += inBatchNumValues;
         }
+        return table;
     }
 
-    template<typename T>
-    static int resizeBilinearFunctor_(NDArray const *images, int width, int height, bool center, NDArray *output) {
-        const Nd4jLong batchSize = images->sizeAt(0);
-        const Nd4jLong inHeight = images->sizeAt(1);
-        const Nd4jLong inWidth = images->sizeAt(2);
-        const Nd4jLong channels = images->sizeAt(3);
+    /**
+     * Tables depend only on (method, inSize, outSize, center), so they are built once per size pair and shared
+     * between calls: frame pipelines resize every frame to the same target size.
+     */
+    static std::shared_ptr<const ResizeTable> cachedTable(int method, Nd4jLong inSize, Nd4jLong outSize, bool center) {
+        typedef std::tuple<int, Nd4jLong, Nd4jLong, bool> TableKey;
+        static std::map<TableKey, std::shared_ptr<const ResizeTable>> cache;
+        static std::mutex mutex;
+
+        TableKey key(method, inSize, outSize, center);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(key);
+            if (it != cache.end())
+                return it->second;
+        }
 
-        const Nd4jLong outHeight = output->sizeAt(1);
-        const Nd4jLong outWidth = output->sizeAt(2);
+        std::shared_ptr<ResizeTable> table;
+        switch (method) {
+            case kResizeNearest: {
+                    double scale = center ? (inSize - 1.) / double(outSize - 1.0) : (inSize / double(outSize));
+                    table = std::make_shared<ResizeTable>(nearestTable(inSize, outSize, scale, center));
+                }
+                break;
+            case kResizeBilinear:
+            case kResizeBicubic:
+            case kResizeArea: {
+                    float scale = center ? (inSize - 1.f) / double(outSize - 1.f) : (inSize / float(outSize));
+                    if (method == kResizeBilinear)
+                        table = std::make_shared<ResizeTable>(bilinearTable(inSize, outSize, scale));
+                    else if (method == kResizeBicubic)
+                        table = std::make_shared<ResizeTable>(bicubicTable(inSize, outSize, scale));
+                    else
+                        table = std::make_shared<ResizeTable>(areaTable(inSize, outSize, scale));
+                }
+                break;
+            default:
+                throw std::runtime_error("image_resize: unknown interpolation method");
+        }
 
-        // Handle no-op resizes efficiently.
-        if (outHeight == inHeight && outWidth == inWidth) {
-            output->assign(images);
-            return ND4J_STATUS_OK;
+        std::lock_guard<std::mutex> lock(mutex);
+        // sizes vary wildly only in pathological cases, so simple flush is enough to bound memory
+        if (cache.size() >= 256)
+            cache.clear();
+
+        cache[key] = table;
+        return table;
+    }
+
+    /**
+     * Keeps horizontally resampled source rows, so neighbouring output rows don't resample shared source rows again
+     */
+    template <typename A>
+    class ResampledRows {
+    protected:
+        Nd4jLong _rowLength;
+        std::vector<A> _data;
+        std::vector<Nd4jLong> _tags;
+        std::vector<Nd4jLong> _stamps;
+        Nd4jLong _clock = 0;
+
+    public:
+        ResampledRows(int slots, Nd4jLong rowLength) : _rowLength(rowLength), _data(slots * rowLength), _tags(slots, -1), _stamps(slots, 0) {
+            //
         }
 
-        // Special case for TF compatibility
-        if((center && inHeight < 2) || (center && inWidth < 2)){
-            center = false;
+        // returns cached row, or slot for row that must be filled, least recently used slot gets evicted
+        A* fetch(Nd4jLong row, bool &cached) {
+            int victim = 0;
+            for (int e = 0; e < (int) _tags.size(); e++) {
+                if (_tags[e] == row) {
+                    _stamps[e] = ++_clock;
+                    cached = true;
+                    return _data.data() + e * _rowLength;
+                }
+
+                if (_stamps[e] < _stamps[victim])
+                    victim = e;
+            }
+
+            _tags[victim] = row;
+            _stamps[victim] = ++_clock;
+            cached = false;
+            return _data.data() + victim * _rowLength;
         }
+    };
 
-        if ((center && inHeight < 2) || (inHeight < 1) || (outHeight < 1) || (center && outHeight < 2) ||
-            (center && inWidth < 2) || (inWidth < 1) || (outWidth < 1) || (center && outWidth < 2)) {
-            // wrong input data
-            nd4j_printf("image.resize_bilinear: Wrong input or output size to resize\n", "");
-            return ND4J_STATUS_BAD_ARGUMENTS;
+    template <typename T, typename A>
+    static void resampleRow_(const T *row, const ImageGeometry &in, const ResizeTable &xs, const std::vector<A> &xWeights, Nd4jLong outWidth, A *dst) {
+        const auto channels = in.channels;
+        const auto taps = xs.taps;
+        const auto xIdx = xs.indices.data();
+        const auto xW = xWeights.data();
+
+        if (in.channelStride == 1) {
+            // interleaved channels: innermost loop is contiguous
+            for (Nd4jLong x = 0; x < outWidth; x++) {
+                A *d = dst + x * channels;
+                const T *s = row + xIdx[x * taps] * in.pixelStride;
+                const A w = xW[x * taps];
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong c = 0; c < channels; c++)
+                    d[c] = w * static_cast<A>(s[c]);
+
+                for (int t = 1; t < taps; t++) {
+                    const A wt = xW[x * taps + t];
+                    if (wt == static_cast<A>(0))
+                        continue;
+
+                    s = row + xIdx[x * taps + t] * in.pixelStride;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong c = 0; c < channels; c++)
+                        d[c] += wt * static_cast<A>(s[c]);
+                }
+            }
+        } else {
+            // planar channels: vectorize along output row
+            for (Nd4jLong c = 0; c < channels; c++) {
+                const T *plane = row + c * in.channelStride;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong x = 0; x < outWidth; x++) {
+                    A sum = static_cast<A>(0);
+                    for (int t = 0; t < taps; t++)
+                        sum += xW[x * taps + t] * static_cast<A>(plane[xIdx[x * taps + t] * in.pixelStride]);
+
+                    dst[x * channels + c] = sum;
+                }
+            }
         }
-        float heightScale = center ? (inHeight - 1.f) / double(outHeight - 1.f) : (inHeight / float(outHeight));
-        float widthScale = center ? (inWidth - 1.f) / double(outWidth - 1.f) : (inWidth / float(outWidth));
-
-        std::vector<BilinearInterpolationData> ys(outHeight + 1);
-        std::vector<BilinearInterpolationData> xs(outWidth + 1);
-
-        // Compute the cached interpolation weights on the x and y dimensions.
-        computeInterpolationWeights(outHeight, inHeight, heightScale,
-                                    ys.data());
-        computeInterpolationWeights(outWidth, inWidth, widthScale, xs.data());
-
-        int xsSize = xs.size();
-        // Scale x interpolation weights to avoid a multiplication during iteration.
-        PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = 0; i < xsSize; ++i) {
-            xs[i].bottomIndex *= channels;
-            xs[i].topIndex *= channels;
+    }
+
+    /**
+     * Resamples output rows [yFrom, yTo) of a single image
+     */
+    template <typename T>
+    static void resampleRows_(const T *input, const ImageGeometry &in, T *output, const ImageGeometry &out, const ResizeTable &ys, const ResizeTable &xs, Nd4jLong yFrom, Nd4jLong yTo, double extrapolationValue) {
+        typedef typename ResizeAccumulator<T>::type A;
+
+        const auto channels = in.channels;
+        const auto outWidth = out.width;
+        const auto rowLength = outWidth * channels;
+        const T fill = castPixel<T, double>(extrapolationValue);
+
+        auto fillPixel = [&](Nd4jLong y, Nd4jLong x) {
+            T *z = output + y * out.rowStride + x * out.pixelStride;
+            for (Nd4jLong c = 0; c < channels; c++)
+                z[c * out.channelStride] = fill;
+        };
+
+        if (ys.taps == 1 && xs.taps == 1) {
+            // nearest neighbor: plain copy, no conversion
+            for (Nd4jLong y = yFrom; y < yTo; y++) {
+                if (!ys.outside.empty() && ys.outside[y]) {
+                    for (Nd4jLong x = 0; x < outWidth; x++)
+                        fillPixel(y, x);
+                    continue;
+                }
+
+                const T *row = input + ys.indices[y] * in.rowStride;
+                for (Nd4jLong x = 0; x < outWidth; x++) {
+                    if (!xs.outside.empty() && xs.outside[x]) {
+                        fillPixel(y, x);
+                        continue;
+                    }
+
+                    const T *s = row + xs.indices[x] * in.pixelStride;
+                    T *z = output + y * out.rowStride + x * out.pixelStride;
+                    if (in.channelStride == 1 && out.channelStride == 1) {
+                        memcpy(z, s, channels * sizeof(T));
+                    } else {
+                        for (Nd4jLong c = 0; c < channels; c++)
+                            z[c * out.channelStride] = s[c * in.channelStride];
+                    }
+                }
+            }
+            return;
         }
 
-        resizeImage(images, batchSize, inHeight, inWidth, outHeight, outWidth, channels, xs, ys, output);
-        return ND4J_STATUS_OK;
+        std::vector<A> xWeights(xs.weights.begin(), xs.weights.end());
+        ResampledRows<A> rows(ys.taps + 1, rowLength);
+        std::vector<A> acc(rowLength);
+        std::vector<A*> srcRows(ys.taps);
+        std::vector<A> srcWeights(ys.taps);
+
+        for (Nd4jLong y = yFrom; y < yTo; y++) {
+            if (!ys.outside.empty() && ys.outside[y]) {
+                for (Nd4jLong x = 0; x < outWidth; x++)
+                    fillPixel(y, x);
+                continue;
+            }
+
+            int numRows = 0;
+            for (int t = 0; t < ys.taps; t++) {
+                A w = static_cast<A>(ys.weights[y * ys.taps + t]);
+                if (w == static_cast<A>(0))
+                    continue;
+
+                auto srcY = ys.indices[y * ys.taps + t];
+                bool cached = false;
+                auto buffer = rows.fetch(srcY, cached);
+                if (!cached)
+                    resampleRow_<T, A>(input + srcY * in.rowStride, in, xs, xWeights, outWidth, buffer);
+
+                srcRows[numRows] = buffer;
+                srcWeights[numRows++] = w;
+            }
+
+            A *a = acc.data();
+            {
+                const A *r = numRows > 0 ? srcRows[0] : nullptr;
+                const A w = numRows > 0 ? srcWeights[0] : static_cast<A>(0);
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    a[e] = r == nullptr ? static_cast<A>(0) : w * r[e];
+            }
+
+            for (int t = 1; t < numRows; t++) {
+                const A *r = srcRows[t];
+                const A w = srcWeights[t];
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    a[e] += w * r[e];
+            }
+
+            T *z = output + y * out.rowStride;
+            if (out.channelStride == 1) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    z[e] = castPixel<T, A>(a[e]);
+            } else {
+                for (Nd4jLong c = 0; c < channels; c++) {
+                    T *plane = z + c * out.channelStride;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong x = 0; x < outWidth; x++)
+                        plane[x * out.pixelStride] = castPixel<T, A>(a[x * channels + c]);
+                }
+            }
+
+            if (!xs.outside.empty())
+                for (Nd4jLong x = 0; x < outWidth; x++)
+                    if (xs.outside[x])
+                        fillPixel(y, x);
+        }
     }
 
-    template<typename T>
-    int resizeNeighborFunctor_(NDArray const *images, int width, int height, bool center, NDArray *output) {
+    template <typename T>
+    static void resizeImages_(NDArray const *images, NDArray *output, ResizeTable const &ys, ResizeTable const &xs, bool nchw) {
         const Nd4jLong batchSize = images->sizeAt(0);
-        const Nd4jLong inHeight = images->sizeAt(1);
-        const Nd4jLong inWidth = images->sizeAt(2);
-        const Nd4jLong channels = images->sizeAt(3);
+        const Nd4jLong channels = nchw ? images->sizeAt(1) : images->sizeAt(3);
+        const Nd4jLong inHeight = nchw ? images->sizeAt(2) : images->sizeAt(1);
+        const Nd4jLong inWidth = nchw ? images->sizeAt(3) : images->sizeAt(2);
+        const Nd4jLong outHeight = nchw ? output->sizeAt(2) : output->sizeAt(1);
+        const Nd4jLong outWidth = nchw ? output->sizeAt(3) : output->sizeAt(2);
+
+        ImageGeometry in(inHeight, inWidth, channels, nchw);
+        ImageGeometry out(outHeight, outWidth, channels, nchw);
+
+        // kernels work with dense c-ordered buffers
+        NDArray *source = nullptr;
+        if (images->ordering() != 'c' || images->ews() != 1)
+            source = const_cast<NDArray*>(images)->dup('c');
+
+        NDArray *target = nullptr;
+        if (output->ordering() != 'c' || output->ews() != 1)
+            target = output->dup('c');
+
+        auto x = reinterpret_cast<T const *>(source != nullptr ? source->getBuffer() : images->getBuffer());
+        auto z = reinterpret_cast<T *>(target != nullptr ? target->buffer() : output->buffer());
 
-        const Nd4jLong outHeight = output->sizeAt(1);
-        const Nd4jLong outWidth = output->sizeAt(2);
+        const Nd4jLong numBlocks = (outHeight + kRowsPerTask - 1) / kRowsPerTask;
+        const Nd4jLong numTasks = batchSize * numBlocks;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(batchSize * out.length() > ELEMENT_THRESHOLD)
+        for (Nd4jLong task = 0; task < numTasks; task++) {
+            auto b = task / numBlocks;
+            auto yFrom = (task % numBlocks) * kRowsPerTask;
+            auto yTo = nd4j::math::nd4j_min<Nd4jLong>(yFrom + kRowsPerTask, outHeight);
+
+            resampleRows_<T>(x + b * in.length(), in, z + b * out.length(), out, ys, xs, yFrom, yTo, 0.);
+        }
+
+        if (target != nullptr) {
+            output->assign(target);
+            delete target;
+        }
+
+        delete source;
+    }
+
+    static int resizeFunctor(NDArray const *images, int method, bool center, bool nchw, NDArray *output, const char *opName) {
+        const Nd4jLong inHeight = nchw ? images->sizeAt(2) : images->sizeAt(1);
+        const Nd4jLong inWidth = nchw ? images->sizeAt(3) : images->sizeAt(2);
+        const Nd4jLong outHeight = nchw ? output->sizeAt(2) : output->sizeAt(1);
+        const Nd4jLong outWidth = nchw ? output->sizeAt(3) : output->sizeAt(2);
 
         // Handle no-op resizes efficiently.
         if (outHeight == inHeight && outWidth == inWidth) {
@@ -187,67 +499,75 @@ namespace helpers {
             return ND4J_STATUS_OK;
         }
 
+        // Special case for TF compatibility
+        if (method != kResizeNearest && ((center && inHeight < 2) || (center && inWidth < 2))) {
+            center = false;
+        }
+
         if ((center && inHeight < 2) || (inHeight < 1) || (outHeight < 1) || (center && outHeight < 2) ||
             (center && inWidth < 2) || (inWidth < 1) || (outWidth < 1) || (center && outWidth < 2)) {
             // wrong input data
-            nd4j_printf("image.resize_nearest_neighbor: Wrong input or output size to resize\n", "");
+            nd4j_printf("%s: Wrong input or output size to resize\n", opName);
             return ND4J_STATUS_BAD_ARGUMENTS;
         }
-        double heightScale = center ? (inHeight - 1.) / double(outHeight - 1.0) : (inHeight / double(outHeight));
-        double widthScale = center ? (inWidth - 1.) / double(outWidth - 1.0) : (inWidth / double(outWidth));
-
-        PRAGMA_OMP_PARALLEL_FOR_SIMD_COLLAPSE(2)
-        for (int b = 0; b < batchSize; ++b) {
-            for (int y = 0; y < outHeight; ++y) {
-                Nd4jLong inY = nd4j::math::nd4j_min(
-                        (center) ? static_cast<Nd4jLong>(nd4j::math::p_round<float>(y * heightScale)) : static_cast<Nd4jLong>(nd4j::math::p_floor<float>(
-                                y * heightScale)), inHeight - 1);
-                for (int x = 0; x < outWidth; ++x) {
-                    Nd4jLong inX = nd4j::math::nd4j_min(
-                            (center) ? static_cast<Nd4jLong>(nd4j::math::p_round<float>(x * widthScale)) : static_cast<Nd4jLong>(nd4j::math::p_floor<float>(
-                                    x * widthScale)), inWidth - 1);
-                    for (Nd4jLong e = 0; e < channels; e++)
-                        output->p(b, y, x, e, images->e<T>(b, inY, inX, e));
-//              std::copy_n(&input(b, in_y, in_x, 0), channels, &output(b, y, x, 0));
-                }
-            }
-        }
 
+        auto ys = cachedTable(method, inHeight, outHeight, center);
+        auto xs = cachedTable(method, inWidth, outWidth, center);
+
+        BUILD_SINGLE_SELECTOR(images->dataType(), resizeImages_, (images, output, *ys, *xs, nchw), NUMERIC_TYPES);
         return ND4J_STATUS_OK;
     }
 
-    void resizeImage(NDArray const *images, Nd4jLong batchSize, Nd4jLong inHeight, Nd4jLong inWidth, Nd4jLong outHeight,
-                     Nd4jLong outWidth, Nd4jLong channels,
-                     std::vector<BilinearInterpolationData> const &xs,
-                     std::vector<BilinearInterpolationData> const &ys,
-                     NDArray *output) {
-        BUILD_SINGLE_SELECTOR(images->dataType(), resizeImage_,
-                              (images, batchSize, inHeight, inWidth, outHeight, outWidth, channels, xs, ys, output),
-                              LIBND4J_TYPES);
+    int resizeBilinearFunctor(NDArray const *images, int width, int height, bool center, NDArray *output, bool dataFormatNCHW) {
+        return resizeFunctor(images, kResizeBilinear, center, dataFormatNCHW, output, "image.resize_bilinear");
     }
 
-    BUILD_SINGLE_TEMPLATE(template void resizeImage_,
-                          (NDArray const* images, Nd4jLong batchSize, Nd4jLong inHeight, Nd4jLong inWidth, Nd4jLong outHeight,
-                                  Nd4jLong outWidth, Nd4jLong channels,
-                                  std::vector<BilinearInterpolationData> const& xs,
-                                  std::vector<BilinearInterpolationData> const& ys,
-                                  NDArray* output), LIBND4J_TYPES);
-
-    int resizeBilinearFunctor(NDArray const *images, int width, int height, bool center, NDArray *output) {
-        BUILD_SINGLE_SELECTOR(images->dataType(), return resizeBilinearFunctor_,
-                              (images, width, height, center, output), LIBND4J_TYPES);
+    int resizeNeighborFunctor(NDArray const *images, int width, int height, bool center, NDArray *output, bool dataFormatNCHW) {
+        return resizeFunctor(images, kResizeNearest, center, dataFormatNCHW, output, "image.resize_nearest_neighbor");
     }
 
-    BUILD_SINGLE_TEMPLATE(template int resizeBilinearFunctor_,
-                          (NDArray const* images, int width, int height, bool center, NDArray* output), LIBND4J_TYPES);
+    int resizeBicubicFunctor(NDArray const *images, int width, int height, bool center, NDArray *output, bool dataFormatNCHW) {
+        return resizeFunctor(images, kResizeBicubic, center, dataFormatNCHW, output, "image.resize_bicubic");
+    }
 
-    int resizeNeighborFunctor(NDArray const *images, int width, int height, bool center, NDArray *output) {
-        BUILD_SINGLE_SELECTOR(images->dataType(), return resizeNeighborFunctor_,
-                              (images, width, height, center, output), LIBND4J_TYPES);
+    int resizeAreaFunctor(NDArray const *images, int width, int height, bool center, NDArray *output, bool dataFormatNCHW) {
+        return resizeFunctor(images, kResizeArea, center, dataFormatNCHW, output, "image.resize_area");
     }
 
-    BUILD_SINGLE_TEMPLATE(template int resizeNeighborFunctor_,
-                          (NDArray const* images, int width, int height, bool center, NDArray* output), LIBND4J_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void resizeImages_, (NDArray const* images, NDArray* output, ResizeTable const& ys, ResizeTable const& xs, bool nchw), NUMERIC_TYPES);
+
+    /**
+     * Builds per-box tables: box coordinates are arbitrary, so these can't be cached
+     */
+    static void cropTable(ResizeTable &table, float from, float to, Nd4jLong inSize, Nd4jLong outSize, int method) {
+        const float scale = (outSize > 1) ? (to - from) * (inSize - 1) / (outSize - 1) : 0.f;
+
+        table.taps = method == 0 ? 2 : 1;
+        table.indices.assign(outSize * table.taps, 0);
+        table.weights.assign(outSize * table.taps, 0.);
+        table.outside.assign(outSize, 0);
+
+        for (Nd4jLong i = 0; i < outSize; i++) {
+            const float in = (outSize > 1) ? from * (inSize - 1) + i * scale : 0.5 * (from + to) * (inSize - 1);
+            if (in < 0 || in > inSize - 1) {
+                table.outside[i] = 1;
+                continue;
+            }
+
+            if (method == 0 /* bilinear */) {
+                const auto lower = static_cast<Nd4jLong>(nd4j::math::p_floor(in));
+                const auto upper = static_cast<Nd4jLong>(nd4j::math::p_ceil(in));
+                const float lerp = in - lower;
+                table.indices[2 * i] = lower;
+                table.indices[2 * i + 1] = upper;
+                table.weights[2 * i] = 1.f - lerp;
+                table.weights[2 * i + 1] = lerp;
+            } else {
+                table.indices[i] = static_cast<Nd4jLong>(roundf(in));
+                table.weights[i] = 1.;
+            }
+        }
+    }
 
     template<typename T>
     static void cropAndResizeFunctor_(NDArray const *images, NDArray const *boxes, NDArray const *indices,
@@ -261,86 +581,52 @@ namespace helpers {
         const int cropWidth = crops->sizeAt(2);
         const int depth = crops->sizeAt(3);
 
-        // Sharding across boxes.
-        auto CropAndResizePerBox = [&](int startBox, int limitBox) {
-            for (int b = startBox; b < limitBox; ++b) {
-                T y1 = boxes->t<T>(b, 0);
-                T x1 = boxes->t<T>(b, 1);
-                T y2 = boxes->t<T>(b, 2);
-                T x2 = boxes->t<T>(b, 3);
+        ImageGeometry in(imageHeight, imageWidth, depth, false);
+        ImageGeometry out(cropHeight, cropWidth, depth, false);
 
-                int bIn = indices->e<int>(b);
-                if (bIn >= batchSize) {
-                    continue;
-                }
+        std::vector<ResizeTable> ys(numBoxes);
+        std::vector<ResizeTable> xs(numBoxes);
+        std::vector<int> bIn(numBoxes);
 
-                T heightScale = (cropHeight > 1) ? (y2 - y1) * (imageHeight - 1) / (cropHeight - 1) : T(0);
-                T widthScale = (cropWidth > 1) ? (x2 - x1) * (imageWidth - 1) / (cropWidth - 1) : T(0);
-
-                PRAGMA_OMP_PARALLEL_FOR_SIMD
-                for (int y = 0; y < cropHeight; ++y) {
-                    const float inY = (cropHeight > 1)
-                                      ? y1 * (imageHeight - 1) + y * heightScale
-                                      : 0.5 * (y1 + y2) * (imageHeight - 1);
-                    if (inY < 0 || inY > imageHeight - 1) {
-                        for (int x = 0; x < cropWidth; ++x) {
-                            for (int d = 0; d < depth; ++d) {
-                                crops->p(b, y, x, d, extrapolationVal);
-                            }
-                        }
-                        continue;
-                    }
-                    if (method == 0 /* bilinear */) {
-                        const int topYIndex = nd4j::math::p_floor(inY);
-                        const int bottomYIndex = nd4j::math::p_ceil(inY);
-                        const float y_lerp = inY - topYIndex;
-
-                        for (int x = 0; x < cropWidth; ++x) {
-                            const float in_x = (cropWidth > 1)
-                                               ? x1 * (imageWidth - 1) + x * widthScale
-                                               : 0.5 * (x1 + x2) * (imageWidth - 1);
-                            if (in_x < 0 || in_x > imageWidth - 1) {
-                                for (int d = 0; d < depth; ++d) {
-                                    crops->p(b, y, x, d, extrapolationVal);
-                                }
-                                continue;
-                            }
-                            int left_x_index = math::p_floor(in_x);
-                            int right_x_index = math::p_ceil(in_x);
-                            T x_lerp = in_x - left_x_index;
-
-                            for (int d = 0; d < depth; ++d) {
-                                const float topLeft(images->e<float>(bIn, topYIndex, left_x_index, d));
-                                const float topRight(images->e<float>(bIn, topYIndex, right_x_index, d));
-                                const float bottomLeft(images->e<float>(bIn, bottomYIndex, left_x_index, d));
-                                const float bottomRight(images->e<float>(bIn, bottomYIndex, right_x_index, d));
-                                const float top = topLeft + (topRight - topLeft) * x_lerp;
-                                const float bottom = bottomLeft + (bottomRight - bottomLeft) * x_lerp;
-                                crops->p(b, y, x, d, top + (bottom - top) * y_lerp);
-                            }
-                        }
-                    } else {  // method is "nearest neighbor"
-                        for (int x = 0; x < cropWidth; ++x) {
-                            const float inX = (cropWidth > 1)
-                                              ? x1 * (imageWidth - 1) + x * widthScale
-                                              : 0.5 * (x1 + x2) * (imageWidth - 1);
-                            if (inX < 0 || inX > imageWidth - 1) {
-                                for (int d = 0; d < depth; ++d) {
-                                    crops->p(b, y, x, d, extrapolationVal);
-                                }
-                                continue;
-                            }
-                            const int closestXIndex = roundf(inX);
-                            const int closestYIndex = roundf(inY);
-                            for (int d = 0; d < depth; ++d) {
-                                crops->p(b, y, x, d, images->e<T>(bIn, closestYIndex, closestXIndex, d));
-                            }
-                        }
-                    }
-                }
-            }
-        };
-        CropAndResizePerBox(0, numBoxes);
+        for (int b = 0; b < numBoxes; ++b) {
+            bIn[b] = indices->e<int>(b);
+            cropTable(ys[b], boxes->e<float>(b, 0), boxes->e<float>(b, 2), imageHeight, cropHeight, method);
+            cropTable(xs[b], boxes->e<float>(b, 1), boxes->e<float>(b, 3), imageWidth, cropWidth, method);
+        }
+
+        NDArray *source = nullptr;
+        if (images->ordering() != 'c' || images->ews() != 1)
+            source = const_cast<NDArray*>(images)->dup('c');
+
+        NDArray *target = nullptr;
+        if (crops->ordering() != 'c' || crops->ews() != 1)
+            target = crops->dup('c');
+
+        auto x = reinterpret_cast<T const *>(source != nullptr ? source->getBuffer() : images->getBuffer());
+        auto z = reinterpret_cast<T *>(target != nullptr ? target->buffer() : crops->buffer());
+
+        const Nd4jLong numBlocks = (cropHeight + kRowsPerTask - 1) / kRowsPerTask;
+        const Nd4jLong numTasks = numBoxes * numBlocks;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numBoxes * out.length() > ELEMENT_THRESHOLD)
+        for (Nd4jLong task = 0; task < numTasks; task++) {
+            auto b = task / numBlocks;
+            // boxes pointing outside of batch are left untouched
+            if (bIn[b] >= batchSize)
+                continue;
+
+            auto yFrom = (task % numBlocks) * kRowsPerTask;
+            auto yTo = nd4j::math::nd4j_min<Nd4jLong>(yFrom + kRowsPerTask, cropHeight);
+
+            resampleRows_<T>(x + bIn[b] * in.length(), in, z + b * out.length(), out, ys[b], xs[b], yFrom, yTo, extrapolationVal);
+        }
+
+        if (target != nullptr) {
+            crops->assign(target);
+            delete target;
+        }
+
+        delete source;
     }
 
 
@@ -19,72 +19,321 @@
 //
 
 #include <ops/declarable/helpers/image_suppression.h>
-//#include <blas/NDArray.h>
+#include <algorithm>
+#include <queue>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // kept boxes are scanned backwards in blocks of this size: overlapping boxes are likely to have similar scores,
+    // so suppression is usually decided by the most recent block, and each block is single vectorized loop
+    static const Nd4jLong kSuppressionBlock = 32;
+
+    /**
+     * Boxes selected so far, in SoA layout, corners normalized to (yMin, xMin, yMax, xMax)
+     */
     template <typename T>
-    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        std::vector<Nd4jLong> indices(scales->lengthOf());
-        for (size_t i = 0; i < indices.size(); ++i)
-            indices[i] = i;
-        std::sort(indices.begin(), indices.end(), [scales](int i, int j) {return scales->e<T>(i) > scales->e<T>(j);});
-
-        std::vector<int> selected;
-        std::vector<int> selectedIndices(output->lengthOf(), 0);
-        auto needToSuppressWithThreshold = [threshold] (NDArray& boxes, int previousIndex, int nextIndex) -> bool {
-            T minYPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T minXPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T maxYPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T maxXPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T minYNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T minXNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T maxYNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T maxXNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T areaPrev = (maxYPrev - minYPrev) * (maxXPrev - minXPrev);
-            T areaNext = (maxYNext - minYNext) * (maxXNext - minXNext);
-
-            if (areaNext <= T(0.f) || areaPrev <= T(0.f)) return false;
-
-            T minIntersectionY = nd4j::math::nd4j_max(minYPrev, minYNext);
-            T minIntersectionX = nd4j::math::nd4j_max(minXPrev, minXNext);
-            T maxIntersectionY = nd4j::math::nd4j_min(maxYPrev, maxYNext);
-            T maxIntersectionX = nd4j::math::nd4j_min(maxXPrev, maxXNext);
-            T intersectionArea =
-                    nd4j::math::nd4j_max(T(maxIntersectionY - minIntersectionY), T(0.0f)) *
-                            nd4j::math::nd4j_max(T(maxIntersectionX - minIntersectionX), T(0.0f));
-            T intersectionValue = intersectionArea / (areaPrev + areaNext - intersectionArea);
-            return intersectionValue > threshold;
+    class SuppressionSet {
+    protected:
+        std::vector<T> _yMin;
+        std::vector<T> _xMin;
+        std::vector<T> _yMax;
+        std::vector<T> _xMax;
+        std::vector<T> _area;
 
-        };
-        int numSelected = 0;
-        for (int i = 0; i < boxes->sizeAt(0); ++i) {
-            if (selected.size() >= output->lengthOf()) break;
-            bool shouldSelect = true;
-            // Overlapping boxes are likely to have similar scores,
-            // therefore we iterate through the selected boxes backwards.
-            for (int j = numSelected - 1; j >= 0; --j) {
-                if (needToSuppressWithThreshold(*boxes, indices[i], indices[selectedIndices[j]])) {
-                    shouldSelect = false;
+    public:
+        explicit SuppressionSet(Nd4jLong capacity) {
+            _yMin.reserve(capacity);
+            _xMin.reserve(capacity);
+            _yMax.reserve(capacity);
+            _xMax.reserve(capacity);
+            _area.reserve(capacity);
+        }
+
+        Nd4jLong size() const {
+            return static_cast<Nd4jLong>(_area.size());
+        }
+
+        void push(const T *box) {
+            _yMin.push_back(nd4j::math::nd4j_min<T>(box[0], box[2]));
+            _xMin.push_back(nd4j::math::nd4j_min<T>(box[1], box[3]));
+            _yMax.push_back(nd4j::math::nd4j_max<T>(box[0], box[2]));
+            _xMax.push_back(nd4j::math::nd4j_max<T>(box[1], box[3]));
+            _area.push_back((_yMax.back() - _yMin.back()) * (_xMax.back() - _xMin.back()));
+        }
+
+        /**
+         * This method returns max IoU of given box against kept boxes [from, to)
+         */
+        T maxOverlap(const T *box, Nd4jLong from, Nd4jLong to) const {
+            const T yMin = nd4j::math::nd4j_min<T>(box[0], box[2]);
+            const T xMin = nd4j::math::nd4j_min<T>(box[1], box[3]);
+            const T yMax = nd4j::math::nd4j_max<T>(box[0], box[2]);
+            const T xMax = nd4j::math::nd4j_max<T>(box[1], box[3]);
+            const T area = (yMax - yMin) * (xMax - xMin);
+            if (area <= static_cast<T>(0))
+                return static_cast<T>(0);
+
+            const T *kyMin = _yMin.data();
+            const T *kxMin = _xMin.data();
+            const T *kyMax = _yMax.data();
+            const T *kxMax = _xMax.data();
+            const T *kArea = _area.data();
+
+            T result = static_cast<T>(0);
+            PRAGMA_OMP_SIMD_ARGS(reduction(max:result))
+            for (Nd4jLong k = from; k < to; k++) {
+                T h = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(yMax, kyMax[k]) - nd4j::math::nd4j_max<T>(yMin, kyMin[k]), static_cast<T>(0));
+                T w = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(xMax, kxMax[k]) - nd4j::math::nd4j_max<T>(xMin, kxMin[k]), static_cast<T>(0));
+                T intersection = h * w;
+                // degenerate kept boxes never suppress anything
+                T iou = kArea[k] > static_cast<T>(0) ? intersection / (area + kArea[k] - intersection) : static_cast<T>(0);
+                result = nd4j::math::nd4j_max<T>(result, iou);
+            }
+
+            return result;
+        }
+
+        /**
+         * This method returns sum of squared IoU of given box against kept boxes [from, to), used for soft-NMS decay.
+         * Max IoU over the same range is written to maxIou, so hard cutoff doesn't need another pass
+         */
+        T sumSquaredOverlap(const T *box, Nd4jLong from, Nd4jLong to, T &maxIou) const {
+            const T yMin = nd4j::math::nd4j_min<T>(box[0], box[2]);
+            const T xMin = nd4j::math::nd4j_min<T>(box[1], box[3]);
+            const T yMax = nd4j::math::nd4j_max<T>(box[0], box[2]);
+            const T xMax = nd4j::math::nd4j_max<T>(box[1], box[3]);
+            const T area = (yMax - yMin) * (xMax - xMin);
+            maxIou = static_cast<T>(0);
+            if (area <= static_cast<T>(0))
+                return static_cast<T>(0);
+
+            const T *kyMin = _yMin.data();
+            const T *kxMin = _xMin.data();
+            const T *kyMax = _yMax.data();
+            const T *kxMax = _xMax.data();
+            const T *kArea = _area.data();
+
+            T sum = static_cast<T>(0);
+            T result = static_cast<T>(0);
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum) reduction(max:result))
+            for (Nd4jLong k = from; k < to; k++) {
+                T h = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(yMax, kyMax[k]) - nd4j::math::nd4j_max<T>(yMin, kyMin[k]), static_cast<T>(0));
+                T w = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(xMax, kxMax[k]) - nd4j::math::nd4j_max<T>(xMin, kxMin[k]), static_cast<T>(0));
+                T intersection = h * w;
+                T iou = kArea[k] > static_cast<T>(0) ? intersection / (area + kArea[k] - intersection) : static_cast<T>(0);
+                sum += iou * iou;
+                result = nd4j::math::nd4j_max<T>(result, iou);
+            }
+
+            maxIou = result;
+            return sum;
+        }
+    };
+
+    /**
+     * Single NMS problem: box i is at boxes + i * boxStride, its score at scores + i * scoreStride.
+     * Selected box numbers are appended to selected in order of selection, with their (possibly decayed) scores.
+     */
+    template <typename T>
+    static void suppress_(const T *boxes, Nd4jLong boxStride, const T *scores, Nd4jLong scoreStride, Nd4jLong numBoxes,
+                          Nd4jLong maxOutputSize, T iouThreshold, T scoreThreshold, T softNmsSigma,
+                          std::vector<Nd4jLong> &selected, std::vector<T> &selectedScores) {
+        // candidates below score threshold never participate
+        std::vector<std::pair<T, Nd4jLong>> candidates;
+        candidates.reserve(numBoxes);
+        for (Nd4jLong i = 0; i < numBoxes; i++) {
+            auto score = scores[i * scoreStride];
+            if (score > scoreThreshold)
+                candidates.emplace_back(score, i);
+        }
+
+        if (candidates.empty() || maxOutputSize <= 0)
+            return;
+
+        SuppressionSet<T> kept(nd4j::math::nd4j_min<Nd4jLong>(maxOutputSize, candidates.size()));
+
+        if (softNmsSigma <= static_cast<T>(0)) {
+            // hard suppression: candidates are sorted once, and each one is checked against kept set only
+            std::stable_sort(candidates.begin(), candidates.end(), [](const std::pair<T, Nd4jLong> &a, const std::pair<T, Nd4jLong> &b) -> bool {
+                return a.first > b.first;
+            });
+
+            for (const auto &candidate : candidates) {
+                if (kept.size() >= maxOutputSize)
                     break;
+
+                const T *box = boxes + candidate.second * boxStride;
+                bool suppressed = false;
+                for (Nd4jLong to = kept.size(); to > 0 && !suppressed; to -= kSuppressionBlock) {
+                    auto from = nd4j::math::nd4j_max<Nd4jLong>(0, to - kSuppressionBlock);
+                    suppressed = kept.maxOverlap(box, from, to) > iouThreshold;
+                }
+
+                if (!suppressed) {
+                    kept.push(box);
+                    selected.push_back(candidate.second);
+                    selectedScores.push_back(candidate.first);
                 }
             }
-            if (shouldSelect) {
-                selected.push_back(indices[i]);
-                selectedIndices[numSelected++] = i;
+            return;
+        }
+
+        // soft suppression: scores decay as exp(-iou^2 / (2 * sigma)) with every overlapping box selected,
+        // so candidate goes back to queue until its score is up to date with the whole kept set.
+        // Same as NonMaxSuppressionV5, boxes overlapping any kept box above iouThreshold are still dropped
+        struct Candidate {
+            T score;
+            Nd4jLong index;
+            Nd4jLong checkedUpTo;
+        };
+
+        auto cmp = [](const Candidate &a, const Candidate &b) -> bool {
+            return a.score == b.score ? a.index > b.index : a.score < b.score;
+        };
+
+        std::priority_queue<Candidate, std::vector<Candidate>, decltype(cmp)> queue(cmp);
+        for (const auto &candidate : candidates)
+            queue.push({candidate.first, candidate.second, 0});
+
+        const T scale = static_cast<T>(-0.5) / softNmsSigma;
+        while (kept.size() < maxOutputSize && !queue.empty()) {
+            auto candidate = queue.top();
+            queue.pop();
+
+            const T original = candidate.score;
+            const T *box = boxes + candidate.index * boxStride;
+            if (candidate.checkedUpTo < kept.size()) {
+                T maxIou;
+                auto decay = kept.sumSquaredOverlap(box, candidate.checkedUpTo, kept.size(), maxIou);
+                if (maxIou > iouThreshold)
+                    continue;
+
+                candidate.score *= nd4j::math::nd4j_exp<T, T>(scale * decay);
+            }
+
+            candidate.checkedUpTo = kept.size();
+
+            if (candidate.score == original) {
+                kept.push(box);
+                selected.push_back(candidate.index);
+                selectedScores.push_back(candidate.score);
+            } else if (candidate.score > scoreThreshold) {
+                queue.push(candidate);
             }
         }
+    }
+
+    template <typename T>
+    static void toDense(NDArray *array, std::vector<T> &buffer) {
+        buffer.resize(array->lengthOf());
+        auto length = array->lengthOf();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = array->e<T>(e);
+    }
+
+    template <typename T>
+    static void nonMaxSuppression_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, double scoreThreshold, double softNmsSigma, NDArray* output) {
+        std::vector<T> coords;
+        std::vector<T> scores;
+        toDense<T>(boxes, coords);
+        toDense<T>(scales, scores);
+
+        std::vector<Nd4jLong> selected;
+        std::vector<T> selectedScores;
+        auto maxOutputSize = nd4j::math::nd4j_min<Nd4jLong>(maxSize, output->lengthOf());
+        suppress_<T>(coords.data(), 4, scores.data(), 1, scales->lengthOf(), maxOutputSize,
+                     static_cast<T>(threshold), static_cast<T>(scoreThreshold), static_cast<T>(softNmsSigma), selected, selectedScores);
+
         for (size_t e = 0; e < selected.size(); ++e)
-            output->p<int>(e, selected[e]);
+            output->p<Nd4jLong>(e, selected[e]);
     }
 
-    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), nonMaxSuppressionV2_, (boxes, scales, maxSize, threshold, output), NUMERIC_TYPES);
+    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output, double scoreThreshold, double softNmsSigma) {
+        // boxes are processed in double only if given in double
+        if (boxes->dataType() == nd4j::DataType::DOUBLE)
+            nonMaxSuppression_<double>(boxes, scales, maxSize, threshold, scoreThreshold, softNmsSigma, output);
+        else
+            nonMaxSuppression_<float>(boxes, scales, maxSize, threshold, scoreThreshold, softNmsSigma, output);
     }
-    BUILD_SINGLE_TEMPLATE(template void nonMaxSuppressionV2_, (NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output), NUMERIC_TYPES);
 
+    template <typename T>
+    static void combinedNonMaxSuppression_(NDArray* boxes, NDArray* scores, int maxOutputPerClass, int maxTotalSize,
+                                           double threshold, double scoreThreshold, double softNmsSigma, bool clipBoxes,
+                                           NDArray* nmsedBoxes, NDArray* nmsedScores, NDArray* nmsedClasses, NDArray* validDetections) {
+        const Nd4jLong batchSize = boxes->sizeAt(0);
+        const Nd4jLong numBoxes = boxes->sizeAt(1);
+        const Nd4jLong q = boxes->sizeAt(2);
+        const Nd4jLong numClasses = scores->sizeAt(2);
+
+        std::vector<T> coords;
+        std::vector<T> probs;
+        toDense<T>(boxes, coords);
+        toDense<T>(scores, probs);
+
+        // every (batch, class) pair is independent NMS problem
+        std::vector<std::vector<Nd4jLong>> selected(batchSize * numClasses);
+        std::vector<std::vector<T>> selectedScores(batchSize * numClasses);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(dynamic) if(batchSize * numClasses > 1))
+        for (Nd4jLong task = 0; task < batchSize * numClasses; task++) {
+            auto b = task / numClasses;
+            auto c = task % numClasses;
+
+            const T *classBoxes = coords.data() + (b * numBoxes * q + (q > 1 ? c : 0)) * 4;
+            const T *classScores = probs.data() + b * numBoxes * numClasses + c;
+
+            suppress_<T>(classBoxes, q * 4, classScores, numClasses, numBoxes, maxOutputPerClass,
+                         static_cast<T>(threshold), static_cast<T>(scoreThreshold), static_cast<T>(softNmsSigma), selected[task], selectedScores[task]);
+        }
+
+        nmsedBoxes->assign(0.f);
+        nmsedScores->assign(0.f);
+        nmsedClasses->assign(0.f);
+
+        // per batch: best maxTotalSize detections over all classes
+        PRAGMA_OMP_PARALLEL_FOR_IF(batchSize > 1)
+        for (Nd4jLong b = 0; b < batchSize; b++) {
+            std::vector<std::pair<T, std::pair<Nd4jLong, Nd4jLong>>> detections;
+            for (Nd4jLong c = 0; c < numClasses; c++) {
+                auto task = b * numClasses + c;
+                for (size_t e = 0; e < selected[task].size(); e++)
+                    detections.push_back({selectedScores[task][e], {c, selected[task][e]}});
+            }
+
+            std::stable_sort(detections.begin(), detections.end(), [](const std::pair<T, std::pair<Nd4jLong, Nd4jLong>> &a, const std::pair<T, std::pair<Nd4jLong, Nd4jLong>> &b) -> bool {
+                return a.first > b.first;
+            });
+
+            auto numValid = nd4j::math::nd4j_min<Nd4jLong>(maxTotalSize, detections.size());
+            for (Nd4jLong e = 0; e < numValid; e++) {
+                auto c = detections[e].second.first;
+                auto i = detections[e].second.second;
+                const T *box = coords.data() + (b * numBoxes * q + i * q + (q > 1 ? c : 0)) * 4;
+                for (int k = 0; k < 4; k++)
+                    nmsedBoxes->p<T>((b * maxTotalSize + e) * 4 + k, clipBoxes ? nd4j::math::nd4j_max<T>(static_cast<T>(0), nd4j::math::nd4j_min<T>(box[k], static_cast<T>(1))) : box[k]);
+
+                nmsedScores->p<T>(b * maxTotalSize + e, detections[e].first);
+                nmsedClasses->p<Nd4jLong>(b * maxTotalSize + e, c);
+            }
+
+            validDetections->p<Nd4jLong>(b, numValid);
+        }
+    }
+
+    void combinedNonMaxSuppression(NDArray* boxes, NDArray* scores, int maxOutputPerClass, int maxTotalSize,
+                                   double threshold, double scoreThreshold, double softNmsSigma, bool clipBoxes,
+                                   NDArray* nmsedBoxes, NDArray* nmsedScores, NDArray* nmsedClasses, NDArray* validDetections) {
+        if (boxes->dataType() == nd4j::DataType::DOUBLE)
+            combinedNonMaxSuppression_<double>(boxes, scores, maxOutputPerClass, maxTotalSize, threshold, scoreThreshold, softNmsSigma, clipBoxes, nmsedBoxes, nmsedScores, nmsedClasses, validDetections);
+        else
+            combinedNonMaxSuppression_<float>(boxes, scores, maxOutputPerClass, maxTotalSize, threshold, scoreThreshold, softNmsSigma, clipBoxes, nmsedBoxes, nmsedScores, nmsedClasses, validDetections);
+    }
+
+}
 }
 }
-}
\ No newline at end of file
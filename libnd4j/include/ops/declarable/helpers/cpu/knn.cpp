@@ -0,0 +1,280 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/knn.h>
+#include <helpers/BlasHelper.h>
+#include <helpers/ContiguousBuffer.h>
+#include <helpers/HalfConversions.h>
+#include <ops/ops.h>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // queries processed together: their heaps stay hot, and every base tile is read once per block
+    static const int KNN_QUERY_BLOCK = 256;
+
+    // base rows per tile: KNN_QUERY_BLOCK x KNN_BASE_BLOCK scores block is 4MB for fp32
+    static const int KNN_BASE_BLOCK = 4096;
+
+    /**
+     * Search candidate. Lower distance is better, ties are resolved in favor of lower id, so results are deterministic
+     */
+    template <typename C>
+    struct KnnCandidate {
+        C distance;
+        Nd4jLong id;
+
+        FORCEINLINE bool operator<(const KnnCandidate<C>& other) const {
+            return distance < other.distance || (distance == other.distance && id < other.id);
+        }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Metrics: norm() prepares squared norm of row, distance() turns dot product and prepared norms into "lower is better"
+    // distance, output() converts it into value reported to user
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    template <typename C>
+    struct KnnEuclidean {
+        static FORCEINLINE C norm(C squared) { return squared; }
+        static FORCEINLINE C distance(C dot, C qNorm, C bNorm) { return nd4j::math::nd4j_max<C>(qNorm + bNorm - static_cast<C>(2) * dot, static_cast<C>(0)); }
+        static FORCEINLINE C output(C distance) { return nd4j::math::nd4j_sqrt<C, C>(distance); }
+    };
+
+    template <typename C>
+    struct KnnCosine {
+        static FORCEINLINE C norm(C squared) { return squared > static_cast<C>(0) ? static_cast<C>(1) / nd4j::math::nd4j_sqrt<C, C>(squared) : static_cast<C>(0); }
+        static FORCEINLINE C distance(C dot, C qNorm, C bNorm) { return static_cast<C>(1) - dot * qNorm * bNorm; }
+        static FORCEINLINE C output(C distance) { return distance; }
+    };
+
+    template <typename C>
+    struct KnnDot {
+        static FORCEINLINE C norm(C squared) { return static_cast<C>(0); }
+        static FORCEINLINE C distance(C dot, C qNorm, C bNorm) { return -dot; }
+        static FORCEINLINE C output(C distance) { return -distance; }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Staging
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    template <typename T>
+    static FORCEINLINE void stage(const T* x, float* z, Nd4jLong length) {
+        HalfConversions::toFloat(x, z, length);
+    }
+
+    template <typename T>
+    static FORCEINLINE void stage(const T* x, double* z, Nd4jLong length) {
+        for (Nd4jLong e = 0; e < length; e++)
+            z[e] = static_cast<double>(x[e]);
+    }
+
+    /**
+     * This method returns pointer to rows of compute type C: input itself if types match, staging buffer otherwise
+     */
+    template <typename T, typename C>
+    static FORCEINLINE const C* rowsAs(const T* x, Nd4jLong rows, Nd4jLong dim, std::vector<C>& staging) {
+        if (std::is_same<T, C>::value)
+            return reinterpret_cast<const C*>(x);
+
+        stage(x, staging.data(), rows * dim);
+        return staging.data();
+    }
+
+    template <typename T, typename C, typename Metric>
+    static void rowNorms_(const T* x, Nd4jLong rows, Nd4jLong dim, C* norms) {
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(rows * dim > Environment::getInstance()->elementwiseThreshold()) schedule(static))
+        for (Nd4jLong r0 = 0; r0 < rows; r0 += KNN_BASE_BLOCK / 16) {
+            const Nd4jLong rb = nd4j::math::nd4j_min<Nd4jLong>(KNN_BASE_BLOCK / 16, rows - r0);
+            std::vector<C> staging(std::is_same<T, C>::value ? 0 : rb * dim);
+            auto rowsC = rowsAs<T, C>(x + r0 * dim, rb, dim, staging);
+
+            for (Nd4jLong r = 0; r < rb; r++) {
+                auto row = rowsC + r * dim;
+                C sum = static_cast<C>(0);
+
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (Nd4jLong e = 0; e < dim; e++)
+                    sum += row[e] * row[e];
+
+                norms[r0 + r] = Metric::norm(sum);
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Scores
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * scores[qb, bb] = queries[qb, dim] * base[bb, dim]^T
+     */
+    template <typename C>
+    static void dotBlock_(const C* q, const C* b, C* scores, int qb, int bb, int dim) {
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(static_cast<Nd4jLong>(qb) * bb * dim > Environment::getInstance()->elementwiseThreshold()) collapse(2))
+        for (int i = 0; i < qb; i++) {
+            for (int j = 0; j < bb; j++) {
+                auto x = q + static_cast<Nd4jLong>(i) * dim;
+                auto y = b + static_cast<Nd4jLong>(j) * dim;
+                C sum = static_cast<C>(0);
+
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (int e = 0; e < dim; e++)
+                    sum += x[e] * y[e];
+
+                scores[static_cast<Nd4jLong>(i) * bb + j] = sum;
+            }
+        }
+    }
+
+    static void dotBlock(const float* q, const float* b, float* scores, int qb, int bb, int dim) {
+        if (BlasHelper::getInstance()->hasGEMM<float>())
+            BlasHelper::getInstance()->sgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, qb, bb, dim, 1.f, const_cast<float*>(q), dim, const_cast<float*>(b), dim, 0.f, scores, bb);
+        else
+            dotBlock_<float>(q, b, scores, qb, bb, dim);
+    }
+
+    static void dotBlock(const double* q, const double* b, double* scores, int qb, int bb, int dim) {
+        if (BlasHelper::getInstance()->hasGEMM<double>())
+            BlasHelper::getInstance()->dgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, qb, bb, dim, 1., const_cast<double*>(q), dim, const_cast<double*>(b), dim, 0., scores, bb);
+        else
+            dotBlock_<double>(q, b, scores, qb, bb, dim);
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Search
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * T is data type of inputs, C is compute type: double for double inputs, float for everything else
+     */
+    template <typename T, typename C, typename Metric>
+    static void knnSearch_(NDArray* queries, NDArray* base, int k, NDArray* distances, NDArray* indices) {
+        const Nd4jLong numQueries = queries->sizeAt(0);
+        const Nd4jLong numBase = base->sizeAt(0);
+        const int dim = static_cast<int>(queries->sizeAt(1));
+
+        ContiguousBuffer qBuffer(queries, queries->dataType());
+        ContiguousBuffer bBuffer(base, queries->dataType());
+        ContiguousBuffer dBuffer(distances, DataTypeUtils::fromT<C>(), true);
+        ContiguousBuffer iBuffer(indices, nd4j::DataType::INT64, true);
+
+        auto q = qBuffer.buffer<T>();
+        auto b = bBuffer.buffer<T>();
+        auto dist = dBuffer.buffer<C>();
+        auto idx = iBuffer.buffer<Nd4jLong>();
+
+        std::vector<C> qNorms(numQueries);
+        std::vector<C> bNorms(numBase);
+        rowNorms_<T, C, Metric>(q, numQueries, dim, qNorms.data());
+        rowNorms_<T, C, Metric>(b, numBase, dim, bNorms.data());
+
+        const bool native = std::is_same<T, C>::value;
+        std::vector<C> qStaging(native ? 0 : static_cast<Nd4jLong>(KNN_QUERY_BLOCK) * dim);
+        std::vector<C> bStaging(native ? 0 : static_cast<Nd4jLong>(KNN_BASE_BLOCK) * dim);
+        std::vector<C> scores(static_cast<Nd4jLong>(KNN_QUERY_BLOCK) * KNN_BASE_BLOCK);
+        std::vector<std::vector<KnnCandidate<C>>> heaps(KNN_QUERY_BLOCK);
+
+        for (Nd4jLong q0 = 0; q0 < numQueries; q0 += KNN_QUERY_BLOCK) {
+            const int qb = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(KNN_QUERY_BLOCK, numQueries - q0));
+            auto qRows = rowsAs<T, C>(q + q0 * dim, qb, dim, qStaging);
+
+            for (int i = 0; i < qb; i++) {
+                heaps[i].clear();
+                heaps[i].reserve(k);
+            }
+
+            for (Nd4jLong b0 = 0; b0 < numBase; b0 += KNN_BASE_BLOCK) {
+                const int bb = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(KNN_BASE_BLOCK, numBase - b0));
+                auto bRows = rowsAs<T, C>(b + b0 * dim, bb, dim, bStaging);
+
+                // gemm is called outside of parallel region, so BLAS can use its own threads
+                dotBlock(qRows, bRows, scores.data(), qb, bb, dim);
+
+                // every query owns its heap, so no synchronization is needed
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(if(qb > 1 && static_cast<Nd4jLong>(qb) * bb > Environment::getInstance()->elementwiseThreshold()) schedule(static))
+                for (int i = 0; i < qb; i++) {
+                    auto& heap = heaps[i];
+                    auto s = scores.data() + static_cast<Nd4jLong>(i) * bb;
+                    auto qNorm = qNorms[q0 + i];
+
+                    for (int j = 0; j < bb; j++) {
+                        KnnCandidate<C> candidate = {Metric::distance(s[j], qNorm, bNorms[b0 + j]), b0 + j};
+
+                        if (static_cast<int>(heap.size()) < k) {
+                            heap.emplace_back(candidate);
+                            std::push_heap(heap.begin(), heap.end());
+                        } else if (candidate < heap.front()) {
+                            std::pop_heap(heap.begin(), heap.end());
+                            heap.back() = candidate;
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                    }
+                }
+            }
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(qb > 1 && static_cast<Nd4jLong>(qb) * k > Environment::getInstance()->elementwiseThreshold())
+            for (int i = 0; i < qb; i++) {
+                auto& heap = heaps[i];
+                std::sort_heap(heap.begin(), heap.end());
+
+                auto d = dist + (q0 + i) * k;
+                auto x = idx + (q0 + i) * k;
+                for (int e = 0; e < k; e++) {
+                    d[e] = Metric::output(heap[e].distance);
+                    x[e] = heap[e].id;
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    static void knnTopK_(NDArray* queries, NDArray* base, int k, int metric, NDArray* distances, NDArray* indices) {
+        typedef typename std::conditional<std::is_same<T, double>::value, double, float>::type C;
+
+        switch (metric) {
+            case KNN_EUCLIDEAN:
+                knnSearch_<T, C, KnnEuclidean<C>>(queries, base, k, distances, indices);
+                break;
+            case KNN_COSINE:
+                knnSearch_<T, C, KnnCosine<C>>(queries, base, k, distances, indices);
+                break;
+            case KNN_DOT:
+                knnSearch_<T, C, KnnDot<C>>(queries, base, k, distances, indices);
+                break;
+            default:
+                throw std::invalid_argument("knnTopK: unknown metric " + std::to_string(metric));
+        }
+    }
+
+    void knnTopK(NDArray* queries, NDArray* base, int k, int metric, NDArray* distances, NDArray* indices) {
+        BUILD_SINGLE_SELECTOR(queries->dataType(), knnTopK_, (queries, base, k, metric, distances, indices), NUMERIC_TYPES);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void knnTopK_, (NDArray* queries, NDArray* base, int k, int metric, NDArray* distances, NDArray* indices), NUMERIC_TYPES);
+}
+}
+}
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/layer_norm.h>
+#include <NDArrayAccessor.h>
+#include <type_traits>
+
+namespace nd4j    {
+namespace ops     {
+namespace helpers {
+
+// rows handled by single task of layerNormBp, partial sums of dLdg/dLdb are merged in fixed order
+static const Nd4jLong kLayerNormRowsPerTask = 64;
+
+// mean and 1/stdev (population) of single row, 1/stdev is 0 for constant row, same as standardize op gives after ReplaceNans
+template <typename T, typename A>
+static FORCEINLINE void rowStats(const T* x, const Nd4jLong len, A& mean, A& invStd) {
+    A sum = 0;
+    PRAGMA_OMP_SIMD_SUM(sum)
+    for(Nd4jLong i = 0; i < len; ++i)
+        sum += static_cast<A>(x[i]);
+    mean = sum / static_cast<A>(len);
+
+    A sq = 0;
+    PRAGMA_OMP_SIMD_SUM(sq)
+    for(Nd4jLong i = 0; i < len; ++i) {
+        const A d = static_cast<A>(x[i]) - mean;
+        sq += d * d;
+    }
+
+    const A std = nd4j::math::nd4j_sqrt<A, A>(sq / static_cast<A>(len));
+    invStd = std > (A) 0 ? (A) 1 / std : (A) 0;
+}
+
+template <typename T>
+static std::vector<T> paramToVector(const NDArray* param) {
+    std::vector<T> result(param->lengthOf());
+    NDArrayAccessor<const T> acc(*param);
+    for(Nd4jLong i = 0; i < param->lengthOf(); ++i)
+        result[i] = acc[i];
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void layerNorm_(const NDArray* input, const NDArray* gain, const NDArray* bias, NDArray* output) {
+
+    // half precision types are accumulated in float
+    typedef typename std::conditional<sizeof(T) < sizeof(float), float, T>::type A;
+
+    const Nd4jLong numFeatures = input->sizeAt(-1);
+    const Nd4jLong numRows = input->lengthOf() / numFeatures;
+
+    const auto g = paramToVector<T>(gain);
+    const auto b = bias != nullptr ? paramToVector<T>(bias) : std::vector<T>(numFeatures, static_cast<T>(0));
+    const T* gp = g.data();
+    const T* bp = b.data();
+
+    const T* x = input->bufferAsT<T>();
+          T* z = output->bufferAsT<T>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(numRows > 1 && input->lengthOf() > Environment::getInstance()->elementwiseThreshold())
+    for(Nd4jLong r = 0; r < numRows; ++r) {
+        const T* xr = x + r * numFeatures;
+              T* zr = z + r * numFeatures;
+
+        A mean, invStd;
+        rowStats<T, A>(xr, numFeatures, mean, invStd);
+
+        PRAGMA_OMP_SIMD
+        for(Nd4jLong i = 0; i < numFeatures; ++i)
+            zr[i] = static_cast<T>((static_cast<A>(xr[i]) - mean) * invStd) * gp[i] + bp[i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// with xhat = (x - mean) / stdev and g = eps * gain per row of F elements:
+// dLdx = (g - sum(g) / F - xhat * sum(g * xhat) / F) / stdev, dLdg = sum over rows of eps * xhat, dLdb = sum over rows of eps
+template <typename T>
+static void layerNormBp_(const NDArray* input, const NDArray* gain, const NDArray* eps, NDArray* dLdx, NDArray* dLdg, NDArray* dLdb) {
+
+    typedef typename std::conditional<sizeof(T) < sizeof(float), float, T>::type A;
+
+    const Nd4jLong numFeatures = input->sizeAt(-1);
+    const Nd4jLong numRows = input->lengthOf() / numFeatures;
+    const Nd4jLong numTasks = (numRows + kLayerNormRowsPerTask - 1) / kLayerNormRowsPerTask;
+
+    const auto g = paramToVector<T>(gain);
+    const T* gp = g.data();
+
+    const T* x = input->bufferAsT<T>();
+    const T* e = eps->bufferAsT<T>();
+          T* z = dLdx->bufferAsT<T>();
+
+    std::vector<A> partG(numTasks * numFeatures, (A) 0), partB(numTasks * numFeatures, (A) 0);
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(numTasks > 1 && input->lengthOf() > Environment::getInstance()->elementwiseThreshold())
+    for(Nd4jLong t = 0; t < numTasks; ++t) {
+        A* tg = partG.data() + t * numFeatures;
+        A* tb = partB.data() + t * numFeatures;
+        const Nd4jLong rEnd = nd4j::math::nd4j_min<Nd4jLong>((t + 1) * kLayerNormRowsPerTask, numRows);
+
+        for(Nd4jLong r = t * kLayerNormRowsPerTask; r < rEnd; ++r) {
+            const T* xr = x + r * numFeatures;
+            const T* er = e + r * numFeatures;
+                  T* zr = z + r * numFeatures;
+
+            A mean, invStd;
+            rowStats<T, A>(xr, numFeatures, mean, invStd);
+
+            A sumG = 0, sumGX = 0;
+            PRAGMA_OMP_SIMD_SUM(sumG)
+            for(Nd4jLong i = 0; i < numFeatures; ++i)
+                sumG += static_cast<A>(er[i]) * static_cast<A>(gp[i]);
+
+            PRAGMA_OMP_SIMD_SUM(sumGX)
+            for(Nd4jLong i = 0; i < numFeatures; ++i)
+                sumGX += static_cast<A>(er[i]) * static_cast<A>(gp[i]) * (static_cast<A>(xr[i]) - mean) * invStd;
+
+            const A meanG  = sumG / static_cast<A>(numFeatures);
+            const A meanGX = sumGX / static_cast<A>(numFeatures);
+
+            PRAGMA_OMP_SIMD
+            for(Nd4jLong i = 0; i < numFeatures; ++i) {
+                const A ei = static_cast<A>(er[i]);
+                const A xhat = (static_cast<A>(xr[i]) - mean) * invStd;
+                zr[i] = static_cast<T>(invStd * (ei * static_cast<A>(gp[i]) - meanG - xhat * meanGX));
+                tg[i] += ei * xhat;
+                tb[i] += ei;
+            }
+        }
+    }
+
+    for(Nd4jLong t = 1; t < numTasks; ++t)
+        for(Nd4jLong i = 0; i < numFeatures; ++i) {
+            partG[i] += partG[t * numFeatures + i];
+            partB[i] += partB[t * numFeatures + i];
+        }
+
+    NDArrayAccessor<T> dLdgAcc(*dLdg);
+    for(Nd4jLong i = 0; i < numFeatures; ++i)
+        dLdgAcc[i] = static_cast<T>(partG[i]);
+
+    if(dLdb != nullptr) {
+        NDArrayAccessor<T> dLdbAcc(*dLdb);
+        for(Nd4jLong i = 0; i < numFeatures; ++i)
+            dLdbAcc[i] = static_cast<T>(partB[i]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool layerNormFusable(const NDArray* input, const std::vector<int>& axis, const std::vector<const NDArray*>& arrays, const std::vector<const NDArray*>& params) {
+
+    const int rank = input->rankOf();
+    if(axis.size() != 1 || (axis[0] != rank - 1 && axis[0] != -1) || input->lengthOf() == 0)
+        return false;
+
+    for(const auto arr : arrays) {
+        if(arr == nullptr)
+            continue;
+        if(arr->ordering() != 'c' || arr->ews() != 1 || !arr->isSameShape(input) || arr->dataType() != input->dataType())
+            return false;
+    }
+
+    for(const auto param : params) {
+        if(param == nullptr)
+            continue;
+        if(param->lengthOf() != input->sizeAt(-1) || param->sizeAt(-1) != input->sizeAt(-1) || param->dataType() != input->dataType())
+            return false;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void layerNorm(const NDArray* input, const NDArray* gain, const NDArray* bias, NDArray* output) {
+
+    BUILD_SINGLE_SELECTOR(input->dataType(), layerNorm_, (input, gain, bias, output), FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void layerNormBp(const NDArray* input, const NDArray* gain, const NDArray* eps, NDArray* dLdx, NDArray* dLdg, NDArray* dLdb) {
+
+    BUILD_SINGLE_SELECTOR(input->dataType(), layerNormBp_, (input, gain, eps, dLdx, dLdg, dLdb), FLOAT_TYPES);
+}
+
+
+BUILD_SINGLE_TEMPLATE(template void layerNorm_, (const NDArray* input, const NDArray* gain, const NDArray* bias, NDArray* output), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void layerNormBp_, (const NDArray* input, const NDArray* gain, const NDArray* eps, NDArray* dLdx, NDArray* dLdg, NDArray* dLdb), FLOAT_TYPES);
+
+}
+}
+}
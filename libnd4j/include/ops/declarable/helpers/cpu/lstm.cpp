@@ -34,6 +34,7 @@
 #include <array/NDArrayList.h>
 #include <iterator>
 #include <MmulHelper.h>
+#include <NDArrayExpression.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -112,7 +113,8 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
     const int numProj     = ht_1->sizeAt(1);
     const int numUnits    = ct_1->sizeAt(1);
 
-    auto z = mmul(*xt, *Wx) + mmul(*ht_1, *Wh) + *b;      // [bS x 4*numUnits] + [bS x 4*numUnits] + [1 x 4*numUnits] = [bS x 4*numUnits]
+    auto z = mmul(*xt, *Wx);
+    z.assign(expr::lazy(z) + mmul(*ht_1, *Wh) + *b);        // [bS x 4*numUnits] + [bS x 4*numUnits] + [1 x 4*numUnits] = [bS x 4*numUnits]
 
     auto zit = z({0,0, 0,            numUnits});      	// z for input gate,  = mmul(Wxi,xt) + mmul(Whi,ht_1) + bi    = [bS x numUnits]
     auto zft = z({0,0, numUnits,   2*numUnits});      	// z for forget gate, = mmul(Wxf,xt) + mmul(Whf,ht_1) + bf    = [bS x numUnits]
@@ -120,32 +122,32 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
     auto zot = z({0,0, 3*numUnits, 4*numUnits});      	// z for output gate, = mmul(Wxo,xt) + mmul(Who,ht_1) + bo    = [bS x numUnits]
 
     if(peephole) {                                              // add peephole connections: z  +  ct_1*Wc
-        zit += (*ct_1) * (*Wc)({0,          numUnits});       // add peephole connections to input gate
-        zft += (*ct_1) * (*Wc)({numUnits, 2*numUnits});       // add peephole connections to forget gate
+        zit.assign(expr::lazy(zit) + expr::lazy(*ct_1) * (*Wc)({0,          numUnits}));       // add peephole connections to input gate
+        zft.assign(expr::lazy(zft) + expr::lazy(*ct_1) * (*Wc)({numUnits, 2*numUnits}));       // add peephole connections to forget gate
     }
 
     // current sell state = ft*ct_1 + it*tanh(mmul(Wxc,xt) + mmul(Whc,ht_1) + bc
-    ct->assign( sigmoid(zft + forgetBias) * (*ct_1) + sigmoid(zit) * tanh(zct) );
+    ct->assign( expr::sigmoid(expr::lazy(zft) + forgetBias) * (*ct_1) + expr::sigmoid(zit) * expr::tanh(zct) );
 
     // if clipping value is provided then cell state is clipped by this value prior to the cell output activation
     if(clippingCellValue > 0.0)
         clipping(ct, clippingCellValue);
 
     if(peephole)
-        zot += (*ct) * (*Wc)({{2*numUnits, 3*numUnits}});            // add peephole connections to output gate zot + ct*Wc
+        zot.assign(expr::lazy(zot) + expr::lazy(*ct) * (*Wc)({{2*numUnits, 3*numUnits}}));            // add peephole connections to output gate zot + ct*Wc
 
     // current cell output = ot*tanh(ct)
-    auto htNoPeepHole = sigmoid(zot) * tanh(*ct);      // = [bS x numUnits]
+    auto htNoPeepHole = expr::sigmoid(zot) * expr::tanh(*ct);      // = [bS x numUnits]
 
     // apply projection
     if(projection) {
-        ht->assign( mmul(htNoPeepHole, *Wp) );                           // [bS x numUnits] * [ numUnits x numProj] = [bS x numProj]
+        ht->assign( mmul(htNoPeepHole.evaluate(), *Wp) );                // [bS x numUnits] * [ numUnits x numProj] = [bS x numProj]
         // if clipping projection is provided then projected cell output state is clipped by this value
         if(clippingProjValue != 0.)
             clipping(ht, clippingProjValue);
     }
     else
-        ht->assign(&htNoPeepHole);
+        ht->assign(htNoPeepHole);
 }
 
 template <typename T>
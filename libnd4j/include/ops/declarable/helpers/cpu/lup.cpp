@@ -18,250 +18,492 @@
 //  @author raver119@gmail.com
 //
 
-#include <ops/declarable/helpers/top_k.h>
-#include <MmulHelper.h>
+#include <ops/declarable/helpers/lup.h>
+#include <helpers/BlasHelper.h>
+#include <helpers/ContiguousBuffer.h>
+#include <ops/ops.h>
 #include <NDArrayFactory.h>
 #include <Status.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    template <typename T> 
-    static void _swapRows(NDArray* matrix, int theFirst, int theSecond) {
+    // panel width of blocked factorizations: trailing matrix is updated with rank-LINALG_BLOCK products
+    static const int LINALG_BLOCK = 64;
 
-        if (theFirst != theSecond)
-            for (int i = 0; i < matrix->columns(); i++) {
-                T _e0 = matrix->e<T>(theFirst, i);
-                T _e1 = matrix->e<T>(theSecond, i);
+    // matrices up to this size are processed one per thread, bigger ones one by one with parallel kernels
+    static const int BATCH_PARALLEL_LIMIT = 256;
 
-                matrix->p<T>(theFirst, i, _e1);
-                matrix->p<T>(theSecond, i, _e0);
+    // matrices of this size and above are handed over to LAPACK, if it's available
+    static const int LAPACK_THRESHOLD = 128;
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Batches
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * This method calls func(index, matrix, parallel) for every n x n matrix of batch. Small matrices are processed in parallel,
+     * one per thread, with parallel = false. Big ones are processed one by one, and kernels are allowed to use threads themselves
+     */
+    template <typename T, typename F>
+    static void forEachMatrix(T* buffer, Nd4jLong batchSize, int n, const F& func) {
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const bool batchParallel = batchSize > 1 && n <= BATCH_PARALLEL_LIMIT;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(batchParallel) schedule(dynamic))
+        for (Nd4jLong e = 0; e < batchSize; e++)
+            func(e, buffer + e * n2, !batchParallel);
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Trailing matrix updates
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * C -= A * B for row-major m x k and k x n blocks with leading dimension ld
+     */
+    template <typename T>
+    static void gemmUpdate_(const T* A, const T* B, T* C, int m, int n, int k, int ld, bool parallel) {
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallel && static_cast<Nd4jLong>(m) * n * k > Environment::getInstance()->elementwiseThreshold())
+        for (int i = 0; i < m; i++) {
+            auto c = C + static_cast<Nd4jLong>(i) * ld;
+            auto a = A + static_cast<Nd4jLong>(i) * ld;
+
+            for (int p = 0; p < k; p++) {
+                auto v = a[p];
+                auto b = B + static_cast<Nd4jLong>(p) * ld;
+
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < n; j++)
+                    c[j] -= v * b[j];
             }
+        }
     }
-    BUILD_SINGLE_TEMPLATE(template void _swapRows, (NDArray* matrix, int theFirst, int theSecond), FLOAT_TYPES);
 
-    void swapRows(NDArray* matrix, int theFirst, int theSecond) {
-        BUILD_SINGLE_SELECTOR(matrix->dataType(), _swapRows, (matrix, theFirst, theSecond), FLOAT_TYPES);
+    static void gemmUpdate(const float* A, const float* B, float* C, int m, int n, int k, int ld, bool parallel) {
+        if (parallel && BlasHelper::getInstance()->hasGEMM<float>())
+            BlasHelper::getInstance()->sgemm()(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, -1.f, const_cast<float*>(A), ld, const_cast<float*>(B), ld, 1.f, C, ld);
+        else
+            gemmUpdate_<float>(A, B, C, m, n, k, ld, parallel);
+    }
+
+    static void gemmUpdate(const double* A, const double* B, double* C, int m, int n, int k, int ld, bool parallel) {
+        if (parallel && BlasHelper::getInstance()->hasGEMM<double>())
+            BlasHelper::getInstance()->dgemm()(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, -1., const_cast<double*>(A), ld, const_cast<double*>(B), ld, 1., C, ld);
+        else
+            gemmUpdate_<double>(A, B, C, m, n, k, ld, parallel);
     }
 
     template <typename T>
-    static void _invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->assign(0.f);
+    static void gemmUpdate(const T* A, const T* B, T* C, int m, int n, int k, int ld, bool parallel) {
+        gemmUpdate_<T>(A, B, C, m, n, k, ld, parallel);
+    }
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, 1.0f);
+    /**
+     * C -= A * A^T for row-major m x k block A, only lower triangle of C is updated
+     */
+    template <typename T>
+    static void syrkUpdate_(const T* A, T* C, int m, int k, int ld, bool parallel) {
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel && static_cast<Nd4jLong>(m) * m * k > Environment::getInstance()->elementwiseThreshold()) schedule(dynamic, 8))
+        for (int i = 0; i < m; i++) {
+            auto a = A + static_cast<Nd4jLong>(i) * ld;
+            auto c = C + static_cast<Nd4jLong>(i) * ld;
 
-        if (inputMatrix->isIdentityMatrix()) return;
+            for (int j = 0; j <= i; j++) {
+                auto b = A + static_cast<Nd4jLong>(j) * ld;
+                T sum = static_cast<T>(0);
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 1; i < n; i++)
-            invertedMatrix->p(i, i - 1,  -inputMatrix->e<T>(i, i - 1));
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (int p = 0; p < k; p++)
+                    sum += a[p] * b[p];
 
-        //PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = 2; i < n; i++) {
-            for (int j = i - 2; j > -1; --j) 
-                for (int k = 0; k < i; k++) 
-                    invertedMatrix->t<T>(i, j) -= (invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k));
+                c[j] -= sum;
+            }
         }
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertLowerMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
+    // BlasHelper exposes gemm but not syrk, so full gemm is used: upper triangle of C gets updated too, but it's never read
+    static void syrkUpdate(const float* A, float* C, int m, int k, int ld, bool parallel) {
+        if (parallel && BlasHelper::getInstance()->hasGEMM<float>())
+            BlasHelper::getInstance()->sgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, m, m, k, -1.f, const_cast<float*>(A), ld, const_cast<float*>(A), ld, 1.f, C, ld);
+        else
+            syrkUpdate_<float>(A, C, m, k, ld, parallel);
+    }
+
+    static void syrkUpdate(const double* A, double* C, int m, int k, int ld, bool parallel) {
+        if (parallel && BlasHelper::getInstance()->hasGEMM<double>())
+            BlasHelper::getInstance()->dgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, m, m, k, -1., const_cast<double*>(A), ld, const_cast<double*>(A), ld, 1., C, ld);
+        else
+            syrkUpdate_<double>(A, C, m, k, ld, parallel);
+    }
+
+    template <typename T>
+    static void syrkUpdate(const T* A, T* C, int m, int k, int ld, bool parallel) {
+        syrkUpdate_<T>(A, C, m, k, ld, parallel);
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Factorizations
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * Blocked right-looking LU decomposition with partial pivoting, in place: L (unit diagonal) is stored below main diagonal,
+     * U on and above it. Row i of result corresponds to row permutation[i] of original matrix.
+     * Returns number of row swaps, so sign of determinant can be restored
+     */
+    template <typename T>
+    static int luDecompose_(T* a, int n, int* permutation, bool parallel) {
+        int swaps = 0;
+        std::iota(permutation, permutation + n, 0);
+
+        for (int k0 = 0; k0 < n; k0 += LINALG_BLOCK) {
+            const int k1 = nd4j::math::nd4j_min<int>(k0 + LINALG_BLOCK, n);
+
+            // panel factorization. whole rows are swapped, so columns left and right of the panel are permuted as well
+            for (int j = k0; j < k1; j++) {
+                int pivot = j;
+                T pivotValue = nd4j::math::nd4j_abs<T>(a[static_cast<Nd4jLong>(j) * n + j]);
+
+                for (int i = j + 1; i < n; i++) {
+                    auto v = nd4j::math::nd4j_abs<T>(a[static_cast<Nd4jLong>(i) * n + j]);
+                    if (v > pivotValue) {
+                        pivotValue = v;
+                        pivot = i;
+                    }
+                }
+
+                auto rowJ = a + static_cast<Nd4jLong>(j) * n;
+                if (pivot != j) {
+                    std::swap_ranges(rowJ, rowJ + n, a + static_cast<Nd4jLong>(pivot) * n);
+                    std::swap(permutation[j], permutation[pivot]);
+                    swaps++;
+                }
+
+                // singular matrix: nothing to eliminate in this column
+                if (pivotValue == static_cast<T>(0))
+                    continue;
+
+                for (int i = j + 1; i < n; i++) {
+                    auto rowI = a + static_cast<Nd4jLong>(i) * n;
+                    rowI[j] /= rowJ[j];
+                    auto l = rowI[j];
+
+                    PRAGMA_OMP_SIMD
+                    for (int c = j + 1; c < k1; c++)
+                        rowI[c] -= l * rowJ[c];
+                }
+            }
+
+            if (k1 == n)
+                break;
+
+            // U12 = L11^-1 * A12
+            for (int j = k0; j < k1; j++) {
+                auto rowJ = a + static_cast<Nd4jLong>(j) * n;
+
+                for (int i = j + 1; i < k1; i++) {
+                    auto rowI = a + static_cast<Nd4jLong>(i) * n;
+                    auto l = rowI[j];
 
-    void invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertLowerMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+                    PRAGMA_OMP_SIMD
+                    for (int c = k1; c < n; c++)
+                        rowI[c] -= l * rowJ[c];
+                }
+            }
+
+            // A22 -= L21 * U12
+            gemmUpdate(a + static_cast<Nd4jLong>(k1) * n + k0, a + static_cast<Nd4jLong>(k0) * n + k1, a + static_cast<Nd4jLong>(k1) * n + k1, n - k1, n - k1, k1 - k0, n, parallel);
+        }
+
+        return swaps;
     }
 
+    /**
+     * Blocked right-looking Cholesky decomposition, in place: lower triangle is replaced with L, so that A = L * L^T.
+     * Upper triangle is left in undefined state. Returns false if matrix isn't positive-definite
+     */
     template <typename T>
-    static void _invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->setIdentity();
+    static bool choleskyDecompose_(T* a, int n, bool parallel) {
+        for (int k0 = 0; k0 < n; k0 += LINALG_BLOCK) {
+            const int k1 = nd4j::math::nd4j_min<int>(k0 + LINALG_BLOCK, n);
+
+            // panel: diagonal block and column block below it, previous panels are applied already
+            for (int j = k0; j < k1; j++) {
+                auto rowJ = a + static_cast<Nd4jLong>(j) * n;
+
+                T d = rowJ[j];
+                for (int k = k0; k < j; k++)
+                    d -= rowJ[k] * rowJ[k];
+
+                if (!(d > static_cast<T>(0)))
+                    return false;
+
+                const T l = nd4j::math::nd4j_sqrt<T, T>(d);
+                rowJ[j] = l;
+
+                PRAGMA_OMP_PARALLEL_FOR_IF(parallel && static_cast<Nd4jLong>(n - j) * (j - k0) > Environment::getInstance()->elementwiseThreshold())
+                for (int i = j + 1; i < n; i++) {
+                    auto rowI = a + static_cast<Nd4jLong>(i) * n;
+
+                    T s = rowI[j];
+                    for (int k = k0; k < j; k++)
+                        s -= rowI[k] * rowJ[k];
 
-        if (inputMatrix->isIdentityMatrix()) { // the inverse for I is I
-            return;
+                    rowI[j] = s / l;
+                }
+            }
+
+            if (k1 == n)
+                break;
+
+            // A22 -= L21 * L21^T
+            syrkUpdate(a + static_cast<Nd4jLong>(k1) * n + k0, a + static_cast<Nd4jLong>(k1) * n + k1, n - k1, k1 - k0, n, parallel);
         }
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, invertedMatrix->e<T>(i, i) / inputMatrix->e<T>(i, i));
+        return true;
+    }
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n - 1; i++)
-            invertedMatrix->p(i, i + 1, invertedMatrix->e<T>(i, i+1) - (inputMatrix->e<T>(i, i + 1) * invertedMatrix->e<T>(i + 1, i + 1) / inputMatrix->e<T>(i, i)));
+    template <typename T, typename F>
+    static int lapackLu_(F getrf, T* a, int n, int* permutation) {
+        std::vector<int> ipiv(n);
 
-//        PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = n - 2; i > - 1; i--) {
-            for (int j = i + 2; j < n; j++) 
-                for (int k = i; k < n; k++) 
-                    invertedMatrix->t<T>(i, j) -= ((invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k) / inputMatrix->t<T>(i, i)));
+        // positive info means exactly singular matrix, factorization is still complete
+        getrf(LAPACK_ROW_MAJOR, n, n, a, n, ipiv.data());
+
+        // LAPACK pivots are 1-based sequential row swaps
+        int swaps = 0;
+        std::iota(permutation, permutation + n, 0);
+        for (int i = 0; i < n; i++) {
+            if (ipiv[i] - 1 != i) {
+                std::swap(permutation[i], permutation[ipiv[i] - 1]);
+                swaps++;
+            }
         }
+
+        return swaps;
+    }
+
+    template <typename T>
+    static int luFactor(T* a, int n, int* permutation, bool parallel) {
+        return luDecompose_<T>(a, n, permutation, parallel);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertUpperMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
+    static int luFactor(float* a, int n, int* permutation, bool parallel) {
+        auto getrf = BlasHelper::getInstance()->sgetrf();
+        if (parallel && n >= LAPACK_THRESHOLD && getrf != nullptr)
+            return lapackLu_<float>(getrf, a, n, permutation);
 
-    void invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertUpperMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+        return luDecompose_<float>(a, n, permutation, parallel);
     }
 
+    static int luFactor(double* a, int n, int* permutation, bool parallel) {
+        auto getrf = BlasHelper::getInstance()->dgetrf();
+        if (parallel && n >= LAPACK_THRESHOLD && getrf != nullptr)
+            return lapackLu_<double>(getrf, a, n, permutation);
+
+        return luDecompose_<double>(a, n, permutation, parallel);
+    }
 
     template <typename T>
-    static NDArray _lup(NDArray* input, NDArray* compound, NDArray* permutation) {
+    static bool choleskyFactor(T* a, int n, bool parallel) {
+        return choleskyDecompose_<T>(a, n, parallel);
+    }
 
-        const int rowNum = input->rows();
-        const int columnNum = input->columns();
+    static bool choleskyFactor(float* a, int n, bool parallel) {
+        auto potrf = BlasHelper::getInstance()->spotrf();
+        if (parallel && n >= LAPACK_THRESHOLD && potrf != nullptr)
+            return potrf(LAPACK_ROW_MAJOR, 'L', n, a, n) == 0;
 
-        NDArray determinant = NDArrayFactory::create<T>(1.f);
-        std::unique_ptr<NDArray> compoundMatrix(input->dup()); // copy
-        std::unique_ptr<NDArray> permutationMatrix(input->dupUninitialized()); //put identity
-        permutationMatrix->setIdentity();
+        return choleskyDecompose_<float>(a, n, parallel);
+    }
 
-        T pivotValue; // = T(0.0);
-        int pivot; // = -1;
-        int swapCount = 0;
+    static bool choleskyFactor(double* a, int n, bool parallel) {
+        auto potrf = BlasHelper::getInstance()->dpotrf();
+        if (parallel && n >= LAPACK_THRESHOLD && potrf != nullptr)
+            return potrf(LAPACK_ROW_MAJOR, 'L', n, a, n) == 0;
 
-        for(int i = 0; i < rowNum; i++ ) {
-            pivotValue = T(0.0);
-            pivot = -1;
+        return choleskyDecompose_<double>(a, n, parallel);
+    }
 
-            for(int rowCounter = i; rowCounter < rowNum; rowCounter++ ) {
-                if(nd4j::math::nd4j_abs(compoundMatrix->e<T>(rowCounter, i)) > pivotValue ) {
-                    pivotValue = nd4j::math::nd4j_abs(compoundMatrix->e<T>(rowCounter, i));
-                    pivot = rowCounter;
-                }
+    /**
+     * This method computes inverse matrix from LU decomposition, by solving L * U * X = P with forward and back substitution.
+     * Columns of X are independent, so they're processed in blocks
+     */
+    template <typename T>
+    static void luInverse_(const T* lu, const int* permutation, int n, T* z, bool parallel) {
+        const int numBlocks = (n + LINALG_BLOCK - 1) / LINALG_BLOCK;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallel && numBlocks > 1 && static_cast<Nd4jLong>(n) * n * n > Environment::getInstance()->elementwiseThreshold())
+        for (int b = 0; b < numBlocks; b++) {
+            const int c0 = b * LINALG_BLOCK;
+            const int c1 = nd4j::math::nd4j_min<int>(c0 + LINALG_BLOCK, n);
+
+            for (int i = 0; i < n; i++) {
+                auto rowI = z + static_cast<Nd4jLong>(i) * n;
+                for (int c = c0; c < c1; c++)
+                    rowI[c] = permutation[i] == c ? static_cast<T>(1) : static_cast<T>(0);
             }
 
-            if( pivotValue != T(0.0) ) {
-                swapRows(compoundMatrix.get(), pivot, i);
-                swapRows(permutationMatrix.get(), pivot, i);
-                if (pivot != i)
-                    swapCount++;
-
-                for( int j = i + 1; j < rowNum; j++ ) {
-                    compoundMatrix->p(j, i, compoundMatrix->e<T>(j, i) / compoundMatrix->e<T>(i, i));
-                    for( int k = i + 1; k < rowNum; k++ ) {
-                        T arg = compoundMatrix->e<T>(j, i) * compoundMatrix->e<T>(i, k);
-                        compoundMatrix->p(j, k, compoundMatrix->e<T>(j, k) - arg);
-                    }
+            // L * Y = P
+            for (int i = 1; i < n; i++) {
+                auto rowI = z + static_cast<Nd4jLong>(i) * n;
+                auto luRow = lu + static_cast<Nd4jLong>(i) * n;
+
+                for (int k = 0; k < i; k++) {
+                    auto l = luRow[k];
+                    if (l == static_cast<T>(0))
+                        continue;
+
+                    auto rowK = z + static_cast<Nd4jLong>(k) * n;
+
+                    PRAGMA_OMP_SIMD
+                    for (int c = c0; c < c1; c++)
+                        rowI[c] -= l * rowK[c];
                 }
             }
-        }
 
-        for (int e = 0; e < rowNum; e++) {
-            // nd4j_printf("Compound matrix diag %i %f.\n", e, (*compoundMatrix)(e, e));
-            determinant *= compoundMatrix->e<T>(e, e);
+            // U * X = Y
+            for (int i = n - 1; i >= 0; i--) {
+                auto rowI = z + static_cast<Nd4jLong>(i) * n;
+                auto luRow = lu + static_cast<Nd4jLong>(i) * n;
+
+                for (int k = i + 1; k < n; k++) {
+                    auto u = luRow[k];
+                    auto rowK = z + static_cast<Nd4jLong>(k) * n;
+
+                    PRAGMA_OMP_SIMD
+                    for (int c = c0; c < c1; c++)
+                        rowI[c] -= u * rowK[c];
+                }
+
+                auto d = luRow[i];
+
+                PRAGMA_OMP_SIMD
+                for (int c = c0; c < c1; c++)
+                    rowI[c] /= d;
+            }
         }
-        if (swapCount % 2) determinant = -determinant;
-        if (compound != nullptr)
-            *compound = *compoundMatrix;
-        if (permutation != nullptr)
-            *permutation = *permutationMatrix;
-        return determinant;
     }
 
-    BUILD_SINGLE_TEMPLATE(template NDArray _lup, (NDArray* input, NDArray* output, NDArray* permutation), FLOAT_TYPES);
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Entry points
+    // -------------------------------------------------------------------------------------------------------------- //
 
+    template <typename T>
+    static int determinant_(NDArray* input, NDArray* output) {
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batchSize = output->lengthOf();
 
+        ContiguousBuffer x(input, input->dataType());
+        std::vector<T> result(batchSize);
 
-    template <typename T>
-    static int _determinant(NDArray* input, NDArray* output) {
+        forEachMatrix<T>(x.buffer<T>(), batchSize, n, [&] (Nd4jLong e, const T* matrix, bool parallel) {
+            std::vector<T> lu(matrix, matrix + n2);
+            std::vector<int> permutation(n);
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
+            auto swaps = luFactor(lu.data(), n, permutation.data(), parallel);
 
-        auto matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), input->getWorkspace()); //, block.getWorkspace());
+            T det = static_cast<T>(1);
+            for (int i = 0; i < n; i++)
+                det *= lu[static_cast<Nd4jLong>(i) * n + i];
 
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
-            }
+            result[e] = swaps % 2 ? -det : det;
+        });
 
-            output->p(e, _lup<T>(&matrix, (NDArray*)nullptr, (NDArray*)nullptr));
-        }
+        for (Nd4jLong e = 0; e < batchSize; e++)
+            output->p(e, result[e]);
 
         return Status::OK();
     }
 
-    BUILD_SINGLE_TEMPLATE(template int _determinant, (NDArray* input, NDArray* output), FLOAT_TYPES);
-
     int determinant(NDArray* input, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), return _determinant, (input, output), FLOAT_TYPES);
+        BUILD_SINGLE_SELECTOR(input->dataType(), return determinant_, (input, output), FLOAT_TYPES);
     }
 
-template <typename T>
-    int log_abs_determinant_(NDArray* input, NDArray* output) {
+    template <typename T>
+    static int log_abs_determinant_(NDArray* input, NDArray* output) {
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batchSize = output->lengthOf();
+
+        ContiguousBuffer x(input, input->dataType());
+        std::vector<T> result(batchSize);
+        std::vector<int8_t> singular(batchSize, 0);
+
+        forEachMatrix<T>(x.buffer<T>(), batchSize, n, [&] (Nd4jLong e, const T* matrix, bool parallel) {
+            std::vector<T> lu(matrix, matrix + n2);
+            std::vector<int> permutation(n);
+
+            luFactor(lu.data(), n, permutation.data(), parallel);
+
+            // sum of logarithms doesn't overflow, unlike product of diagonal elements
+            T logDet = static_cast<T>(0);
+            for (int i = 0; i < n; i++) {
+                auto v = nd4j::math::nd4j_abs<T>(lu[static_cast<Nd4jLong>(i) * n + i]);
+                if (v == static_cast<T>(0)) {
+                    singular[e] = 1;
+                    return;
+                }
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
+                logDet += nd4j::math::nd4j_log<T, T>(v);
+            }
 
-        NDArray matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), input->getWorkspace()); //, block.getWorkspace());
+            result[e] = logDet;
+        });
 
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
-            }
-	    NDArray det = _lup<T>(&matrix, (NDArray*)nullptr, (NDArray*)nullptr);
-	    if (det.e<T>(0) != 0.f)
-             	output->p(e, nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_abs(det.t<T>(0))));
-        }
+        // output isn't touched for singular matrices
+        for (Nd4jLong e = 0; e < batchSize; e++)
+            if (!singular[e])
+                output->p(e, result[e]);
 
         return ND4J_STATUS_OK;
     }
 
-    BUILD_SINGLE_TEMPLATE(template int log_abs_determinant_, (NDArray* input, NDArray* output), FLOAT_TYPES);
-
     int log_abs_determinant(NDArray* input, NDArray* output) {
         BUILD_SINGLE_SELECTOR(input->dataType(), return log_abs_determinant_, (input, output), FLOAT_TYPES);
     }
 
     template <typename T>
-    static int _inverse(NDArray* input, NDArray* output) {
-
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        
-        output->assign(0.f); // fill up output tensor with zeros
-        auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace()); //, block.getWorkspace());
-        auto compound = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace()); //, block.getWorkspace());
-        auto permutation = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-        auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-        auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-
-        for (int e = 0; e < totalCount; e++) {
-            if (e)
-                matrix.assign(0.f);
-
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                matrix.p(row++, input->e<T>(k));
-            }
-            T det = _lup<T>(&matrix, &compound, &permutation).template e<T>(0);
+    static int inverse_(NDArray* input, NDArray* output) {
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        if (n2 == 0)
+            return Status::OK();
+
+        const Nd4jLong batchSize = output->lengthOf() / n2;
+
+        ContiguousBuffer x(input, output->dataType());
+        ContiguousBuffer z(output, output->dataType(), true);
+        std::vector<T> dets(batchSize);
+
+        forEachMatrix<T>(x.buffer<T>(), batchSize, n, [&] (Nd4jLong e, const T* matrix, bool parallel) {
+            std::vector<T> lu(matrix, matrix + n2);
+            std::vector<int> permutation(n);
+
+            luFactor(lu.data(), n, permutation.data(), parallel);
+
+            T det = static_cast<T>(1);
+            for (int i = 0; i < n; i++)
+                det *= lu[static_cast<Nd4jLong>(i) * n + i];
+
+            dets[e] = det;
 
             // FIXME: and how this is going to work on float16?
-            if (nd4j::math::nd4j_abs<T>(det) < T(0.0000001)) {
-                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", e, det);
-                matrix.printIndexedBuffer("Wrong matrix");
-                return ND4J_STATUS_VALIDATION;
-            }
-            lowerMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 1; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = 0; j < k; j++)
-                    lowerMatrix.p(k, j, compound.template e<T>(k, j));
-            }
-            upperMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 0; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = k; j < n; j++)
-                    upperMatrix.p(k, j, compound.template e<T>(k, j));
-            }
-            invertUpperMatrix(&upperMatrix, &matrix);
+            if (nd4j::math::nd4j_abs<T>(det) < static_cast<T>(0.0000001))
+                return;
 
-            invertLowerMatrix(&lowerMatrix, &upperMatrix);
+            luInverse_<T>(lu.data(), permutation.data(), n, z.buffer<T>() + e * n2, parallel);
+        });
 
-            nd4j::MmulHelper::mmul(&matrix, &upperMatrix, &compound, 1.0, 0.0);
-            nd4j::MmulHelper::mmul(&compound, &permutation, &matrix, 1.0, 0.0);
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                output->p(k, matrix.template e<T>(row++));
+        for (Nd4jLong e = 0; e < batchSize; e++) {
+            if (nd4j::math::nd4j_abs<T>(dets[e]) < static_cast<T>(0.0000001)) {
+                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", (int) e, (double) dets[e]);
+                return ND4J_STATUS_VALIDATION;
             }
         }
 
@@ -269,76 +511,69 @@ template <typename T>
     }
 
     int inverse(NDArray* input, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), return _inverse, (input, output), FLOAT_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return inverse_, (input, output), FLOAT_TYPES);
     }
 
     template <typename T>
     static bool checkCholeskyInput_(NDArray const* input) {
-        //std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //, block.getWorkspace());
-        std::unique_ptr<ResultSet> lastMatrixList(input->allTensorsAlongDimension({input->rankOf() - 2, input->rankOf()-1}));
-        for (size_t i = 0; i < lastMatrixList->size(); i++) {
-            auto thisMatrix = lastMatrixList->at(i);
-            // check for symmetric
-            for (Nd4jLong r = 0; r < thisMatrix->rows(); r++)
-                for (Nd4jLong c = 0; c < thisMatrix->columns(); c++)
-                    if (nd4j::math::nd4j_abs(thisMatrix->e<T>(r, c) - lastMatrixList->at(i)->e<T>(c,r)) > T(1.e-6f)) return false;
-
-            NDArray output = NDArrayFactory::create<T>(0.);
-            if (ND4J_STATUS_OK != determinant(thisMatrix, &output)) return false;
-            if (output.e<T>(0) <= T(0)) return 0;
-            NDArray reversedMatrix(*thisMatrix);
-            if (ND4J_STATUS_OK != inverse(thisMatrix, &reversedMatrix)) return false;
-            if (ND4J_STATUS_OK != determinant(&reversedMatrix, &output)) return false;
-            if (output.e<T>(0) <= T(0)) return 0;
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        if (n2 == 0)
+            return true;
 
-        }
+        const Nd4jLong batchSize = input->lengthOf() / n2;
 
+        ContiguousBuffer x(input, DataTypeUtils::fromT<T>());
+        std::vector<int8_t> valid(batchSize, 0);
 
-        return true;
+        // symmetric matrix is positive-definite if and only if its Cholesky decomposition exists
+        forEachMatrix<T>(x.buffer<T>(), batchSize, n, [&] (Nd4jLong e, const T* matrix, bool parallel) {
+            for (int r = 0; r < n; r++)
+                for (int c = r + 1; c < n; c++)
+                    if (nd4j::math::nd4j_abs<T>(matrix[static_cast<Nd4jLong>(r) * n + c] - matrix[static_cast<Nd4jLong>(c) * n + r]) > static_cast<T>(1.e-6f))
+                        return;
+
+            std::vector<T> l(matrix, matrix + n2);
+            valid[e] = choleskyFactor(l.data(), n, parallel) ? 1 : 0;
+        });
+
+        return std::all_of(valid.begin(), valid.end(), [] (int8_t v) -> bool { return v != 0; });
     }
-    BUILD_SINGLE_TEMPLATE(template bool checkCholeskyInput_, (NDArray const* input), FLOAT_TYPES);
 
     bool checkCholeskyInput(NDArray const* input) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), return checkCholeskyInput_, (input), FLOAT_TYPES);
+        auto dtype = input->isR() ? input->dataType() : nd4j::DataType::DOUBLE;
+        BUILD_SINGLE_SELECTOR(dtype, return checkCholeskyInput_, (input), FLOAT_TYPES);
     }
 
     template <typename T>
-    int cholesky_(NDArray* input, NDArray* output, bool inplace) {
+    static int cholesky_(NDArray* input, NDArray* output, bool inplace) {
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        if (n2 == 0)
+            return ND4J_STATUS_OK;
 
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        if (!inplace)
-             output->assign(0.f); // fill up output tensor with zeros only inplace=false
+        const Nd4jLong batchSize = output->lengthOf() / n2;
 
-        std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //, block.getWorkspace());
-        std::unique_ptr<NDArray> lowerMatrix(NDArrayFactory::create_('c',{n, n}, input->dataType()));
+        // for inplace op both buffers wrap the same array
+        ContiguousBuffer x(input, output->dataType());
+        ContiguousBuffer z(output, output->dataType(), true);
+        std::vector<int8_t> valid(batchSize, 0);
 
-        for (int e = 0; e < totalCount; e++) {
+        forEachMatrix<T>(x.buffer<T>(), batchSize, n, [&] (Nd4jLong e, const T* matrix, bool parallel) {
+            auto l = z.buffer<T>() + e * n2;
+            if (l != matrix)
+                std::copy(matrix, matrix + n2, l);
 
-            // fill up matrix
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                matrix->p(l++, input->e<T>(k));
-            }
-            //if (e) // from the second loop need to zero matrix
-            lowerMatrix->assign(0.f);
-
-            for (Nd4jLong col = 0; col < n; col++) {
-                for (Nd4jLong row = 0; row < col; row++) {
-                    T rowSum = 0;
-                    for (Nd4jLong k = 0; k < row; ++k)
-                        rowSum += (lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(row, k));
-                    lowerMatrix->p(col, row, (matrix->e<T>(row, col) - rowSum) / lowerMatrix->e<double>(row, row));
-                }
-                T diagonalSum = 0;
-                for (Nd4jLong k = 0; k < col;  ++k)
-                    diagonalSum += lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(col, k);
-                lowerMatrix->p(col, col, nd4j::math::nd4j_sqrt<T, T>(matrix->e<T>(col, col) - diagonalSum));
-                //nd4j_printf("%i: ", col);
-                //lowerMatrix->printIndexedBuffer("Lower matrix");
-            }
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                output->p(k, lowerMatrix->e<T>(l++));
+            valid[e] = choleskyFactor(l, n, parallel) ? 1 : 0;
+
+            for (int r = 0; r < n; r++)
+                std::fill(l + static_cast<Nd4jLong>(r) * n + r + 1, l + static_cast<Nd4jLong>(r + 1) * n, static_cast<T>(0));
+        });
+
+        for (Nd4jLong e = 0; e < batchSize; e++) {
+            if (!valid[e]) {
+                nd4j_printf("cholesky: matrix %i isn't positive-definite\n", (int) e);
+                return ND4J_STATUS_VALIDATION;
             }
         }
 
@@ -346,36 +581,53 @@ template <typename T>
     }
 
     int cholesky(NDArray* input, NDArray* output, bool inplace) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), return cholesky_, (input, output, inplace), FLOAT_TYPES);
-    }    
-    BUILD_SINGLE_TEMPLATE(template int cholesky_, (NDArray* input, NDArray* output, bool inplace), FLOAT_TYPES);
-    BUILD_SINGLE_TEMPLATE(template int _inverse, (NDArray* input, NDArray* output), FLOAT_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return cholesky_, (input, output, inplace), FLOAT_TYPES);
+    }
 
     template <typename T>
-    int logdetFunctor_(NDArray* input, NDArray* output) {
-        std::unique_ptr<NDArray> tempOutput(input->dup());
-        int res = cholesky_<T>(input, tempOutput.get(), false);
-        if (res != ND4J_STATUS_OK)
-            return res;
-        auto n = input->sizeAt(-1);
-        auto totalCount = output->lengthOf();
-        std::vector<T> d(n);
-        std::unique_ptr<ResultSet> matricies(tempOutput->allTensorsAlongDimension({input->rankOf()-2, input->rankOf() - 1}));
-        std::unique_ptr<ResultSet> inputMatricies(input->allTensorsAlongDimension({input->rankOf()-2, input->rankOf() - 1}));
-        for (Nd4jLong e = 0; e < totalCount; e++) {
-
-            //d[0] = inputMatricies->at(e)->t<T>(0, 0);
-            for (size_t i = 0; i < n; ++i) {
-                output->t<T>(e) += nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_pow<T,T,T>(matricies->at(e)->t<T>(i, i), T(2)));
-            }
+    static int logdetFunctor_(NDArray* input, NDArray* output) {
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batchSize = output->lengthOf();
+
+        ContiguousBuffer x(input, output->dataType());
+        std::vector<T> result(batchSize);
+        std::vector<int8_t> valid(batchSize, 0);
+
+        // log(det(A)) = log(det(L)^2) = 2 * sum(log(diag(L)))
+        forEachMatrix<T>(x.buffer<T>(), batchSize, n, [&] (Nd4jLong e, const T* matrix, bool parallel) {
+            std::vector<T> l(matrix, matrix + n2);
+            if (!choleskyFactor(l.data(), n, parallel))
+                return;
+
+            T logDet = static_cast<T>(0);
+            for (int i = 0; i < n; i++)
+                logDet += nd4j::math::nd4j_log<T, T>(l[static_cast<Nd4jLong>(i) * n + i]);
+
+            result[e] = static_cast<T>(2) * logDet;
+            valid[e] = 1;
+        });
+
+        for (Nd4jLong e = 0; e < batchSize; e++) {
+            if (!valid[e])
+                return ND4J_STATUS_VALIDATION;
+
+            output->p(e, result[e]);
         }
+
         return ND4J_STATUS_OK;
     }
 
     int logdetFunctor(NDArray* input, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), return logdetFunctor_, (input, output), FLOAT_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return logdetFunctor_, (input, output), FLOAT_TYPES);
     }
 
+    BUILD_SINGLE_TEMPLATE(template int determinant_, (NDArray* input, NDArray* output), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int log_abs_determinant_, (NDArray* input, NDArray* output), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int inverse_, (NDArray* input, NDArray* output), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template bool checkCholeskyInput_, (NDArray const* input), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int cholesky_, (NDArray* input, NDArray* output, bool inplace), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int logdetFunctor_, (NDArray* input, NDArray* output), FLOAT_TYPES);
 }
 }
 }
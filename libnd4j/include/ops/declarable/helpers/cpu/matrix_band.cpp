@@ -18,6 +18,7 @@
 //  @author George A. Shulinok <sgazeos@gmail.com>
 //
 #include <ops/declarable/helpers/matrix_band.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -30,35 +31,29 @@ namespace helpers {
         Nd4jLong N = input->sizeAt(-1);
         Nd4jLong lastDim = input->rankOf() - 1;
         Nd4jLong preLastDim = input->rankOf() - 2;
-        std::unique_ptr<ResultSet> listOut(output->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
-        std::unique_ptr<ResultSet> listDiag(input->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
-        for (Nd4jLong e = 0; e < listOut->size(); ++e) {
-            NDArray* inputMatrix = listDiag->at(e);
-            NDArray* outputMatrix = listOut->at(e);
-            if (outputMatrix != inputMatrix) // if not inplace
-                outputMatrix->assign(inputMatrix);
+        TadViews listOut(*output, {(int)preLastDim, (int)lastDim});
+        TadViews listDiag(*input, {(int)preLastDim, (int)lastDim});
+        for (Nd4jLong e = 0; e < listOut.size(); ++e) {
+            if (listOut.bufferAt(e) != listDiag.bufferAt(e)) // if not inplace
+                listOut.at(e).assign(listDiag.at(e));
+
+            auto outputMatrix = listOut.accessor<T, 2>(e);
+            // in_band(m, n) = (num_lower < 0 || (m-n) <= num_lower)) && (num_upper < 0 || (n-m) <= num_upper).
             if (lowerBand >= 0) {
-                for (Nd4jLong row = 0; row < inputMatrix->rows(); ++row) {
+                for (Nd4jLong row = 0; row < M; ++row) {
                     for (Nd4jLong col = 0; col < row; ++col) {
                         if ((row - col) > lowerBand)
-                            outputMatrix->p(row, col, 0.);
-//                        else
-  //                          (*outputMatrix)(row, col) = (*inputMatrix)(row, col);
+                            outputMatrix(row, col) = static_cast<T>(0);
                     }
-//                    in_band(m, n) = (num_lower < 0 || (m-n) <= num_lower)) && (num_upper < 0 || (n-m) <= num_upper).
                 }
             }
             if (upperBand >= 0) {
-                for (Nd4jLong col = 0; col < inputMatrix->columns(); ++col) {
+                for (Nd4jLong col = 0; col < N; ++col) {
                     for (Nd4jLong row = 0; row < col; ++row) {
                         if ((col - row) > upperBand)
-                            outputMatrix->p(row, col, 0.);
-//                        else
-  //                          (*outputMatrix)(row, col) = (*inputMatrix)(row, col);
+                            outputMatrix(row, col) = static_cast<T>(0);
                     }
-//                    in_band(m, n) = (num_lower < 0 || (m-n) <= num_lower)) && (num_upper < 0 || (n-m) <= num_upper).
                 }
-
             }
         }
     }
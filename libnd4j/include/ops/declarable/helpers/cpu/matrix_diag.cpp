@@ -21,6 +21,7 @@
 #include "ResultSet.h"
 #include <ops/declarable/helpers/matrix_diag.h>
 #include <Status.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -33,23 +34,23 @@ namespace helpers {
 template <typename T>
 static int _matrixDiag(const NDArray* input, NDArray* output) {
 
-    auto listOut  = output->allTensorsAlongDimension({output->rankOf() - 2, output->rankOf() - 1});
-    auto listDiag = input->allTensorsAlongDimension({input->rankOf() - 1});
+    TadViews listOut(*output, {output->rankOf() - 2, output->rankOf() - 1});
+    TadViews listDiag(*input, {input->rankOf() - 1});
 
-    if (listOut->size() != listDiag->size()) {
+    if (listOut.size() != listDiag.size()) {
         nd4j_printf("matrix_diag: Input matrix has wrong shape.", "");
         return ND4J_STATUS_VALIDATION;
     }
     int lastDimension = input->sizeAt(-1);
     // TODO: tune this properlys
-    int lO = listOut->size();
+    Nd4jLong lO = listOut.size();
     PRAGMA_OMP_PARALLEL_FOR_IF(lO > Environment::getInstance()->tadThreshold())
-    for(int i = 0; i < lO; ++i)
+    for(Nd4jLong i = 0; i < lO; ++i) {
+        auto matrix = listOut.accessor<T, 2>(i);
+        auto diag = listDiag.accessor<T>(i);
         for (int e = 0; e < lastDimension; e++)
-            listOut->at(i)->p(e, e, listDiag->at(i)->e<T>(e));
-    
-    delete listOut;
-    delete listDiag;
+            matrix(e, e) = diag[e];
+    }
 
     return Status::OK();
 }
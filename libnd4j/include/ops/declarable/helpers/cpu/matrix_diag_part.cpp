@@ -21,6 +21,7 @@
 #include "ResultSet.h"
 #include <ops/declarable/helpers/matrix_diag_part.h>
 #include <Status.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -33,23 +34,23 @@ namespace helpers {
 template <typename T>
 int _matrixDiagPart(const NDArray* input, NDArray* output) {
 
-    auto listOut  = output->allTensorsAlongDimension({output->rankOf() - 1});
-    auto listDiag = input->allTensorsAlongDimension({input->rankOf() - 2, input->rankOf() - 1});
+    TadViews listOut(*output, {output->rankOf() - 1});
+    TadViews listDiag(*input, {input->rankOf() - 2, input->rankOf() - 1});
 
-    if (listOut->size() != listDiag->size()) {
+    if (listOut.size() != listDiag.size()) {
         nd4j_printf("matrix_diag_part: Input matrix has wrong shape.", "");
         return ND4J_STATUS_VALIDATION;
     }
     int lastDimension = nd4j::math::nd4j_min(input->sizeAt(-2), input->sizeAt(-1));
     // TODO: tune this properlys
-    int lO = listOut->size();
+    Nd4jLong lO = listOut.size();
     PRAGMA_OMP_PARALLEL_FOR_IF(lO > Environment::getInstance()->tadThreshold())
-    for(int i = 0; i < lO; ++i)
+    for(Nd4jLong i = 0; i < lO; ++i) {
+        auto diag = listOut.accessor<T>(i);
+        auto matrix = listDiag.accessor<T, 2>(i);
         for(int j = 0; j < lastDimension; ++j)
-            listOut->at(i)->p(j, listDiag->at(i)->e<T>(j, j));
-    
-    delete listOut;
-    delete listDiag;
+            diag[j] = matrix(j, j);
+    }
 
     return Status::OK();
 }
@@ -44,32 +44,39 @@ namespace helpers {
             int oY = 0;
             int oX = 0;
 
-            const int bSize = input->sizeAt(0);
-            const int inD = input->sizeAt(1);
-            const int inY = input->sizeAt(2);
-            const int inX = input->sizeAt(3);
-
             const bool isSameMode = params[8] != 0;
+            const bool isNCHW = params.size() > 10 ? params[10] == 0 : true;       // params[10]: 1-NHWC, 0-NCHW
+
+            const int inY = isNCHW ? input->sizeAt(2) : input->sizeAt(1);
+            const int inX = isNCHW ? input->sizeAt(3) : input->sizeAt(2);
 
             ConvolutionUtils::calcOutSizePool2D(oY, oX, kY, kX, sY, sX, pY, pX, dY, dX, inY, inX, isSameMode);
 
             if (isSameMode)
                 ConvolutionUtils::calcPadding2D(pY, pX, oY, oX, inY, inX, params[0], params[1], params[2], params[3], params[6], params[7]);
 
-            // 0,1 - kernel Height/Width; 2,3 - stride Height/Width; 4,5 - pad Height/Width; 6,7 - dilation Height/Width; 8 - poolingMode; 9 - divisor;
-            ConvolutionUtils::pooling2d(block, *input, *values, kY, kX, sY, sX, pY, pX, dY, dX, 0, 1);
-            
-            if (nullptr != indices) {
-                // for max_pool_with_argmax 
-                int total = input->lengthOf();
-                int part = total / bSize;
-                
-                for (int k = 0; k < total; )
-                for (int i = 0; i < part; i++) {
-                    indices->p(k++, i);
-                }
+            NDArray* in = input;
+            NDArray* out = values;
+            NDArray* idx = indices;
+
+            if (!isNCHW) {
+                in  = input->permute({0, 3, 1, 2});             // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+                out = values->permute({0, 3, 1, 2});            // [bS, oH, oW, iC] -> [bS, iC, oH, oW]
+                if (nullptr != indices)
+                    idx = indices->permute({0, 3, 1, 2});
             }
 
+            // 0,1 - kernel Height/Width; 2,3 - stride Height/Width; 4,5 - pad Height/Width; 6,7 - dilation Height/Width; 8 - poolingMode; 9 - divisor;
+            if (nullptr != indices)
+                ConvolutionUtils::maxPooling2dWithArgmax(*in, *out, *idx, kY, kX, sY, sX, pY, pX, dY, dX, isNCHW);
+            else
+                ConvolutionUtils::pooling2d(block, *in, *out, kY, kX, sY, sX, pY, pX, dY, dX, 0, 1);
+
+            if (!isNCHW) {
+                delete in;
+                delete out;
+                delete idx;
+            }
     }
 
     void maxPoolingFunctor(nd4j::graph::Context& block, NDArray* input, NDArray* values, std::vector<int> const& params, NDArray* indices) {
@@ -21,6 +21,7 @@
 
 #include<ops/declarable/helpers/meshgrid.h>
 #include <array/ResultSet.h>
+#include <TadViews.h>
 #include <numeric>
 
 namespace nd4j 	  {
@@ -41,11 +42,9 @@ void meshgrid(const std::vector<NDArray*>& inArrs, const std::vector<NDArray*>&
     }
             
     for(int i = 0; i < rank; ++i) {        
-        auto list = outArrs[i]->allTensorsAlongDimension({inIndices[i]});
-        for(int j = 0; j < list->size(); ++j)
-            list->at(j)->assign(inArrs[i]);
-
-        delete list;
+        TadViews list(*outArrs[i], {inIndices[i]});
+        for(Nd4jLong j = 0; j < list.size(); ++j)
+            list.at(j).assign(inArrs[i]);
     }
 }
 
@@ -22,6 +22,7 @@
 #include <TAD.h>
 #include <ShapeUtils.h>
 #include <helpers/ConstantTadHelper.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -49,14 +50,14 @@ namespace helpers {
             auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(sortedVals.shapeInfo(), lastDims);
             SpecialMethods<T>::sortTadGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), lastDims.data(), lastDims.size(), tadPack.primaryShapeInfo(), tadPack.primaryOffsets(), reverse);
 
-            std::unique_ptr<ResultSet> rows(sortedVals.allTensorsAlongDimension(lastDims));
+            TadViews rows(sortedVals, lastDims);
 
             Nd4jLong oL = output->lengthOf();
 
             PRAGMA_OMP_PARALLEL_FOR
             for (Nd4jLong e = 0; e < oL; e++) {
-                auto row = rows->at(e);
-                output->p(e, row->e<T>(n));
+                auto row = rows.accessor<T>(e);
+                output->p(e, row[n]);
             }
         }
     }
@@ -21,6 +21,7 @@
 #include <ops/declarable/helpers/percentile.h>
 #include <NDArrayFactory.h>
 #include "ResultSet.h"
+#include <TadViews.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -40,11 +41,11 @@ static void _percentile(const NDArray& input, NDArray& output, std::vector<int>&
         shape::checkDimensions(inputRank, axises);          // check, sort dimensions and remove duplicates if they are present
 
 
-    auto listOfSubArrs = input.allTensorsAlongDimension(axises);
+    TadViews listOfSubArrs(input, axises);
     
-    std::vector<Nd4jLong> shapeOfSubArr(listOfSubArrs->at(0)->rankOf());
+    std::vector<Nd4jLong> shapeOfSubArr(shape::rank(listOfSubArrs.shapeInfo()));
     for(int i=0; i<shapeOfSubArr.size(); ++i)
-        shapeOfSubArr[i] = listOfSubArrs->at(0)->shapeOf()[i];
+        shapeOfSubArr[i] = shape::shapeOf(listOfSubArrs.shapeInfo())[i];
 
     auto flattenedArr = NDArrayFactory::create('c', shapeOfSubArr, input.dataType(), input.getWorkspace());
     const int len = flattenedArr.lengthOf();
@@ -67,15 +68,13 @@ static void _percentile(const NDArray& input, NDArray& output, std::vector<int>&
 
     // FIXME: our sort impl should be used instead, so this operation might be implemented as generic
     PRAGMA_OMP_PARALLEL_FOR_ARGS(firstprivate(flattenedArr))
-    for(int i=0; i<listOfSubArrs->size(); ++i) {
+    for(Nd4jLong i=0; i<listOfSubArrs.size(); ++i) {
         
         T* buff = reinterpret_cast<T *>(flattenedArr.getBuffer());
-        flattenedArr.assign(listOfSubArrs->at(i));
+        flattenedArr.assign(listOfSubArrs.at(i));
         std::sort(buff, buff + len);
         output.p(i, flattenedArr.e<T>(position));
     }
-
-    delete listOfSubArrs;
 }
 
     void percentile(const NDArray& input, NDArray& output, std::vector<int>& axises, const float q, const int interpolation) {
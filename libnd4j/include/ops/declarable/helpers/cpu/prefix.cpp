@@ -22,6 +22,7 @@
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
 #include <ops/declarable/helpers/prefix.h>
+#include <TadViews.h>
 
 namespace nd4j {
     namespace ops {
@@ -99,19 +100,12 @@ namespace nd4j {
 
             template <typename T>
             static void __prefix(scalar::Ops op, NDArray* x, NDArray* z, std::vector<int>& dims, bool exclusive, bool reverse) {
-                auto xTads = x->allTensorsAlongDimension(dims);
-                auto zTads = z->allTensorsAlongDimension(dims);
-                auto t = xTads->size();
+                TadViews xTads(*x, dims);
+                TadViews zTads(*z, dims);
+                auto t = xTads.size();
 
-                for (int e = 0; e < t; e++) {
-                    auto tx = xTads->at(e);
-                    auto tz = zTads->at(e);
-
-                    __prefix<T>(op, tx->buffer(), tx->shapeInfo(), tz->buffer(), tz->shapeInfo(), exclusive, reverse);
-                }
-
-                delete xTads;
-                delete zTads;
+                for (Nd4jLong e = 0; e < t; e++)
+                    __prefix<T>(op, xTads.bufferAt(e), xTads.shapeInfo(), zTads.bufferAt(e), zTads.shapeInfo(), exclusive, reverse);
             };
 
             template <typename T>
@@ -21,6 +21,7 @@
 #include <ops/declarable/helpers/reverse.h>
 #include <helpers/ShapeUtils.h>
 #include <array/ResultSet.h>
+#include <TadViews.h>
 
 
 namespace nd4j    {
@@ -148,28 +149,30 @@ static void _reverseSequence(const NDArray* input, const NDArray* seqLengths, ND
 
         std::vector<int> dimensions = ShapeUtils::evalDimsToExclude(input->rankOf(), {batchDim});
 
-        auto inSubArrsSet  = input->allTensorsAlongDimension(dimensions);
-        auto outSubArrsSet = output->allTensorsAlongDimension(dimensions);
+        TadViews inSubArrsSet(*input, dimensions);
+        TadViews outSubArrsSet(*output, dimensions);
 
-        for(int i = 0; i < inSubArrsSet->size(); ++i) {
+        if(inSubArrsSet.size() == 0)
+            return;
+
+        // all sub-arrays share the same shape, so their inner sub-arrays along seqDim have the same offsets too
+        TadViews inInnerSet(inSubArrsSet.at(0), {seqDim});
+        TadViews outInnerSet(outSubArrsSet.at(0), {seqDim});
+
+        for(Nd4jLong i = 0; i < inSubArrsSet.size(); ++i) {
 
             Nd4jLong numOfElemsToReverse = seqLengths->e<Nd4jLong>(i);
         
             if(numOfElemsToReverse == 0 || numOfElemsToReverse == 1) {
-                outSubArrsSet->at(i)->assign(inSubArrsSet->at(i));
+                outSubArrsSet.at(i).assign(inSubArrsSet.at(i));
             }
             else {
-                auto inInnerSet  = inSubArrsSet->at(i)->allTensorsAlongDimension({seqDim});
-                auto outInnerSet = outSubArrsSet->at(i)->allTensorsAlongDimension({seqDim});
-                for(int j = 0; j < inInnerSet->size(); ++j)
-                    helpers::reverseArray<T>(inInnerSet->at(j)->getBuffer(), inInnerSet->at(j)->getShapeInfo(), outInnerSet->at(j)->getBuffer(), outInnerSet->at(j)->getShapeInfo(), numOfElemsToReverse);
-            
-                delete inInnerSet;
-                delete outInnerSet;
+                auto inSubArr  = inSubArrsSet.bufferAt<T>(i);
+                auto outSubArr = outSubArrsSet.bufferAt<T>(i);
+                for(Nd4jLong j = 0; j < inInnerSet.size(); ++j)
+                    helpers::reverseArray<T>(inSubArr + inInnerSet.offset(j), inInnerSet.shapeInfo(), outSubArr + outInnerSet.offset(j), outInnerSet.shapeInfo(), numOfElemsToReverse);
             }
         }
-        delete inSubArrsSet;
-        delete outSubArrsSet;
     }
 
 }
@@ -184,19 +187,12 @@ void reverse(const NDArray* input, NDArray* output, const std::vector<int>* intA
     // we need to reverse axis only if that's new op
     std::vector<int> dimensions = isBackProp ? ShapeUtils::evalDimsToExclude(input->rankOf(), *intArgs) : *intArgs;
 
-    auto listOut = output->allTensorsAlongDimension(dimensions);
-    auto listIn  = input->allTensorsAlongDimension(dimensions);
-       
-    NDArray *subArrIn, *subArrOut;
+    TadViews listOut(*output, dimensions);
+    TadViews listIn(*input, dimensions);
 
-    for(int i = 0; i < listIn->size(); ++i) {               // listIn->size() = listOut->size()
-        subArrIn   = listIn->at(i);
-        subArrOut  = listOut->at(i);        
-        BUILD_SINGLE_SELECTOR(input->dataType(), helpers::reverseArray, (subArrIn->getBuffer(), subArrIn->getShapeInfo(), subArrOut->getBuffer(), subArrOut->getShapeInfo()), LIBND4J_TYPES);
+    for(Nd4jLong i = 0; i < listIn.size(); ++i) {               // listIn.size() = listOut.size()
+        BUILD_SINGLE_SELECTOR(input->dataType(), helpers::reverseArray, (listIn.bufferAt(i), listIn.shapeInfo(), listOut.bufferAt(i), listOut.shapeInfo()), LIBND4J_TYPES);
     }
-
-    delete listOut;
-    delete listIn;
 }
 
 BUILD_SINGLE_TEMPLATE(template void reverseArray, (void *inArr, Nd4jLong *inShapeBuffer, void *outArr, Nd4jLong *outShapeBuffer, int numOfElemsToReverse), LIBND4J_TYPES);
@@ -19,6 +19,8 @@
 //
 
 #include <ops/declarable/helpers/roll.h>
+#include <NDArrayAccessor.h>
+#include <TadViews.h>
 
 namespace nd4j {
 namespace ops {
@@ -39,6 +41,7 @@ namespace helpers {
             actualShift %= fullLen;
 
         if (actualShift) {
+            NDArrayAccessor<T> z(*output);
             int shiftCount = fullLen / actualShift - 1;
             int remainShift = fullLen % actualShift; 
             
@@ -47,12 +50,12 @@ namespace helpers {
             for (int e = 0; e < actualShift; ++e) {
                 int sourceIndex = fullLen - actualShift + e;
 
-                auto _e0 = output->e<T>(e);
-                auto _e1 = output->e<T>(sourceIndex);
+                auto _e0 = z[e];
+                auto _e1 = z[sourceIndex];
 
                 //nd4j::math::nd4j_swap((*output)(e), (*output)(sourceIndex));
-                output->p<T>(e, _e1);
-                output->p<T>(sourceIndex, _e0);
+                z[e] = _e1;
+                z[sourceIndex] = _e0;
             }
 
             // stage 2) swap swapped actualShift elements with rest remainShiftCount times.
@@ -62,25 +65,25 @@ namespace helpers {
                     int destinationIndex = fullLen - (count + 1) * actualShift + e;
                     int sourceIndex = fullLen - count * actualShift + e;
 
-                    auto _e0 = output->e<T>(destinationIndex);
-                    auto _e1 = output->e<T>(sourceIndex);
+                    auto _e0 = z[destinationIndex];
+                    auto _e1 = z[sourceIndex];
 
                     //nd4j::math::nd4j_swap((*output)(destinationIndex), (*output)(sourceIndex));
-                    output->p<T>(destinationIndex, _e1);
-                    output->p<T>(sourceIndex, _e0);
+                    z[destinationIndex] = _e1;
+                    z[sourceIndex] = _e0;
                 }
             }
             
             // stage 3) swap remainer of items.
             if (remainShift && shiftCount)
             for (int i = actualShift; i < 2 * actualShift; ++i) {
-                auto _e0 = output->e<T>(i);
-                auto _e1 = output->e<T>(i + remainShift);
+                auto _e0 = z[i];
+                auto _e1 = z[i + remainShift];
 
                 //nd4j::math::nd4j_swap((*output)(i), (*output)(i + remainShift));
 
-                output->p<T>(i, _e1);
-                output->p<T>(i + remainShift, _e0);
+                z[i] = _e1;
+                z[i + remainShift] = _e0;
             }
         }
     }
@@ -93,9 +96,9 @@ namespace helpers {
         auto source = input;
         for (int axe: axes) {
             if (axe == source->rankOf() - 1) {// last dimension
-                std::unique_ptr<ResultSet> listOfTensors(source->allTensorsAlongDimension({axe}));
-                std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension({axe}));
-                int fullLen = listOfTensors->size();
+                TadViews listOfTensors(*source, {axe});
+                TadViews listOfOutTensors(*output, {axe});
+                int fullLen = listOfTensors.size();
                 int theShift = shift;
                 if (theShift > 0) {
                     theShift %= fullLen;
@@ -104,7 +107,9 @@ namespace helpers {
                         theShift -= fullLen * (theShift / fullLen - 1);
                 }
                 for (int k = 0; k < fullLen; k++) {
-                    rollFunctorLinear(listOfTensors->at(k), listOfOutTensors->at(k), theShift, true);
+                    auto tad = listOfTensors.at(k);
+                    auto outTad = listOfOutTensors.at(k);
+                    rollFunctorLinear(&tad, &outTad, theShift, true);
                 }
             }
             else {
@@ -112,10 +117,10 @@ namespace helpers {
                 for (int i = 0; i < dims.size(); ++i)
                     dims[i] = axe + 1 + i;
 
-                std::unique_ptr<ResultSet> listOfTensors(source->allTensorsAlongDimension({dims}));
-                std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension({dims}));
+                TadViews listOfTensors(*source, dims);
+                TadViews listOfOutTensors(*output, dims);
             
-                int fullLen = listOfTensors->size();
+                int fullLen = listOfTensors.size();
                 int sizeAt = input->sizeAt(axe);
 
                 int theShift = shift;
@@ -130,17 +135,17 @@ namespace helpers {
                 if (theShift) {
                     for (int dim = 0; dim < fullLen / sizeAt; ++dim) {
                         for (int e = theShift; e < sizeAt - theShift; ++e) {
-                            auto sourceM = listOfTensors->at(dim * sizeAt + e - theShift);
-                            auto targetM = listOfOutTensors->at(dim * sizeAt + e);
-                            sourceM->swapUnsafe(*targetM);
+                            auto sourceM = listOfTensors.at(dim * sizeAt + e - theShift);
+                            auto targetM = listOfOutTensors.at(dim * sizeAt + e);
+                            sourceM.swapUnsafe(targetM);
                         }
     
                         for (int e = 0; e < theShift; ++e) {
                             int sourceIndex = dim * sizeAt + sizeAt - theShift + e;
-                            auto sourceM = listOfTensors->at(sourceIndex);
-                            auto targetM = listOfOutTensors->at(dim * sizeAt + e);
+                            auto sourceM = listOfTensors.at(sourceIndex);
+                            auto targetM = listOfOutTensors.at(dim * sizeAt + e);
     
-                            sourceM->swapUnsafe(*targetM);
+                            sourceM.swapUnsafe(targetM);
                         }
                     }
                 }
@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/scatter.h>
+#include <Environment.h>
+#include <helpers/ContiguousBuffer.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // number of row elements handled by single task, so wide rows keep all threads busy even if few rows are hit
+    static const Nd4jLong SCATTER_BLOCK = 256;
+
+    /**
+     * Updates grouped by target row: rows[r] receives updates perm[offsets[r]] ... perm[offsets[r + 1] - 1],
+     * in original order. Only rows hit by at least one index are stored
+     */
+    struct ScatterGroups {
+        std::vector<Nd4jLong> rows;
+        std::vector<Nd4jLong> offsets;
+        std::vector<Nd4jLong> perm;
+
+        FORCEINLINE Nd4jLong numRows() const {
+            return static_cast<Nd4jLong>(rows.size());
+        }
+
+        FORCEINLINE Nd4jLong count(Nd4jLong r) const {
+            return offsets[r + 1] - offsets[r];
+        }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Update ops: apply() merges update into output element. For reducible ops consecutive updates of the same element
+    // can be merged with reduce() first, and result applied once: op(op(z, a), b) == op(z, reduce(a, b))
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    template <typename T>
+    struct ScatterAddOp {
+        static const bool reducible = true;
+        static FORCEINLINE T apply(T z, T u) { return z + u; }
+        static FORCEINLINE T reduce(T a, T u) { return a + u; }
+    };
+
+    template <typename T>
+    struct ScatterSubtractOp {
+        static const bool reducible = true;
+        static FORCEINLINE T apply(T z, T u) { return z - u; }
+        static FORCEINLINE T reduce(T a, T u) { return a + u; }
+    };
+
+    template <typename T>
+    struct ScatterMultiplyOp {
+        static const bool reducible = true;
+        static FORCEINLINE T apply(T z, T u) { return z * u; }
+        static FORCEINLINE T reduce(T a, T u) { return a * u; }
+    };
+
+    template <typename T>
+    struct ScatterDivideOp {
+        static const bool reducible = false;
+        static FORCEINLINE T apply(T z, T u) { return z / u; }
+        static FORCEINLINE T reduce(T a, T u) { return a * u; }
+    };
+
+    // product of bools is conjunction
+    template <>
+    struct ScatterMultiplyOp<bool> {
+        static const bool reducible = true;
+        static FORCEINLINE bool apply(bool z, bool u) { return z && u; }
+        static FORCEINLINE bool reduce(bool a, bool u) { return a && u; }
+    };
+
+    template <>
+    struct ScatterDivideOp<bool> {
+        static const bool reducible = false;
+        static FORCEINLINE bool apply(bool z, bool u) { return z / u; }
+        static FORCEINLINE bool reduce(bool a, bool u) { return a && u; }
+    };
+
+    template <typename T>
+    struct ScatterMaxOp {
+        static const bool reducible = true;
+        static FORCEINLINE T apply(T z, T u) { return u > z ? u : z; }
+        static FORCEINLINE T reduce(T a, T u) { return u > a ? u : a; }
+    };
+
+    template <typename T>
+    struct ScatterMinOp {
+        static const bool reducible = true;
+        static FORCEINLINE T apply(T z, T u) { return u < z ? u : z; }
+        static FORCEINLINE T reduce(T a, T u) { return u < a ? u : a; }
+    };
+
+    // last update wins, so order matters and updates can't be merged
+    template <typename T>
+    struct ScatterCopyOp {
+        static const bool reducible = false;
+        static FORCEINLINE T apply(T z, T u) { return u; }
+        static FORCEINLINE T reduce(T a, T u) { return u; }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Indices and buffers
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    template <typename I>
+    static void readIndices_(const NDArray& indices, Nd4jLong* target) {
+        auto length = indices.lengthOf();
+        auto ews = indices.ews();
+
+        if (ews >= 1 && indices.ordering() == 'c') {
+            auto idx = reinterpret_cast<I*>(indices.getBuffer());
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++)
+                target[e] = static_cast<Nd4jLong>(idx[e * ews]);
+        } else {
+            for (Nd4jLong e = 0; e < length; e++)
+                target[e] = indices.e<Nd4jLong>(e);
+        }
+    }
+
+    static std::vector<Nd4jLong> readIndices(const NDArray& indices) {
+        std::vector<Nd4jLong> result(indices.lengthOf());
+        BUILD_SINGLE_SELECTOR(indices.dataType(), readIndices_, (indices, result.data()), LIBND4J_TYPES);
+        return result;
+    }
+
+    /**
+     * This method groups updates by target row. Counting sort is used if number of output rows is comparable
+     * with number of updates, otherwise update numbers are stable-sorted by target row
+     */
+    static void groupUpdates(const std::vector<Nd4jLong>& idx, Nd4jLong numRows, ScatterGroups& groups) {
+        const auto n = static_cast<Nd4jLong>(idx.size());
+
+        for (auto v : idx)
+            if (v < 0 || v >= numRows)
+                throw std::invalid_argument("scatter: index " + std::to_string(v) + " is out of range [0, " + std::to_string(numRows) + ")");
+
+        groups.perm.resize(n);
+        groups.rows.clear();
+        groups.offsets.clear();
+
+        if (numRows <= 4 * n + 1024) {
+            std::vector<Nd4jLong> position(numRows + 1, 0);
+            for (auto v : idx)
+                position[v + 1]++;
+
+            for (Nd4jLong r = 0; r < numRows; r++) {
+                if (position[r + 1] > 0) {
+                    groups.rows.emplace_back(r);
+                    groups.offsets.emplace_back(position[r]);
+                }
+
+                position[r + 1] += position[r];
+            }
+
+            for (Nd4jLong e = 0; e < n; e++)
+                groups.perm[position[idx[e]]++] = e;
+        } else {
+            std::iota(groups.perm.begin(), groups.perm.end(), 0);
+            std::stable_sort(groups.perm.begin(), groups.perm.end(), [&] (Nd4jLong a, Nd4jLong b) -> bool {
+                return idx[a] < idx[b];
+            });
+
+            for (Nd4jLong p = 0; p < n; p++) {
+                if (p == 0 || idx[groups.perm[p]] != idx[groups.perm[p - 1]]) {
+                    groups.rows.emplace_back(idx[groups.perm[p]]);
+                    groups.offsets.emplace_back(p);
+                }
+            }
+        }
+
+        groups.offsets.emplace_back(n);
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Kernels
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * Every task owns block of single output row, and applies all updates of this row sequentially, so no atomics are needed
+     */
+    template <typename T, typename Op>
+    static void scatterRows_(const ScatterGroups& groups, const T* upd, T* out, Nd4jLong rowLen, bool parallel) {
+        const auto numRows = groups.numRows();
+        const auto numBlocks = (rowLen + SCATTER_BLOCK - 1) / SCATTER_BLOCK;
+        const auto numUpdates = groups.offsets.back();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel && numUpdates * rowLen > Environment::getInstance()->elementwiseThreshold()) collapse(2) schedule(guided))
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                auto start = b * SCATTER_BLOCK;
+                auto len = nd4j::math::nd4j_min<Nd4jLong>(SCATTER_BLOCK, rowLen - start);
+                auto z = out + groups.rows[r] * rowLen + start;
+
+                for (Nd4jLong p = groups.offsets[r]; p < groups.offsets[r + 1]; p++) {
+                    auto u = upd + groups.perm[p] * rowLen + start;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < len; e++)
+                        z[e] = Op::apply(z[e], u[e]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Duplicate-heavy case: updates of each row are split into chunks, every chunk is reduced into its own partial row
+     * in parallel, and partial rows are applied to output afterwards
+     */
+    template <typename T, typename Op>
+    static void scatterPartial_(const ScatterGroups& groups, const T* upd, T* out, Nd4jLong rowLen, int numChunks) {
+        const auto numRows = groups.numRows();
+        std::unique_ptr<T[]> partial(new T[numRows * numChunks * rowLen]);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2) schedule(static))
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            for (int c = 0; c < numChunks; c++) {
+                auto lo = groups.offsets[r] + groups.count(r) * c / numChunks;
+                auto hi = groups.offsets[r] + groups.count(r) * (c + 1) / numChunks;
+                if (lo >= hi)
+                    continue;
+
+                auto acc = partial.get() + (r * numChunks + c) * rowLen;
+                auto first = upd + groups.perm[lo] * rowLen;
+                std::copy(first, first + rowLen, acc);
+
+                for (Nd4jLong p = lo + 1; p < hi; p++) {
+                    auto u = upd + groups.perm[p] * rowLen;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < rowLen; e++)
+                        acc[e] = Op::reduce(acc[e], u[e]);
+                }
+            }
+        }
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numRows * rowLen > Environment::getInstance()->elementwiseThreshold()) collapse(2))
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            for (Nd4jLong e = 0; e < rowLen; e++) {
+                auto z = out + groups.rows[r] * rowLen + e;
+
+                for (int c = 0; c < numChunks; c++) {
+                    auto lo = groups.offsets[r] + groups.count(r) * c / numChunks;
+                    auto hi = groups.offsets[r] + groups.count(r) * (c + 1) / numChunks;
+                    if (lo < hi)
+                        *z = Op::apply(*z, partial[(r * numChunks + c) * rowLen + e]);
+                }
+            }
+        }
+    }
+
+    template <typename T, typename Op>
+    static void scatterApply_(const ScatterGroups& groups, const T* upd, T* out, Nd4jLong rowLen, bool parallel) {
+        int numThreads = 1;
+#ifdef _OPENMP
+        numThreads = omp_get_max_threads();
+#endif
+        const auto numBlocks = (rowLen + SCATTER_BLOCK - 1) / SCATTER_BLOCK;
+        const auto numUpdates = groups.offsets.back();
+
+        // row ownership can't keep all threads busy if just few rows are hit by many updates
+        if (Op::reducible && parallel && numThreads > 1 && groups.numRows() * numBlocks < numThreads && numUpdates >= 4 * numThreads
+                && numUpdates * rowLen > Environment::getInstance()->elementwiseThreshold())
+            scatterPartial_<T, Op>(groups, upd, out, rowLen, numThreads);
+        else
+            scatterRows_<T, Op>(groups, upd, out, rowLen, parallel);
+    }
+
+    template <typename T>
+    static void scatter_(pairwise::Ops op, const ScatterGroups& groups, const NDArray& updates, NDArray& output, Nd4jLong rowLen, bool parallel) {
+        ContiguousBuffer u(updates, output.dataType());
+        ContiguousBuffer z(output, output.dataType(), true);
+
+        auto upd = u.buffer<T>();
+        auto out = z.buffer<T>();
+
+        switch (op) {
+            case pairwise::Add:
+                scatterApply_<T, ScatterAddOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            case pairwise::Subtract:
+                scatterApply_<T, ScatterSubtractOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            case pairwise::Multiply:
+                scatterApply_<T, ScatterMultiplyOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            case pairwise::Divide:
+                scatterApply_<T, ScatterDivideOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            case pairwise::MaxPairwise:
+                scatterApply_<T, ScatterMaxOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            case pairwise::MinPairwise:
+                scatterApply_<T, ScatterMinOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            case pairwise::CopyPws:
+                scatterApply_<T, ScatterCopyOp<T>>(groups, upd, out, rowLen, parallel);
+                break;
+            default:
+                throw std::invalid_argument("scatter: unsupported pairwise op " + std::to_string(static_cast<int>(op)));
+        }
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Entry points
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    static void scatterGrouped(pairwise::Ops op, const std::vector<Nd4jLong>& rowIdx, Nd4jLong numRows, const NDArray& updates, NDArray& output, bool serial) {
+        if (rowIdx.empty() || output.lengthOf() == 0)
+            return;
+
+        const auto rowLen = output.lengthOf() / numRows;
+        const auto numUpdates = static_cast<Nd4jLong>(rowIdx.size());
+
+        if (updates.lengthOf() != numUpdates * rowLen)
+            throw std::invalid_argument("scatter: updates length " + std::to_string(updates.lengthOf()) + " doesn't match " + std::to_string(numUpdates) + " rows of length " + std::to_string(rowLen));
+
+        ScatterGroups groups;
+        groupUpdates(rowIdx, numRows, groups);
+
+        BUILD_SINGLE_SELECTOR(output.dataType(), scatter_, (op, groups, updates, output, rowLen, !serial), LIBND4J_TYPES);
+    }
+
+    void scatter(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, bool serial) {
+        scatterGrouped(op, readIndices(indices), output.sizeAt(0), updates, output, serial);
+    }
+
+    void scatterND(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, bool serial) {
+        const int outRank = output.rankOf();
+        const int indLastDim = static_cast<int>(indices.sizeAt(-1));
+
+        if (indLastDim < 1 || indLastDim > outRank)
+            throw std::invalid_argument("scatterND: last dimension of indices should be in range [1, " + std::to_string(outRank) + "], but got " + std::to_string(indLastDim));
+
+        // coordinates within first indLastDim dimensions are turned into linear row numbers
+        auto coords = readIndices(indices);
+        const auto numUpdates = static_cast<Nd4jLong>(coords.size()) / indLastDim;
+
+        Nd4jLong numRows = 1;
+        for (int d = 0; d < indLastDim; d++)
+            numRows *= output.sizeAt(d);
+
+        std::vector<Nd4jLong> rowIdx(numUpdates);
+        for (Nd4jLong i = 0; i < numUpdates; i++) {
+            Nd4jLong row = 0;
+            for (int d = 0; d < indLastDim; d++) {
+                auto c = coords[i * indLastDim + d];
+                if (c < 0 || c >= output.sizeAt(d))
+                    throw std::invalid_argument("scatterND: index " + std::to_string(c) + " is out of range [0, " + std::to_string(output.sizeAt(d)) + ") for dimension " + std::to_string(d));
+
+                row = row * output.sizeAt(d) + c;
+            }
+            rowIdx[i] = row;
+        }
+
+        scatterGrouped(op, rowIdx, numRows, updates, output, serial);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void scatter_, (pairwise::Ops op, const ScatterGroups& groups, const NDArray& updates, NDArray& output, Nd4jLong rowLen, bool parallel), LIBND4J_TYPES);
+}
+}
+}
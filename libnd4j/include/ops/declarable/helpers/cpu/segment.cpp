@@ -19,330 +19,369 @@
 //
 
 #include <ops/declarable/helpers/segment.h>
+#include <NDArrayAccessor.h>
+#include <helpers/ContiguousBuffer.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    // segment max
+    // number of row elements handled by single task: wide rows are split into blocks, so even few segments keep all threads busy
+    static const Nd4jLong SEGMENT_BLOCK = 256;
+
+    /**
+     * Input rows grouped by segment: rows of segment s are row(offsets[s]) ... row(offsets[s + 1] - 1), in ascending order.
+     * Sorted segments are contiguous already, so permutation is used only for unsorted ones
+     */
+    struct SegmentGroups {
+        std::vector<Nd4jLong> offsets;
+        std::vector<Nd4jLong> perm;
+
+        FORCEINLINE Nd4jLong numSegments() const {
+            return static_cast<Nd4jLong>(offsets.size()) - 1;
+        }
+
+        FORCEINLINE Nd4jLong count(Nd4jLong segment) const {
+            return offsets[segment + 1] - offsets[segment];
+        }
+
+        FORCEINLINE Nd4jLong row(Nd4jLong position) const {
+            return perm.empty() ? position : perm[position];
+        }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Reduction ops: update() merges input row into accumulated one, postProcess() is applied once per segment,
+    // bp() returns gradient for input element x, given gradient and forward result of its segment
+    // -------------------------------------------------------------------------------------------------------------- //
+
     template <typename T>
-    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-
-            for (Nd4jLong e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // max
-                   val = nd4j::math::nd4j_max<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(e);
-                    val = input->t<T>(e);
-                }
-                output->t<T>(idx) = val;
-            }
+    struct SegmentSumOp {
+        static FORCEINLINE T update(T old, T x) { return old + x; }
+        static FORCEINLINE T postProcess(T v, Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(T x, T grad, T ff, Nd4jLong count) { return grad; }
+    };
+
+    template <typename T>
+    struct SegmentMeanOp {
+        static FORCEINLINE T update(T old, T x) { return old + x; }
+        static FORCEINLINE T postProcess(T v, Nd4jLong count) { return static_cast<T>(static_cast<double>(v) / count); }
+        static FORCEINLINE T bp(T x, T grad, T ff, Nd4jLong count) { return static_cast<T>(static_cast<double>(grad) / count); }
+    };
+
+    template <typename T>
+    struct SegmentSqrtNOp {
+        static FORCEINLINE T update(T old, T x) { return old + x; }
+        static FORCEINLINE T postProcess(T v, Nd4jLong count) { return static_cast<T>(static_cast<double>(v) / nd4j::math::nd4j_sqrt<double, double>(static_cast<double>(count))); }
+        static FORCEINLINE T bp(T x, T grad, T ff, Nd4jLong count) { return static_cast<T>(static_cast<double>(grad) / nd4j::math::nd4j_sqrt<double, double>(static_cast<double>(count))); }
+    };
+
+    template <typename T>
+    struct SegmentProdOp {
+        static FORCEINLINE T update(T old, T x) { return old * x; }
+        static FORCEINLINE T postProcess(T v, Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(T x, T grad, T ff, Nd4jLong count) { return ff * grad / x; }
+    };
+
+    // product of bools is conjunction
+    template <>
+    struct SegmentProdOp<bool> {
+        static FORCEINLINE bool update(bool old, bool x) { return old && x; }
+        static FORCEINLINE bool postProcess(bool v, Nd4jLong count) { return v; }
+        static FORCEINLINE bool bp(bool x, bool grad, bool ff, Nd4jLong count) { return ff && grad; }
+    };
+
+    template <typename T>
+    struct SegmentMaxOp {
+        static FORCEINLINE T update(T old, T x) { return nd4j::math::nd4j_max<T>(old, x); }
+        static FORCEINLINE T postProcess(T v, Nd4jLong count) { return v; }
+        // gradient goes to every element equal to segment maximum
+        static FORCEINLINE T bp(T x, T grad, T ff, Nd4jLong count) { return nd4j::math::nd4j_abs<T>(ff - x) <= static_cast<T>(1.e-6) ? grad : static_cast<T>(0); }
+    };
+
+    template <typename T>
+    struct SegmentMinOp {
+        static FORCEINLINE T update(T old, T x) { return nd4j::math::nd4j_min<T>(old, x); }
+        static FORCEINLINE T postProcess(T v, Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(T x, T grad, T ff, Nd4jLong count) { return nd4j::math::nd4j_abs<T>(ff - x) <= static_cast<T>(1.e-6) ? grad : static_cast<T>(0); }
+    };
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Indices and buffers
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    template <typename I>
+    static void readIndices_(NDArray* indices, Nd4jLong* target) {
+        auto length = indices->lengthOf();
+        auto ews = indices->ews();
+
+        if (ews >= 1) {
+            auto idx = reinterpret_cast<I*>(indices->getBuffer());
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++)
+                target[e] = static_cast<Nd4jLong>(idx[e * ews]);
+        } else {
+            NDArrayAccessor<const I> idx(*indices);
+            for (auto it = idx.begin(); it != idx.end(); ++it)
+                target[it.index()] = static_cast<Nd4jLong>(*it);
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    }
+
+    static std::vector<Nd4jLong> readIndices(NDArray* indices) {
+        std::vector<Nd4jLong> result(indices->lengthOf());
+        BUILD_SINGLE_SELECTOR(indices->dataType(), readIndices_, (indices, result.data()), LIBND4J_TYPES);
+        return result;
+    }
+
+    // sorted segments: boundaries are found with binary search, one per segment
+    static void groupSorted(const std::vector<Nd4jLong>& idx, Nd4jLong numOfClasses, SegmentGroups& groups) {
+        groups.offsets.resize(numOfClasses + 1);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numOfClasses > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong s = 0; s <= numOfClasses; s++)
+            groups.offsets[s] = std::lower_bound(idx.begin(), idx.end(), s) - idx.begin();
+    }
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    // unsorted segments: stable counting sort of row numbers by segment
+    static void groupUnsorted(const std::vector<Nd4jLong>& idx, Nd4jLong numOfClasses, SegmentGroups& groups) {
+        groups.offsets.assign(numOfClasses + 1, 0);
+        groups.perm.resize(idx.size());
 
-            auto numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
+        for (auto v : idx)
+            groups.offsets[v + 1]++;
 
-            //int pos = 0;
-            maxT->assign(listOfTensors->at(0));
+        for (Nd4jLong s = 0; s < numOfClasses; s++)
+            groups.offsets[s + 1] += groups.offsets[s];
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
+        std::vector<Nd4jLong> position(groups.offsets.begin(), groups.offsets.end() - 1);
+        for (Nd4jLong e = 0; e < static_cast<Nd4jLong>(idx.size()); e++)
+            groups.perm[position[idx[e]]++] = e;
+    }
+
+    /**
+     * This method groups rows by segment. Backprop ops for sorted segments don't validate indices order,
+     * so sorted path is used only if indices are really sorted
+     */
+    static void groupRows(const std::vector<Nd4jLong>& idx, Nd4jLong numOfClasses, bool sorted, SegmentGroups& groups) {
+        for (auto v : idx)
+            if (v < 0 || v >= numOfClasses)
+                throw std::invalid_argument("segment: index " + std::to_string(v) + " is out of range [0, " + std::to_string(numOfClasses) + ")");
+
+        if (sorted && std::is_sorted(idx.begin(), idx.end()))
+            groupSorted(idx, numOfClasses, groups);
+        else
+            groupUnsorted(idx, numOfClasses, groups);
+    }
+
+    static FORCEINLINE Nd4jLong rowLengthOf(NDArray* array) {
+        auto rows = array->sizeAt(0);
+        return rows > 0 ? array->lengthOf() / rows : 0;
+    }
 
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->t<T>(e) = nd4j::math::nd4j_max(maxT->t<T>(e), listOfTensors->at(i)->t<T>(e));
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Kernels
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    /**
+     * Forward kernel: output row s is reduction of input rows of segment s.
+     * Empty segments are set to emptyValue if fillEmpty is true, and left untouched otherwise
+     */
+    template <typename T, typename OpType>
+    static void segmentReduce_(const T* x, const SegmentGroups& groups, Nd4jLong rowLength, T* z, bool fillEmpty, T emptyValue) {
+        const auto numSegments = groups.numSegments();
+        const auto numBlocks = (rowLength + SEGMENT_BLOCK - 1) / SEGMENT_BLOCK;
+        const bool parallel = numSegments * rowLength > Environment::getInstance()->elementwiseThreshold();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel) schedule(guided) collapse(2))
+        for (Nd4jLong s = 0; s < numSegments; s++) {
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                const auto first = groups.offsets[s];
+                const auto last = groups.offsets[s + 1];
+                const auto start = b * SEGMENT_BLOCK;
+                const auto length = nd4j::math::nd4j_min<Nd4jLong>(SEGMENT_BLOCK, rowLength - start);
+
+                auto zRow = z + s * rowLength + start;
+
+                if (first == last) {
+                    if (fillEmpty) {
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong e = 0; e < length; e++)
+                            zRow[e] = emptyValue;
                     }
+                    continue;
                 }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
+
+                auto xRow = x + groups.row(first) * rowLength + start;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    zRow[e] = xRow[e];
+
+                for (Nd4jLong p = first + 1; p < last; p++) {
+                    xRow = x + groups.row(p) * rowLength + start;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        zRow[e] = OpType::update(zRow[e], xRow[e]);
                 }
 
+                const auto count = last - first;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    zRow[e] = OpType::postProcess(zRow[e], count);
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
     }
 
-    // segmen min 
-    template <typename T>
-    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // min 
-                   val = nd4j::math::nd4j_min<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
+    /**
+     * Backprop kernel: every input row gets gradient computed from gradOut and forward result rows of its segment.
+     * Rows are independent, so they are processed in parallel without any synchronization
+     */
+    template <typename T, typename OpType>
+    static void segmentReduceBP_(const T* x, const Nd4jLong* idx, const SegmentGroups& groups, const T* grad, const T* ff, Nd4jLong numRows, Nd4jLong rowLength, T* z) {
+        const auto numBlocks = (rowLength + SEGMENT_BLOCK - 1) / SEGMENT_BLOCK;
+        const bool parallel = numRows * rowLength > Environment::getInstance()->elementwiseThreshold();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel) collapse(2))
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                const auto segment = idx[r];
+                const auto count = groups.count(segment);
+                const auto start = b * SEGMENT_BLOCK;
+                const auto length = nd4j::math::nd4j_min<Nd4jLong>(SEGMENT_BLOCK, rowLength - start);
+
+                auto xRow = x + r * rowLength + start;
+                auto zRow = z + r * rowLength + start;
+                auto gRow = grad + segment * rowLength + start;
+
+                if (ff != nullptr) {
+                    auto fRow = ff + segment * rowLength + start;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        zRow[e] = OpType::bp(xRow[e], gRow[e], fRow[e], count);
+                } else {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        zRow[e] = OpType::bp(xRow[e], gRow[e], static_cast<T>(0), count);
                 }
-                output->t<T>(idx) = val;
             }
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            auto loop_length = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_length; e++)
-                restDims[e - 1] = e;
+    }
 
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Entry points shared by sorted and unsorted ops
+    // -------------------------------------------------------------------------------------------------------------- //
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
+    template <typename T, template <typename> class OpType>
+    static void segmentFunctor_(NDArray* input, NDArray* indices, NDArray* output, bool sorted, bool fillEmpty, T emptyValue) {
+        const auto numOfClasses = output->sizeAt(0);
+        const auto rowLength = rowLengthOf(output);
 
-            int pos = 0;
-            minT->assign(listOfTensors->at(0));
+        auto idx = readIndices(indices);
+        SegmentGroups groups;
+        groupRows(idx, numOfClasses, sorted, groups);
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<T>(i) == idx) {
+        ContiguousBuffer x(input, output->dataType());
+        ContiguousBuffer z(output, output->dataType(), true);
 
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
-                }
-            }
+        segmentReduce_<T, OpType<T>>(x.buffer<T>(), groups, rowLength, z.buffer<T>(), fillEmpty, emptyValue);
+    }
+
+    template <typename T, template <typename> class OpType>
+    static int segmentFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output, Nd4jLong numOfClasses, bool sorted, bool needsForward) {
+        const auto dataType = output->dataType();
+        const auto numRows = input->sizeAt(0);
+        const auto rowLength = rowLengthOf(output);
+
+        auto idx = readIndices(indices);
+        SegmentGroups groups;
+        groupRows(idx, numOfClasses, sorted, groups);
+
+        ContiguousBuffer x(input, dataType);
+        ContiguousBuffer grad(gradOut, dataType);
+        ContiguousBuffer z(output, dataType, true);
+
+        // forward pass result is required by max, min and prod gradients only
+        std::unique_ptr<NDArray> ff;
+        if (needsForward) {
+            ff.reset(new NDArray('c', grad.array()->getShapeAsVector(), dataType, output->getWorkspace()));
+            segmentReduce_<T, OpType<T>>(x.buffer<T>(), groups, rowLength, reinterpret_cast<T*>(ff->getBuffer()), false, static_cast<T>(0));
         }
+
+        segmentReduceBP_<T, OpType<T>>(x.buffer<T>(), idx.data(), groups, grad.buffer<T>(), needsForward ? reinterpret_cast<T*>(ff->getBuffer()) : nullptr, numRows, rowLength, z.buffer<T>());
+
+        return ND4J_STATUS_OK;
+    }
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Sorted segment ops
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    template <typename T>
+    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        segmentFunctor_<T, SegmentMaxOp>(input, indices, output, true, false, static_cast<T>(0));
+    }
+
+    template <typename T>
+    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        segmentFunctor_<T, SegmentMinOp>(input, indices, output, true, false, static_cast<T>(0));
     }
 
-    // segmen mean
     template <typename T>
     static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // mean 
-                   val += input->e<T>(e);
-                   count++;
-                }
-                else {
-                   output->p<T>(idx, val / count);
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                    count = 1;
-                }
-                output->p<T>(idx, val / count);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
-
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                    count++;
-                }
-                else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
-                    count = 1;
-                }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-            }
-            delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+        segmentFunctor_<T, SegmentMeanOp>(input, indices, output, true, false, static_cast<T>(0));
     }
 
     template <typename T>
     static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val += input->t<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-	    int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+        segmentFunctor_<T, SegmentSumOp>(input, indices, output, true, false, static_cast<T>(0));
     }
 
     template <typename T>
     static void segmentProdFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        output->assign(1.f);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-            int count = 0;
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val *= input->e<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+        segmentFunctor_<T, SegmentProdOp>(input, indices, output, true, true, static_cast<T>(1));
     }
 
-//    template <typename T>
-//    static bool segmentIndicesValidate_(NDArray* indices, NDArray& aexpected, NDArray& anOutput) {
-//      }
-
     void segmentMaxFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMaxFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentMaxFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentMinFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMinFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentMinFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentMeanFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMeanFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentMeanFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentSumFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentSumFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentSumFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentProdFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentProdFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentProdFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     bool segmentIndicesValidate(NDArray* indices, NDArray& expected, NDArray& output) {
-        auto val = indices->e(0);
-        for (int e = 1; e < indices->lengthOf(); e++) {
-            output = indices->e(e);
-            if (val.e<Nd4jLong>(0) > output.e<Nd4jLong>(0))
+        auto idx = readIndices(indices);
+        for (size_t e = 1; e < idx.size(); e++) {
+            if (idx[e - 1] > idx[e]) {
+                expected = indices->e(e - 1);
+                output = indices->e(e);
                 return false;
-            val = indices->e(e);
+            }
         }
 
         return true;
     }
 
-    //BUILD_SINGLE_TEMPLATE(template bool segmentIndicesValidate_, (NDArray*, NDArray&, NDArray&), LIBND4J_TYPES);
     BUILD_SINGLE_TEMPLATE(template void segmentProdFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
     BUILD_SINGLE_TEMPLATE(template void segmentSumFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
     BUILD_SINGLE_TEMPLATE(template void segmentMeanFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
@@ -353,773 +392,168 @@ namespace helpers {
     // -------------------------------------------------------------------------------------------------------------- //
 
     bool unsortedSegmentIndicesValidate(NDArray* indices, Nd4jLong expected, Nd4jLong& output) {
-        Nd4jLong val = indices->e<Nd4jLong>(0);
-
-        Nd4jLong maxInd = indices->argMax();
-        if (indices->e<Nd4jLong>(maxInd) >= expected) {
-                output = val;
+        auto idx = readIndices(indices);
+        for (auto v : idx) {
+            if (v < 0 || v >= expected) {
+                output = v;
                 return false;
+            }
         }
+
         output = expected;
         return true;
     }
 
     template <typename T>
     static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
-                }
-                output->p(fi->first, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
-    }
-    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        segmentFunctor_<T, SegmentMaxOp>(input, indices, output, false, true, static_cast<T>(-DataTypeUtils::max<T>()));
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     template <typename T>
     static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+        segmentFunctor_<T, SegmentMinOp>(input, indices, output, false, true, DataTypeUtils::max<T>());
+    }
 
-        //std::sort(idxs.begin(), idxs.end());
+    template <typename T>
+    static void unsortedSegmentMeanFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentFunctor_<T, SegmentMeanOp>(input, indices, output, false, false, static_cast<T>(0));
+    }
 
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
+    template <typename T>
+    static void unsortedSegmentSumFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentFunctor_<T, SegmentSumOp>(input, indices, output, false, false, static_cast<T>(0));
+    }
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->t<T>(fi->second.at(0));
+    template <typename T>
+    static void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentFunctor_<T, SegmentProdOp>(input, indices, output, false, true, static_cast<T>(1));
+    }
 
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
-                }
-                output->t<T>(fi->first) = val;
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
-
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
+    template <typename T>
+    static void unsortedSegmentSqrtNFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        segmentFunctor_<T, SegmentSqrtNOp>(input, indices, output, false, false, static_cast<T>(0));
+    }
 
+    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
+
     void unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
-                              NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
     void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                int loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(+:sumValue)
-                for (size_t idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-
-                output->p(fi->first, sumValue / fi->second.size());
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size= input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                (*outputT) /= double(fi->second.size());
-            }
-        }
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMeanFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
 
     void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_REDUCTION(+:sumValue)
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
-                }
-                //outputT->assign(maxT);
-            }
-        }
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentSumFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
 
-    template <typename T>
-    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+    void unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
 
-        //std::sort(idxs.begin(), idxs.end());
+    void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentSqrtNFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
 
-        output->assign(1.f);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMeanFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSumFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSqrtNFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
-                }
-                output->p(fi->first, prodValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-
-                    *outputT *= *current;
-                }
-            }
-        }
-    }
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Backpropagate ops helpers
+    // -------------------------------------------------------------------------------------------------------------- //
 
-    void unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    template <typename T>
+    static int segmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted) {
+        return segmentFunctorBP_<T, SegmentMaxOp>(input, indices, gradOut, output, numOfClasses, sorted, true);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-    void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+    template <typename T>
+    static int segmentMinFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted) {
+        return segmentFunctorBP_<T, SegmentMinOp>(input, indices, gradOut, output, numOfClasses, sorted, true);
+    }
 
-        //std::sort(idxs.begin(), idxs.end());
+    template <typename T>
+    static int segmentMeanFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted) {
+        return segmentFunctorBP_<T, SegmentMeanOp>(input, indices, gradOut, output, numOfClasses, sorted, false);
+    }
 
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-
-            int loop_size =  input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
-        }
+    template <typename T>
+    static int segmentSumFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted) {
+        return segmentFunctorBP_<T, SegmentSumOp>(input, indices, gradOut, output, numOfClasses, sorted, false);
     }
 
-    // -------------------------------------------------------------------------------------------------------------- //
-    // Backpropagate ops helpers
-    // -------------------------------------------------------------------------------------------------------------- //
-    // Sorted backpropagate ops
-    //
+    template <typename T>
+    static int segmentProdFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted) {
+        return segmentFunctorBP_<T, SegmentProdOp>(input, indices, gradOut, output, numOfClasses, sorted, true);
+    }
 
-    // segment max
     template <typename T>
-    int segmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        //int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        segmentMaxFunctor_<T>(input, indices, tempRes);
-        if (input->isVector()) {
-            Nd4jLong loop_size = input->lengthOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < loop_size; ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<T>(classNum) -input->e<T>(e) <= T(1.e-6)))
-                    output->p(e, gradOut->e<T>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            int pos = 0;
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (Nd4jLong e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<T>(e) - current->e<T>(e)) <= T(1.e-6))
-                        currentOut->p(e, currentGradOut->e<T>(e));
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+    static int segmentSqrtNFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted) {
+        return segmentFunctorBP_<T, SegmentSqrtNOp>(input, indices, gradOut, output, numOfClasses, sorted, false);
     }
 
+    BUILD_SINGLE_TEMPLATE(template int segmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int segmentMinFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int segmentMeanFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int segmentSumFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int segmentProdFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int segmentSqrtNFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output, bool sorted), NUMERIC_TYPES);
+
+    // Sorted backpropagate ops
+    //
     int segmentMaxFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMaxFunctorBP_, (input, indices, gradOut, output), NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMaxFunctorBP_, (input, indices, gradOut, gradOut->sizeAt(0), output, true), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template int segmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output), NUMERIC_TYPES);
 
-    // segmen min
     int segmentMinFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        std::unique_ptr<NDArray> tempRes(gradOut->dup());
-        segmentMinFunctor(input, indices, tempRes.get());
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            output->assign(0.);
-            int pos = 0;
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<double>(e));
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMinFunctorBP_, (input, indices, gradOut, gradOut->sizeAt(0), output, true), NUMERIC_TYPES);
     }
 
-    // segmen mean
     int segmentMeanFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)] ++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            int pos = 0;
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / classCount[classNum]);
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMeanFunctorBP_, (input, indices, gradOut, gradOut->sizeAt(0), output, true), NUMERIC_TYPES);
     }
 
     int segmentSumFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-//        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(currentGradOut);
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentSumFunctorBP_, (input, indices, gradOut, gradOut->sizeAt(0), output, true), NUMERIC_TYPES);
     }
 
     int segmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        auto tempRes = gradOut->dup();
-        segmentProdFunctor(input, indices, tempRes);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) * tempRes->e<double>(classNum)/ input->e<double>(e));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                NDArray* currentFFOut = listOfBPTensors->at(classNum);
-
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentProdFunctorBP_, (input, indices, gradOut, gradOut->sizeAt(0), output, true), NUMERIC_TYPES);
     }
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Unsorted backpropagate segment ops
     // -------------------------------------------------------------------------------------------------------------- //
 
-    template <typename T>
-    static int unsortedSegmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-//        int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMaxFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<T>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<T>(e));
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
-    }
-
     int unsortedSegmentMaxFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMaxFunctorBP_, (input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
-    }
-    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    template <typename T>
-    static int unsortedSegmentMinFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMinFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->t<T>(classNum) - input->t<T>(e)) < 1.e-6)
-                    output->t<T>(e) = gradOut->t<T>(classNum);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->t<T>(e) - current->t<T>(e)) < 1.e-6)
-                        currentOut->t<T>(e) = currentGradOut->t<T>(e);
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMaxFunctorBP_, (input, indices, gradOut, numOfClasses, output, false), NUMERIC_TYPES);
     }
 
     int unsortedSegmentMinFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMinFunctorBP_, (input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMinFunctorBP_, (input, indices, gradOut, numOfClasses, output, false), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMinFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     int unsortedSegmentMeanFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(*currentGradOut / double(classCount[classNum]));
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMeanFunctorBP_, (input, indices, gradOut, numOfClasses, output, false), NUMERIC_TYPES);
     }
 
     int unsortedSegmentSumFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                //NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                currentOut->assign(currentGradOut);
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentSumFunctorBP_, (input, indices, gradOut, numOfClasses, output, false), NUMERIC_TYPES);
     }
 
     int unsortedSegmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        auto tempRes = gradOut->dup();
-
-        unsortedSegmentProdFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p<double>(e, gradOut->e<double>(classNum) * tempRes->e<double>(classNum)/ input->e<double>(e));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                auto currentFFOut = listOfBPTensors->at(classNum);
-
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentProdFunctorBP_, (input, indices, gradOut, numOfClasses, output, false), NUMERIC_TYPES);
     }
 
-//    template <typename T>
     int unsortedSegmentSqrtNFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentSqrtNFunctorBP_, (input, indices, gradOut, numOfClasses, output, false), NUMERIC_TYPES);
     }
 
 }
@@ -19,8 +19,10 @@
 //
 
 #include <ops/declarable/helpers/stack.h>
+#include <ops/declarable/helpers/transforms.h>
 #include <helpers/ShapeUtils.h>
 #include <array/ResultSet.h>
+#include <TadViews.h>
 
 
 namespace nd4j {
@@ -42,18 +44,19 @@ static void stack_(const std::vector<NDArray*>& inArrs, NDArray& outArr, const i
 	else {
 
 		std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(outArr.rankOf(), {dim});
-		auto list = outArr.allTensorsAlongDimension(dimsToExclude);		// list.size() == block.width()
-        int listSize = list->size();
+		TadViews list(outArr, dimsToExclude);		// list.size() == block.width()
+        Nd4jLong listSize = list.size();
 
         PRAGMA_OMP_PARALLEL_FOR_IF(listSize > Environment::getInstance()->tadThreshold())
-		for(int i=0; i<listSize; ++i)
-			list->at(i)->assign(inArrs[i]);
-		
-		delete list;
+		for(Nd4jLong i=0; i<listSize; ++i)
+			list.at(i).assign(inArrs[i]);
 	}
 }
 
 	void stack(const std::vector<NDArray*>& inArrs, NDArray& outArr, const int dim) {
+		if(concatDense(inArrs, outArr, dim))
+			return;
+
 		BUILD_SINGLE_SELECTOR(outArr.dataType(), stack_, (inArrs, outArr, dim), LIBND4J_TYPES);
 	}
 
@@ -22,6 +22,7 @@
 #include <ops/declarable/helpers/jacobiSVD.h>
 #include <ops/declarable/helpers/biDiagonalUp.h>
 #include <array/ResultSet.h>
+#include <TadViews.h>
 #include <NDArrayFactory.h>
 
 
@@ -960,35 +961,26 @@ static void svd_(const NDArray* x, const std::vector<NDArray*>& outArrs, const b
     const int rank =  x->rankOf();    
     const int sRank = rank - 1; 
 
-    auto listX = x->allTensorsAlongDimension({rank-2, rank-1});
-    auto listS = s->allTensorsAlongDimension({sRank-1});
-    ResultSet* listU(nullptr), *listV(nullptr);
-    
-    if(calcUV) {                
-        listU = u->allTensorsAlongDimension({rank-2, rank-1});
-        listV = v->allTensorsAlongDimension({rank-2, rank-1});
-    }
+    TadViews listX(*x, {rank-2, rank-1});
+    TadViews listS(*s, {sRank-1});
+    // u and v may be absent if calcUV is not set, then lists below are empty and never used
+    const std::vector<int> dimsUV = calcUV ? std::vector<int>({rank-2, rank-1}) : std::vector<int>();
+    TadViews listU(calcUV ? *u : *x, dimsUV);
+    TadViews listV(calcUV ? *v : *x, dimsUV);
 
-    for(int i = 0; i < listX->size(); ++i) {
+    for(Nd4jLong i = 0; i < listX.size(); ++i) {
         
         // NDArray<T> matrix(x->ordering(), {listX->at(i)->sizeAt(0), listX->at(i)->sizeAt(1)}, block.getWorkspace());
         // matrix.assign(listX->at(i));
-        helpers::SVD<T> svdObj(*(listX->at(i)), switchNum, calcUV, calcUV, fullUV);
-        listS->at(i)->assign(svdObj._s);
+        auto matrix = listX.at(i);
+        helpers::SVD<T> svdObj(matrix, switchNum, calcUV, calcUV, fullUV);
+        listS.at(i).assign(svdObj._s);
 
         if(calcUV) {
-            listU->at(i)->assign(svdObj._u);
-            listV->at(i)->assign(svdObj._v);
+            listU.at(i).assign(svdObj._u);
+            listV.at(i).assign(svdObj._v);
         }        
     }
-
-    delete listX;
-    delete listS;
-    
-    if(calcUV) {
-        delete listU;
-        delete listV;
-    }
 }
 
     void svd(const NDArray* x, const std::vector<NDArray*>& outArrs, const bool fullUV, const bool calcUV, const int switchNum) {
@@ -21,6 +21,7 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <NDArrayFactory.h>
+#include <NDArrayAccessor.h>
 
 namespace nd4j {
 namespace ops {
@@ -49,14 +50,15 @@ namespace helpers {
             if (k == 1) {
                 for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
                     auto trial = (*input)(e, dimsToExclude);
+                    NDArrayAccessor<const T, 1> row(trial);
                     //int maxPos = //lastDimList->at(e)->argMax();
                     Nd4jLong maxPos = 0;
                     //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
+                    T maxVal = row[0];
+                    for (Nd4jLong pos = 1; pos < row.lengthOf(); pos++)
+                        if (maxVal < row[pos]) {
                             maxPos = pos;
-                            maxVal = trial.e<T>(pos);
+                            maxVal = row[pos];
                         }
                     if (indeces)
                         indeces->p(e, maxPos); //topIndex;
@@ -69,35 +71,35 @@ namespace helpers {
 
                 for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
                     auto trial = (*input)(e, dimsToExclude);
+                    NDArrayAccessor<const T, 1> row(trial);
 
                     // fill up the first k elements
                     NDArray topValues = NDArrayFactory::create<T>('c', {k});
                     NDArray sortedVals = NDArrayFactory::create<T>('c', {k});
                     NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k});
+                    T* top = topValues.bufferAsT<T>();
+                    T* sorted = sortedVals.bufferAsT<T>();
+                    Nd4jLong* topIdx = topIndices.bufferAsT<Nd4jLong>();
                     for (Nd4jLong pos = 0; pos < k; ++pos) {
-                        topIndices.t<Nd4jLong>(pos) = pos;
-                        topValues.t<T>(pos) = trial.t<T>(pos);
+                        topIdx[pos] = pos;
+                        top[pos] = row[pos];
                     }
                     //std::vector<T> sortedVals(topValues);
                     sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
                     //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
                     SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
                     for (int i = k; i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
+                        T val = row[i];
+                        T minTopVal = sorted[0];
                         if (minTopVal < val) { // value should be inserted to top k
                             // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
+                            bool exists = std::binary_search(sorted, sorted + k, val);
                             if (!exists) {
                                 //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.t<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.t<Nd4jLong>(exchangePos) = i;
-                                sortedVals.t<T>(0) = val; // suppress in sorted
+                                auto exchangePos = std::distance(top, std::find(top, top + k, sorted[0]));
+                                top[exchangePos] = val; //*exchangeIt = val;
+                                topIdx[exchangePos] = i;
+                                sorted[0] = val; // suppress in sorted
                                 //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
                                 SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
                             }
@@ -106,16 +108,18 @@ namespace helpers {
                     if (needSort) {
                         SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
 
-                        for (int j = 0; j < width; j++)
+                        for (int j = 0; j < width; j++) {
+                            const T val = row[j];
                             for (int pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.t<Nd4jLong>(pos) = j;
+                                if (top[pos] == val)
+                                    topIdx[pos] = j;
+                        }
                     }
                     else { // else sort by indices
                         std::map<Nd4jLong, T> sortValsMap;
                         //std::vector<std::pair<int, T>> data(topValues.lengthOf());
                         for (size_t e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
+                            sortValsMap[topIdx[e]] = top[e];
                         }
 
                         //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
@@ -123,8 +127,8 @@ namespace helpers {
                         //});
                         Nd4jLong e = 0;
                         for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.t<Nd4jLong>(e) = it->first;
-                            topValues.t<T>(e) = it->second;
+                            topIdx[e] = it->first;
+                            top[e] = it->second;
                         }
 
                     }
@@ -151,12 +155,14 @@ namespace helpers {
             int status = topKFunctor(input, values, indices.get(), k, true);
 
             if (status == ND4J_STATUS_OK) {
+                NDArrayAccessor<const Nd4jLong> topIndices(*indices);
                 bool condition = target->lengthOf() > Environment::getInstance()->tadThreshold();
                 PRAGMA_OMP_PARALLEL_FOR_IF(condition)
                 for (int e = 0; e < target->lengthOf(); e++) {
                     bool found = false;
+                    const Nd4jLong expected = target->e<Nd4jLong>(e);
                     for (int j = 0; j < k; j++) {
-                        if (target->e<Nd4jLong>(e) == indices->e<Nd4jLong>(e * k + j)) {
+                        if (expected == topIndices[e * k + j]) {
                             found = true;
                             break;
                         }
@@ -27,6 +27,8 @@
 #include <helpers/TAD.h>
 #include <helpers/ConstantTadHelper.h>
 #include <Loops.h>
+#include <NDArrayAccessor.h>
+#include <TadViews.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -53,17 +55,15 @@ void triu(const NDArray& input, NDArray& output, const int diagonal) {
             break;
 
         default: 
-            auto inTads  = input.allTensorsAlongDimension({rank-2, rank-1});
-            auto outTads = output.allTensorsAlongDimension({rank-2, rank-1});
-
-            for(int i = 0; i < inTads->size(); ++i) {
-                auto inSubArr = inTads->at(i);
-                auto outSubArr = outTads->at(i);
-                outSubArr->assign(inSubArr);
-                outSubArr->setValueInDiagMatrix(0., diagonal-1, 'l');
+            TadViews inTads(input, {rank-2, rank-1});
+            TadViews outTads(output, {rank-2, rank-1});
+
+            for(Nd4jLong i = 0; i < inTads.size(); ++i) {
+                auto inSubArr = inTads.at(i);
+                auto outSubArr = outTads.at(i);
+                outSubArr.assign(inSubArr);
+                outSubArr.setValueInDiagMatrix(0., diagonal-1, 'l');
             }
-            delete inTads;
-            delete outTads;
     }
 }
 
@@ -99,13 +99,11 @@ static void trace_(const NDArray& input, NDArray& output) {
 
     const int inRank = input.rankOf();
 
-    auto setOfSubArrs = input.allTensorsAlongDimension({inRank-2, inRank-1});
+    TadViews setOfSubArrs(input, {inRank-2, inRank-1});
 
-    PRAGMA_OMP_PARALLEL_FOR_IF(setOfSubArrs->size() > Environment::getInstance()->tadThreshold())
-    for(int i = 0; i < setOfSubArrs->size(); ++i)
-        output.p(i, setOfSubArrs->at(i)->getTrace());
-
-    delete setOfSubArrs;
+    PRAGMA_OMP_PARALLEL_FOR_IF(setOfSubArrs.size() > Environment::getInstance()->tadThreshold())
+    for(Nd4jLong i = 0; i < setOfSubArrs.size(); ++i)
+        output.p(i, setOfSubArrs.at(i).getTrace());
 }
 
     void trace(const NDArray& input, NDArray& output) {
@@ -163,7 +161,7 @@ void randomShuffle_(NDArray& input, NDArray& output, nd4j::random::RandomBuffer&
             
         // evaluate sub-arrays list of input array through all dimensions excluding first one
         std::vector<int> dimensions = ShapeUtils::evalDimsToExclude(input.rankOf(), {0});
-        auto subArrsListIn = input.allTensorsAlongDimension(dimensions);
+        TadViews subArrsListIn(input, dimensions);
 
         // apply Fisher-Yates shuffle
         if(isInplace) {
@@ -172,32 +170,31 @@ void randomShuffle_(NDArray& input, NDArray& output, nd4j::random::RandomBuffer&
                 int r = rng.nextInt(0, i);
                 if(i == r)
                     continue;
-                subArrsListIn->at(i)->swapUnsafe(*subArrsListIn->at(r));
+                auto subArrR = subArrsListIn.at(r);
+                subArrsListIn.at(i).swapUnsafe(subArrR);
             }        
         }
         else {
             // evaluate sub-arrays list of output array through all dimensions excluding first one        
-            auto subArrsListOut = output.allTensorsAlongDimension(dimensions);
+            TadViews subArrsListOut(output, dimensions);
             std::vector<int> indices(firstDim);        
             std::iota(indices.begin(), indices.end(), 0);        
             bool isZeroShuffled = false;
             PRAGMA_OMP_PARALLEL_FOR_IF((firstDim-1) > Environment::getInstance()->tadThreshold())
             for(int i = firstDim-1; i > 0; --i) {
                 int r = rng.nextInt(0, i);
-                subArrsListOut->at(i)->assign(subArrsListIn->at(indices[r]));
+                subArrsListOut.at(i).assign(subArrsListIn.at(indices[r]));
                 if(r == 0)
                     isZeroShuffled = true;
                 if(i == r)
                     continue;
-                subArrsListOut->at(r)->assign(subArrsListIn->at(indices[i]));
+                subArrsListOut.at(r).assign(subArrsListIn.at(indices[i]));
                 math::nd4j_swap<int>(indices[i], indices[r]);
             }           
             if(!isZeroShuffled)
-                subArrsListOut->at(0)->assign(subArrsListIn->at(0));
-            delete subArrsListOut;
+                subArrsListOut.at(0).assign(subArrsListIn.at(0));
         }
         rng.rewindH(firstDim-1);
-        delete subArrsListIn;
     }
 
 }
@@ -532,12 +529,12 @@ static void gatherND_(NDArray& input, NDArray& indices, NDArray& output) {
     
     std::vector<int> tadDims(rankIn - lastIndDim);
     std::iota(tadDims.begin(), tadDims.end(), rankInd-1);
-    auto innerMostOut = output.allTensorsAlongDimension(tadDims);
+    TadViews innerMostOut(output, tadDims);
 
-    auto innerMostInd = indices.allTensorsAlongDimension({rankInd-1});
+    TadViews innerMostInd(indices, {rankInd-1});
     
     std::iota(tadDims.begin(), tadDims.end(), lastIndDim);
-    auto innerMostIn = input.allTensorsAlongDimension(tadDims);
+    TadViews innerMostIn(input, tadDims);
 
     Nd4jLong* outerShapeInfo = nullptr;
     ALLOCATE(outerShapeInfo, input.getWorkspace(), shape::shapeInfoLength(lastIndDim), Nd4jLong);
@@ -548,29 +545,26 @@ static void gatherND_(NDArray& input, NDArray& indices, NDArray& output) {
 
     Nd4jLong idx[MAX_RANK];
 
-    for(int i = 0; i < innerMostInd->size(); ++i) {
+    for(Nd4jLong i = 0; i < innerMostInd.size(); ++i) {
                 
-        auto idxSubArr = innerMostInd->at(i);
+        auto idxSubArr = innerMostInd.at(i);
         
         for(int j = 0; j < lastIndDim; ++j) {
-            if(idxSubArr->e<Nd4jLong>(j) >= input.sizeAt(j))
+            if(idxSubArr.e<Nd4jLong>(j) >= input.sizeAt(j))
                 throw std::runtime_error("helpers::gatherND function: indices array contains wrong elements, each element must be smaller than corresponding dimension of input array !");
-            idx[j] = idxSubArr->e<Nd4jLong>(j);
+            idx[j] = idxSubArr.e<Nd4jLong>(j);
         }
                 
         auto currentInd0 = shape::getOffset(0, shape::shapeOf(outerShapeInfo), shape::stride(outerShapeInfo), idx, lastIndDim);
 
         if(rankIn != lastIndDim) {
-            auto outSubArr = innerMostOut->at(i);
-            outSubArr->assign(innerMostIn->at(currentInd0));
+            auto outSubArr = innerMostOut.at(i);
+            outSubArr.assign(innerMostIn.at(currentInd0));
         }
         else
             output.p(i, input.e<T>(currentInd0));
     }
 
-    delete innerMostInd;
-    delete innerMostIn;
-    delete innerMostOut;
     RELEASE(outerShapeInfo, input.getWorkspace());    
 }
 
@@ -664,13 +658,11 @@ static void gather_(NDArray* input, const NDArray* indices, NDArray* output, con
 void eye(NDArray& output) {
 
     const int rank = output.rankOf();
-    auto arrs = output.allTensorsAlongDimension({rank-2, rank-1});
+    TadViews arrs(output, {rank-2, rank-1});
 
-    PRAGMA_OMP_PARALLEL_FOR_IF(arrs->size() > Environment::getInstance()->tadThreshold())
-    for(int i = 0; i < arrs->size(); ++i)
-        arrs->at(i)->setIdentity();
-    
-    delete arrs;
+    PRAGMA_OMP_PARALLEL_FOR_IF(arrs.size() > Environment::getInstance()->tadThreshold())
+    for(Nd4jLong i = 0; i < arrs.size(); ++i)
+        arrs.at(i).setIdentity();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -752,6 +744,27 @@ void scatterSimple(const int opId, NDArray& input, const NDArray& updates, const
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// typed accessors of merge inputs, inputs of other data types are cast to T first and kept in casts
+template<typename T>
+static std::vector<NDArrayAccessor<const T>> mergeInputs_(const std::vector<NDArray*>& inArrs, std::vector<std::unique_ptr<NDArray>>& casts) {
+
+    std::vector<NDArrayAccessor<const T>> result;
+    result.reserve(inArrs.size());
+
+    for (auto array : inArrs) {
+        if (array->dataType() == DataTypeUtils::fromT<T>()) {
+            result.emplace_back(*array);
+        }
+        else {
+            casts.emplace_back(array->cast(DataTypeUtils::fromT<T>()));
+            result.emplace_back(*casts.back());
+        }
+    }
+
+    return result;
+}
+
 //////////////////////////////////////////////////////////////////////////
 template<typename T>
 static void mergeMaxIndex_(const std::vector<NDArray*>& inArrs, NDArray& output) {
@@ -759,6 +772,9 @@ static void mergeMaxIndex_(const std::vector<NDArray*>& inArrs, NDArray& output)
     const Nd4jLong numArgs = inArrs.size();
     auto x = inArrs[0];
 
+    std::vector<std::unique_ptr<NDArray>> casts;
+    auto in = mergeInputs_<T>(inArrs, casts);
+
     PRAGMA_OMP_PARALLEL_FOR_IF(x->lengthOf() > Environment::getInstance()->elementwiseThreshold())
     for (Nd4jLong e = 0; e < x->lengthOf(); e++) {
         T max = -DataTypeUtils::max<T>();
@@ -766,7 +782,7 @@ static void mergeMaxIndex_(const std::vector<NDArray*>& inArrs, NDArray& output)
             
         for (int i = 0; i < numArgs; i++){
             
-            T v = inArrs[i]->e<T>(e);
+            T v = in[i][e];
             if (v > max) {
                 max = v;
                 idx = i;
@@ -788,15 +804,19 @@ static void mergeMax_(const std::vector<NDArray*>& inArrs, NDArray& output) {
     const Nd4jLong numArgs = inArrs.size();
     auto x = inArrs[0];
 
+    std::vector<std::unique_ptr<NDArray>> casts;
+    auto in = mergeInputs_<T>(inArrs, casts);
+    NDArrayAccessor<T> z(output);
+
     PRAGMA_OMP_PARALLEL_FOR_IF(x->lengthOf() > Environment::getInstance()->elementwiseThreshold())
      for (Nd4jLong e = 0; e < x->lengthOf(); e++) {
         T max = -DataTypeUtils::max<T>();
         for (int i = 0; i < numArgs; i++) {
-            T v = inArrs[i]->e<T>(e);
+            T v = in[i][e];
             if (v > max)
                 max = v;
         }
-        output.p(e, max);
+        z[e] = max;
     }
 }
     void mergeMax(const std::vector<NDArray*>& inArrs, NDArray& output) {
@@ -813,14 +833,18 @@ static void mergeAvg_(const std::vector<NDArray*>& inArrs, NDArray& output) {
     const T factor = 1.f / numArgs;
     auto x = inArrs[0];
 
+    std::vector<std::unique_ptr<NDArray>> casts;
+    auto in = mergeInputs_<T>(inArrs, casts);
+    NDArrayAccessor<T> z(output);
+
     PRAGMA_OMP_PARALLEL_FOR_IF(x->lengthOf() > Environment::getInstance()->elementwiseThreshold())
     for (Nd4jLong e = 0; e < x->lengthOf(); e++) {
         T sum = 0.;
         for (int i = 0; i < numArgs; i++) { 
-            T v = inArrs[i]->e<T>(e);
+            T v = in[i][e];
             sum += v;
         }
-        output.p<T>(e, sum * factor);
+        z[e] = sum * factor;
     }
 }
     void mergeAvg(const std::vector<NDArray*>& inArrs, NDArray& output) {
@@ -836,15 +860,19 @@ static void mergeAdd_(const std::vector<NDArray*>& inArrs, NDArray& output) {
     const Nd4jLong numArgs = inArrs.size();
     auto x = inArrs[0];
 
+    std::vector<std::unique_ptr<NDArray>> casts;
+    auto in = mergeInputs_<T>(inArrs, casts);
+    NDArrayAccessor<T> z(output);
+
     PRAGMA_OMP_PARALLEL_FOR_IF(x->lengthOf() > Environment::getInstance()->elementwiseThreshold())
     for (Nd4jLong e = 0; e < x->lengthOf(); e++) {
         
         T sum = (T) 0.f;
         
         for (int i = 0; i < numArgs; i++) 
-            sum += inArrs[i]->e<T>(e);
+            sum += in[i][e];
 
-        output.p(e, sum);
+        z[e] = sum;
     }
 }
     void mergeAdd(const std::vector<NDArray*>& inArrs, NDArray& output) {
@@ -1048,17 +1076,16 @@ static void clipByAveraged_(NDArray& input, NDArray& output, const std::vector<i
         auto norm2 = input.reduceAlongDims(reduce::Norm2, dimensions, false);
         if (!isInplace)
                 output.assign(input);
-        auto tads = output.allTensorsAlongDimension(dimensions);
+        TadViews tads(output, dimensions);
         // TODO: make this CUDA-compliant somehow
-        for (int e = 0; e < tads->size(); e++) {
-            T n2 = norm2.e<T>(e) / tads->at(e)->lengthOf();
+        for (Nd4jLong e = 0; e < tads.size(); e++) {
+            T n2 = norm2.e<T>(e) / tads.tadLength();
             const T factor = cn / n2;
             if (n2 > cn) {
                 auto lambda = LAMBDA_T(_x, factor) {return _x * factor;};
-                tads->at(e)->applyLambda<T>(lambda, &output);
+                tads.at(e).applyLambda<T>(lambda, &output);
             }
         }
-        delete tads;
     }
 }
 
@@ -1160,6 +1187,102 @@ static void mirrorPad_(const NDArray& input, const NDArray& paddings, NDArray& o
 
     BUILD_SINGLE_TEMPLATE(template void mirrorPad_, (const NDArray& input, const NDArray& paddings, NDArray& output, const int mode), LIBND4J_TYPES);
 
+//////////////////////////////////////////////////////////////////////////
+// contiguous pieces larger than this are copied by several threads
+static const Nd4jLong kChunkCopyBytes = 1 << 18;
+static const Nd4jLong kMinChunkBytes = 64;
+
+static FORCEINLINE bool isDenseChunkable(const NDArray* arr, const NDArray& whole) {
+    return arr->ordering() == 'c' && arr->ews() == 1 && !arr->isEmpty() && !arr->isS() && arr->dataType() == whole.dataType();
+}
+
+// whole is [outer, sum of part lengths], parts[i] holds its piece of lengthOf() / outer elements for every outer index
+// toWhole == true: parts are gathered into whole (concat), otherwise whole is scattered into parts (split)
+static bool copyChunks(const NDArray& whole, const std::vector<NDArray*>& parts, const int axis, const bool toWhole) {
+
+    if(!isDenseChunkable(&whole, whole) || axis < 0 || axis >= whole.rankOf())
+        return false;
+
+    Nd4jLong outer = 1;
+    for(int i = 0; i < axis; ++i)
+        outer *= whole.sizeAt(i);
+
+    const Nd4jLong sizeOfT = whole.sizeOfT();
+    const int numParts = parts.size();
+    std::vector<int8_t*> partBuffs(numParts);
+    std::vector<Nd4jLong> partBytes(numParts), partShifts(numParts);
+    Nd4jLong rowBytes = 0;
+
+    for(int i = 0; i < numParts; ++i) {
+        if(!isDenseChunkable(parts[i], whole) || parts[i]->lengthOf() % outer != 0)
+            return false;
+        partBuffs[i]  = reinterpret_cast<int8_t*>(parts[i]->getBuffer());
+        partBytes[i]  = parts[i]->lengthOf() / outer * sizeOfT;
+        partShifts[i] = rowBytes;
+        rowBytes += partBytes[i];
+    }
+
+    if(rowBytes * outer != whole.lengthOf() * sizeOfT)
+        return false;
+
+    // memcpy per couple of elements is slower than strided typed loops of callers
+    if(outer > 1 && *std::min_element(partBytes.begin(), partBytes.end()) < kMinChunkBytes)
+        return false;
+
+    int8_t* wholeBuff = reinterpret_cast<int8_t*>(whole.getBuffer());
+    const bool parallel = whole.lengthOf() > Environment::getInstance()->elementwiseThreshold();
+
+    if(outer > 1) {
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallel)
+        for(Nd4jLong o = 0; o < outer; ++o) {
+            for(int i = 0; i < numParts; ++i) {
+                int8_t* w = wholeBuff + o * rowBytes + partShifts[i];
+                int8_t* p = partBuffs[i] + o * partBytes[i];
+                if(w == p)
+                    continue;
+                if(toWhole)
+                    memcpy(w, p, partBytes[i]);
+                else
+                    memcpy(p, w, partBytes[i]);
+            }
+        }
+        return true;
+    }
+
+    // single row: big pieces are cut into blocks, so that few large inputs still keep all threads busy
+    std::vector<std::pair<int, Nd4jLong>> blocks;
+    for(int i = 0; i < numParts; ++i) {
+        if(wholeBuff + partShifts[i] == partBuffs[i])
+            continue;       // part is a view into whole already, nothing to copy
+        for(Nd4jLong b = 0; b < partBytes[i]; b += kChunkCopyBytes)
+            blocks.emplace_back(i, b);
+    }
+
+    const Nd4jLong numBlocks = blocks.size();
+    PRAGMA_OMP_PARALLEL_FOR_IF(parallel && numBlocks > 1)
+    for(Nd4jLong b = 0; b < numBlocks; ++b) {
+        const int i = blocks[b].first;
+        const Nd4jLong start = blocks[b].second;
+        const Nd4jLong bytes = nd4j::math::nd4j_min<Nd4jLong>(kChunkCopyBytes, partBytes[i] - start);
+        int8_t* w = wholeBuff + partShifts[i] + start;
+        int8_t* p = partBuffs[i] + start;
+        if(toWhole)
+            memcpy(w, p, bytes);
+        else
+            memcpy(p, w, bytes);
+    }
+
+    return true;
+}
+
+bool concatDense(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis) {
+    return copyChunks(output, inArrs, axis, true);
+}
+
+bool splitDense(const NDArray& input, const std::vector<NDArray*>& outArrs, const int axis) {
+    return copyChunks(input, outArrs, axis, false);
+}
+
 //////////////////////////////////////////////////////////////////////////
 template<typename T>
 static void concat_(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis) {
@@ -1231,6 +1354,9 @@ static void concat_(const std::vector<NDArray*>& inArrs, NDArray& output, const
 }
 
     void concat(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis) {
+        if(concatDense(inArrs, output, axis))
+            return;
+
         BUILD_SINGLE_SELECTOR(output.dataType(), concat_,(inArrs, output, axis), LIBND4J_TYPES);
     }
 
@@ -26,8 +26,21 @@ namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    int resizeBilinearFunctor(NDArray const* image, int width, int height, bool center, NDArray* output);
-    int resizeNeighborFunctor(NDArray const* image, int width, int height, bool center, NDArray* output);
+    enum ImageResizeMethods {
+        kResizeBilinear = 0,
+        kResizeNearest,
+        kResizeBicubic,
+        kResizeArea
+    };
+
+    /**
+     * Resize functors take 4D images in NHWC layout, or NCHW if dataFormatNCHW is set.
+     * Target size is taken from preallocated output, computations are done in input data type (i.e. uint8 stays uint8).
+     */
+    int resizeBilinearFunctor(NDArray const* image, int width, int height, bool center, NDArray* output, bool dataFormatNCHW = false);
+    int resizeNeighborFunctor(NDArray const* image, int width, int height, bool center, NDArray* output, bool dataFormatNCHW = false);
+    int resizeBicubicFunctor(NDArray const* image, int width, int height, bool center, NDArray* output, bool dataFormatNCHW = false);
+    int resizeAreaFunctor(NDArray const* image, int width, int height, bool center, NDArray* output, bool dataFormatNCHW = false);
     void cropAndResizeFunctor(NDArray const* images, NDArray const* boxes, NDArray const* indices, NDArray const* cropSize, int method, double extrapolationVal, NDArray* crops);
 }
 }
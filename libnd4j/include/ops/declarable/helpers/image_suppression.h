@@ -21,12 +21,29 @@
 #define __IMAGE_SUPPRESSION_H_HELPERS__
 #include <op_boilerplate.h>
 #include <NDArray.h>
+#include <limits>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output);
+    /**
+     * Greedy NMS: output gets indices of selected boxes, in order of selection.
+     * Boxes with score not above scoreThreshold are dropped upfront. Positive softNmsSigma enables soft-NMS:
+     * boxes overlapping kept ones by no more than threshold aren't removed, but their scores decay as exp(-iou^2 / (2 * sigma)).
+     */
+    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output,
+                             double scoreThreshold = -std::numeric_limits<double>::infinity(), double softNmsSigma = 0.);
+
+    /**
+     * Batched multi-class NMS: boxes [batch, numBoxes, q, 4] with q either 1 (shared by classes) or numClasses,
+     * scores [batch, numBoxes, numClasses]. Each (batch, class) pair is suppressed independently, and best
+     * maxTotalSize detections of each batch entry are written out ordered by score, with zero padding.
+     * If clipBoxes is set, written box coordinates are clipped to [0, 1].
+     */
+    void combinedNonMaxSuppression(NDArray* boxes, NDArray* scores, int maxOutputPerClass, int maxTotalSize,
+                                   double threshold, double scoreThreshold, double softNmsSigma, bool clipBoxes,
+                                   NDArray* nmsedBoxes, NDArray* nmsedScores, NDArray* nmsedClasses, NDArray* validDetections);
 
 }
 }
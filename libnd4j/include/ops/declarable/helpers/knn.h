@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HELPERS_KNN_H
+#define LIBND4J_HELPERS_KNN_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    enum KnnMetric {
+        KNN_EUCLIDEAN = 0,
+        KNN_COSINE = 1,
+        KNN_DOT = 2,
+    };
+
+    /**
+     * Brute-force k nearest neighbors search: for every row of queries [Q, D] finds k closest rows of base [N, D].
+     * Distances are computed in tiles as ||q||^2 + ||b||^2 - 2 * q.b, with q.b block computed by gemm, and only k best
+     * candidates per query are kept in bounded heap, so full Q x N distances matrix never exists.
+     *
+     * 16-bit and integer inputs are staged through fp32 tiles.
+     *
+     * @param metric - KNN_EUCLIDEAN, KNN_COSINE (1 - cosine similarity) or KNN_DOT (dot product, the larger the better)
+     * @param distances - [Q, k] output, ordered from best to worst
+     * @param indices - [Q, k] INT64 output, row numbers within base
+     */
+    void knnTopK(NDArray* queries, NDArray* base, int k, int metric, NDArray* distances, NDArray* indices);
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_KNN_H
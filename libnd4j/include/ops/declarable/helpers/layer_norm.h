@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2019 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_LAYER_NORM_H
+#define LIBND4J_LAYER_NORM_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace nd4j    {
+namespace ops     {
+namespace helpers {
+
+    /**
+     * Returns true if layer norm over given axis can be done by fused kernels below: axis is the last dimension only,
+     * input and outputs are dense c-ordered arrays of same data type, and params are vectors of length input->sizeAt(-1)
+     */
+    bool layerNormFusable(const NDArray* input, const std::vector<int>& axis, const std::vector<const NDArray*>& arrays, const std::vector<const NDArray*>& params);
+
+    /**
+     * output = standardize(input) * gain + bias along last dimension, statistics of every row are computed in cache
+     * right before row is written, so input is read from memory once. bias may be nullptr
+     */
+    void layerNorm(const NDArray* input, const NDArray* gain, const NDArray* bias, NDArray* output);
+
+    /**
+     * Gradients of layer norm over last dimension of rank 2 input, in single pass over input and eps. dLdb may be nullptr
+     */
+    void layerNormBp(const NDArray* input, const NDArray* gain, const NDArray* eps, NDArray* dLdx, NDArray* dLdg, NDArray* dLdb);
+
+}
+}
+}
+
+
+#endif //LIBND4J_LAYER_NORM_H
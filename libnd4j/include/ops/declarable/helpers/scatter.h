@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HELPERS_SCATTER_H
+#define LIBND4J_HELPERS_SCATTER_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * This method applies updates to rows of output along first dimension: output[indices[i]] = op(output[indices[i]], updates[i]).
+     * Supported ops: Add, Subtract, Multiply, Divide, MinPairwise, MaxPairwise, CopyPws.
+     *
+     * Updates are grouped by target row first, so every output row is owned by single thread and updated
+     * without atomics, in original order of indices. If just few distinct rows are hit, commutative ops
+     * are reduced into per-thread partial rows instead.
+     *
+     * @param serial - if true, everything is done in calling thread
+     */
+    void scatter(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, bool serial);
+
+    /**
+     * Same as scatter(), but last dimension of indices holds coordinates within first indices.sizeAt(-1) dimensions of output
+     */
+    void scatterND(pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, bool serial);
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_SCATTER_H
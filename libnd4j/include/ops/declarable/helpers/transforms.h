@@ -74,6 +74,20 @@ namespace helpers {
 
 	void concat(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis);
 
+	/**
+	 * Concatenation of dense c-ordered arrays as parallel memcpy of contiguous chunks: output is viewed as [outer, inner],
+	 * outer = product of output dimensions before axis, and every input fills chunk of its lengthOf() / outer elements in each
+	 * of outer rows. Chunks which input already occupies (input is a view into output, see graph::OutputAliasing) are skipped.
+	 * Ranks of inputs may differ from rank of output by unity axis dimension, so stack goes here too.
+	 * Returns false without copying anything if some array isn't dense c-ordered or data types differ.
+	 */
+	bool concatDense(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis);
+
+	/**
+	 * Inverse of concatDense: output arrays get consecutive chunks of input along axis (split, unstack)
+	 */
+	bool splitDense(const NDArray& input, const std::vector<NDArray*>& outArrs, const int axis);
+
 	void tileBP(const NDArray& gradO /*input*/, NDArray& gradI /*output*/, const std::vector<Nd4jLong> reps);
 
 }
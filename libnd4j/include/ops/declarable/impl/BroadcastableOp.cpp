@@ -26,7 +26,8 @@
 namespace nd4j {
     namespace ops {
         BroadcastableOp::BroadcastableOp(const char *name, int numTArgs, int numIArgs) : DeclarableCustomOp::DeclarableCustomOp(2, 1, name, false, numTArgs, numIArgs) {
-            //
+            // output shape is defined by broadcasting rules alone
+            _descriptor->setShapeCacheable(true);
         }
 
         BroadcastableOp::~BroadcastableOp() {
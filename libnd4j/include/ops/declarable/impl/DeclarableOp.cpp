@@ -25,9 +25,13 @@
 #include <NDArrayFactory.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
+#include <helpers/OpTracer.h>
 
 namespace nd4j {
     namespace ops {
+        // number of distinct input signatures remembered by single op instance
+        static const size_t kShapeCacheLimit = 128;
+
         Nd4jStatus conditionHelper(const char *file, int line, int condition, int argNumber, const char *format, ...) {
             if (!condition) {
                 va_list args;
@@ -180,7 +184,51 @@ namespace nd4j {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
+                // shape function is skipped if this op has seen same input signature before.
+                // key storage is reused by calls on the same thread, so hits don't allocate
+                static thread_local std::vector<Nd4jLong> key;
+                CachedShapes cached;
+                const bool cacheable = _descriptor->isShapeCacheable();
+                if (cacheable) {
+                    key.clear();
+                    buildShapeCacheKey(ctx, inSha, key);
+
+                    _shapeCacheLock.lockRead();
+                    auto it = _shapeCache.find(key);
+                    if (it != _shapeCache.end())
+                        cached = it->second;
+                    _shapeCacheLock.unlockRead();
+                }
+
+                ShapeList* outSha = nullptr;
+                if (cached != nullptr) {
+                    // shapes are owned by cache entry, which is kept alive by local reference, so ShapeList must not release them.
+                    // output arrays copy shapeInfo, so entry is never written to
+                    outSha = new ShapeList({}, true);
+                    for (auto &shape: *cached)
+                        outSha->push_back(const_cast<Nd4jLong*>(shape.data()));
+                } else {
+                    // shape function may run other ops on this thread, and they'd reuse key storage
+                    std::vector<Nd4jLong> missedKey;
+                    if (cacheable)
+                        missedKey = key;
+
+                    outSha = this->calculateOutputShape(&inSha, ctx);
+
+                    if (cacheable) {
+                        auto shapes = std::make_shared<std::vector<std::vector<Nd4jLong>>>();
+                        for (auto out: *outSha->asVector())
+                            shapes->emplace_back(out, out + shape::shapeInfoLength(out));
+
+                        _shapeCacheLock.lockWrite();
+                        if (_shapeCache.size() >= kShapeCacheLimit)
+                            _shapeCache.clear();
+
+                        _shapeCache[missedKey] = shapes;
+                        _shapeCacheLock.unlockWrite();
+                    }
+                }
+
                 results = outSha->size();
 
                 // optionally saving shapeTime
@@ -203,6 +251,7 @@ namespace nd4j {
                                 shape::printShapeInfoLinear("Going to create variable with shape", out);
 
                             auto outArr = new NDArray(out, true, workspace);
+                            OpTracer::trackAllocation(outArr->lengthOf() * outArr->sizeOfT());
 
                             ctx.pushNDArrayToVariableSpace(pair, outArr);
                         } else {
@@ -227,6 +276,7 @@ namespace nd4j {
                         if (fout.size() <= idx) {
                             // array doesnt exist
                             auto outArr = new NDArray(out, true, workspace);
+                            OpTracer::trackAllocation(outArr->lengthOf() * outArr->sizeOfT());
                             ctx.setOutputArray(idx, outArr, true);
                         } else {
                             auto array = fout[idx];
@@ -413,9 +463,19 @@ namespace nd4j {
             if (Environment::getInstance()->isProfiling())
                 timeEnter = std::chrono::system_clock::now();
 
+            OpTraceScope traceScope(this->getOpName()->c_str(), -1);
+
             // basic validation: ensure inputs are set
             REQUIRE_OK(this->validateNonEmptyInput(*block));
 
+            if (traceScope.isActive()) {
+                for (int e = 0; e < (int) block->width() && e < TraceEvent::MAX_INPUTS; e++) {
+                    auto array = block->array(e);
+                    if (array != nullptr)
+                        traceScope.addShape(array->shapeInfo());
+                }
+            }
+
             // ensure number of IArgs, TArgs match our expectations
             REQUIRE_OK(this->validateArguments(*block));
 
@@ -816,6 +876,50 @@ namespace nd4j {
             this->getOpDescriptor()->setSameMode(true);
         }
 
+        void DeclarableOp::buildShapeCacheKey(Context& block, ShapeList& inputShapes, std::vector<Nd4jLong>& key) {
+            // every section is prefixed by its length, so different signatures never produce equal keys
+            key.emplace_back(inputShapes.size());
+            for (auto shapeInfo: *inputShapes.asVector())
+                key.insert(key.end(), shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+
+            auto iArgs = block.getIArguments();
+            key.emplace_back(iArgs->size());
+            key.insert(key.end(), iArgs->begin(), iArgs->end());
+
+            auto tArgs = block.getTArguments();
+            key.emplace_back(tArgs->size());
+            for (auto t: *tArgs) {
+                Nd4jLong bits;
+                memcpy(&bits, &t, sizeof(bits));
+                key.emplace_back(bits);
+            }
+
+            auto bArgs = block.getBArguments();
+            key.emplace_back(bArgs->size());
+            key.insert(key.end(), bArgs->begin(), bArgs->end());
+
+            auto axis = block.getAxis();
+            key.emplace_back(axis->size());
+            key.insert(key.end(), axis->begin(), axis->end());
+
+            key.emplace_back(block.width());
+            key.emplace_back(static_cast<Nd4jLong>(block.dataType()));
+        }
+
+        int DeclarableOp::shapeCacheSize() {
+            _shapeCacheLock.lockRead();
+            auto size = static_cast<int>(_shapeCache.size());
+            _shapeCacheLock.unlockRead();
+
+            return size;
+        }
+
+        void DeclarableOp::purgeShapeCache() {
+            _shapeCacheLock.lockWrite();
+            _shapeCache.clear();
+            _shapeCacheLock.unlockWrite();
+        }
+
         /*
         template <typename T>
         int* nd4j::ops::DeclarableOp::calculateOutputShape(int* inputShape, nd4j::graph::Block& block) {
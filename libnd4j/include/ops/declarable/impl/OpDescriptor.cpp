@@ -143,6 +143,10 @@ namespace nd4j {
             return _allowsInplace;
         }
 
+        bool OpDescriptor::isShapeCacheable() {
+            return _shapeCacheable;
+        }
+
         int OpDescriptor::getOpNum() {
             return _opNum;
         }
@@ -193,6 +197,11 @@ namespace nd4j {
             return this;
         }
 
+        OpDescriptor* OpDescriptor::setShapeCacheable(const bool reallyCacheable) {
+            _shapeCacheable = reallyCacheable;
+            return this;
+        }
+
         OpDescriptor* OpDescriptor::setAllowedInputTypes(int index, const std::vector<nd4j::DataType> &dtype) {
             _inputTypes[index] = dtype;
             return this;
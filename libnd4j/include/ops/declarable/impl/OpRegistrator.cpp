@@ -60,8 +60,11 @@ namespace nd4j {
 
 
         void OpRegistrator::updateMSVC(Nd4jLong newHash, std::string& oldName) {
+            std::lock_guard<std::mutex> lock(_locker);
+
             std::pair<Nd4jLong, std::string> pair(newHash, oldName);
             _msvc.insert(pair);
+            _table.store(nullptr, std::memory_order_release);
         }
 
         template <typename T>
@@ -118,6 +121,12 @@ namespace nd4j {
             _declarablesD.clear();
 
             _declarablesLD.clear();
+
+            _table.store(nullptr);
+            for (auto t : _tables)
+                delete t;
+
+            _tables.clear();
 #endif
         }
 
@@ -146,12 +155,18 @@ namespace nd4j {
         }
         bool OpRegistrator::registerOperation(const char* name, nd4j::ops::DeclarableOp* op) {
             std::string str(name);
+            auto hash = nd4j::ops::HashHelper::getInstance()->getLongHash(str);
+
+            std::lock_guard<std::mutex> lock(_locker);
+
             std::pair<std::string, nd4j::ops::DeclarableOp*> pair(str, op);
             _declarablesD.insert(pair);
 
-            auto hash = nd4j::ops::HashHelper::getInstance()->getLongHash(str);
             std::pair<Nd4jLong, nd4j::ops::DeclarableOp*> pair2(hash, op);
             _declarablesLD.insert(pair2);
+
+            // lookup table will be rebuilt on next request
+            _table.store(nullptr, std::memory_order_release);
             return true;
         }
 
@@ -177,25 +192,78 @@ namespace nd4j {
          * @return
          */
         nd4j::ops::DeclarableOp *OpRegistrator::getOperation(Nd4jLong hash) {
-            if (!_declarablesLD.count(hash)) {
-                if (!_msvc.count(hash)) {
-                    nd4j_printf("Unknown D operation requested by hash: [%lld]\n", hash);
-                    return nullptr;
-                } else {
-                    _locker.lock();
+            auto table = _table.load(std::memory_order_acquire);
+            if (table == nullptr)
+                table = freeze();
 
-                    auto str = _msvc.at(hash);
-                    auto op = _declarablesD.at(str);
-                    auto oHash = op->getOpDescriptor()->getHash();
+            auto op = findOp(table, hash);
+            if (op == nullptr)
+                nd4j_printf("Unknown D operation requested by hash: [%lld]\n", hash);
 
-                    std::pair<Nd4jLong, nd4j::ops::DeclarableOp*> pair(oHash, op);
-                    _declarablesLD.insert(pair);
+            return op;
+        }
 
-                    _locker.unlock();
-                }
+        static FORCEINLINE uint64_t slotIndex(Nd4jLong hash, uint64_t mask) {
+            auto h = static_cast<uint64_t>(hash);
+            return (h ^ (h >> 29) ^ (h >> 47)) & mask;
+        }
+
+        void OpRegistrator::insertOp(OpTable* table, Nd4jLong hash, nd4j::ops::DeclarableOp* op) {
+            auto idx = slotIndex(hash, table->mask);
+            while (table->slots[idx].op != nullptr) {
+                if (table->slots[idx].hash == hash)
+                    return;
+
+                idx = (idx + 1) & table->mask;
+            }
+
+            table->slots[idx].hash = hash;
+            table->slots[idx].op = op;
+        }
+
+        nd4j::ops::DeclarableOp* OpRegistrator::findOp(const OpTable* table, Nd4jLong hash) {
+            // table is never full, so every probe sequence ends at empty slot
+            auto idx = slotIndex(hash, table->mask);
+            while (table->slots[idx].op != nullptr) {
+                if (table->slots[idx].hash == hash)
+                    return table->slots[idx].op;
+
+                idx = (idx + 1) & table->mask;
+            }
+
+            return nullptr;
+        }
+
+        OpRegistrator::OpTable* OpRegistrator::freeze() {
+            std::lock_guard<std::mutex> lock(_locker);
+
+            // somebody else could have built it while we were waiting
+            auto table = _table.load(std::memory_order_acquire);
+            if (table != nullptr)
+                return table;
+
+            uint64_t capacity = 16;
+            while (capacity < 2 * (_declarablesLD.size() + _msvc.size()))
+                capacity <<= 1;
+
+            table = new OpTable();
+            table->slots.assign(capacity, {0, nullptr});
+            table->mask = capacity - 1;
+
+            for (auto &v : _declarablesLD)
+                insertOp(table, v.first, v.second);
+
+            // MSVC doesn't register synonyms statically, so they are resolved by name of original op here
+            for (auto &v : _msvc) {
+                auto op = _declarablesD.find(v.second);
+                if (op != _declarablesD.end())
+                    insertOp(table, v.first, op->second);
             }
 
-            return _declarablesLD.at(hash);
+            _tables.emplace_back(table);
+            _table.store(table, std::memory_order_release);
+
+            return table;
         }
 
         nd4j::ops::DeclarableOp *OpRegistrator::getOperation(std::string& name) {
@@ -122,13 +122,14 @@
     }
 
     local_def void assign(float rhs) {
-#ifdef __CUDACC__
-      if(::isnan(rhs)) {
-          _data = bfloat16::nan();
+      auto x = *reinterpret_cast<int32_t*>(&rhs);
+
+      // rounding would turn NaN into infinity or zero
+      if((x & 0x7fffffff) > 0x7f800000) {
+          _data = bfloat16::nan()._data;
           return;
       }
-#endif
-      auto x = *reinterpret_cast<int32_t*>(&rhs);
+
       uint32_t lsb = (x >> 16) & 1;
       uint32_t rounding_bias = 0x7fff + lsb;
       x += rounding_bias;
@@ -0,0 +1,309 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include "PerformanceSuite.h"
+#include <NDArrayFactory.h>
+#include <helpers/RandomLauncher.h>
+#include <ops/declarable/CustomOperations.h>
+#include <stdexcept>
+#include <memory>
+
+namespace nd4j {
+
+    static NDArray* randomArray(char order, const std::vector<Nd4jLong> &shape, nd4j::DataType dataType, Nd4jLong seed = 119) {
+        auto array = NDArrayFactory::create_(order, shape, dataType);
+        nd4j::graph::RandomGenerator rng(seed, seed);
+        RandomLauncher::fillUniform(rng, array, -1.0, 1.0);
+        return array;
+    }
+
+    static NDArray* randomIndices(Nd4jLong length, int maxValue, Nd4jLong seed = 119) {
+        // simple LCG is enough here, we only need reproducible spread of indices
+        std::vector<int> values(length);
+        uint64_t state = static_cast<uint64_t>(seed);
+        for (Nd4jLong e = 0; e < length; e++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            values[e] = static_cast<int>((state >> 33) % maxValue);
+        }
+
+        return NDArrayFactory::create_<int>('c', {length}, values);
+    }
+
+    static NDArray* scalarArray(nd4j::DataType dataType) {
+        return new NDArray(NDArrayFactory::create(dataType));
+    }
+
+    static std::string suffix(nd4j::DataType dataType) {
+        return "_" + DataTypeUtils::asString(dataType);
+    }
+
+    PerformanceSuite::PerformanceSuite(BenchmarkHelper &helper, std::vector<nd4j::DataType> dataTypes, bool quick) : _helper(helper) {
+        _dataTypes = dataTypes;
+        _quick = quick;
+    }
+
+    std::vector<std::string> PerformanceSuite::suites() {
+        return {"gemm", "conv", "reduce", "broadcast", "rnn", "sort", "gather_scatter"};
+    }
+
+    void PerformanceSuite::run(OpBenchmark &benchmark) {
+        std::vector<OpBenchmark*> list = {&benchmark};
+        _helper.runOperationSuit(list, false);
+    }
+
+    void PerformanceSuite::runSuite(const std::string &name) {
+        if (name == "gemm")
+            runGemmSuite();
+        else if (name == "conv")
+            runConvolutionSuite();
+        else if (name == "reduce")
+            runReductionSuite();
+        else if (name == "broadcast")
+            runBroadcastSuite();
+        else if (name == "rnn")
+            runRnnSuite();
+        else if (name == "sort")
+            runSortSuite();
+        else if (name == "gather_scatter")
+            runGatherScatterSuite();
+        else
+            throw std::invalid_argument("PerformanceSuite: unknown suite [" + name + "]");
+    }
+
+    void PerformanceSuite::runGemmSuite() {
+        // M, K, N: square, skinny activations x weights, and matrix-vector like shapes
+        std::vector<std::vector<Nd4jLong>> shapes = {{256, 256, 256}, {32, 1024, 1024}, {128, 512, 2048}, {1, 4096, 4096}, {1024, 1024, 1024}, {2048, 2048, 2048}};
+        if (_quick)
+            shapes.resize(2);
+
+        for (auto dt : _dataTypes) {
+            for (const auto &s : shapes) {
+                for (auto order : {'c', 'f'}) {
+                    std::string name = std::string("gemm_") + order + suffix(dt);
+                    MatrixBenchmark mb(1.0f, 0.0f, name, randomArray(order, {s[0], s[1]}, dt), randomArray(order, {s[1], s[2]}, dt), NDArrayFactory::create_(order, {s[0], s[2]}, dt));
+                    run(mb);
+                }
+            }
+        }
+    }
+
+    void PerformanceSuite::runConvolutionSuite() {
+        // bS, iC, iH, iW, oC, k, s
+        std::vector<std::vector<int>> configs = {{8, 64, 56, 56, 64, 3, 1}, {8, 3, 224, 224, 64, 7, 2}, {8, 128, 28, 28, 128, 3, 1}, {8, 256, 14, 14, 256, 1, 1}};
+        if (_quick)
+            configs.resize(1);
+
+        nd4j::ops::conv2d op;
+
+        for (auto dt : _dataTypes) {
+            for (const auto &c : configs) {
+                for (int isNHWC = 0; isNHWC < 2; isNHWC++) {
+                    const int bS = c[0], iC = c[1], iH = c[2], iW = c[3], oC = c[4], k = c[5], s = c[6];
+                    const int oH = (iH + s - 1) / s, oW = (iW + s - 1) / s;
+
+                    auto ctx = new Context(1);
+                    if (isNHWC) {
+                        ctx->setInputArray(0, randomArray('c', {bS, iH, iW, iC}, dt), true);
+                        ctx->setOutputArray(0, NDArrayFactory::create_('c', {bS, oH, oW, oC}, dt), true);
+                    } else {
+                        ctx->setInputArray(0, randomArray('c', {bS, iC, iH, iW}, dt), true);
+                        ctx->setOutputArray(0, NDArrayFactory::create_('c', {bS, oC, oH, oW}, dt), true);
+                    }
+                    ctx->setInputArray(1, randomArray('c', {k, k, iC, oC}, dt), true);
+                    ctx->setInputArray(2, randomArray('c', {oC}, dt), true);
+
+                    // kH, kW, sH, sW, pH, pW, dH, dW, SAME, data format
+                    std::vector<Nd4jLong> iArgs = {k, k, s, s, 0, 0, 1, 1, 1, isNHWC};
+                    ctx->setIArguments(iArgs.data(), iArgs.size());
+
+                    DeclarableBenchmark db(op, std::string(isNHWC ? "conv2d_nhwc" : "conv2d_nchw") + suffix(dt), ctx);
+                    db.setFlops(2.0 * bS * oC * oH * oW * iC * k * k);
+                    run(db);
+                }
+            }
+        }
+    }
+
+    void PerformanceSuite::runReductionSuite() {
+        std::vector<std::vector<Nd4jLong>> shapes = {{64, 256, 512}, {4096, 4096}, {1048576}};
+        if (_quick)
+            shapes.resize(1);
+
+        for (auto dt : _dataTypes) {
+            for (const auto &s : shapes) {
+                // whole array reduction first, and then reduction along every single axis
+                for (int axis = -1; axis < (int) s.size(); axis++) {
+                    if (axis >= 0 && s.size() == 1)
+                        break;
+
+                    std::vector<Nd4jLong> zShape;
+                    for (int e = 0; e < (int) s.size(); e++)
+                        if (axis >= 0 && e != axis)
+                            zShape.emplace_back(s[e]);
+
+                    std::vector<int> dims;
+                    if (axis >= 0)
+                        dims.emplace_back(axis);
+
+                    auto zSum = zShape.empty() ? scalarArray(dt) : NDArrayFactory::create_('c', zShape, dt);
+                    ReductionBenchmark sum(reduce::SameOps::Sum, "reduce_sum" + suffix(dt), randomArray('c', s, dt), zSum, dims);
+                    run(sum);
+
+                    auto zMax = zShape.empty() ? scalarArray(dt) : NDArrayFactory::create_('c', zShape, dt);
+                    ReductionBenchmark max(reduce::SameOps::Max, "reduce_max" + suffix(dt), randomArray('c', s, dt), zMax, dims);
+                    run(max);
+
+                    auto zMean = zShape.empty() ? scalarArray(dt) : NDArrayFactory::create_('c', zShape, dt);
+                    ReductionBenchmark mean(reduce::FloatOps::Mean, "reduce_mean" + suffix(dt), randomArray('c', s, dt), zMean, dims);
+                    run(mean);
+                }
+            }
+        }
+    }
+
+    void PerformanceSuite::runBroadcastSuite() {
+        for (auto dt : _dataTypes) {
+            // row vector, column vector, and bias add over channels of NCHW activations
+            {
+                BroadcastBenchmark bb(broadcast::Add, "broadcast_add_row" + suffix(dt), randomArray('c', {4096, 1024}, dt), randomArray('c', {1024}, dt), NDArrayFactory::create_('c', {4096, 1024}, dt), {1});
+                run(bb);
+            }
+
+            {
+                BroadcastBenchmark bb(broadcast::Multiply, "broadcast_mul_col" + suffix(dt), randomArray('c', {4096, 1024}, dt), randomArray('c', {4096}, dt), NDArrayFactory::create_('c', {4096, 1024}, dt), {0});
+                run(bb);
+            }
+
+            if (_quick)
+                continue;
+
+            {
+                BroadcastBenchmark bb(broadcast::Add, "broadcast_bias_nchw" + suffix(dt), randomArray('c', {32, 64, 56, 56}, dt), randomArray('c', {64}, dt), NDArrayFactory::create_('c', {32, 64, 56, 56}, dt), {1});
+                run(bb);
+            }
+
+            {
+                BroadcastBenchmark bb(broadcast::Add, "broadcast_bias_nhwc" + suffix(dt), randomArray('c', {32, 56, 56, 64}, dt), randomArray('c', {64}, dt), NDArrayFactory::create_('c', {32, 56, 56, 64}, dt), {3});
+                run(bb);
+            }
+        }
+    }
+
+    void PerformanceSuite::runRnnSuite() {
+        // bS, inSize, numUnits
+        std::vector<std::vector<Nd4jLong>> configs = {{32, 256, 256}, {64, 512, 1024}};
+        if (_quick)
+            configs.resize(1);
+
+        nd4j::ops::lstmCell op;
+
+        for (auto dt : _dataTypes) {
+            for (const auto &c : configs) {
+                const Nd4jLong bS = c[0], inSize = c[1], nU = c[2];
+
+                auto ctx = new Context(1);
+                ctx->setInputArray(0, randomArray('c', {bS, inSize}, dt), true);
+                ctx->setInputArray(1, randomArray('c', {bS, nU}, dt), true);
+                ctx->setInputArray(2, randomArray('c', {bS, nU}, dt), true);
+                ctx->setInputArray(3, randomArray('c', {inSize, 4 * nU}, dt), true);
+                ctx->setInputArray(4, randomArray('c', {nU, 4 * nU}, dt), true);
+                ctx->setInputArray(5, randomArray('c', {3 * nU}, dt), true);
+                ctx->setInputArray(6, randomArray('c', {nU, nU}, dt), true);
+                ctx->setInputArray(7, randomArray('c', {4 * nU}, dt), true);
+
+                ctx->setOutputArray(0, NDArrayFactory::create_('c', {bS, nU}, dt), true);
+                ctx->setOutputArray(1, NDArrayFactory::create_('c', {bS, nU}, dt), true);
+
+                // no peephole, no projection, no clipping, forget bias 1.0
+                std::vector<Nd4jLong> iArgs = {0, 0};
+                std::vector<double> tArgs = {0.0, 0.0, 1.0};
+                ctx->setIArguments(iArgs.data(), iArgs.size());
+                ctx->setTArguments(tArgs.data(), tArgs.size());
+
+                DeclarableBenchmark db(op, "lstm_cell" + suffix(dt), ctx);
+                db.setFlops(2.0 * bS * (inSize + nU) * 4 * nU);
+                run(db);
+            }
+        }
+    }
+
+    void PerformanceSuite::runSortSuite() {
+        for (auto dt : _dataTypes) {
+            {
+                SortBenchmark sb("sort_full" + suffix(dt), randomArray('c', {_quick ? 65536 : 1048576}, dt), false);
+                run(sb);
+            }
+
+            {
+                SortBenchmark sb("sort_tad" + suffix(dt), randomArray('c', {_quick ? 64 : 1024, 1024}, dt), {1}, false);
+                run(sb);
+            }
+        }
+    }
+
+    void PerformanceSuite::runGatherScatterSuite() {
+        // rows, columns, number of indices
+        std::vector<std::vector<Nd4jLong>> configs = {{100000, 128, 4096}, {1000000, 64, 65536}};
+        if (_quick)
+            configs = {{10000, 128, 1024}};
+
+        nd4j::ops::gather gather;
+        nd4j::ops::scatter_add scatter;
+
+        for (auto dt : _dataTypes) {
+            for (const auto &c : configs) {
+                const Nd4jLong rows = c[0], cols = c[1], numIdx = c[2];
+
+                {
+                    auto ctx = new Context(1);
+                    ctx->setInputArray(0, randomArray('c', {rows, cols}, dt), true);
+                    ctx->setInputArray(1, randomIndices(numIdx, rows), true);
+                    ctx->setOutputArray(0, NDArrayFactory::create_('c', {numIdx, cols}, dt), true);
+
+                    std::vector<Nd4jLong> iArgs = {0};
+                    ctx->setIArguments(iArgs.data(), iArgs.size());
+
+                    DeclarableBenchmark db(gather, "gather_rows" + suffix(dt), ctx);
+                    db.setFlops(0.0);
+                    db.setBytes(numIdx * sizeof(int) + 2 * numIdx * cols * DataTypeUtils::sizeOfElement(dt));
+                    run(db);
+                }
+
+                {
+                    // scatter_add is executed in place: output is the same array as input, so it's restored before each iteration
+                    auto input = randomArray('c', {rows, cols}, dt);
+                    std::shared_ptr<NDArray> initial(input->dup());
+
+                    auto ctx = new Context(1);
+                    ctx->setInputArray(0, input, true);
+                    ctx->setInputArray(1, randomIndices(numIdx, rows), true);
+                    ctx->setInputArray(2, randomArray('c', {numIdx, cols}, dt), true);
+                    ctx->setOutputArray(0, input, false);
+
+                    DeclarableBenchmark db(scatter, "scatter_add_rows" + suffix(dt), ctx);
+                    db.setReset([input, initial] { input->assign(*initial); });
+                    db.setFlops(static_cast<double>(numIdx * cols));
+                    db.setBytes(numIdx * sizeof(int) + 3 * numIdx * cols * DataTypeUtils::sizeOfElement(dt));
+                    run(db);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_PERFORMANCESUITE_H
+#define LIBND4J_PERFORMANCESUITE_H
+
+#include <helpers/BenchmarkHelper.h>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * Curated set of op-level benchmarks used for performance regression checks.
+     * Every suite runs its benchmarks through provided helper, so results end up in attached BenchmarkReport.
+     */
+    class PerformanceSuite {
+    protected:
+        BenchmarkHelper &_helper;
+        std::vector<nd4j::DataType> _dataTypes;
+        bool _quick = false;
+
+        void run(OpBenchmark &benchmark);
+    public:
+        explicit PerformanceSuite(BenchmarkHelper &helper, std::vector<nd4j::DataType> dataTypes = {nd4j::DataType::FLOAT32}, bool quick = false);
+
+        static std::vector<std::string> suites();
+
+        /**
+         * This method runs suite with given name, throws std::invalid_argument for unknown names
+         */
+        void runSuite(const std::string &name);
+
+        void runGemmSuite();
+        void runConvolutionSuite();
+        void runReductionSuite();
+        void runBroadcastSuite();
+        void runRnnSuite();
+        void runSortSuite();
+        void runGatherScatterSuite();
+    };
+}
+
+#endif //LIBND4J_PERFORMANCESUITE_H
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Op-level performance regression runner.
+//
+// Runs curated benchmark suites, writes results as JSON and optionally compares them against a stored baseline.
+// Exit code is 0 if no regressions were found, 1 if at least one benchmark got slower than allowed, 2 on usage errors.
+//
+// @author raver119@gmail.com
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <Environment.h>
+#include "PerformanceSuite.h"
+
+using namespace nd4j;
+
+static void help(const char *app, std::ostream &out) {
+    out << "Usage: " << app << " [options]" << std::endl
+        << "  --suite <name>            run given suite only, can be repeated. Available suites:";
+    for (const auto &v : PerformanceSuite::suites())
+        out << " " << v;
+    out << std::endl
+        << "  --dtype <type>            data type to benchmark: FLOAT32, DOUBLE, HALF, BFLOAT16. Can be repeated, default FLOAT32" << std::endl
+        << "  --warmup <N>              number of warmup iterations, default 10" << std::endl
+        << "  --iterations <N>          number of measured iterations, default 100" << std::endl
+        << "  --quick                   run reduced set of shapes, useful for sanity checks" << std::endl
+        << "  --out <file>              write JSON report to given file" << std::endl
+        << "  --baseline <file>         compare median timings against JSON report stored earlier" << std::endl
+        << "  --tolerance <T>           allowed relative slowdown, i.e. 0.1 for 10%. Default 0.1" << std::endl
+        << "  --tolerance <prefix>=<T>  tolerance override for tests with names starting with prefix" << std::endl
+        << "  --noise-floor <us>        absolute slowdown in microseconds ignored as noise, default 5" << std::endl
+        << "  --property <key>=<value>  free-form property stored in report header, i.e. build=1.0.0-beta4" << std::endl;
+}
+
+static bool dataTypeFromString(const std::string &name, nd4j::DataType &dataType) {
+    if (name == "FLOAT32" || name == "float")
+        dataType = nd4j::DataType::FLOAT32;
+    else if (name == "DOUBLE" || name == "double")
+        dataType = nd4j::DataType::DOUBLE;
+    else if (name == "HALF" || name == "half")
+        dataType = nd4j::DataType::HALF;
+    else if (name == "BFLOAT16" || name == "bfloat16")
+        dataType = nd4j::DataType::BFLOAT16;
+    else
+        return false;
+
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> suites;
+    std::vector<nd4j::DataType> dataTypes;
+    std::string outFile;
+    std::string baselineFile;
+    unsigned int warmup = 10;
+    unsigned int iterations = 100;
+    bool quick = false;
+
+    BenchmarkReport report;
+
+    for (int e = 1; e < argc; e++) {
+        std::string arg(argv[e]);
+
+        if (arg == "--help" || arg == "-h") {
+            help(argv[0], std::cout);
+            return 0;
+        } else if (arg == "--quick") {
+            quick = true;
+            continue;
+        }
+
+        if (e + 1 >= argc) {
+            std::cerr << "Missing value for option " << arg << std::endl;
+            help(argv[0], std::cerr);
+            return 2;
+        }
+
+        std::string value(argv[++e]);
+
+        if (arg == "--suite") {
+            suites.emplace_back(value);
+        } else if (arg == "--dtype") {
+            nd4j::DataType dataType;
+            if (!dataTypeFromString(value, dataType)) {
+                std::cerr << "Unsupported data type: " << value << std::endl;
+                return 2;
+            }
+            dataTypes.emplace_back(dataType);
+        } else if (arg == "--warmup") {
+            warmup = static_cast<unsigned int>(atoi(value.c_str()));
+        } else if (arg == "--iterations") {
+            iterations = static_cast<unsigned int>(atoi(value.c_str()));
+        } else if (arg == "--out") {
+            outFile = value;
+        } else if (arg == "--baseline") {
+            baselineFile = value;
+        } else if (arg == "--tolerance") {
+            auto pos = value.find('=');
+            if (pos == std::string::npos)
+                report.setTolerance(atof(value.c_str()));
+            else
+                report.setTolerance(value.substr(0, pos), atof(value.substr(pos + 1).c_str()));
+        } else if (arg == "--noise-floor") {
+            report.setNoiseFloor(atof(value.c_str()));
+        } else if (arg == "--property") {
+            auto pos = value.find('=');
+            if (pos == std::string::npos) {
+                std::cerr << "Property should be specified as key=value: " << value << std::endl;
+                return 2;
+            }
+            report.setProperty(value.substr(0, pos), value.substr(pos + 1));
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            help(argv[0], std::cerr);
+            return 2;
+        }
+    }
+
+    if (iterations == 0) {
+        std::cerr << "Number of iterations should be positive" << std::endl;
+        return 2;
+    }
+
+    if (suites.empty())
+        suites = PerformanceSuite::suites();
+
+    if (dataTypes.empty())
+        dataTypes.emplace_back(nd4j::DataType::FLOAT32);
+
+    // baseline is loaded before benchmarks, so malformed file doesn't waste the whole run
+    BenchmarkReport baseline;
+    if (!baselineFile.empty()) {
+        try {
+            baseline = BenchmarkReport::readJson(baselineFile.c_str());
+        } catch (std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            return 2;
+        }
+    }
+
+    report.setProperty("threads", std::to_string(nd4j::Environment::getInstance()->maxThreads()));
+    report.setProperty("quick", quick ? "true" : "false");
+
+    BenchmarkHelper helper(warmup, iterations);
+    helper.setReport(&report);
+
+    PerformanceSuite suite(helper, dataTypes, quick);
+
+    try {
+        for (const auto &v : suites) {
+            nd4j_printf("\nRunning suite [%s]\n", v.c_str());
+            suite.runSuite(v);
+        }
+    } catch (std::invalid_argument &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+
+    if (!outFile.empty())
+        report.writeJson(outFile.c_str());
+    else if (baselineFile.empty())
+        std::cout << report.asJson();
+
+    if (baselineFile.empty())
+        return 0;
+
+    for (const auto &v : report.missing(baseline))
+        nd4j_printf("Not measured in this run: [%s]\n", v.c_str());
+
+    auto regressions = report.compare(baseline);
+    for (const auto &v : regressions)
+        nd4j_printf("REGRESSION: [%s] median %.2f us -> %.2f us (x%.2f, tolerance %.0f%%)\n", v.key.c_str(), v.baseline, v.current, v.ratio(), v.tolerance * 100.0);
+
+    nd4j_printf("%i benchmarks measured, %i regressions found against baseline\n", (int) report.results().size(), (int) regressions.size());
+
+    return regressions.empty() ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include "testlayers.h"
+#include <helpers/BenchmarkHelper.h>
+#include <NDArrayFactory.h>
+
+using namespace nd4j;
+
+class BenchmarkReportTests : public testing::Test {
+public:
+    static BenchmarkResult result(const char *name, double median) {
+        BenchmarkResult r;
+        r.testName = name;
+        r.dataType = "FLOAT32";
+        r.shape = "[32, 1024]";
+        r.axis = "N/A";
+        r.median = median;
+        r.mean = median;
+        r.p90 = median * 1.5;
+        r.gflops = 1.25;
+        return r;
+    }
+};
+
+TEST_F(BenchmarkReportTests, Test_Json_Roundtrip_1) {
+    BenchmarkReport report;
+    report.setProperty("build", "test \"quoted\"");
+    report.addResult(result("gemm_c", 100.0));
+    report.addResult(result("reduce_sum", 12.5));
+
+    auto restored = BenchmarkReport::fromJson(report.asJson());
+
+    ASSERT_EQ(2, restored.results().size());
+    ASSERT_EQ(std::string("test \"quoted\""), restored.property("build"));
+    ASSERT_EQ(report.results()[0].key(), restored.results()[0].key());
+    ASSERT_NEAR(100.0, restored.results()[0].median, 1e-3);
+    ASSERT_NEAR(150.0, restored.results()[0].p90, 1e-3);
+    ASSERT_NEAR(1.25, restored.results()[0].gflops, 1e-3);
+    ASSERT_NEAR(12.5, restored.results()[1].median, 1e-3);
+}
+
+TEST_F(BenchmarkReportTests, Test_Json_Malformed_1) {
+    ASSERT_ANY_THROW(BenchmarkReport::fromJson("{\"results\": [{\"name\": }"));
+    ASSERT_ANY_THROW(BenchmarkReport::fromJson("[]"));
+}
+
+TEST_F(BenchmarkReportTests, Test_Json_Truncated_1) {
+    ASSERT_ANY_THROW(BenchmarkReport::fromJson("{"));
+    ASSERT_ANY_THROW(BenchmarkReport::fromJson("{\"results\": ["));
+    ASSERT_ANY_THROW(BenchmarkReport::fromJson("{\"results\": [{\"name\": \"a\","));
+    ASSERT_ANY_THROW(BenchmarkReport::fromJson("{\"build\": \"abc"));
+}
+
+TEST_F(BenchmarkReportTests, Test_Key_Threads_1) {
+    auto single = result("gemm_c", 100.0);
+    auto multi = result("gemm_c", 30.0);
+    multi.threads = 8;
+
+    ASSERT_NE(single.key(), multi.key());
+
+    BenchmarkReport baseline;
+    baseline.addResult(single);
+    baseline.addResult(multi);
+
+    BenchmarkReport current;
+    current.setTolerance(0.10);
+    current.addResult(result("gemm_c", 100.0));
+    multi.median = 31.0;
+    current.addResult(multi);
+
+    ASSERT_TRUE(current.compare(baseline).empty());
+    ASSERT_TRUE(current.missing(baseline).empty());
+}
+
+TEST_F(BenchmarkReportTests, Test_Compare_1) {
+    BenchmarkReport baseline;
+    baseline.addResult(result("gemm_c", 100.0));
+    baseline.addResult(result("reduce_sum", 100.0));
+    baseline.addResult(result("sort_full", 100.0));
+
+    BenchmarkReport current;
+    current.setTolerance(0.10);
+    current.addResult(result("gemm_c", 109.0));
+    current.addResult(result("reduce_sum", 130.0));
+
+    auto regressions = current.compare(baseline);
+    ASSERT_EQ(1, regressions.size());
+    ASSERT_EQ(result("reduce_sum", 0.0).key(), regressions[0].key);
+    ASSERT_NEAR(1.3, regressions[0].ratio(), 1e-5);
+
+    auto missing = current.missing(baseline);
+    ASSERT_EQ(1, missing.size());
+    ASSERT_EQ(result("sort_full", 0.0).key(), missing[0]);
+}
+
+TEST_F(BenchmarkReportTests, Test_Compare_Tolerances_1) {
+    BenchmarkReport baseline;
+    baseline.addResult(result("reduce_sum", 100.0));
+    baseline.addResult(result("reduce_mean", 100.0));
+    baseline.addResult(result("gemm_c", 1.0));
+
+    BenchmarkReport current;
+    current.setTolerance(0.10);
+    current.setTolerance("reduce", 0.5);
+    current.setTolerance("reduce_mean", 0.2);
+    current.setNoiseFloor(5.0);
+
+    // gemm is 3x slower, but within noise floor
+    current.addResult(result("reduce_sum", 140.0));
+    current.addResult(result("reduce_mean", 140.0));
+    current.addResult(result("gemm_c", 3.0));
+
+    ASSERT_NEAR(0.5, current.toleranceFor("reduce_sum"), 1e-5);
+    ASSERT_NEAR(0.2, current.toleranceFor("reduce_mean"), 1e-5);
+    ASSERT_NEAR(0.1, current.toleranceFor("gemm_c"), 1e-5);
+
+    auto regressions = current.compare(baseline);
+    ASSERT_EQ(1, regressions.size());
+    ASSERT_EQ(result("reduce_mean", 0.0).key(), regressions[0].key);
+}
+
+TEST_F(BenchmarkReportTests, Test_Helper_Measure_1) {
+    BenchmarkHelper helper(2, 5);
+    BenchmarkReport report;
+    helper.setReport(&report);
+
+    MatrixBenchmark mb(1.0f, 0.0f, "gemm_test", NDArrayFactory::create_<float>('c', {8, 16}), NDArrayFactory::create_<float>('c', {16, 4}), NDArrayFactory::create_<float>('c', {8, 4}));
+    ASSERT_NEAR(2.0 * 8 * 16 * 4, mb.flops(), 1e-5);
+
+    std::vector<OpBenchmark*> list = {&mb};
+    helper.runOperationSuit(list, false);
+
+    ASSERT_EQ(1, report.results().size());
+
+    auto r = report.results()[0];
+    ASSERT_EQ(std::string("gemm_test"), r.testName);
+    ASSERT_EQ(5, r.iterations);
+    ASSERT_TRUE(r.min <= r.median);
+    ASSERT_TRUE(r.median <= r.p90);
+    ASSERT_TRUE(r.p90 <= r.max);
+}
@@ -57,4 +57,150 @@ TEST_F(LoadFromStringTest,PathTest) {
     delete[] loaded;
 }
 
-*/
\ No newline at end of file
+*/
+class NpyStreamingTests : public testing::Test {
+
+};
+
+TEST_F(NpyStreamingTests, Test_Header_Roundtrip_1) {
+    auto header = cnpy::writeNpyHeader(nd4j::DataType::FLOAT32, {3, 4, 5}, true);
+    ASSERT_EQ(0, header.size() % 64);
+
+    auto parsed = cnpy::readNpyHeader(header.data(), header.size());
+    ASSERT_EQ(header.size(), parsed.headerSize);
+    ASSERT_TRUE(parsed.fortranOrder);
+    ASSERT_TRUE(parsed.isNativeOrder());
+    ASSERT_EQ(nd4j::DataType::FLOAT32, parsed.dataType());
+    ASSERT_EQ(60, parsed.length());
+    ASSERT_EQ(240, parsed.byteLength());
+
+    std::vector<Nd4jLong> expShape = {3, 4, 5};
+    ASSERT_EQ(expShape, parsed.shape);
+
+    ASSERT_ANY_THROW(cnpy::readNpyHeader(header.data(), 8));
+}
+
+TEST_F(NpyStreamingTests, Test_Writer_Mapped_Reader_1) {
+    const char *fileName = "npy_streaming_test_1.npy";
+    auto exp = nd4j::NDArrayFactory::create<float>('c', {3, 4});
+    exp.linspace(1);
+
+    {
+        // row count is unknown upfront, header gets updated on close
+        cnpy::NpyWriter writer(fileName, nd4j::DataType::FLOAT32, {-1, 4});
+        for (int r = 0; r < 3; r++) {
+            auto row = exp({r, r + 1, 0, 0});
+            auto copy = row.dup('c');
+            writer.write(*copy);
+            delete copy;
+        }
+        writer.close();
+    }
+
+    {
+        cnpy::NpyMappedFile file(fileName);
+        ASSERT_EQ(2, file.header().shape.size());
+        ASSERT_EQ(3, file.header().shape[0]);
+
+        auto array = file.asArray();
+        ASSERT_TRUE(exp.isSameShape(array));
+        ASSERT_TRUE(exp.equalsTo(array));
+        delete array;
+    }
+
+    std::remove(fileName);
+}
+
+TEST_F(NpyStreamingTests, Test_Writer_Mismatch_1) {
+    const char *fileName = "npy_streaming_test_2.npy";
+    std::vector<float> data(5, 1.0f);
+
+    {
+        cnpy::NpyWriter writer(fileName, nd4j::DataType::FLOAT32, {2, 3});
+        writer.write(data.data(), data.size() * sizeof(float));
+        ASSERT_ANY_THROW(writer.close());
+    }
+
+    std::remove(fileName);
+}
+
+// builds zip archive with stored (uncompressed) members, the way numpy.savez does
+static void writeStoredNpz(const char *fileName, const std::vector<std::pair<std::string, std::string>> &members) {
+    auto le = [] (std::string &out, uint64_t value, int bytes) {
+        for (int e = 0; e < bytes; e++)
+            out.push_back(static_cast<char>((value >> (8 * e)) & 0xFF));
+    };
+
+    std::string archive, directory;
+    for (const auto &m: members) {
+        auto offset = archive.size();
+        le(archive, 0x04034b50, 4);
+        le(archive, 20, 2); le(archive, 0, 2); le(archive, 0, 2); le(archive, 0, 4); le(archive, 0, 4);
+        le(archive, m.second.size(), 4); le(archive, m.second.size(), 4);
+        le(archive, m.first.size(), 2); le(archive, 0, 2);
+        archive += m.first + m.second;
+
+        le(directory, 0x02014b50, 4);
+        le(directory, 20, 2); le(directory, 20, 2); le(directory, 0, 2); le(directory, 0, 2); le(directory, 0, 4); le(directory, 0, 4);
+        le(directory, m.second.size(), 4); le(directory, m.second.size(), 4);
+        le(directory, m.first.size(), 2); le(directory, 0, 2); le(directory, 0, 2); le(directory, 0, 2); le(directory, 0, 2); le(directory, 0, 4);
+        le(directory, offset, 4);
+        directory += m.first;
+    }
+
+    auto directoryOffset = archive.size();
+    archive += directory;
+    le(archive, 0x06054b50, 4);
+    le(archive, 0, 2); le(archive, 0, 2); le(archive, members.size(), 2); le(archive, members.size(), 2);
+    le(archive, directory.size(), 4); le(archive, directoryOffset, 4); le(archive, 0, 2);
+
+    std::ofstream out(fileName, std::ios::binary);
+    out.write(archive.data(), archive.size());
+}
+
+static std::string npyBytes(nd4j::NDArray &array) {
+    auto bytes = cnpy::writeNpyHeader(array.dataType(), array.getShapeAsVector());
+    bytes.append(reinterpret_cast<char *>(array.getBuffer()), array.lengthOf() * array.sizeOfT());
+    return bytes;
+}
+
+TEST_F(NpyStreamingTests, Test_Npz_Roundtrip_1) {
+    const char *fileName = "npz_archive_test_1.npz";
+    auto x = nd4j::NDArrayFactory::create<float>('c', {2, 3});
+    auto y = nd4j::NDArrayFactory::create<double>('c', {4});
+    x.linspace(1);
+    y.linspace(-2);
+
+    // name lengths are picked so data of both members lands at unaligned offsets within the archive
+    writeStoredNpz(fileName, {{"x.npy", npyBytes(x)}, {"yy.npy", npyBytes(y)}});
+
+    {
+        cnpy::NpzArchive archive(fileName);
+        ASSERT_EQ(2, archive.size());
+        ASSERT_TRUE(archive.contains("x"));
+        ASSERT_TRUE(archive.contains("yy"));
+        ASSERT_FALSE(archive.contains("z"));
+        ASSERT_EQ(1, archive.indexOf("yy"));
+        ASSERT_ANY_THROW(archive.indexOf("z"));
+        ASSERT_ANY_THROW(archive.array("z"));
+
+        auto rx = archive.array("x");
+        auto ry = archive.array("yy");
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(rx->getBuffer()) % sizeof(float));
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(ry->getBuffer()) % sizeof(double));
+        ASSERT_TRUE(x.isSameShape(rx));
+        ASSERT_TRUE(x.equalsTo(rx));
+        ASSERT_TRUE(y.isSameShape(ry));
+        ASSERT_TRUE(y.equalsTo(ry));
+        delete rx;
+        delete ry;
+
+        auto all = archive.arrays();
+        ASSERT_EQ(2, all.size());
+        ASSERT_TRUE(y.equalsTo(all["yy"]));
+        for (auto &v: all)
+            delete v.second;
+    }
+
+    std::remove(fileName);
+}
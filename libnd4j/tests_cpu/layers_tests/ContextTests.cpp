@@ -20,6 +20,7 @@
 
 #include "testlayers.h"
 #include <ops/declarable/CustomOperations.h>
+#include <graph/ContextPool.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -347,4 +348,60 @@ TEST_F(ContextTests, test_short_context_3) {
     auto z = ctx.fastpath_out()[0];
 
     ASSERT_EQ(exp, *z);
-}
\ No newline at end of file
+}
+
+TEST_F(ContextTests, test_short_context_4) {
+    auto x0 = NDArrayFactory::create<float>('c', {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    auto x1 = NDArrayFactory::create<float>('c', {2, 2}, {-1.f, -2.f, -3.f, -4.f});
+    auto z0 = NDArrayFactory::create<float>('c', {3, 2});
+    auto z1 = NDArrayFactory::create<float>('c', {2, 2});
+
+    auto exp0 = NDArrayFactory::create<float>('c', {3, 2}, {2.f, 4.f, 6.f, 8.f, 10.f, 12.f});
+    auto exp1 = NDArrayFactory::create<float>('c', {2, 2}, {-2.f, -4.f, -6.f, -8.f});
+    Context ctx(1);
+    nd4j::ops::add op;
+
+    ctx.setInputArray(0, x0.buffer(), x0.shapeInfo(), nullptr, nullptr);
+    ctx.setInputArray(1, x0.buffer(), x0.shapeInfo(), nullptr, nullptr);
+    ctx.setOutputArray(0, z0.buffer(), z0.shapeInfo(), nullptr, nullptr);
+    ASSERT_EQ(Status::OK(), op.execute(&ctx));
+
+    auto in0 = ctx.array(0);
+    auto out0 = ctx.fastpath_out()[0];
+
+    // next call rebinds the same wrappers to other buffers and shapes
+    ctx.clearFastPath();
+    ASSERT_EQ(0, ctx.width());
+
+    ctx.setInputArray(0, x1.buffer(), x1.shapeInfo(), nullptr, nullptr);
+    ctx.setInputArray(1, x1.buffer(), x1.shapeInfo(), nullptr, nullptr);
+    ctx.setOutputArray(0, z1.buffer(), z1.shapeInfo(), nullptr, nullptr);
+    ASSERT_EQ(Status::OK(), op.execute(&ctx));
+
+    ASSERT_TRUE(in0 == ctx.array(0));
+    ASSERT_TRUE(out0 == ctx.fastpath_out()[0]);
+    ASSERT_TRUE(ctx.array(0)->buffer() == x1.buffer());
+    ASSERT_EQ(4, ctx.array(0)->lengthOf());
+
+    ASSERT_EQ(exp0, z0);
+    ASSERT_EQ(exp1, z1);
+}
+
+TEST_F(ContextTests, test_context_pool_1) {
+    auto x = NDArrayFactory::create<float>('c', {3}, {1.f, 2.f, 3.f});
+    auto ctx = ContextPool::acquire();
+    ctx->setInputArray(0, x.buffer(), x.shapeInfo(), nullptr, nullptr);
+    ctx->markInplace(true);
+
+    auto before = ContextPool::size();
+    ContextPool::release(ctx);
+    ASSERT_EQ(before + 1, ContextPool::size());
+
+    // released Context is handed out again, cleared
+    auto other = ContextPool::acquire();
+    ASSERT_TRUE(ctx == other);
+    ASSERT_EQ(0, other->width());
+    ASSERT_FALSE(other->isInplace());
+
+    ContextPool::release(other);
+}
@@ -160,6 +160,23 @@ TEST_F(DeclarableOpsTests1, BasicInitialization3) {
     ASSERT_TRUE(op1 == op2);
 }
 
+TEST_F(DeclarableOpsTests1, BasicInitialization4) {
+    auto registrator = nd4j::ops::OpRegistrator::getInstance();
+
+    // every registered hash, synonyms included, must be resolved by lookup table
+    for (auto hash: registrator->getAllHashes()) {
+        auto op = registrator->getOperation(hash);
+        ASSERT_TRUE(op != nullptr);
+    }
+
+    std::string synonym("Mul");
+    auto op = registrator->getOperation(nd4j::ops::HashHelper::getInstance()->getLongHash(synonym));
+    ASSERT_TRUE(op == registrator->getOperation("multiply"));
+
+    std::string unknown("definitely_not_an_op");
+    ASSERT_TRUE(registrator->getOperation(nd4j::ops::HashHelper::getInstance()->getLongHash(unknown)) == nullptr);
+}
+
 
 TEST_F(DeclarableOpsTests1, SynonymInitialization2) {
     auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation("Mul");
@@ -2518,6 +2518,104 @@ TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_2) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_Soft_1) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {6,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scales = NDArrayFactory::create<float>('c', {6}, {0.9f, .75f, .6f, .95f, .5f, .3f});
+    // overlapping boxes are kept, since their IoU is below threshold, but with decayed scores they go after disjoint box 5
+    NDArray expected = NDArrayFactory::create<float>('c', {6}, {3., 0., 1., 5., 4., 2.});
+
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {0.9, 0.0, 0.5}, {6});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_Soft_2) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {6,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scales = NDArrayFactory::create<float>('c', {6}, {0.9f, .75f, .6f, .95f, .5f, .3f});
+    // IoU of overlapping pairs is ~0.82, so they are suppressed by hard cutoff regardless of sigma
+    NDArray expected = NDArrayFactory::create<float>('c', {3}, {3., 0., 5.});
+
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {0.5, 0.0, 0.5}, {3});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_CombinedNonMaxSuppressing_1) {
+
+    NDArray boxes  = NDArrayFactory::create<float>('c', {1,4,1,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, 10, 1, 11, 0, 20, 1, 21});
+    NDArray scores = NDArrayFactory::create<float>('c', {1,4,2}, {0.9f, 0.1f, 0.8f, 0.7f, 0.2f, 0.6f, 0.05f, 0.01f});
+
+    NDArray expBoxes   = NDArrayFactory::create<float>('c', {1,5,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, 10, 1, 11, 0, 10, 1, 11, 0, 0, 0, 0});
+    NDArray expScores  = NDArrayFactory::create<float>('c', {1,5}, {0.9f, 0.7f, 0.6f, 0.2f, 0.f});
+    NDArray expClasses = NDArrayFactory::create<float>('c', {1,5}, {0.f, 1.f, 1.f, 0.f, 0.f});
+    NDArray expValid   = NDArrayFactory::create<int>('c', {1}, {4});
+
+    nd4j::ops::combined_non_max_suppression op;
+    auto results = op.execute({&boxes, &scores}, {0.5, 0.1}, {2, 5});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_EQ(4, results->size());
+
+    ASSERT_TRUE(expBoxes.isSameShape(results->at(0)));
+    ASSERT_TRUE(expBoxes.equalsTo(results->at(0)));
+    ASSERT_TRUE(expScores.equalsTo(results->at(1)));
+    ASSERT_TRUE(expClasses.equalsTo(results->at(2)));
+    ASSERT_TRUE(expValid.equalsTo(results->at(3)));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_CombinedNonMaxSuppressing_2) {
+
+    NDArray boxes  = NDArrayFactory::create<float>('c', {1,4,1,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, 10, 1, 11, 0, 20, 1, 21});
+    NDArray scores = NDArrayFactory::create<float>('c', {1,4,2}, {0.9f, 0.1f, 0.8f, 0.7f, 0.2f, 0.6f, 0.05f, 0.01f});
+
+    // pad_per_class: output size is min(10, 1 * 2), clip_boxes: coordinates are clipped to [0, 1]
+    NDArray expBoxes   = NDArrayFactory::create<float>('c', {1,2,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1});
+    NDArray expScores  = NDArrayFactory::create<float>('c', {1,2}, {0.9f, 0.7f});
+    NDArray expClasses = NDArrayFactory::create<float>('c', {1,2}, {0.f, 1.f});
+    NDArray expValid   = NDArrayFactory::create<int>('c', {1}, {2});
+
+    nd4j::ops::combined_non_max_suppression op;
+    auto results = op.execute({&boxes, &scores}, {0.5, 0.1}, {1, 10, 1, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_EQ(4, results->size());
+
+    ASSERT_TRUE(expBoxes.isSameShape(results->at(0)));
+    ASSERT_TRUE(expBoxes.equalsTo(results->at(0)));
+    ASSERT_TRUE(expScores.isSameShape(results->at(1)));
+    ASSERT_TRUE(expScores.equalsTo(results->at(1)));
+    ASSERT_TRUE(expClasses.equalsTo(results->at(2)));
+    ASSERT_TRUE(expValid.equalsTo(results->at(3)));
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, Image_CropAndResize_1) {
 
@@ -2613,6 +2711,148 @@ TEST_F(DeclarableOpsTests10, Image_CropAndResize_4) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, ImageResizeArea_Test1) {
+
+    NDArray input = NDArrayFactory::create<float>('c', {1, 4, 4, 1});
+    NDArray expected = NDArrayFactory::create<float>('c', {1, 2, 2, 1}, {3.5f, 5.5f, 11.5f, 13.5f});
+    input.linspace(1);
+
+    nd4j::ops::resize_area op;
+    auto results = op.execute({&input}, {}, {2, 2});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShape(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, ImageResizeBicubic_NCHW_Test1) {
+
+    NDArray input = NDArrayFactory::create<float>('c', {2, 5, 6, 3});
+    input.linspace(1);
+
+    auto permuted = input.permute({0, 3, 1, 2});
+    auto inputNCHW = permuted->dup('c');
+
+    nd4j::ops::resize_bicubic op;
+    auto resultsNHWC = op.execute({&input}, {}, {8, 9});
+    auto resultsNCHW = op.execute({inputNCHW}, {}, {8, 9, 0, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, resultsNHWC->status());
+    ASSERT_EQ(ND4J_STATUS_OK, resultsNCHW->status());
+
+    auto nhwc = resultsNHWC->at(0);
+    auto nchw = resultsNCHW->at(0);
+
+    ASSERT_EQ(std::vector<Nd4jLong>({2, 8, 9, 3}), nhwc->getShapeAsVector());
+    ASSERT_EQ(std::vector<Nd4jLong>({2, 3, 8, 9}), nchw->getShapeAsVector());
+
+    auto back = nchw->permute({0, 2, 3, 1});
+    ASSERT_TRUE(nhwc->equalsTo(back));
+
+    delete back;
+    delete resultsNCHW;
+    delete resultsNHWC;
+    delete inputNCHW;
+    delete permuted;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, ImageResizeBicubic_Test2) {
+
+    NDArray input = NDArrayFactory::create<float>('c', {1, 3, 4, 1}, {
+        0.1f, 0.4f, 0.9f, 1.6f,
+        2.5f, 3.6f, 4.9f, 6.4f,
+        8.1f, 10.0f, 12.1f, 14.4f});
+
+    // reference values from tf.image.resize_bicubic(input, [6, 8]), align_corners = false
+    NDArray expected = NDArrayFactory::create<float>('c', {1, 6, 8, 1}, {
+        0.1f, 0.203125f, 0.4f, 0.6125f, 0.9f, 1.296875f, 1.6f, 1.665625f,
+        0.775f, 1.0101562f, 1.4f, 1.775f, 2.225f, 2.8148438f, 3.25f, 3.3460937f,
+        2.5f, 2.928125f, 3.6f, 4.2125f, 4.9f, 5.771875f, 6.4f, 6.540625f,
+        5.525f, 6.1460938f, 7.1f, 7.95f, 8.875f, 10.0289063f, 10.85f, 11.0351563f,
+        8.1f, 8.853125f, 10.0f, 11.0125f, 12.1f, 13.446875f, 14.4f, 14.615625f,
+        8.625f, 9.4085937f, 10.6f, 11.65f, 12.775f, 14.1664062f, 15.15f, 15.3726563f});
+
+    nd4j::ops::resize_bicubic op;
+    auto results = op.execute({&input}, {}, {6, 8});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShape(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    // same image in NCHW layout, since there's a single channel only the shape differs
+    auto inputNCHW = input.reshape('c', {1, 1, 3, 4});
+    auto resultsNCHW = op.execute({inputNCHW}, {}, {6, 8, 0, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, resultsNCHW->status());
+
+    auto nchw = resultsNCHW->at(0);
+    ASSERT_EQ(std::vector<Nd4jLong>({1, 1, 6, 8}), nchw->getShapeAsVector());
+
+    auto flat = nchw->reshape('c', {1, 6, 8, 1});
+    ASSERT_TRUE(expected.equalsTo(flat));
+
+    delete flat;
+    delete resultsNCHW;
+    delete inputNCHW;
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, ImageResizeBilinear_UInt8_Test1) {
+
+    NDArray input = NDArrayFactory::create<uint8_t>('c', {1, 1, 2, 1}, {0, 255});
+    NDArray expected = NDArrayFactory::create<uint8_t>('c', {1, 1, 4, 1}, {0, 128, 255, 255});
+
+    nd4j::ops::resize_bilinear op;
+    auto results = op.execute({&input}, {}, {1, 4});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto result = results->at(0);
+
+    ASSERT_EQ(nd4j::DataType::UINT8, result->dataType());
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, ImageResizeBilinear_Cast_Test1) {
+
+    NDArray input = NDArrayFactory::create<float>('c', {1, 1, 2, 1}, {0.f, 1.f});
+    NDArray output = NDArrayFactory::create<double>('c', {1, 1, 4, 1});
+    NDArray expected = NDArrayFactory::create<double>('c', {1, 1, 4, 1}, {0., 0.5, 1., 1.});
+
+    // output type differs from image type: resize is done in float, and result is cast
+    nd4j::ops::resize_bilinear op;
+    auto status = op.execute({&input}, {&output}, {}, {1, 4}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+    ASSERT_TRUE(expected.equalsTo(output));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, ImageResizeBilinear_NoSize_Test1) {
+
+    NDArray input = NDArrayFactory::create<float>('c', {1, 1, 2, 1}, {0.f, 1.f});
+    NDArray output = NDArrayFactory::create<float>('c', {1, 1, 4, 1});
+
+    // neither size tensor nor both width and height are given
+    nd4j::ops::resize_bilinear op;
+    ASSERT_ANY_THROW(op.execute({&input}, {&output}, {}, {4}, {}));
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, FakeQuantWithMinMaxVars_Test_1) {
 
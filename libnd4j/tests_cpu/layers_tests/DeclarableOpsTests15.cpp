@@ -134,4 +134,128 @@ TEST_F(DeclarableOpsTests15, test_avgpooling_edge_1) {
     ASSERT_EQ(m, *z);
 
     delete result;
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, knn_topk_1) {
+    // base vectors are points of integer grid, so distances are exact and ties are resolved by row number
+    auto base = NDArrayFactory::create<float>('c', {5000, 4});
+    for (int r = 0; r < 5000; r++) {
+        base.p(r, 0, r % 50);
+        base.p(r, 1, (r / 50) % 50);
+        base.p(r, 2, r / 2500);
+    }
+
+    auto queries = NDArrayFactory::create<float>('c', {1, 4}, {10.25f, 20.f, 1.f, 0.f});
+    auto expD = NDArrayFactory::create<float>('c', {1, 5}, {0.25f, 0.75f, 1.0307764f, 1.0307764f, 1.0307764f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {1, 5}, {3510, 3511, 1010, 3460, 3560});
+
+    nd4j::ops::knn_topk op;
+    auto result = op.execute({&queries, &base}, {}, {5, 0});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(expD.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, knn_topk_cosine_1) {
+    auto base = NDArrayFactory::create<float>('c', {5, 2}, {2.f, 0.f, 0.f, 3.f, 1.f, 1.f, -1.f, 0.f, 3.f, 1.f});
+    auto queries = NDArrayFactory::create<float>('c', {1, 2}, {1.f, 0.f});
+
+    // 1 - cosine similarity: length of vectors doesn't matter
+    auto expD = NDArrayFactory::create<float>('c', {1, 3}, {0.f, 0.0513167f, 0.2928932f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {1, 3}, {0, 4, 2});
+
+    nd4j::ops::knn_topk op;
+    auto result = op.execute({&queries, &base}, {}, {3, 1});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(expD.equalsTo(result->at(0), 1e-5));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, knn_topk_dot_1) {
+    auto base = NDArrayFactory::create<double>('c', {5, 2}, {1., 0., 0., 1., 3., 3., -1., -1., 2., 2.});
+    auto queries = NDArrayFactory::create<double>('c', {2, 2}, {1., 2., -1., 0.});
+
+    // dot product is reported as is, the larger the better
+    auto expD = NDArrayFactory::create<double>('c', {2, 2}, {9., 6., 1., 0.});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 2}, {2, 4, 3, 1});
+
+    nd4j::ops::knn_topk op;
+    auto result = op.execute({&queries, &base}, {}, {2, 2});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_EQ(nd4j::DataType::DOUBLE, result->at(0)->dataType());
+    ASSERT_TRUE(expD.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, knn_topk_int8_half_1) {
+    auto base8 = NDArrayFactory::create<int8_t>('c', {5, 2}, {0, 0, 3, 4, 1, 1, -2, 0, 10, 10});
+    auto queries8 = NDArrayFactory::create<int8_t>('c', {1, 2}, {0, 1});
+
+    auto base16 = NDArrayFactory::create<float16>('c', {5, 2});
+    auto queries16 = NDArrayFactory::create<float16>('c', {1, 2});
+    base16.assign(base8);
+    queries16.assign(queries8);
+
+    // both are staged through fp32 tiles, so results are identical
+    auto expD = NDArrayFactory::create<float>('c', {1, 3}, {1.f, 1.f, 2.2360680f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {1, 3}, {0, 2, 3});
+
+    nd4j::ops::knn_topk op;
+    for (auto pair : {std::make_pair(&queries8, &base8), std::make_pair(&queries16, &base16)}) {
+        auto result = op.execute({pair.first, pair.second}, {}, {3, 0});
+        ASSERT_EQ(Status::OK(), result->status());
+
+        ASSERT_EQ(nd4j::DataType::FLOAT32, result->at(0)->dataType());
+        ASSERT_TRUE(expD.equalsTo(result->at(0), 1e-5));
+        ASSERT_TRUE(expI.equalsTo(result->at(1)));
+
+        delete result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, knn_topk_blocks_1) {
+    // 600 queries span three query blocks, 5000 base rows span two base tiles
+    auto base = NDArrayFactory::create<float>('c', {5000, 4});
+    for (int r = 0; r < 5000; r++) {
+        base.p(r, 0, r % 50);
+        base.p(r, 1, (r / 50) % 50);
+        base.p(r, 2, r / 2500);
+    }
+
+    // every query is shifted grid point, so its nearest neighbor is known
+    const int numQueries = 600;
+    auto queries = NDArrayFactory::create<float>('c', {numQueries, 4});
+    auto expD = NDArrayFactory::create<float>('c', {numQueries, 1});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {numQueries, 1});
+    for (int q = 0; q < numQueries; q++) {
+        const int r = (q * 8) % 5000;
+        queries.p(q, 0, base.e<float>(r, 0) + 0.25f);
+        queries.p(q, 1, base.e<float>(r, 1));
+        queries.p(q, 2, base.e<float>(r, 2));
+        expD.p(q, 0, 0.25f);
+        expI.p(q, 0, (Nd4jLong) r);
+    }
+
+    nd4j::ops::knn_topk op;
+    auto result = op.execute({&queries, &base}, {}, {1, 0});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(expD.equalsTo(result->at(0), 1e-5));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+
+    delete result;
+}
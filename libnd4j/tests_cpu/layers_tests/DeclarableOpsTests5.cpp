@@ -1911,8 +1911,11 @@ TEST_F(DeclarableOpsTests5, fusedBatchNorm_test1) {
     
     ASSERT_EQ(Status::OK(), results->status());
     ASSERT_TRUE(expY.isSameShape(y));
+    ASSERT_TRUE(expY.equalsTo(y));
     ASSERT_TRUE(expBatchMean.isSameShape(batchMean));
+    ASSERT_TRUE(expBatchMean.equalsTo(batchMean));
     ASSERT_TRUE(expBatchVar.isSameShape(batchVar));
+    ASSERT_TRUE(expBatchVar.equalsTo(batchVar));
 
     delete results;
 }
@@ -1940,8 +1943,11 @@ TEST_F(DeclarableOpsTests5, fusedBatchNorm_test2) {
     
     ASSERT_EQ(Status::OK(), results->status());
     ASSERT_TRUE(expY.isSameShape(y));
+    ASSERT_TRUE(expY.equalsTo(y));
     ASSERT_TRUE(expBatchMean.isSameShape(batchMean));
+    ASSERT_TRUE(expBatchMean.equalsTo(batchMean));
     ASSERT_TRUE(expBatchVar.isSameShape(batchVar));
+    ASSERT_TRUE(expBatchVar.equalsTo(batchVar));
 
     delete results;
 }
@@ -514,6 +514,77 @@ TEST_F(DeclarableOpsTests6, MaxPoolWithArgmax_1) {
     delete ress;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MaxPoolWithArgmax_2) {
+
+    auto x = NDArrayFactory::create<float>('c', {1, 1, 4, 4}, {1.f, 5.f, 2.f, 0.f, 3.f, 4.f, 8.f, 7.f, 9.f, 0.f, 1.f, 2.f, 6.f, 15.f, 3.f, 4.f});
+    auto expV = NDArrayFactory::create<float>('c', {1, 1, 2, 2}, {5.f, 8.f, 15.f, 4.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {1, 1, 2, 2}, {1, 6, 13, 15});
+
+    nd4j::ops::max_pool_with_argmax op;
+    auto ress = op.execute({&x}, {}, {2,2, 2,2, 0,0, 1,1, 0});
+
+    ASSERT_EQ(ND4J_STATUS_OK, ress->status());
+    ASSERT_TRUE(expV.isSameShape(ress->at(0)));
+    ASSERT_TRUE(expV.equalsTo(ress->at(0)));
+    ASSERT_TRUE(expI.isSameShape(ress->at(1)));
+    ASSERT_TRUE(expI.equalsTo(ress->at(1)));
+
+    delete ress;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MaxPoolWithArgmax_NHWC_1) {
+
+    auto x = NDArrayFactory::create<float>('c', {1, 2, 2, 2}, {1.f, 8.f, 4.f, 2.f, 3.f, 5.f, 2.f, 6.f});
+    auto expV = NDArrayFactory::create<float>('c', {1, 1, 1, 2}, {4.f, 8.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {1, 1, 1, 2}, {2, 1});
+
+    nd4j::ops::max_pool_with_argmax op;
+    auto ress = op.execute({&x}, {}, {2,2, 1,1, 0,0, 1,1, 0, 1, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, ress->status());
+    ASSERT_TRUE(expV.isSameShape(ress->at(0)));
+    ASSERT_TRUE(expV.equalsTo(ress->at(0)));
+    ASSERT_TRUE(expI.isSameShape(ress->at(1)));
+    ASSERT_TRUE(expI.equalsTo(ress->at(1)));
+
+    delete ress;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MaxPoolWithArgmax_BP_1) {
+
+    for (int isNHWC = 0; isNHWC <= 1; isNHWC++) {
+        auto x = isNHWC ? NDArrayFactory::create<float>('c', {2, 7, 7, 3}) : NDArrayFactory::create<float>('c', {2, 3, 7, 7});
+        x.linspace(1);
+        x.applyScalar(scalar::Multiply, 7.f);
+        x.applyScalar(scalar::FMod, 23.f);              // unordered values without ties within 3x3 windows
+
+        std::vector<Nd4jLong> iArgs = {3,3, 2,2, 1,1, 1,1, 0, 1, isNHWC};
+
+        nd4j::ops::max_pool_with_argmax op;
+        auto fwd = op.execute({&x}, {}, iArgs);
+        ASSERT_EQ(ND4J_STATUS_OK, fwd->status());
+
+        NDArray gradO('c', fwd->at(0)->getShapeAsVector(), nd4j::DataType::FLOAT32);
+        gradO.linspace(1);
+
+        nd4j::ops::maxpool2d_bp opBP;
+        auto exp = opBP.execute({&x, &gradO}, {}, iArgs);
+        auto res = opBP.execute({&x, &gradO, fwd->at(1)}, {}, iArgs);
+        ASSERT_EQ(ND4J_STATUS_OK, exp->status());
+        ASSERT_EQ(ND4J_STATUS_OK, res->status());
+
+        ASSERT_TRUE(exp->at(0)->isSameShape(res->at(0)));
+        ASSERT_TRUE(exp->at(0)->equalsTo(res->at(0)));
+
+        delete fwd;
+        delete exp;
+        delete res;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, SufficientStatistics_1) {
 //    auto x0 = NDArrayFactory::create<double>('c', {10, 10});
@@ -1309,6 +1380,114 @@ TEST_F(DeclarableOpsTests6, MatrixInverse_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_Batched_Blocked_1) {
+    // matrices are wider than single factorization panel, so blocked path with trailing updates is used
+    auto x = NDArrayFactory::create<double>('c', {4, 70, 70});
+    auto exp = NDArrayFactory::create<double>('c', {4, 70, 70});
+    x.linspace(1);
+    x /= 1.e5;
+
+    for (int b = 0; b < 4; b++)
+        for (int i = 0; i < 70; i++) {
+            x.p(b, i, i, x.e<double>(b, i, i) + b + 1.);
+            exp.p(b, i, i, 1.);
+        }
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {}, {}, false, nd4j::DataType::DOUBLE);
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    nd4j::ops::matmul mmul;
+    auto product = mmul.execute({&x, result->at(0)}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, product->status());
+
+    ASSERT_TRUE(exp.equalsTo(product->at(0), 1.e-6));
+
+    delete product;
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_Lapack_Threshold_1) {
+    // size is above LAPACK threshold: getrf is used if backend provides it, blocked LU otherwise
+    const int n = 130;
+    auto x = NDArrayFactory::create<double>('c', {n, n});
+    auto exp = NDArrayFactory::create<double>('c', {n, n});
+    x.linspace(1);
+    x /= 1.e6;
+
+    for (int i = 0; i < n; i++) {
+        x.p(i, i, x.e<double>(i, i) + 2.);
+        exp.p(i, i, 1.);
+    }
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {}, {}, false, nd4j::DataType::DOUBLE);
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    nd4j::ops::matmul mmul;
+    auto product = mmul.execute({&x, result->at(0)}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, product->status());
+
+    ASSERT_TRUE(exp.equalsTo(product->at(0), 1.e-6));
+
+    delete product;
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixDeterminant_Pivoting_1) {
+    // every matrix needs row swaps: even permutation, odd permutation, general case
+    auto x = NDArrayFactory::create<double>('c', {3, 3, 3}, {0., 2., 0., 0., 0., 3., 4., 0., 0.,
+                                                             0., 2., 0., 3., 0., 0., 0., 0., 4.,
+                                                             1., 2., 3., 4., 5., 6., 7., 8., 10.});
+    auto expDet = NDArrayFactory::create<double>({24., -24., -3.});
+    auto expLog = NDArrayFactory::create<double>({3.1780538303479458, 3.1780538303479458, 1.0986122886681098});
+
+    nd4j::ops::matrix_determinant opDet;
+    auto det = opDet.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, det->status());
+    ASSERT_TRUE(expDet.isSameShape(det->at(0)));
+    ASSERT_TRUE(expDet.equalsTo(det->at(0)));
+
+    nd4j::ops::log_matrix_determinant opLog;
+    auto logDet = opLog.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, logDet->status());
+    ASSERT_TRUE(expLog.isSameShape(logDet->at(0)));
+    ASSERT_TRUE(expLog.equalsTo(logDet->at(0)));
+
+    delete det;
+    delete logDet;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixDeterminant_Pivoting_2) {
+    // diagonal matrix with two rows swapped, wider than single factorization panel
+    const int n = 100;
+    auto x = NDArrayFactory::create<double>('c', {n, n});
+    for (int i = 0; i < n; i++)
+        x.p(i, i, i < 3 ? 2. : 1.);
+
+    x.p(0, 0, 0.);
+    x.p(n - 1, n - 1, 0.);
+    x.p(0, n - 1, 1.);
+    x.p(n - 1, 0, 2.);
+
+    nd4j::ops::matrix_determinant opDet;
+    auto det = opDet.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, det->status());
+    ASSERT_NEAR(-8., det->at(0)->e<double>(0), 1.e-10);
+
+    nd4j::ops::log_matrix_determinant opLog;
+    auto logDet = opLog.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, logDet->status());
+    ASSERT_NEAR(std::log(8.), logDet->at(0)->e<double>(0), 1.e-10);
+
+    delete det;
+    delete logDet;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, ReluLayer_1) {
     auto x = NDArrayFactory::create<double>('c', {3, 4}, {1.0, -2.0, 3.0, 4.0, 5.0, -6.0, 7.0, 8.0, 9.0, -10.0, 11.0, 12});
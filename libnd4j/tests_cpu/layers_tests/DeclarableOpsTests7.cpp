@@ -1804,7 +1804,8 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentProdBP_2) {
     auto x = NDArrayFactory::create<double>({ 3.,  1.8, 2.5,  4.,  9., 2.1, 2.4,  9., 2.1, 2.1, 0.7, 0.1,  3., 4.2, 2.2, 1.});
     auto idx = NDArrayFactory::create<double>({2.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 3.0, 3.0, 3.0, 4.0, 4.0, 4.0, 4.0, 4.0, 4.0});
     auto eps = NDArrayFactory::create<double>({1.,    2.,     3.,      4.,     5.});
-    auto exp = NDArrayFactory::create<double>({1., 2.5, 1.8, 90.72, 40.32, 172.8, 151.2, 17.64, 75.6, 75.6, 13.86, 97.02, 3.234, 2.31, 4.41, 9.702});
+    // class 2 has single element, so its gradient is eps[2]
+    auto exp = NDArrayFactory::create<double>({3., 2.5, 1.8, 90.72, 40.32, 172.8, 151.2, 17.64, 75.6, 75.6, 13.86, 97.02, 3.234, 2.31, 4.41, 9.702});
     nd4j::ops::segment_prod_bp op;
 
     auto result = op.execute({&x, &idx, &eps}, {}, {});
@@ -6357,3 +6358,25 @@ TEST_F(DeclarableOpsTests7, Test_Reduce_CumSum_BP_3) {
 
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentMax_Wide_1) {
+    auto x = NDArrayFactory::create<float>('c', {6, 600});
+    auto idx = NDArrayFactory::create<int>({2, 0, 2, 1, 0, 2});
+    auto exp = NDArrayFactory::create<float>('c', {3, 600});
+    x.linspace(1);
+
+    // rows are sorted by value, so the last row of each segment holds maximum
+    std::vector<int> last = {4, 3, 5};
+    for (int s = 0; s < 3; s++)
+        for (int f = 0; f < 600; f++)
+            exp.p(s, f, x.e<float>(last[s], f));
+
+    nd4j::ops::unsorted_segment_max op;
+
+    auto result = op.execute({&x, &idx}, {}, {3});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
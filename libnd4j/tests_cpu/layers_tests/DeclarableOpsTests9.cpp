@@ -25,6 +25,7 @@
 #include <ops/ops.h>
 #include <GradCheck.h>
 #include <loops/random.h>
+#include <thread>
 
 
 using namespace nd4j;
@@ -2549,6 +2550,150 @@ TEST_F(DeclarableOpsTests9, batchnorm_bp_test3) {
     ASSERT_TRUE(isGradCorrect);
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, layer_norm_test1) {
+
+    auto input = NDArrayFactory::create<double>('c', {2,4});
+    auto gain  = NDArrayFactory::create<double>('c', {4}, {1., 0.5, 2., 1.});
+    auto bias  = NDArrayFactory::create<double>('c', {4}, {0.1, 0.2, 0.3, 0.4});
+    auto exp   = NDArrayFactory::create<double>('c', {2,4}, {-1.2416408, -0.0236068, 1.1944272, 1.7416408, -1.2416408, -0.0236068, 1.1944272, 1.7416408});
+
+    input.linspace(1.);
+
+    nd4j::ops::layer_norm op;
+    auto results = op.execute({&input, &gain, &bias}, {}, {1});
+    auto output = results->at(0);
+
+    ASSERT_EQ(Status::OK(), results->status());
+    ASSERT_TRUE(exp.isSameShape(output));
+    ASSERT_TRUE(exp.equalsTo(output));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, layer_norm_bp_test1) {
+
+    auto input = NDArrayFactory::create<double>('c', {3,4});
+    auto gain  = NDArrayFactory::create<double>('c', {4}, {1., 0.5, 2., 1.});
+    auto bias  = NDArrayFactory::create<double>('c', {4}, {0.1, 0.2, 0.3, 0.4});
+    auto dLdO  = NDArrayFactory::create<double>('c', {3,4});
+
+    input.linspace(0.1, 0.1);
+    input.p(5, 2.);
+    input.p(10, -1.);
+
+    const OpArgsHolder argsHolderFF({&input, &gain, &bias}, {}, {1});
+    const OpArgsHolder argsHolderBP({&input, &gain, &bias, &dLdO}, {}, {1});
+
+    nd4j::ops::layer_norm opFF;
+    nd4j::ops::layer_norm_bp opBP;
+
+    const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP);
+
+    ASSERT_TRUE(isGradCorrect);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, shape_cache_test1) {
+
+    auto x  = NDArrayFactory::create<float>('c', {2,3});
+    auto x2 = NDArrayFactory::create<float>('c', {4,3});
+    auto y  = NDArrayFactory::create<float>('c', {3,4});
+    x.linspace(1);
+    x2.linspace(1);
+    y.linspace(1);
+
+    nd4j::ops::matmul op;
+
+    auto result1 = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result1->status());
+    ASSERT_EQ(1, op.shapeCacheSize());
+
+    // same signature reuses cached shape
+    auto result2 = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result2->status());
+    ASSERT_EQ(1, op.shapeCacheSize());
+    ASSERT_TRUE(result1->at(0)->isSameShape(result2->at(0)));
+    ASSERT_TRUE(result1->at(0)->equalsTo(result2->at(0)));
+
+    // new input shape or new arguments give new entries
+    auto result3 = op.execute({&x2, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result3->status());
+    ASSERT_EQ(2, op.shapeCacheSize());
+    ASSERT_EQ(4, result3->at(0)->sizeAt(0));
+
+    auto result4 = op.execute({&y, &x}, {}, {1, 1});
+    ASSERT_EQ(Status::OK(), result4->status());
+    ASSERT_EQ(3, op.shapeCacheSize());
+    ASSERT_EQ(4, result4->at(0)->sizeAt(0));
+    ASSERT_EQ(2, result4->at(0)->sizeAt(1));
+
+    op.purgeShapeCache();
+    ASSERT_EQ(0, op.shapeCacheSize());
+
+    delete result1;
+    delete result2;
+    delete result3;
+    delete result4;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, shape_cache_test2) {
+
+    auto x = NDArrayFactory::create<float>('c', {2,6});
+    auto shape1 = NDArrayFactory::create<Nd4jLong>('c', {2}, {3, 4});
+    auto shape2 = NDArrayFactory::create<Nd4jLong>('c', {2}, {4, 3});
+
+    // reshape output depends on values of shape input, so it's never cached
+    nd4j::ops::reshape op;
+
+    auto result1 = op.execute({&x, &shape1}, {}, {});
+    auto result2 = op.execute({&x, &shape2}, {}, {});
+    ASSERT_EQ(Status::OK(), result1->status());
+    ASSERT_EQ(Status::OK(), result2->status());
+    ASSERT_EQ(0, op.shapeCacheSize());
+
+    ASSERT_EQ(3, result1->at(0)->sizeAt(0));
+    ASSERT_EQ(4, result2->at(0)->sizeAt(0));
+
+    delete result1;
+    delete result2;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, shape_cache_test3) {
+
+    // same op instance shared by threads: cache hits and misses interleave
+    nd4j::ops::matmul op;
+    std::vector<int> failures(4, 0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&op, &failures, t] {
+            for (int e = 0; e < 50; e++) {
+                Nd4jLong rows = 1 + (e + t) % 6;
+                auto x = NDArrayFactory::create<float>('c', {rows, 3});
+                auto y = NDArrayFactory::create<float>('c', {3, 4});
+
+                auto result = op.execute({&x, &y}, {}, {});
+                if (result->status() != Status::OK() || result->at(0)->sizeAt(0) != rows || result->at(0)->sizeAt(1) != 4)
+                    failures[t]++;
+
+                delete result;
+            }
+        });
+    }
+
+    for (auto &thread: threads)
+        thread.join();
+
+    for (auto f: failures)
+        ASSERT_EQ(0, f);
+
+    ASSERT_EQ(6, op.shapeCacheSize());
+}
+
 ////////////////////////////////////////////////////////////////////
 /*
 //2019/02/23 AB - GRU backprop tests disabled pending update of GRU backprop op after rewriting forward pass
@@ -2745,6 +2890,34 @@ TEST_F(DeclarableOpsTests9, Cholesky_Test_2) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, Cholesky_Test_Blocked_1) {
+    // matrix is wider than single factorization panel, so blocked Cholesky with trailing updates is used
+    const int n = 100;
+    NDArray x = NDArrayFactory::create<double>('c', {n, n});
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            x.p(i, j, 1. / (1. + nd4j::math::nd4j_abs<int>(i - j)) + (i == j ? 2. : 0.));
+
+    nd4j::ops::cholesky op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(result->status(), ND4J_STATUS_OK);
+    auto res = result->at(0);
+
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++)
+            ASSERT_EQ(0., res->e<double>(i, j));
+
+    // L * L^T restores input
+    nd4j::ops::matmul mmul;
+    auto product = mmul.execute({res, res}, {}, {0, 1});
+    ASSERT_EQ(product->status(), ND4J_STATUS_OK);
+    ASSERT_TRUE(x.equalsTo(product->at(0), 1.e-10));
+
+    delete product;
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////
 // TEST_F(DeclarableOpsTests9, gru_bp_test1) {
 
@@ -26,6 +26,8 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <GraphExecutioner.h>
+#include <graph/FlatUtils.h>
+#include <graph/MappedFile.h>
 #include <ops/declarable/CustomOperations.h>
 
 using namespace nd4j;
@@ -814,3 +816,208 @@ TEST_F(FlatBuffersTest, ReadLoops_SimpleWhile_1) {
 
  */
 #endif
+
+TEST_F(FlatBuffersTest, Test_Mapped_Import_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    x.linspace(1);
+
+    Variable var(&x, "x", -1);
+    var.markRemovable(false);
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+    std::vector<flatbuffers::Offset<FlatVariable>> variables_vector = {var.asFlatVariable(builder)};
+    auto variables = builder.CreateVector(variables_vector);
+    builder.Finish(CreateFlatGraph(builder, 119, variables));
+
+    const char *fileName = "./mapped_import_1.fb";
+    FILE *out = fopen(fileName, "wb");
+    ASSERT_TRUE(out != nullptr);
+    fwrite(builder.GetBufferPointer(), 1, builder.GetSize(), out);
+    fclose(out);
+
+    auto graph = GraphExecutioner::importFromMappedFlatBuffers(fileName);
+    auto restored = graph->getVariableSpace()->getVariable(-1)->getNDArray();
+
+    ASSERT_TRUE(x.isSameShape(restored));
+    ASSERT_TRUE(x.equalsTo(restored));
+
+    // arrays restored from mapped file reference it instead of own copies
+    MappedFile file(fileName);
+    auto mapped = reinterpret_cast<int8_t *>(file.buffer());
+    auto flatArray = GetFlatGraph(file.buffer())->variables()->Get(0)->ndarray();
+
+    auto referenced = FlatUtils::fromFlatArray(flatArray, true);
+    auto buffer = reinterpret_cast<int8_t *>(referenced->getBuffer());
+    ASSERT_TRUE(buffer >= mapped && buffer < mapped + file.length());
+    ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(buffer) % FlatUtils::BUFFER_ALIGNMENT);
+
+    auto copied = FlatUtils::fromFlatArray(flatArray);
+    buffer = reinterpret_cast<int8_t *>(copied->getBuffer());
+    ASSERT_TRUE(buffer < mapped || buffer >= mapped + file.length());
+
+    ASSERT_TRUE(x.equalsTo(referenced));
+    ASSERT_TRUE(x.equalsTo(copied));
+
+    delete referenced;
+    delete copied;
+    delete graph;
+    remove(fileName);
+}
+
+TEST_F(FlatBuffersTest, Test_Mapped_Import_2) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    x.linspace(1);
+
+    Variable var(&x, "x", -1);
+    var.markRemovable(false);
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+    std::vector<flatbuffers::Offset<FlatVariable>> variables_vector = {var.asFlatVariable(builder)};
+    auto variables = builder.CreateVector(variables_vector);
+    builder.Finish(CreateFlatGraph(builder, 119, variables));
+
+    const char *fileName = "./mapped_import_2.fb";
+    FILE *out = fopen(fileName, "wb");
+    ASSERT_TRUE(out != nullptr);
+    fwrite(builder.GetBufferPointer(), 1, builder.GetSize(), out);
+    fclose(out);
+
+    auto graph = GraphExecutioner::importFromMappedFlatBuffers(fileName);
+    auto original = graph->getVariableSpace()->getVariable(-1);
+    ASSERT_TRUE(original->isReferenced());
+
+    // clones made for every execution share mapped buffer instead of heap copies
+    auto clone = graph->clone();
+    auto cloned = clone->getVariableSpace()->getVariable(-1);
+    ASSERT_TRUE(cloned->isReferenced());
+    ASSERT_EQ(original->getNDArray()->getBuffer(), cloned->getNDArray()->getBuffer());
+
+    // and mapping stays alive as long as any clone does
+    delete graph;
+    ASSERT_TRUE(x.equalsTo(cloned->getNDArray()));
+
+    delete clone;
+    remove(fileName);
+}
+
+TEST_F(FlatBuffersTest, Test_Mapped_Import_3) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3}, {2.f, 4.f, 6.f, 8.f, 10.f, 12.f});
+
+    Variable var(&x, "x", -1);
+    var.markRemovable(false);
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+    auto fVar = var.asFlatVariable(builder);
+
+    // x + x, followed by abs: both nodes would run in place if mapped input wasn't protected
+    std::vector<int> in1 = {-1, -1}, in2 = {1};
+    std::vector<int> out1 = {2}, out2 = {0};
+    auto node1 = CreateFlatNode(builder, 1, builder.CreateString("add"), OpType_PAIRWISE, pairwise::Add, 0, builder.CreateVector(in1), 0, builder.CreateVector(out1));
+    auto node2 = CreateFlatNode(builder, 2, builder.CreateString("abs"), OpType_TRANSFORM_SAME, transform::Abs, 0, builder.CreateVector(in2), 0, builder.CreateVector(out2));
+
+    std::vector<flatbuffers::Offset<FlatVariable>> variables_vector = {fVar};
+    std::vector<flatbuffers::Offset<FlatNode>> nodes_vector = {node1, node2};
+
+    auto configuration = CreateFlatConfiguration(builder, 119, ExecutionMode_SEQUENTIAL, ProfilingMode_NONE, OutputMode_OPTIMIZED);
+    builder.Finish(CreateFlatGraph(builder, 119, builder.CreateVector(variables_vector), builder.CreateVector(nodes_vector), 0, configuration));
+
+    const char *fileName = "./mapped_import_3.fb";
+    FILE *out = fopen(fileName, "wb");
+    ASSERT_TRUE(out != nullptr);
+    fwrite(builder.GetBufferPointer(), 1, builder.GetSize(), out);
+    fclose(out);
+
+    auto graph = GraphExecutioner::importFromMappedFlatBuffers(fileName);
+    auto input = graph->getVariableSpace()->getVariable(-1);
+    ASSERT_TRUE(input->isReferenced());
+    ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(input->getNDArray()->getBuffer()) % FlatUtils::BUFFER_ALIGNMENT);
+
+    // mapping is read-only, so each execution has to leave mapped input untouched
+    for (int e = 0; e < 2; e++) {
+        auto clone = graph->clone();
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(clone));
+
+        auto z = clone->getVariableSpace()->getVariable(2)->getNDArray();
+        ASSERT_TRUE(exp.isSameShape(z));
+        ASSERT_TRUE(exp.equalsTo(z));
+
+        delete clone;
+    }
+
+    ASSERT_TRUE(x.equalsTo(input->getNDArray()));
+
+    delete graph;
+    remove(fileName);
+}
+
+TEST_F(FlatBuffersTest, Test_Mapped_Import_4) {
+    auto e = NDArrayFactory::create<float>('c', {7}, {10.f,0.778786f, 0.801198f, 0.724375f, 0.230894f, 0.727141f,10.f});
+
+    // exported by SameDiff: big-endian buffers go through copy path, graph has to behave exactly as regular import
+    auto graph = GraphExecutioner::importFromMappedFlatBuffers("./resources/pad_1D.fb");
+    ASSERT_TRUE(graph != nullptr);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(4));
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(z != nullptr);
+    ASSERT_EQ(e, *z);
+
+    delete graph;
+}
+
+TEST_F(FlatBuffersTest, Test_Import_Folding_1) {
+    auto c = NDArrayFactory::create<float>('c', {2, 3}, {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f});
+    auto v = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 1.f, 1.f, 1.f, 1.f, 1.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3}, {2.f, 3.f, 4.f, 5.f, 6.f, 7.f});
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+
+    // -1 is CONSTANT, -2 is VARIABLE
+    auto cArray = CreateFlatArray(builder, builder.CreateVector(c.getShapeInfoAsFlatVector()), builder.CreateVector(c.asByteVector()), nd4j::graph::DataType::DataType_FLOAT);
+    auto cVar = CreateFlatVariable(builder, CreateIntPair(builder, -1), 0, nd4j::graph::DataType::DataType_FLOAT, 0, cArray, -1, VarType_CONSTANT);
+
+    auto vArray = CreateFlatArray(builder, builder.CreateVector(v.getShapeInfoAsFlatVector()), builder.CreateVector(v.asByteVector()), nd4j::graph::DataType::DataType_FLOAT);
+    auto vVar = CreateFlatVariable(builder, CreateIntPair(builder, -2), 0, nd4j::graph::DataType::DataType_FLOAT, 0, vArray, -1, VarType_VARIABLE);
+
+    // explicit output has to be announced as ARRAY variable
+    auto zVar = CreateFlatVariable(builder, CreateIntPair(builder, 2, 0), 0, nd4j::graph::DataType::DataType_FLOAT, 0, 0, -1, VarType_ARRAY);
+
+    std::vector<int> in1 = {-1}, in2 = {1, -2}, in3 = {-2};
+    std::vector<int> out1 = {2}, out2 = {0}, out3 = {0};
+
+    // node 1 depends on constant only, node 3 doesn't contribute to outputs
+    auto node1 = CreateFlatNode(builder, 1, builder.CreateString("abs"), OpType_TRANSFORM_SAME, transform::Abs, 0, builder.CreateVector(in1), 0, builder.CreateVector(out1));
+    auto node2 = CreateFlatNode(builder, 2, builder.CreateString("add"), OpType_PAIRWISE, pairwise::Add, 0, builder.CreateVector(in2), 0, builder.CreateVector(out2));
+    auto node3 = CreateFlatNode(builder, 3, builder.CreateString("cos"), OpType_TRANSFORM_STRICT, transform::Cosine, 0, builder.CreateVector(in3), 0, builder.CreateVector(out3));
+
+    std::vector<flatbuffers::Offset<FlatVariable>> variables_vector = {cVar, vVar, zVar};
+    std::vector<flatbuffers::Offset<FlatNode>> nodes_vector = {node1, node2, node3};
+    std::vector<flatbuffers::Offset<IntPair>> outputs_vector = {CreateIntPair(builder, 2, 0)};
+
+    auto configuration = CreateFlatConfiguration(builder, 119, ExecutionMode_SEQUENTIAL, ProfilingMode_NONE, OutputMode_EXPLICIT);
+    builder.Finish(CreateFlatGraph(builder, 119, builder.CreateVector(variables_vector), builder.CreateVector(nodes_vector), builder.CreateVector(outputs_vector), configuration));
+
+    Graph graph(GetFlatGraph(builder.GetBufferPointer()));
+    auto vs = graph.getVariableSpace();
+
+    // only node 2 is left for execution
+    int planned = 0;
+    for (auto &l: *graph.getOnion())
+        planned += l.second->size();
+
+    ASSERT_EQ(1, planned);
+    ASSERT_EQ(3, graph.totalNodes());
+    ASSERT_TRUE(vs->getVariable(1)->isConstant());
+    ASSERT_FALSE(vs->getVariable(-2)->isConstant());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto z = vs->getVariable(2)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    ASSERT_TRUE(!vs->hasVariable(3) || !vs->getVariable(3)->hasNDArray());
+}
@@ -1089,6 +1089,113 @@ TEST_F(GraphTests, MemoryEstimationTest5) {
     ASSERT_EQ((25 + 100) * x->sizeOfT(), memReq);
 }
 
+TEST_F(GraphTests, OutputAliasing_Concat_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 2, 3});
+    x->linspace(1);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::concat op;
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Neg, 1, {-1}, {3});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-1}, {3});
+    auto nodeC = new Node(&op, 3, {1, 2}, {}, {}, 0.0f, {}, {1});
+    nodeA->markInplace(false);
+    nodeB->markInplace(false);
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto vs = graph.getVariableSpace();
+    auto z = vs->getVariable(3)->getNDArray();
+    auto exp = NDArrayFactory::create<float>('c', {1, 4, 3}, {-1.f, -2.f, -3.f, -4.f, -5.f, -6.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // both producers have written their results into concat output directly
+    ASSERT_EQ(z->getBuffer(), vs->getVariable(1)->getNDArray()->getBuffer());
+    ASSERT_EQ(z->bufferWithOffset(6), vs->getVariable(2)->getNDArray()->getBuffer());
+}
+
+TEST_F(GraphTests, OutputAliasing_Split_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {6, 2});
+    x->linspace(1);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::split op;
+
+    auto node = new Node(&op, 1, {-1}, {}, {}, 0.0f, {}, {3});
+    graph.addNode(node);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto vs = graph.getVariableSpace();
+    for (int e = 0; e < 3; e++) {
+        auto z = vs->getVariable(1, e)->getNDArray();
+        auto exp = NDArrayFactory::create<float>('c', {2, 2}, {4.f * e + 1.f, 4.f * e + 2.f, 4.f * e + 3.f, 4.f * e + 4.f});
+
+        ASSERT_TRUE(exp.isSameShape(z));
+        ASSERT_TRUE(exp.equalsTo(z));
+
+        // outputs are views of input
+        ASSERT_EQ(x->bufferWithOffset(4 * e), z->getBuffer());
+    }
+}
+
+TEST_F(GraphTests, Optimized_Inplace_1) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3});
+    x->linspace(-2);
+    auto original = x->dup();
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::tanh opT;
+    nd4j::ops::sigmoid opS;
+    nd4j::ops::relu opR;
+
+    // x is variable, so tanh can't overwrite it
+    auto nodeA = new Node(&opT, 1, {-1}, {2});
+    // the only consumer of node 1
+    auto nodeB = new Node(&opS, 2, {1}, {3, 4});
+    // both read node 2
+    auto nodeC = new Node(&opT, 3, {2}, {});
+    auto nodeD = new Node(&opR, 4, {2}, {}, {}, 0.0f, {0.0});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_FALSE(graph.nodeById(1)->isInplace());
+    ASSERT_TRUE(graph.nodeById(2)->isInplace());
+    ASSERT_FALSE(graph.nodeById(3)->isInplace());
+    ASSERT_FALSE(graph.nodeById(4)->isInplace());
+
+    auto vs = graph.getVariableSpace();
+    ASSERT_TRUE(vs->getVariable(1)->getNDArray() == vs->getVariable(2)->getNDArray());
+    ASSERT_TRUE(original->equalsTo(x));
+
+    auto exp = x->transform(transform::Tanh).transform(transform::Sigmoid);
+    ASSERT_TRUE(exp.transform(transform::Tanh).equalsTo(vs->getVariable(3)->getNDArray()));
+    ASSERT_TRUE(exp.equalsTo(vs->getVariable(4)->getNDArray()));
+
+    delete original;
+}
+
 TEST_F(GraphTests, TestGraphInGraph_1) {
     // this one is external graph
     Graph graphA;
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include "testlayers.h"
+#include <helpers/HalfConversions.h>
+#include <helpers/MmulHelper.h>
+#include <loops/type_conversions.h>
+#include <NDArrayFactory.h>
+#include <cstring>
+
+using namespace nd4j;
+
+class HalfConversionsTests : public testing::Test {
+public:
+    // covers normals, denormals, zeros, infinities and values near rounding boundaries
+    static std::vector<float> values() {
+        std::vector<float> result;
+        for (int e = -30; e <= 30; e++) {
+            auto base = std::ldexp(1.0f, e);
+            for (int m = 0; m < 37; m++) {
+                result.emplace_back(base * (1.0f + m / 37.0f));
+                result.emplace_back(-base * (1.0f + m / 37.0f));
+            }
+        }
+
+        result.emplace_back(0.0f);
+        result.emplace_back(-0.0f);
+        result.emplace_back(65504.0f);
+        result.emplace_back(1e-7f);
+        result.emplace_back(std::numeric_limits<float>::infinity());
+        result.emplace_back(-std::numeric_limits<float>::infinity());
+        return result;
+    }
+};
+
+TEST_F(HalfConversionsTests, Test_Float16_Bulk_1) {
+    auto x = values();
+    std::vector<float16> z(x.size());
+    std::vector<float> r(x.size());
+
+    HalfConversions::fromFloat(x.data(), z.data(), x.size());
+    HalfConversions::toFloat(z.data(), r.data(), z.size());
+
+    for (size_t e = 0; e < x.size(); e++) {
+        float16 exp(x[e]);
+        ASSERT_EQ(exp.data.getX(), z[e].data.getX());
+        ASSERT_EQ(static_cast<float>(exp), r[e]);
+    }
+}
+
+TEST_F(HalfConversionsTests, Test_BFloat16_Bulk_1) {
+    auto x = values();
+    std::vector<bfloat16> z(x.size());
+    std::vector<float> r(x.size());
+
+    HalfConversions::fromFloat(x.data(), z.data(), x.size());
+    HalfConversions::toFloat(z.data(), r.data(), z.size());
+
+    for (size_t e = 0; e < x.size(); e++) {
+        bfloat16 exp(x[e]);
+        ASSERT_EQ(exp._data, z[e]._data);
+        ASSERT_EQ(static_cast<float>(exp), r[e]);
+    }
+}
+
+TEST_F(HalfConversionsTests, Test_BFloat16_Bulk_2) {
+    // NaNs with various payloads, infinities, denormals and largest finite values
+    std::vector<uint32_t> bits = {0x7F800001u, 0xFF800001u, 0x7FC00000u, 0x7FFFFFFFu, 0xFFFFFFFFu, 0x7FBFFFFFu,
+                                  0x7F800000u, 0xFF800000u, 0x00000001u, 0x80000001u, 0x00400000u, 0x007FFFFFu,
+                                  0x807FFFFFu, 0x00008000u, 0x00018000u, 0x7F7FFFFFu, 0xFF7FFFFFu, 0x00000000u, 0x80000000u};
+
+    std::vector<float> x(bits.size());
+    std::memcpy(x.data(), bits.data(), bits.size() * sizeof(float));
+    std::vector<bfloat16> z(x.size());
+
+    HalfConversions::fromFloat(x.data(), z.data(), x.size());
+
+    for (size_t e = 0; e < x.size(); e++) {
+        bfloat16 exp(x[e]);
+        ASSERT_EQ(exp._data, z[e]._data);
+        ASSERT_EQ(std::isnan(x[e]), std::isnan(static_cast<float>(z[e])));
+        if (std::isinf(x[e])) {
+            ASSERT_EQ(x[e], static_cast<float>(z[e]));
+        }
+    }
+}
+
+TEST_F(HalfConversionsTests, Test_ConvertGeneric_1) {
+    const int length = 5000;
+    std::vector<float16> x(length);
+    std::vector<double> z(length);
+    std::vector<bfloat16> b(length);
+
+    for (int e = 0; e < length; e++)
+        x[e] = static_cast<float16>(e * 0.25f);
+
+    TypeCast::convertGeneric<float16, double>(nullptr, x.data(), length, z.data());
+    TypeCast::convertGeneric<double, bfloat16>(nullptr, z.data(), length, b.data());
+
+    for (int e = 0; e < length; e++) {
+        ASSERT_EQ(static_cast<double>(static_cast<float>(x[e])), z[e]);
+        ASSERT_EQ(bfloat16(static_cast<float>(z[e]))._data, b[e]._data);
+    }
+}
+
+TEST_F(HalfConversionsTests, Test_Mmul_Accumulation_1) {
+    // half accumulator stalls at 32.0 here, since 0.01 is below half of its ulp
+    auto x = NDArrayFactory::create<float16>('c', {1, 4096});
+    auto y = NDArrayFactory::create<float16>('c', {4096, 1});
+    x.assign(0.01f);
+    y.assign(1.0f);
+
+    auto z = MmulHelper::mmul(&x, &y);
+    ASSERT_EQ(nd4j::DataType::HALF, z->dataType());
+    ASSERT_NEAR(40.96f, z->e<float>(0), 0.1f);
+
+    delete z;
+}
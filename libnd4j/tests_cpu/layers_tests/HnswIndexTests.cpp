@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include "testlayers.h"
+#include <helpers/HnswIndex.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+
+using namespace nd4j;
+
+// file in system temp directory, removed when test finishes, even if assertion fails
+class HnswTempFile {
+public:
+    std::string path;
+
+    explicit HnswTempFile(const char *name) {
+        auto dir = std::getenv("TMPDIR");
+        if (dir == nullptr)
+            dir = std::getenv("TEMP");
+
+        path = std::string(dir != nullptr ? dir : "/tmp") + "/" + name + "_" + std::to_string(std::random_device()());
+    }
+
+    ~HnswTempFile() {
+        std::remove(path.c_str());
+    }
+
+    // overwrites 8 bytes at given position, used to corrupt saved index
+    void patch(Nd4jLong position, Nd4jLong value) {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(position);
+        file.write(reinterpret_cast<const char *>(&value), sizeof(Nd4jLong));
+    }
+};
+
+class HnswIndexTests : public testing::Test {
+public:
+    static const int rows = 3000;
+    static const int dims = 16;
+    static const int queries = 50;
+    static const int k = 10;
+
+    std::vector<float> data;
+    std::vector<float> query;
+
+    HnswIndexTests() {
+        std::mt19937 rng(119);
+        std::normal_distribution<float> dist;
+
+        data.resize(rows * dims);
+        query.resize(queries * dims);
+
+        for (auto &v: data)
+            v = dist(rng);
+
+        for (auto &v: query)
+            v = dist(rng);
+    }
+
+    // exact euclidean neighbors
+    std::vector<int> bruteForce(int q) {
+        std::vector<std::pair<float, int>> all(rows);
+        for (int r = 0; r < rows; r++) {
+            float sum = 0.0f;
+            for (int e = 0; e < dims; e++) {
+                auto d = query[q * dims + e] - data[r * dims + e];
+                sum += d * d;
+            }
+            all[r] = {sum, r};
+        }
+
+        std::partial_sort(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(k), all.end());
+
+        std::vector<int> result;
+        for (int e = 0; e < k; e++)
+            result.emplace_back(all[e].second);
+
+        return result;
+    }
+};
+
+// gtest assertions take arguments by reference, so constants need definitions
+const int HnswIndexTests::rows;
+const int HnswIndexTests::dims;
+const int HnswIndexTests::queries;
+const int HnswIndexTests::k;
+
+TEST_F(HnswIndexTests, Test_Recall_1) {
+    HnswIndex index(dims, HnswIndex::METRIC_EUCLIDEAN, 16, 100);
+
+    // second batch makes index grow beyond initial capacity
+    index.add(data.data(), rows / 2);
+    index.add(data.data() + (rows / 2) * dims, rows - rows / 2);
+    ASSERT_EQ(rows, index.size());
+
+    std::vector<Nd4jLong> ids(queries * k);
+    std::vector<float> distances(queries * k);
+    index.search(query.data(), queries, k, 64, ids.data(), distances.data());
+
+    int hits = 0;
+    for (int q = 0; q < queries; q++) {
+        auto exact = bruteForce(q);
+        for (int e = 0; e < k; e++) {
+            if (e > 0) {
+                ASSERT_TRUE(distances[q * k + e - 1] <= distances[q * k + e]);
+            }
+
+            if (std::find(exact.begin(), exact.end(), static_cast<int>(ids[q * k + e])) != exact.end())
+                hits++;
+        }
+    }
+
+    ASSERT_TRUE(hits >= queries * k * 9 / 10);
+}
+
+TEST_F(HnswIndexTests, Test_Save_Load_1) {
+    HnswIndex index(dims, HnswIndex::METRIC_COSINE, 8, 64);
+    index.add(data.data(), rows);
+
+    std::vector<Nd4jLong> expIds(queries * k);
+    std::vector<float> expDistances(queries * k);
+    index.search(query.data(), queries, k, 32, expIds.data(), expDistances.data());
+
+    HnswTempFile file("hnsw_index");
+    index.save(file.path.c_str());
+    std::unique_ptr<HnswIndex> loaded(HnswIndex::load(file.path.c_str()));
+
+    ASSERT_EQ(rows, loaded->size());
+    ASSERT_EQ(dims, loaded->dimensions());
+
+    std::vector<Nd4jLong> ids(queries * k);
+    std::vector<float> distances(queries * k);
+    loaded->search(query.data(), queries, k, 32, ids.data(), distances.data());
+
+    ASSERT_EQ(expIds, ids);
+    ASSERT_EQ(expDistances, distances);
+
+    // index copies mapped data once it has to grow
+    loaded->add(data.data(), 1);
+    ASSERT_EQ(rows + 1, loaded->size());
+    ASSERT_FALSE(loaded->isMapped());
+
+    loaded->search(data.data(), 1, 2, 32, ids.data(), distances.data());
+    ASSERT_TRUE((ids[0] == 0 && ids[1] == rows) || (ids[0] == rows && ids[1] == 0));
+}
+
+TEST_F(HnswIndexTests, Test_Load_Corrupted_1) {
+    HnswIndex index(2, HnswIndex::METRIC_EUCLIDEAN, 4, 16);
+    index.add(data.data(), 4);
+
+    // layout: 72 bytes of header, then 4 x 2 vectors, 4 levels and links of layer 0, each section aligned to 8 bytes
+    const Nd4jLong entryPoint = 56;
+    const Nd4jLong links0 = 72 + 32 + 16;
+
+    HnswTempFile file("hnsw_corrupted");
+    index.save(file.path.c_str());
+    std::unique_ptr<HnswIndex> loaded(HnswIndex::load(file.path.c_str()));
+    ASSERT_EQ(4, loaded->size());
+    loaded.reset();
+
+    file.patch(entryPoint, 4);
+    ASSERT_ANY_THROW(HnswIndex::load(file.path.c_str()));
+
+    index.save(file.path.c_str());
+
+    // number of links of node 0 stays, first neighbor id points beyond index
+    file.patch(links0, (static_cast<Nd4jLong>(1000) << 32) | 1);
+    ASSERT_ANY_THROW(HnswIndex::load(file.path.c_str()));
+}
+
+TEST_F(HnswIndexTests, Test_Load_Corrupted_2) {
+    HnswIndex index(2, HnswIndex::METRIC_EUCLIDEAN, 4, 16);
+    index.add(data.data(), 4);
+
+    // header fields used to derive index parameters and section sizes
+    const Nd4jLong dimensions = 12;
+    const Nd4jLong M = 20;
+    const Nd4jLong size = 48;
+
+    HnswTempFile file("hnsw_corrupted_header");
+
+    // zero dimensions, metric stays euclidean
+    index.save(file.path.c_str());
+    file.patch(dimensions, 0);
+    ASSERT_ANY_THROW(HnswIndex::load(file.path.c_str()));
+
+    // M0 = 2 * M overflows int
+    index.save(file.path.c_str());
+    file.patch(M, (static_cast<Nd4jLong>(0x80000000L) << 32) | 0x40000000L);
+    ASSERT_ANY_THROW(HnswIndex::load(file.path.c_str()));
+
+    // consistent, but way too big M
+    index.save(file.path.c_str());
+    file.patch(M, (static_cast<Nd4jLong>(0x20000000L) << 32) | 0x10000000L);
+    ASSERT_ANY_THROW(HnswIndex::load(file.path.c_str()));
+
+    // size * (M0 + 1) section would be bigger than the file
+    index.save(file.path.c_str());
+    file.patch(size, static_cast<Nd4jLong>(1) << 40);
+    ASSERT_ANY_THROW(HnswIndex::load(file.path.c_str()));
+}
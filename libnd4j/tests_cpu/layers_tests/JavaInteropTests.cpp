@@ -24,6 +24,7 @@
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/GraphHolder.h>
 #include <graph/FlatUtils.h>
+#include <graph/ExecutionQueue.h>
 #include "testlayers.h"
 #include <array>
 
@@ -152,6 +153,160 @@ TEST_F(JavaInteropTests, Test_Squeeze_1) {
     ASSERT_EQ(e, z);
 }
 
+TEST_F(JavaInteropTests, Test_Squeeze_2) {
+    auto x = NDArrayFactory::create<float>('c', {1, 6}, {1, 2, 3, 4, 5, 6});
+    auto z = NDArrayFactory::create<float>('c', {6});
+    auto e = NDArrayFactory::create<float>('c', {6}, {1, 2, 3, 4, 5, 6});
+
+    nd4j::ops::squeeze op;
+
+    Nd4jPointer ptrsInBuffer[] = {(Nd4jPointer) x.getBuffer()};
+    Nd4jPointer ptrsInShapes[] = {(Nd4jPointer) x.getShapeInfo()};
+
+    Nd4jPointer ptrsOutBuffers[] = {(Nd4jPointer) z.getBuffer()};
+    Nd4jPointer ptrsOutShapes[] = {(Nd4jPointer) z.getShapeInfo()};
+
+    NativeOps nativeOps;
+
+    // handle is resolved once, and reused for every call
+    auto handle = nativeOps.getCustomOpHandle(op.getOpHash());
+    ASSERT_TRUE(handle != nullptr);
+    ASSERT_TRUE(handle == nativeOps.getCustomOpHandle(op.getOpHash()));
+
+    for (int i = 0; i < 3; i++) {
+        z.assign(0.f);
+        auto status = nativeOps.execCustomOpByHandle(nullptr, handle, ptrsInBuffer, ptrsInShapes, 1, ptrsOutBuffers, ptrsOutShapes, 1, nullptr, 0, nullptr, 0, nullptr, 0, false);
+        ASSERT_EQ(Status::OK(), status);
+    }
+
+    ASSERT_EQ(e, z);
+}
+
+TEST_F(JavaInteropTests, Test_OpContext_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto y = NDArrayFactory::create<float>('c', {2, 3}, {6, 5, 4, 3, 2, 1});
+    auto z = NDArrayFactory::create<float>('c', {2, 3});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {7, 7, 7, 7, 7, 7});
+
+    nd4j::ops::add op;
+    NativeOps nativeOps;
+
+    // context is created once, and only buffers are bound for every call
+    auto ctx = nativeOps.createOpContext();
+    for (int i = 0; i < 3; i++) {
+        z.assign(0.f);
+        nativeOps.resetOpContext(ctx);
+        nativeOps.setOpContextInput(ctx, 0, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+        nativeOps.setOpContextInput(ctx, 1, y.getBuffer(), y.getShapeInfo(), nullptr, nullptr);
+        nativeOps.setOpContextOutput(ctx, 0, z.getBuffer(), z.getShapeInfo(), nullptr, nullptr);
+
+        auto status = nativeOps.execCustomOp(nullptr, op.getOpHash(), ctx);
+        ASSERT_EQ(Status::OK(), status);
+        ASSERT_EQ(e, z);
+    }
+
+    nativeOps.deleteOpContext(ctx);
+}
+
+TEST_F(JavaInteropTests, Test_Async_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto z = NDArrayFactory::create<float>('c', {2, 3});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {2, 4, 6, 8, 10, 12});
+
+    nd4j::ops::add op;
+    NativeOps nativeOps;
+
+    auto ctx = nativeOps.createOpContext();
+    nativeOps.setOpContextInput(ctx, 0, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextInput(ctx, 1, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextOutput(ctx, 0, z.getBuffer(), z.getShapeInfo(), nullptr, nullptr);
+
+    auto ticket = nativeOps.execCustomOpAsync(nullptr, 1, op.getOpHash(), ctx, nullptr, 0);
+    ASSERT_EQ(Status::OK(), nativeOps.waitForTicket(ticket));
+    ASSERT_TRUE(nativeOps.isTicketDone(ticket));
+    ASSERT_EQ(e, z);
+
+    nativeOps.deleteTicket(ticket);
+    nativeOps.deleteOpContext(ctx);
+}
+
+TEST_F(JavaInteropTests, Test_Async_2) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+    auto z = NDArrayFactory::create<float>('c', {2, 3});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {4, 8, 12, 16, 20, 24});
+
+    nd4j::ops::add op;
+    NativeOps nativeOps;
+
+    auto ctx0 = nativeOps.createOpContext();
+    nativeOps.setOpContextInput(ctx0, 0, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextInput(ctx0, 1, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextOutput(ctx0, 0, y.getBuffer(), y.getShapeInfo(), nullptr, nullptr);
+
+    auto ctx1 = nativeOps.createOpContext();
+    nativeOps.setOpContextInput(ctx1, 0, y.getBuffer(), y.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextInput(ctx1, 1, y.getBuffer(), y.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextOutput(ctx1, 0, z.getBuffer(), z.getShapeInfo(), nullptr, nullptr);
+
+    // second op runs in other stream, and consumes result of first one
+    auto first = nativeOps.execCustomOpAsync(nullptr, 2, op.getOpHash(), ctx0, nullptr, 0);
+    Nd4jPointer deps[] = {first};
+    auto second = nativeOps.execCustomOpAsync(nullptr, 3, op.getOpHash(), ctx1, deps, 1);
+
+    // unknown op fails its ticket, not the stream
+    auto bad = nativeOps.execCustomOpAsync(nullptr, 3, 119, ctx1, nullptr, 0);
+    nativeOps.syncExecutionStream(3);
+
+    ASSERT_TRUE(nativeOps.isTicketDone(first));
+    ASSERT_TRUE(nativeOps.isTicketDone(second));
+    ASSERT_EQ(Status::OK(), nativeOps.waitForTicket(second));
+    ASSERT_EQ(ND4J_STATUS_BAD_INPUT, nativeOps.waitForTicket(bad));
+    ASSERT_EQ(e, z);
+
+    nativeOps.deleteTicket(first);
+    nativeOps.deleteTicket(second);
+    nativeOps.deleteTicket(bad);
+    nativeOps.deleteOpContext(ctx0);
+    nativeOps.deleteOpContext(ctx1);
+}
+
+TEST_F(JavaInteropTests, Test_Async_3) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto z = NDArrayFactory::create<float>('c', {2, 3});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {2, 4, 6, 8, 10, 12});
+
+    nd4j::ops::add op;
+    NativeOps nativeOps;
+
+    auto ctx = nativeOps.createOpContext();
+    nativeOps.setOpContextInput(ctx, 0, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextInput(ctx, 1, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr);
+    nativeOps.setOpContextOutput(ctx, 0, z.getBuffer(), z.getShapeInfo(), nullptr, nullptr);
+
+    auto before = nd4j::graph::ExecutionQueue::getInstance()->numberOfStreams();
+    auto ticket = nativeOps.execCustomOpAsync(nullptr, 4, op.getOpHash(), ctx, nullptr, 0);
+    ASSERT_EQ(before + 1, nd4j::graph::ExecutionQueue::getInstance()->numberOfStreams());
+
+    // pending task is still executed after stream is destroyed
+    nativeOps.destroyExecutionStream(4);
+    ASSERT_EQ(before, nd4j::graph::ExecutionQueue::getInstance()->numberOfStreams());
+
+    ASSERT_EQ(Status::OK(), nativeOps.waitForTicket(ticket));
+    ASSERT_EQ(e, z);
+    nativeOps.deleteTicket(ticket);
+
+    // same stream id can be used again
+    z.assign(0.f);
+    ticket = nativeOps.execCustomOpAsync(nullptr, 4, op.getOpHash(), ctx, nullptr, 0);
+    ASSERT_EQ(Status::OK(), nativeOps.waitForTicket(ticket));
+    ASSERT_EQ(e, z);
+
+    nativeOps.destroyExecutionStream(4);
+    nativeOps.deleteTicket(ticket);
+    nativeOps.deleteOpContext(ctx);
+}
+
 TEST_F(JavaInteropTests, Test_RDiv_1) {
     auto x = NDArrayFactory::create<double>('c', {3}, {2, 2, 2});
     auto y = NDArrayFactory::create<double>('c', {3}, {4, 6, 8});
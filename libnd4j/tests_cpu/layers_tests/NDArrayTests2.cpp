@@ -21,6 +21,9 @@
 #include "testlayers.h"
 #include <memory>
 #include <NDArray.h>
+#include <NDArrayExpression.h>
+#include <NDArrayAccessor.h>
+#include <TadViews.h>
 #include <DebugHelper.h>
 #include <ops/declarable/headers/parity_ops.h>
 
@@ -1283,3 +1286,90 @@ TEST_F(NDArrayTest2, reduce_1) {
     delete arr6s;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, Lazy_Expression_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto y = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto b = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+    auto c = NDArrayFactory::create<float>('c', {3, 1}, {0.5f, 1.f, 2.f});
+    auto z = NDArrayFactory::create<float>('c', {2, 3, 4});
+    x.linspace(1);
+    y.linspace(-1, 0.1);
+
+    auto exp = (x * y + b) * c - 1.f;
+    z.assign((expr::lazy(x) * y + b) * c - 1.);
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    auto w = expr::sigmoid(expr::lazy(x) / 10.).evaluate();
+    ASSERT_TRUE(x.isSameShape(w));
+    ASSERT_TRUE((x / 10.f).transform(transform::Sigmoid).equalsTo(w));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, Lazy_Expression_Aliasing_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f});
+    auto exp = NDArrayFactory::create<float>('c', {3, 3}, {2.f, 6.f, 10.f, 6.f, 10.f, 14.f, 10.f, 14.f, 18.f});
+
+    auto t = x.transpose();
+    x.assign(expr::lazy(x) + *t);
+
+    ASSERT_TRUE(exp.equalsTo(x));
+
+    delete t;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, Accessor_Test_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3, 4});
+    x.linspace(0);
+
+    NDArrayAccessor<float, 3> acc(x);
+    ASSERT_EQ(23.f, acc(1, 2, 3));
+    ASSERT_EQ(13.f, acc[13]);
+
+    // permuted view: traversal follows logical c-order, same as e<T>(i)
+    auto p = x.permute({2, 1, 0});
+    NDArrayAccessor<const float> view(*p);
+    ASSERT_FALSE(view.isLinear());
+
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        ASSERT_EQ(p->e<float>(it.index()), *it);
+        ASSERT_EQ(p->e<float>(it.index()), view[it.index()]);
+    }
+
+    ASSERT_THROW(NDArrayAccessor<double> wrongType(x), std::invalid_argument);
+
+    delete p;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, TadViews_Test_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4, 5});
+    x.linspace(1);
+
+    std::unique_ptr<ResultSet> list(x.allTensorsAlongDimension({0, 2}));
+    TadViews views(x, {2, 0});
+
+    ASSERT_EQ(list->size(), views.size());
+    ASSERT_EQ(15, views.tadLength());
+
+    for (Nd4jLong i = 0; i < views.size(); i++) {
+        auto view = views.at(i);
+        ASSERT_TRUE(list->at(i)->equalsTo(&view));
+        ASSERT_EQ(list->at(i)->getBuffer(), views.bufferAt(i));
+
+        auto acc = views.accessor<float, 2>(i);
+        ASSERT_EQ(list->at(i)->e<float>(2, 4), acc(2, 4));
+    }
+
+    // writes through views go to original array
+    for (auto view : views)
+        view.assign(0.f);
+
+    ASSERT_EQ(0.f, x.reduceNumber(reduce::Sum).e<float>(0));
+
+    ASSERT_EQ(0, TadViews(x, {}).size());
+    ASSERT_THROW(views.accessor<double>(0), std::invalid_argument);
+}
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include "testlayers.h"
+#include <helpers/OpTracer.h>
+#include <ops/declarable/CustomOperations.h>
+#include <NDArrayFactory.h>
+#include <thread>
+#include <set>
+
+using namespace nd4j;
+
+class OpTracerTests : public testing::Test {
+public:
+    OpTracerTests() {
+        OpTracer::getInstance()->reset();
+    }
+
+    ~OpTracerTests() {
+        OpTracer::getInstance()->setEnabled(false);
+        OpTracer::getInstance()->reset();
+    }
+};
+
+TEST_F(OpTracerTests, Test_Disabled_1) {
+    OpTracer::getInstance()->setEnabled(false);
+
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+
+    nd4j::ops::add op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    ASSERT_EQ(0, OpTracer::getInstance()->events().size());
+}
+
+TEST_F(OpTracerTests, Test_Custom_Op_1) {
+    OpTracer::getInstance()->setEnabled(true);
+
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+
+    nd4j::ops::add op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    auto events = OpTracer::getInstance()->events();
+    ASSERT_EQ(1, events.size());
+
+    auto &e = events[0];
+    ASSERT_EQ(std::string("add"), std::string(e.name));
+    ASSERT_EQ(2, e.numInputs);
+    ASSERT_EQ(2, e.ranks[0]);
+    ASSERT_EQ(3, e.shapes[1][1]);
+    ASSERT_EQ((int) nd4j::DataType::FLOAT32, e.dataType);
+    ASSERT_EQ(6 * sizeof(float), e.bytes);
+    ASSERT_TRUE(e.end >= e.start);
+
+    auto json = OpTracer::getInstance()->asChromeTrace();
+    ASSERT_TRUE(json.find("\"name\": \"add\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"ph\": \"X\"") != std::string::npos);
+    ASSERT_TRUE(json.find("[2, 3], [2, 3]") != std::string::npos);
+
+    OpTracer::getInstance()->reset();
+    ASSERT_EQ(0, OpTracer::getInstance()->events().size());
+}
+
+TEST_F(OpTracerTests, Test_Threads_1) {
+    OpTracer::getInstance()->setEnabled(true);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([] () {
+            for (int e = 0; e < 10; e++) {
+                OpTraceScope scope("thread_op", e);
+            }
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    auto events = OpTracer::getInstance()->events();
+    ASSERT_EQ(40, events.size());
+
+    std::set<int> tids;
+    for (int e = 0; e < (int) events.size(); e++) {
+        tids.insert(events[e].threadId);
+
+        if (e > 0) {
+            ASSERT_TRUE(events[e - 1].start <= events[e].start);
+        }
+    }
+
+    ASSERT_EQ(4, tids.size());
+}
+
+TEST_F(OpTracerTests, Test_Buffer_Reuse_1) {
+    OpTracer::getInstance()->setEnabled(true);
+
+    // make sure there's an idle buffer of current capacity before measuring
+    std::thread([] () {
+        OpTraceScope scope("warmup_op", 0);
+    }).join();
+    OpTracer::getInstance()->reset();
+
+    auto before = OpTracer::getInstance()->numBuffers();
+
+    // threads run one after another, so each of them picks up buffer released by previous one
+    for (int t = 0; t < 16; t++) {
+        std::thread([t] () {
+            OpTraceScope scope("sequential_op", t);
+        }).join();
+    }
+
+    ASSERT_EQ(before, OpTracer::getInstance()->numBuffers());
+
+    auto events = OpTracer::getInstance()->events();
+    ASSERT_EQ(16, events.size());
+
+    std::set<int> tids;
+    for (auto &e : events)
+        tids.insert(e.threadId);
+
+    ASSERT_EQ(16, tids.size());
+}
+
+TEST_F(OpTracerTests, Test_Wrap_Around_1) {
+    OpTraceBuffer buffer(0, 16);
+    std::atomic<bool> done(false);
+
+    // writer keeps overwriting slots while events are collected
+    std::thread writer([&] () {
+        TraceEvent event;
+        for (Nd4jLong e = 0; e < 200000; e++) {
+            event.opNum = (int) (e % 1000);
+            event.start = e;
+            event.end = e;
+            event.bytes = e;
+            buffer.push(event);
+        }
+        done.store(true);
+    });
+
+    while (!done.load()) {
+        std::vector<TraceEvent> events;
+        buffer.collect(events);
+
+        // every returned event must be one written as a whole
+        for (auto &v : events) {
+            ASSERT_EQ(v.start, v.end);
+            ASSERT_EQ(v.start, v.bytes);
+            ASSERT_EQ(v.start % 1000, v.opNum);
+        }
+    }
+
+    writer.join();
+
+    std::vector<TraceEvent> events;
+    buffer.collect(events);
+    ASSERT_EQ(16, events.size());
+    ASSERT_EQ(199999, events.back().start);
+}
@@ -1426,3 +1426,97 @@ TEST_F(ParityOpsTests, scatterND_update_test5) {
     delete result;
 }
 
+
+////////////////////////////////////////////////////////////////////////
+TEST_F(ParityOpsTests, scatterAdd_duplicates_test1) {
+    auto matrix = NDArrayFactory::create<float>('c', {3, 4});
+    auto idc = NDArrayFactory::create<Nd4jLong>('c', {1000});
+    auto updates = NDArrayFactory::create<float>('c', {1000, 4});
+    auto exp = NDArrayFactory::create<float>('c', {3, 4}, {499.f, 499.f, 499.f, 499.f, 1.f, 1.f, 1.f, 1.f, 500.f, 500.f, 500.f, 500.f});
+
+    // even rows go to the first output row, odd rows to the last one, except row 500 which goes to the middle one
+    for (int e = 0; e < 1000; e++)
+        idc.p(e, e == 500 ? 1 : (e % 2 == 0 ? 0 : 2));
+
+    updates.assign(1.f);
+
+    nd4j::ops::scatter_add op;
+    auto result = op.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////
+TEST_F(ParityOpsTests, scatterUpd_duplicates_test1) {
+    auto matrix = NDArrayFactory::create<float>('c', {4, 3});
+    auto idc = NDArrayFactory::create<Nd4jLong>('c', {5}, {1, 3, 1, 1, 3});
+    auto updates = NDArrayFactory::create<float>('c', {5, 3}, {1.f, 1.f, 1.f, 2.f, 2.f, 2.f, 3.f, 3.f, 3.f, 4.f, 4.f, 4.f, 5.f, 5.f, 5.f});
+    auto exp = NDArrayFactory::create<float>('c', {4, 3}, {0.f, 0.f, 0.f, 4.f, 4.f, 4.f, 0.f, 0.f, 0.f, 5.f, 5.f, 5.f});
+
+    // last update of each row wins
+    nd4j::ops::scatter_upd op;
+    auto result = op.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////
+TEST_F(ParityOpsTests, scatterMaxSub_duplicates_test1) {
+    auto matrix = NDArrayFactory::create<float>('c', {2, 4});
+    auto idc = NDArrayFactory::create<Nd4jLong>('c', {2000});
+    auto updates = NDArrayFactory::create<float>('c', {2000, 4});
+    auto expMax = NDArrayFactory::create<float>('c', {2, 4}, {1998.f, 1998.f, 1998.f, 1998.f, 1999.f, 1999.f, 1999.f, 1999.f});
+    auto expSub = NDArrayFactory::create<float>('c', {2, 4}, {-999000.f, -999000.f, -999000.f, -999000.f, -1000000.f, -1000000.f, -1000000.f, -1000000.f});
+
+    // two rows are hit by all updates, so updates are reduced in chunks
+    for (int e = 0; e < 2000; e++) {
+        idc.p(e, e % 2);
+        for (int c = 0; c < 4; c++)
+            updates.p(e, c, (float) e);
+    }
+
+    nd4j::ops::scatter_max opMax;
+    auto resMax = opMax.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, resMax->status());
+    ASSERT_TRUE(expMax.equalsTo(resMax->at(0)));
+
+    nd4j::ops::scatter_sub opSub;
+    auto resSub = opSub.execute({&matrix, &idc, &updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, resSub->status());
+    ASSERT_TRUE(expSub.equalsTo(resSub->at(0)));
+
+    delete resMax;
+    delete resSub;
+}
+
+////////////////////////////////////////////////////////////////////////
+TEST_F(ParityOpsTests, scatterAdd_noncontiguous_test1) {
+    auto matrix = NDArrayFactory::create<float>('f', {4, 3});
+    auto idc = NDArrayFactory::create<Nd4jLong>('c', {2}, {2, 0});
+    auto base = NDArrayFactory::create<float>('c', {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    auto exp = NDArrayFactory::create<float>('c', {4, 3}, {2.f, 5.f, 8.f, 3.f, 4.f, 5.f, 7.f, 10.f, 13.f, 9.f, 10.f, 11.f});
+
+    for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 3; c++)
+            matrix.p(r, c, (float) (r * 3 + c));
+
+    // updates are transposed view: {{1, 3, 5}, {2, 4, 6}}
+    auto updates = base.permute({1, 0});
+
+    nd4j::ops::scatter_add op;
+    auto result = op.execute({&matrix, &idc, updates}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete updates;
+    delete result;
+}
@@ -170,4 +170,24 @@ TEST_F(VariableProxyTests, Test_Clone_1) {
     ASSERT_TRUE(clone->hasVariable(119));
 
     delete clone;
-}
\ No newline at end of file
+}
+TEST_F(VariableProxyTests, Test_Slots_1) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2}, {4, 2, 3, 1});
+    VariableSpace ref;
+
+    std::pair<int,int> pair(1, 0);
+    ref.putVariable(pair, x);
+
+    VariableProxy proxy(&ref);
+
+    auto slot = proxy.reserveSlot(pair);
+    ASSERT_EQ(slot, ref.slotOf(pair));
+    ASSERT_EQ(slot, proxy.slotOf(pair));
+    ASSERT_TRUE(proxy.slotVariable(slot, pair) == ref.getVariable(pair));
+
+    // local variable shadows backed one
+    proxy.putVariable(1, 0, y);
+    ASSERT_TRUE(proxy.slotVariable(slot, pair)->getNDArray() == y);
+    ASSERT_TRUE(ref.slotVariable(slot, pair)->getNDArray() == x);
+}
@@ -189,6 +189,42 @@ TEST_F(VariableSpaceTest, CloneTests_2) {
 }
 
 
+TEST_F(VariableSpaceTest, Test_Slots_1) {
+    VariableSpace space;
+
+    std::pair<int, int> pairA(-1, 0);
+    std::pair<int, int> pairB(3, 1);
+    std::pair<int, int> pairC(3, 2);
+
+    auto slotA = space.reserveSlot(pairA);
+    auto slotB = space.reserveSlot(pairB);
+
+    ASSERT_EQ(slotA, space.reserveSlot(pairA));
+    ASSERT_EQ(slotB, space.slotOf(pairB));
+    ASSERT_EQ(-1, space.slotOf(pairC));
+
+    // slots are reserved before values are produced
+    ASSERT_TRUE(space.slotVariable(slotB, pairB) == nullptr);
+
+    auto arrayA = NDArrayFactory::create_<float>('c', {2, 2});
+    auto arrayB = NDArrayFactory::create_<float>('c', {2, 2});
+    space.putVariable(-1, arrayA);
+    space.putVariable(pairB, arrayB);
+
+    ASSERT_TRUE(space.slotVariable(slotA, pairA) == space.getVariable(pairA));
+    ASSERT_TRUE(space.slotVariable(slotB, pairB) == space.getVariable(pairB));
+
+    // slot index doesn't match pair
+    ASSERT_TRUE(space.slotVariable(slotA, pairB) == nullptr);
+
+    auto clone = space.clone();
+    ASSERT_EQ(slotB, clone->slotOf(pairB));
+    ASSERT_TRUE(clone->slotVariable(slotB, pairB) == clone->getVariable(pairB));
+    ASSERT_TRUE(clone->slotVariable(slotB, pairB) != space.getVariable(pairB));
+
+    delete clone;
+}
+
 TEST_F(VariableSpaceTest, Test_DType_Conversion_1) {
     /*
     VariableSpace spaceA;
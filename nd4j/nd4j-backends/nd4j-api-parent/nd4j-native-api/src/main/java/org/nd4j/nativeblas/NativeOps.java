@@ -685,6 +685,11 @@ public abstract class NativeOps extends Pointer {
 
     public abstract void initializeFunctions(PointerPointer functions);
 
+    /**
+     * This method passes BLAS/LAPACK functions table of given length. Version without length assumes legacy 10-slot table
+     */
+    public abstract void initializeFunctions(PointerPointer functions, int numFunctions);
+
     public abstract Pointer mallocHost(long memorySize, int flags);
 
     public abstract Pointer mallocDevice(long memorySize, Pointer ptrToDeviceId, int flags);
@@ -739,6 +744,14 @@ public abstract class NativeOps extends Pointer {
 
     public abstract void enableVerboseMode(boolean reallyEnable);
 
+    public abstract void enableOpTracing(boolean reallyEnable);
+
+    public abstract boolean isOpTracingEnabled();
+
+    public abstract void resetOpTrace();
+
+    public abstract void dumpOpTrace(String fileName);
+
     public abstract void setGridLimit(int gridSize);
 
     public abstract void tadOnlyShapeInfo(@Cast("Nd4jLong *") LongPointer shapeInfo, IntPointer dimension, int dimensionLength,
@@ -1092,14 +1105,60 @@ public abstract class NativeOps extends Pointer {
 
     public abstract int execCustomOp(PointerPointer extraPointers, long opHashCode, PointerPointer inputBuffers, PointerPointer inputShapes, int numInput, PointerPointer outputBuffers, PointerPointer outputShapes, int numOutputs, DoublePointer tArgs, int numTArgs, @Cast("Nd4jLong *") LongPointer iArgs, int numIArgs, @Cast("bool *") BooleanPointer bArgs, int numBArgs, boolean isInplace);
 
+    /**
+     * Resolves custom op by hash once, returned handle stays valid for process lifetime
+     *
+     * @param opHashCode
+     * @return handle, or null pointer if op wasn't found
+     */
+    public abstract Pointer getCustomOpHandle(long opHashCode);
+
+    public abstract int execCustomOpByHandle(PointerPointer extraPointers, Pointer opHandle, PointerPointer inputBuffers, PointerPointer inputShapes, int numInput, PointerPointer outputBuffers, PointerPointer outputShapes, int numOutputs, DoublePointer tArgs, int numTArgs, @Cast("Nd4jLong *") LongPointer iArgs, int numIArgs, @Cast("bool *") BooleanPointer bArgs, int numBArgs, boolean isInplace);
+
+    public abstract int execCustomOpByHandle(PointerPointer extraPointers, Pointer opHandle, Pointer context);
+
+    public abstract Pointer createOpContext();
+
+    public abstract void setOpContextInput(Pointer opContext, int index, Pointer buffer, Pointer shapeInfo, Pointer specialBuffer, Pointer specialShapeInfo);
+
+    public abstract void setOpContextOutput(Pointer opContext, int index, Pointer buffer, Pointer shapeInfo, Pointer specialBuffer, Pointer specialShapeInfo);
+
+    public abstract void setOpContextTArguments(Pointer opContext, DoublePointer arguments, int numberOfArguments);
+
+    public abstract void setOpContextIArguments(Pointer opContext, @Cast("Nd4jLong *") LongPointer arguments, int numberOfArguments);
+
+    public abstract void setOpContextBArguments(Pointer opContext, @Cast("bool *") BooleanPointer arguments, int numberOfArguments);
+
+    public abstract void resetOpContext(Pointer opContext);
+
+    public abstract void deleteOpContext(Pointer opContext);
+
     public abstract Pointer calculateOutputShapes(PointerPointer extraPointers, long hash, PointerPointer inputShapes, int numInputShapes, DoublePointer tArgs, int numTArgs, @Cast("Nd4jLong *") LongPointer iArgs, int numIArgs);
 
     public abstract Pointer calculateOutputShapes(PointerPointer extraPointers, long hash, PointerPointer inputBunffers, PointerPointer inputShapes, int numInputShapes, DoublePointer tArgs, int numTArgs, @Cast("Nd4jLong *") LongPointer iArgs, int numIArgs, @Cast("bool *") BooleanPointer bArgs, int numBArgs);
 
     public abstract int registerGraph(PointerPointer extraPointers, long graphId, Pointer flatBufferPointer);
 
+    public abstract int registerMappedGraph(PointerPointer extraPointers, long graphId, String fileName);
+
     public abstract Pointer executeStoredGraph(PointerPointer extraPointers, long graphId, PointerPointer inputBuffers, PointerPointer inputShapes, IntPointer inputIndices, int numInputs);
 
+    public abstract Pointer execCustomOpAsync(PointerPointer extraPointers, long streamId, long opHashCode, Pointer opContext, PointerPointer dependencies, int numDependencies);
+
+    public abstract Pointer executeStoredGraphAsync(PointerPointer extraPointers, long streamId, long graphId, PointerPointer inputBuffers, PointerPointer inputShapes, IntPointer inputIndices, int numInputs, PointerPointer dependencies, int numDependencies);
+
+    public abstract boolean isTicketDone(Pointer ticket);
+
+    public abstract int waitForTicket(Pointer ticket);
+
+    public abstract Pointer getTicketVariables(Pointer ticket);
+
+    public abstract void deleteTicket(Pointer ticket);
+
+    public abstract void syncExecutionStream(long streamId);
+
+    public abstract void destroyExecutionStream(long streamId);
+
     public abstract void deleteResultWrapper(Pointer ptr);
 
     public abstract void deleteShapeList(Pointer ptr);
@@ -1141,4 +1200,18 @@ public abstract class NativeOps extends Pointer {
 
 
     public abstract void inspectArray(PointerPointer extraPointers, Pointer buffer, @Cast("Nd4jLong *") LongPointer shapeInfo, Pointer specialBuffer, @Cast("Nd4jLong *") LongPointer specialShapeInfo, @Cast("nd4j::DebugInfo *") Pointer debugInfo);
+
+    public abstract Pointer createHnswIndex(int dimensions, int metric, int M, int efConstruction, long capacity);
+
+    public abstract int addToHnswIndex(Pointer index, FloatPointer vectors, long numVectors);
+
+    public abstract int searchHnswIndex(Pointer index, FloatPointer queries, long numQueries, int k, int ef, @Cast("Nd4jLong *") LongPointer ids, FloatPointer distances);
+
+    public abstract long hnswIndexSize(Pointer index);
+
+    public abstract int saveHnswIndex(Pointer index, String fileName);
+
+    public abstract Pointer loadHnswIndex(String fileName);
+
+    public abstract void deleteHnswIndex(Pointer index);
 }
@@ -94,7 +94,7 @@ public class CpuNDArrayFactory extends BaseNativeNDArrayFactory {
 
         // TODO: add batched gemm here
 
-        PointerPointer functions = new PointerPointer(10);
+        PointerPointer functions = new PointerPointer(14);
         functions.put(0, Loader.addressof("cblas_sgemv"));
         functions.put(1, Loader.addressof("cblas_dgemv"));
         functions.put(2, Loader.addressof("cblas_sgemm"));
@@ -105,7 +105,11 @@ public class CpuNDArrayFactory extends BaseNativeNDArrayFactory {
         functions.put(7, Loader.addressof("LAPACKE_dgesvd"));
         functions.put(8, Loader.addressof("LAPACKE_sgesdd"));
         functions.put(9, Loader.addressof("LAPACKE_dgesdd"));
-        nativeOps.initializeFunctions(functions);
+        functions.put(10, Loader.addressof("LAPACKE_sgetrf"));
+        functions.put(11, Loader.addressof("LAPACKE_dgetrf"));
+        functions.put(12, Loader.addressof("LAPACKE_spotrf"));
+        functions.put(13, Loader.addressof("LAPACKE_dpotrf"));
+        nativeOps.initializeFunctions(functions, 14);
     }
 
     @Override